@@ -0,0 +1,68 @@
+// Leases payload buffers from the Windows plugin's per-printer pools so Dart
+// can write a ticket straight into the memory the print worker sends from.
+
+import 'dart:ffi';
+import 'dart:typed_data';
+
+import 'package:ffi/ffi.dart';
+
+typedef _LeaseBufferNative = Pointer<Uint8> Function(
+  Pointer<Utf8> printer,
+  Size size,
+  Pointer<Int64> lease,
+);
+typedef _LeaseBuffer = Pointer<Uint8> Function(
+  Pointer<Utf8> printer,
+  int size,
+  Pointer<Int64> lease,
+);
+typedef _ReleaseBufferNative = Void Function(Int64 lease);
+typedef _ReleaseBuffer = void Function(int lease);
+
+/// A native buffer leased from one printer's pool.
+///
+/// [bytes] is a view of native memory: fill it, then pass [lease] to
+/// `printBuffer`, after which [bytes] must not be touched again.
+class NativePrintBuffer {
+  NativePrintBuffer._(this.lease, this.bytes);
+
+  final int lease;
+  final Uint8List bytes;
+}
+
+/// Binds the buffer exports of `flutter_thermal_printer_plugin.dll`.
+class NativeBufferPool {
+  NativeBufferPool._(DynamicLibrary library)
+      : _lease = library.lookupFunction<_LeaseBufferNative, _LeaseBuffer>(
+          'FlutterThermalPrinterLeaseBuffer',
+        ),
+        _release =
+            library.lookupFunction<_ReleaseBufferNative, _ReleaseBuffer>(
+          'FlutterThermalPrinterReleaseBuffer',
+        );
+
+  static NativeBufferPool? _instance;
+
+  /// The engine has already loaded the plugin DLL, so this only looks it up.
+  static NativeBufferPool get instance => _instance ??= NativeBufferPool._(
+        DynamicLibrary.open('flutter_thermal_printer_plugin.dll'),
+      );
+
+  final _LeaseBuffer _lease;
+  final _ReleaseBuffer _release;
+
+  /// [size] writable bytes from [printer]'s pool, or null when too many
+  /// leases are outstanding.
+  NativePrintBuffer? lease(String printer, int size) => using((arena) {
+        final lease = arena<Int64>();
+        final name = printer.toNativeUtf8(allocator: arena);
+        final data = _lease(name, size, lease);
+        if (data == nullptr) {
+          return null;
+        }
+        return NativePrintBuffer._(lease.value, data.asTypedList(size));
+      });
+
+  /// Returns [buffer] to its pool without printing it.
+  void release(NativePrintBuffer buffer) => _release(buffer.lease);
+}
@@ -1,8 +0,0 @@
-// Windows-specific printer functionality
-// This file re-exports Windows printer classes and constants
-
-export 'package:ffi/ffi.dart' show using;
-export 'package:win32/win32.dart' show PRINTER_ENUM_LOCAL;
-
-export 'print_data.dart';
-export 'printers_data.dart';
@@ -7,14 +7,33 @@ import 'package:flutter/material.dart';
 import 'package:image/image.dart' as img;
 import 'package:screenshot/screenshot.dart';
 
+import 'flutter_thermal_printer_platform_interface.dart';
 import 'printer_manager.dart';
 import 'utils/ble_config.dart';
+import 'utils/dither_mode.dart';
+import 'utils/job_stats.dart';
+import 'utils/print_job_event.dart';
+import 'utils/print_template.dart';
 import 'utils/printer.dart';
+import 'utils/printer_status.dart';
+import 'utils/printer_transport.dart';
+import 'utils/receipt_text.dart';
+import 'utils/windows_printer_info.dart';
 
 export 'package:esc_pos_utils_plus/esc_pos_utils_plus.dart';
 export 'package:flutter_thermal_printer/network/network_printer.dart';
 export 'package:flutter_thermal_printer/utils/ble_config.dart';
+export 'package:flutter_thermal_printer/utils/dither_mode.dart';
+export 'package:flutter_thermal_printer/utils/job_stats.dart';
+export 'package:flutter_thermal_printer/utils/nv_logo.dart';
+export 'package:flutter_thermal_printer/utils/print_job_event.dart';
+export 'package:flutter_thermal_printer/utils/print_template.dart';
 export 'package:flutter_thermal_printer/utils/printer.dart';
+export 'package:flutter_thermal_printer/utils/printer_status.dart';
+export 'package:flutter_thermal_printer/utils/printer_transport.dart';
+export 'package:flutter_thermal_printer/utils/receipt_text.dart';
+export 'package:flutter_thermal_printer/utils/warm_up_report.dart';
+export 'package:flutter_thermal_printer/utils/windows_printer_info.dart';
 
 /// Main class for thermal printer operations across all platforms
 ///
@@ -108,6 +127,144 @@ class FlutterThermalPrinter {
         chunkSize: chunkSize,
       );
 
+  /// Print bytes that [fill] writes into a pooled native buffer; see
+  /// [PrinterManager.printPooled].
+  Future<void> printPooled(
+    Printer printer,
+    int capacity,
+    int Function(Uint8List buffer) fill,
+  ) =>
+      PrinterManager.instance.printPooled(printer, capacity, fill);
+
+  /// Start sending [printer]'s writes as one document; see
+  /// [PrinterManager.beginBatch].
+  Future<void> beginBatch(Printer printer) =>
+      PrinterManager.instance.beginBatch(printer);
+
+  /// Spool the writes since [beginBatch] as one document.
+  Future<void> endBatch(Printer printer) =>
+      PrinterManager.instance.endBatch(printer);
+
+  /// Merge writes that arrive within [window]; see
+  /// [PrinterManager.setBatchWindow].
+  Future<void> setBatchWindow(Printer printer, Duration window) =>
+      PrinterManager.instance.setBatchWindow(printer, window);
+
+  /// Register a pre-encoded ticket; see [PrinterManager.registerTemplate].
+  Future<void> registerTemplate(PrintTemplate template) =>
+      PrinterManager.instance.registerTemplate(template);
+
+  /// Drop a registered template.
+  Future<bool> removeTemplate(String name) =>
+      PrinterManager.instance.removeTemplate(name);
+
+  /// Print a registered template with only its field values sent; see
+  /// [PrinterManager.printTemplate].
+  Future<void> printTemplate(
+    Printer printer,
+    String name,
+    Map<String, List<int>> values, {
+    int priority = 0,
+  }) =>
+      PrinterManager.instance.printTemplate(
+        printer,
+        name,
+        values,
+        priority: priority,
+      );
+
+  /// Store [logo] in [printer]'s NV graphics memory under [key]; see
+  /// [PrinterManager.storeLogo].
+  Future<bool> storeLogo(
+    Printer printer,
+    String key,
+    img.Image logo, {
+    DitherMode dither = DitherMode.threshold,
+    int? scaleWidth,
+    bool force = false,
+  }) =>
+      PrinterManager.instance.storeLogo(
+        printer,
+        key,
+        _rgbaBytes(logo),
+        width: logo.width,
+        height: logo.height,
+        dither: dither,
+        scaleWidth: scaleWidth,
+        force: force,
+      );
+
+  /// Print a logo stored with [storeLogo] by its key.
+  Future<void> printLogo(Printer printer, String key) =>
+      PrinterManager.instance.printLogo(printer, key);
+
+  /// Queue raw data on the native print worker without waiting for it to
+  /// print; completes with the job id.
+  ///
+  /// Completion is reported on [jobEvents]. Windows USB printers only.
+  Future<int> submitPrintJob(
+    Printer device,
+    List<int> bytes, {
+    int priority = 0,
+  }) async =>
+      PrinterManager.instance.submitPrintJob(
+        device,
+        bytes,
+        priority: priority,
+      );
+
+  /// Cancel a queued job; see [PrinterManager.cancelJob].
+  Future<bool> cancelJob(int jobId) =>
+      PrinterManager.instance.cancelJob(jobId);
+
+  /// Bound a printer's native queue; see [PrinterManager.setQueueLimit].
+  Future<void> setQueueLimit(Printer printer, int maxBytes) =>
+      PrinterManager.instance.setQueueLimit(printer, maxBytes);
+
+  /// Completions of jobs queued with [submitPrintJob].
+  Stream<PrintJobEvent> get jobEvents => PrinterManager.instance.jobEvents;
+
+  /// Spooler, direct USB, raw TCP or loopback writes; see
+  /// [PrinterManager.setTransport].
+  Future<bool> setTransport(
+    Printer device,
+    PrinterTransport transport, {
+    String? devicePath,
+    int? chunkSize,
+    int? maxInFlight,
+    String? host,
+    int? port,
+    Duration? connectTimeout,
+    String? path,
+    int? baudRate,
+    Duration? latency,
+  }) =>
+      PrinterManager.instance.setTransport(
+        device,
+        transport,
+        devicePath: devicePath,
+        chunkSize: chunkSize,
+        maxInFlight: maxInFlight,
+        host: host,
+        port: port,
+        connectTimeout: connectTimeout,
+        path: path,
+        baudRate: baudRate,
+        latency: latency,
+      );
+
+  /// Native per-stage job timings; see [PrinterManager.getJobStats].
+  Future<JobStatsSnapshot> getJobStats({String? printer}) =>
+      PrinterManager.instance.getJobStats(printer: printer);
+
+  /// Prepares the native side for the first print; see
+  /// [PrinterManager.warmUp].
+  Future<WarmUpReport> warmUp([List<Printer> printers = const []]) =>
+      PrinterManager.instance.warmUp(printers);
+
+  /// Stage timings of each native job as it finishes (Windows only).
+  Stream<JobStageTimes> get jobStats => PrinterManager.instance.jobStats;
+
   /// Get available printers
   Future<void> getPrinters({
     Duration refreshDuration = const Duration(seconds: 2),
@@ -123,6 +280,32 @@ class FlutterThermalPrinter {
     );
   }
 
+  /// Cached Windows print queue metadata; see
+  /// [PrinterManager.getPrinterDetails].
+  Future<List<WindowsPrinterInfo>> getPrinterDetails() =>
+      PrinterManager.instance.getPrinterDetails();
+
+  /// Last polled printer status; see [PrinterManager.getStatus].
+  Future<PrinterStatus> getStatus(Printer printer) =>
+      PrinterManager.instance.getStatus(printer);
+
+  /// Encode a text receipt natively; see [PrinterManager.encodeText].
+  Future<Uint8List> encodeText(ReceiptText receipt) =>
+      PrinterManager.instance.encodeText(receipt);
+
+  /// Print one ticket on several printers at once; see
+  /// [PrinterManager.printToMany].
+  Future<Map<String, String?>> printToMany(
+    List<Printer> printers,
+    List<int> bytes, {
+    int priority = 0,
+  }) =>
+      PrinterManager.instance.printToMany(
+        printers,
+        bytes,
+        priority: priority,
+      );
+
   /// Stop scanning for printers
   Future<void> stopScan() async {
     await PrinterManager.instance.stopScan();
@@ -141,6 +324,11 @@ class FlutterThermalPrinter {
   // ==========================================================================
 
   /// Optimized screen capture and conversion to printer-ready bytes
+  ///
+  /// [dither] selects the native raster mode on Windows; other platforms
+  /// always use the threshold raster from `esc_pos_utils_plus`. On Windows,
+  /// [feedBlankRows] sends white gaps as paper feeds instead of raster rows
+  /// (for printers whose feed unit is one dot, as on most 203 dpi models).
   Future<Uint8List> screenShotWidget(
     BuildContext context, {
     required Widget widget,
@@ -148,6 +336,8 @@ class FlutterThermalPrinter {
     int? customWidth,
     PaperSize paperSize = PaperSize.mm80,
     Generator? generator,
+    DitherMode dither = DitherMode.threshold,
+    bool feedBlankRows = false,
   }) async {
     final controller = ScreenshotController();
 
@@ -158,6 +348,18 @@ class FlutterThermalPrinter {
         delay: delay,
       );
 
+      // The native engine decodes the PNG itself, resamples it to
+      // [customWidth] and pads odd widths, so the capture never becomes a
+      // full-size RGBA image in Dart.
+      if (Platform.isWindows) {
+        return FlutterThermalPrinterPlatform.instance.rasterizeEncodedImage(
+          image,
+          dither: dither,
+          scaleWidth: customWidth,
+          feedBlankRows: feedBlankRows,
+        );
+      }
+
       final profile = await CapabilityProfile.load();
       final generator0 = generator ?? Generator(paperSize, profile);
 
@@ -194,6 +396,10 @@ class FlutterThermalPrinter {
   }
 
   /// Optimized widget printing with better resource management
+  ///
+  /// [customWidth] scales the capture to that many dots wide; Windows USB
+  /// printers resample it natively while it prints. [feedBlankRows] is as
+  /// for [screenShotWidget].
   Future<void> printWidget(
     BuildContext context, {
     required Printer printer,
@@ -204,6 +410,9 @@ class FlutterThermalPrinter {
     bool printOnBle = false,
     bool cutAfterPrinted = true,
     int? chunkSize,
+    int? customWidth,
+    DitherMode dither = DitherMode.threshold,
+    bool feedBlankRows = false,
   }) async {
     final controller = ScreenshotController();
 
@@ -222,6 +431,9 @@ class FlutterThermalPrinter {
         profile,
         cutAfterPrinted,
         chunkSize: chunkSize,
+        customWidth: customWidth,
+        dither: dither,
+        feedBlankRows: feedBlankRows,
       );
     } catch (e) {
       throw Exception('Failed to print widget: $e');
@@ -267,6 +479,11 @@ class FlutterThermalPrinter {
     return Uint8List.fromList(bytes);
   }
 
+  /// Tightly packed 8-bit RGBA, the layout the native raster engine takes.
+  Uint8List _rgbaBytes(img.Image image) => image
+      .convert(format: img.Format.uint8, numChannels: 4)
+      .getBytes(order: img.ChannelOrder.rgba);
+
   /// Ensure image width is compatible with thermal printers (divisible by 8)
   img.Image _buildImageRasterAvailable(img.Image image) {
     if (image.width % 8 == 0) {
@@ -293,21 +510,43 @@ class FlutterThermalPrinter {
     CapabilityProfile? profile,
     bool cutAfterPrinted, {
     int? chunkSize,
+    int? customWidth,
+    DitherMode dither = DitherMode.threshold,
+    bool feedBlankRows = false,
   }) async {
     final profile0 = profile ?? await CapabilityProfile.load();
     final ticket = Generator(paperSize, profile0);
 
+    if (Platform.isWindows && printer.connectionType == ConnectionType.USB) {
+      // The PNG is decoded natively a band of rows at a time and each band
+      // goes to the spooler as it is rasterized, so paper starts moving
+      // before the rest of a long receipt is even decoded.
+      await FlutterThermalPrinterPlatform.instance.printEncodedImage(
+        printer,
+        image,
+        dither: dither,
+        scaleWidth: customWidth,
+        feedBlankRows: feedBlankRows,
+        suffix: cutAfterPrinted ? Uint8List.fromList(ticket.cut()) : null,
+      );
+      return;
+    }
+
     var imagebytes = img.decodeImage(image);
     if (imagebytes == null) {
       throw Exception('Failed to decode image for chunked printing');
     }
 
+    if (customWidth != null) {
+      imagebytes = img.copyResize(
+        imagebytes,
+        width: _makeDivisibleBy8(customWidth),
+      );
+    }
     imagebytes = _buildImageRasterAvailable(imagebytes);
 
-    if ((Platform.isMacOS || Platform.isWindows) &&
-        printer.connectionType == ConnectionType.USB) {
-      List<int> raster;
-      raster = ticket.imageRaster(imagebytes);
+    if (Platform.isMacOS && printer.connectionType == ConnectionType.USB) {
+      var raster = ticket.imageRaster(imagebytes);
       if (cutAfterPrinted) {
         raster += ticket.cut();
       }
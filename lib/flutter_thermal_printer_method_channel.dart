@@ -2,7 +2,15 @@ import 'package:flutter/foundation.dart';
 import 'package:flutter/services.dart';
 
 import 'flutter_thermal_printer_platform_interface.dart';
+import 'utils/dither_mode.dart';
+import 'utils/job_stats.dart';
+import 'utils/print_template.dart';
 import 'utils/printer.dart';
+import 'utils/printer_status.dart';
+import 'utils/printer_transport.dart';
+import 'utils/receipt_text.dart';
+import 'utils/warm_up_report.dart';
+import 'utils/windows_printer_info.dart';
 
 /// An implementation of [FlutterThermalPrinterPlatform] that uses method channels.
 class MethodChannelFlutterThermalPrinter extends FlutterThermalPrinterPlatform {
@@ -10,6 +18,14 @@ class MethodChannelFlutterThermalPrinter extends FlutterThermalPrinterPlatform {
   @visibleForTesting
   final methodChannel = const MethodChannel('flutter_thermal_printer');
 
+  /// Byte payloads go to the Windows plugin as a typed `Uint8List`, which the
+  /// codec copies in one block. The Android and macOS handlers still read
+  /// `List<int>`.
+  Object _encodePayload(Uint8List data) =>
+      defaultTargetPlatform == TargetPlatform.windows
+          ? data
+          : List<int>.from(data);
+
   @override
   Future<String?> getPlatformVersion() async {
     final version =
@@ -35,10 +51,38 @@ class MethodChannelFlutterThermalPrinter extends FlutterThermalPrinterPlatform {
         'vendorId': device.vendorId.toString(),
         'productId': device.productId.toString(),
         'name': device.name,
-        'data': List<int>.from(data),
+        if (device.address != null) 'address': device.address,
+        'data': _encodePayload(data),
         'path': path ?? '',
       });
 
+  @override
+  Future<int> submitPrintJob(
+    Printer device,
+    Uint8List data, {
+    int priority = 0,
+  }) async =>
+      await methodChannel.invokeMethod('submitJob', {
+        'name': device.name,
+        'data': data,
+        if (priority != 0) 'priority': priority,
+      });
+
+  @override
+  Future<bool> cancelJob(int jobId) async =>
+      await methodChannel.invokeMethod<bool>('cancelJob', {
+        'jobId': jobId,
+      }) ??
+      false;
+
+  @override
+  Future<bool> setQueueLimit(Printer device, int maxBytes) async =>
+      await methodChannel.invokeMethod<bool>('setQueueLimit', {
+        'name': device.name,
+        'maxBytes': maxBytes,
+      }) ??
+      false;
+
   @override
   Future<bool> isConnected(Printer device) async =>
       await methodChannel.invokeMethod('isConnected', device.toJson());
@@ -49,9 +93,286 @@ class MethodChannelFlutterThermalPrinter extends FlutterThermalPrinterPlatform {
         'path': List<int>.from(value!),
       });
 
+  @override
+  Future<Uint8List> rasterizeImage(
+    Uint8List pixels, {
+    required int width,
+    required int height,
+    DitherMode dither = DitherMode.threshold,
+    int threshold = 128,
+    int? scaleWidth,
+    bool feedBlankRows = false,
+  }) async {
+    final raster =
+        await methodChannel.invokeMethod<Uint8List>('convertimage', {
+      'pixels': pixels,
+      'width': width,
+      'height': height,
+      'dither': dither.index,
+      'threshold': threshold,
+      if (scaleWidth != null) 'scaleWidth': scaleWidth,
+      if (feedBlankRows) 'feedBlankRows': true,
+    });
+    return raster!;
+  }
+
+  @override
+  Future<void> printImage(
+    Printer device,
+    Uint8List pixels, {
+    required int width,
+    required int height,
+    DitherMode dither = DitherMode.threshold,
+    int threshold = 128,
+    int? scaleWidth,
+    bool feedBlankRows = false,
+    Uint8List? prefix,
+    Uint8List? suffix,
+  }) async =>
+      await methodChannel.invokeMethod('printImage', {
+        'name': device.name,
+        'pixels': pixels,
+        'width': width,
+        'height': height,
+        'dither': dither.index,
+        'threshold': threshold,
+        if (scaleWidth != null) 'scaleWidth': scaleWidth,
+        if (feedBlankRows) 'feedBlankRows': true,
+        if (prefix != null) 'prefix': prefix,
+        if (suffix != null) 'suffix': suffix,
+      });
+
+  @override
+  Future<Uint8List> rasterizeEncodedImage(
+    Uint8List encoded, {
+    DitherMode dither = DitherMode.threshold,
+    int threshold = 128,
+    int? scaleWidth,
+    bool feedBlankRows = false,
+  }) async {
+    final raster =
+        await methodChannel.invokeMethod<Uint8List>('convertimage', {
+      'encoded': encoded,
+      'dither': dither.index,
+      'threshold': threshold,
+      if (scaleWidth != null) 'scaleWidth': scaleWidth,
+      if (feedBlankRows) 'feedBlankRows': true,
+    });
+    return raster!;
+  }
+
+  @override
+  Future<void> printEncodedImage(
+    Printer device,
+    Uint8List encoded, {
+    DitherMode dither = DitherMode.threshold,
+    int threshold = 128,
+    int? scaleWidth,
+    bool feedBlankRows = false,
+    Uint8List? prefix,
+    Uint8List? suffix,
+  }) async =>
+      await methodChannel.invokeMethod('printImage', {
+        'name': device.name,
+        'encoded': encoded,
+        'dither': dither.index,
+        'threshold': threshold,
+        if (scaleWidth != null) 'scaleWidth': scaleWidth,
+        if (feedBlankRows) 'feedBlankRows': true,
+        if (prefix != null) 'prefix': prefix,
+        if (suffix != null) 'suffix': suffix,
+      });
+
+  @override
+  Future<bool> printBuffer(Printer device, int buffer, int length) async =>
+      await methodChannel.invokeMethod<bool>('printBuffer', {
+        'name': device.name,
+        'buffer': buffer,
+        'length': length,
+      }) ??
+      false;
+
+  @override
+  Future<bool> beginBatch(Printer device) async =>
+      await methodChannel.invokeMethod<bool>('beginBatch', {
+        'name': device.name,
+      }) ??
+      false;
+
+  @override
+  Future<bool> endBatch(Printer device) async =>
+      await methodChannel.invokeMethod<bool>('endBatch', {
+        'name': device.name,
+      }) ??
+      false;
+
+  @override
+  Future<bool> setBatchWindow(Printer device, Duration window) async =>
+      await methodChannel.invokeMethod<bool>('setBatchWindow', {
+        'name': device.name,
+        'windowMs': window.inMilliseconds,
+      }) ??
+      false;
+
+  @override
+  Future<bool> registerTemplate(PrintTemplate template) async =>
+      await methodChannel.invokeMethod<bool>('registerTemplate', {
+        'template': template.name,
+        'bytes': template.bytes,
+        'fields': template.fields.map((field) => field.toMap()).toList(),
+      }) ??
+      false;
+
+  @override
+  Future<bool> removeTemplate(String name) async =>
+      await methodChannel.invokeMethod<bool>('removeTemplate', {
+        'template': name,
+      }) ??
+      false;
+
+  @override
+  Future<bool> printTemplate(
+    Printer device,
+    String name,
+    Map<String, Uint8List> values, {
+    int priority = 0,
+  }) async =>
+      await methodChannel.invokeMethod<bool>('printTemplate', {
+        'name': device.name,
+        'template': name,
+        'values': values,
+        if (priority != 0) 'priority': priority,
+      }) ??
+      false;
+
+  @override
+  Future<bool> storeLogo(
+    Printer device,
+    String key,
+    Uint8List pixels, {
+    required int width,
+    required int height,
+    DitherMode dither = DitherMode.threshold,
+    int threshold = 128,
+    int? scaleWidth,
+    bool force = false,
+  }) async =>
+      await methodChannel.invokeMethod<bool>('storeLogo', {
+        'name': device.name,
+        'key': key,
+        'pixels': pixels,
+        'width': width,
+        'height': height,
+        'dither': dither.index,
+        'threshold': threshold,
+        if (scaleWidth != null) 'scaleWidth': scaleWidth,
+        'force': force,
+      }) ??
+      false;
+
+  @override
+  Future<bool> printLogo(Printer device, String key) async =>
+      await methodChannel.invokeMethod<bool>('printLogo', {
+        'name': device.name,
+        'key': key,
+      }) ??
+      false;
+
+  @override
+  Future<JobStatsSnapshot> getJobStats({String? printer}) async {
+    final stats = await methodChannel.invokeMethod<Map>('getJobStats', {
+      if (printer != null) 'printer': printer,
+    });
+    return JobStatsSnapshot.fromMap(stats ?? const {});
+  }
+
+  @override
+  Future<WarmUpReport> warmUp(List<Printer> devices) async {
+    final report = await methodChannel.invokeMethod<Map>('warmUp', {
+      'printers': [for (final device in devices) device.name],
+    });
+    return WarmUpReport.fromMap(report ?? const {});
+  }
+
+  @override
+  Future<bool> setTransport(
+    Printer device,
+    PrinterTransport transport, {
+    String? devicePath,
+    int? chunkSize,
+    int? maxInFlight,
+    String? host,
+    int? port,
+    Duration? connectTimeout,
+    String? path,
+    int? baudRate,
+    Duration? latency,
+  }) async =>
+      await methodChannel.invokeMethod<bool>('setTransport', {
+        'name': device.name,
+        if (device.address != null) 'address': device.address,
+        'transport': transport.name,
+        if (devicePath != null) 'devicePath': devicePath,
+        if (chunkSize != null) 'chunkSize': chunkSize,
+        if (maxInFlight != null) 'maxInFlight': maxInFlight,
+        if (host != null) 'host': host,
+        if (port != null) 'port': port,
+        if (connectTimeout != null)
+          'connectTimeoutMs': connectTimeout.inMilliseconds,
+        if (path != null) 'path': path,
+        if (baudRate != null) 'baudRate': baudRate,
+        if (latency != null) 'latencyMs': latency.inMilliseconds,
+      }) ??
+      false;
+
+  @override
+  Future<List<WindowsPrinterInfo>> getPrinterDetails() async {
+    final printers = await methodChannel.invokeMethod<List>('getPrinters');
+    return (printers ?? const [])
+        .map((entry) => WindowsPrinterInfo.fromMap(entry as Map))
+        .toList();
+  }
+
+  @override
+  Future<PrinterStatus> getStatus(Printer device) async {
+    final status = await methodChannel.invokeMethod<Map>('getStatus', {
+      'name': device.name,
+      if (device.address != null) 'address': device.address,
+    });
+    return status == null
+        ? const PrinterStatus()
+        : PrinterStatus.fromMap(status);
+  }
+
+  @override
+  Future<Uint8List> encodeText(ReceiptText receipt) async {
+    final bytes = await methodChannel.invokeMethod<Uint8List>(
+        'encodeText', receipt.toMap());
+    return bytes!;
+  }
+
+  @override
+  Future<Map<String, String?>> printToMany(
+    List<Printer> devices,
+    Uint8List data, {
+    int priority = 0,
+  }) async {
+    final outcomes = await methodChannel.invokeMethod<Map>('printToMany', {
+      'printers': [for (final device in devices) device.name],
+      'data': data,
+      if (priority != 0) 'priority': priority,
+    });
+    return {
+      for (final entry in (outcomes ?? const {}).entries)
+        entry.key as String: entry.value as String?,
+    };
+  }
+
   @override
   Future<bool> disconnect(Printer device) async =>
       await methodChannel.invokeMethod('disconnect', {
+        if (device.name != null) 'name': device.name,
+        if (device.address != null) 'address': device.address,
         'vendorId': device.vendorId.toString(),
         'productId': device.productId.toString(),
       });
@@ -3,7 +3,15 @@ import 'dart:typed_data';
 import 'package:plugin_platform_interface/plugin_platform_interface.dart';
 
 import 'flutter_thermal_printer_method_channel.dart';
+import 'utils/dither_mode.dart';
+import 'utils/job_stats.dart';
+import 'utils/print_template.dart';
 import 'utils/printer.dart';
+import 'utils/printer_status.dart';
+import 'utils/printer_transport.dart';
+import 'utils/receipt_text.dart';
+import 'utils/warm_up_report.dart';
+import 'utils/windows_printer_info.dart';
 
 abstract class FlutterThermalPrinterPlatform extends PlatformInterface {
   FlutterThermalPrinterPlatform() : super(token: _token);
@@ -33,6 +41,31 @@ abstract class FlutterThermalPrinterPlatform extends PlatformInterface {
     throw UnimplementedError('printText() has not been implemented.');
   }
 
+  /// Queues [data] natively and completes with the job id without waiting
+  /// for the printer. Jobs with a higher [priority] print first. Only
+  /// implemented on Windows.
+  Future<int> submitPrintJob(
+    Printer device,
+    Uint8List data, {
+    int priority = 0,
+  }) {
+    throw UnimplementedError('submitPrintJob() has not been implemented.');
+  }
+
+  /// Cancels job [jobId]: removes it from the queue, or stops a streaming
+  /// image that is printing. Completes with false if it already reached the
+  /// spooler. Only implemented on Windows.
+  Future<bool> cancelJob(int jobId) {
+    throw UnimplementedError('cancelJob() has not been implemented.');
+  }
+
+  /// Caps the bytes [device]'s unfinished jobs may hold; further jobs fail
+  /// with `BUSY` until it drains. Zero removes the cap. Only implemented on
+  /// Windows.
+  Future<bool> setQueueLimit(Printer device, int maxBytes) {
+    throw UnimplementedError('setQueueLimit() has not been implemented.');
+  }
+
   Future<bool> isConnected(Printer device) {
     throw UnimplementedError('isConnected() has not been implemented.');
   }
@@ -43,6 +76,73 @@ abstract class FlutterThermalPrinterPlatform extends PlatformInterface {
     );
   }
 
+  /// Converts tightly packed RGBA [pixels] to ESC/POS `GS v 0` raster bytes
+  /// natively. A non-null [scaleWidth] first resamples the image to that
+  /// many dots wide, keeping its aspect ratio, so captures need no resize
+  /// in Dart. [feedBlankRows] sends runs of white rows as `ESC J` paper
+  /// feeds instead of raster data; it assumes the printer's feed unit is
+  /// one dot, as on most 203 dpi printers. Only implemented on Windows.
+  Future<Uint8List> rasterizeImage(
+    Uint8List pixels, {
+    required int width,
+    required int height,
+    DitherMode dither = DitherMode.threshold,
+    int threshold = 128,
+    int? scaleWidth,
+    bool feedBlankRows = false,
+  }) {
+    throw UnimplementedError('rasterizeImage() has not been implemented.');
+  }
+
+  /// Rasterizes RGBA [pixels] natively and prints them as one document,
+  /// writing each band while the next is converted. [prefix] and [suffix]
+  /// are raw bytes sent before and after the image. Only implemented on
+  /// Windows.
+  Future<void> printImage(
+    Printer device,
+    Uint8List pixels, {
+    required int width,
+    required int height,
+    DitherMode dither = DitherMode.threshold,
+    int threshold = 128,
+    int? scaleWidth,
+    bool feedBlankRows = false,
+    Uint8List? prefix,
+    Uint8List? suffix,
+  }) {
+    throw UnimplementedError('printImage() has not been implemented.');
+  }
+
+  /// [rasterizeImage] for an encoded image such as the PNG of a widget
+  /// capture, decoded natively a band of rows at a time so no full-size
+  /// RGBA copy is made. Only implemented on Windows.
+  Future<Uint8List> rasterizeEncodedImage(
+    Uint8List encoded, {
+    DitherMode dither = DitherMode.threshold,
+    int threshold = 128,
+    int? scaleWidth,
+    bool feedBlankRows = false,
+  }) {
+    throw UnimplementedError(
+      'rasterizeEncodedImage() has not been implemented.',
+    );
+  }
+
+  /// [printImage] for an encoded image such as the PNG of a widget capture,
+  /// decoded natively as it is printed. Only implemented on Windows.
+  Future<void> printEncodedImage(
+    Printer device,
+    Uint8List encoded, {
+    DitherMode dither = DitherMode.threshold,
+    int threshold = 128,
+    int? scaleWidth,
+    bool feedBlankRows = false,
+    Uint8List? prefix,
+    Uint8List? suffix,
+  }) {
+    throw UnimplementedError('printEncodedImage() has not been implemented.');
+  }
+
   Future<bool> disconnect(Printer device) {
     throw UnimplementedError('disconnect() has not been implemented.');
   }
@@ -54,4 +154,134 @@ abstract class FlutterThermalPrinterPlatform extends PlatformInterface {
   Future<void> getPrinters() {
     throw UnimplementedError('getPrinters() has not been implemented.');
   }
+
+  /// Prints the first [length] bytes of native buffer [buffer], leased from
+  /// the plugin's pool and filled in place. Only implemented on Windows.
+  Future<bool> printBuffer(Printer device, int buffer, int length) {
+    throw UnimplementedError('printBuffer() has not been implemented.');
+  }
+
+  /// Starts collecting [device]'s writes into one document. Writes reply
+  /// straight away until [endBatch]. Only implemented on Windows.
+  Future<bool> beginBatch(Printer device) {
+    throw UnimplementedError('beginBatch() has not been implemented.');
+  }
+
+  /// Sends the writes since [beginBatch] as one document and completes once
+  /// it is spooled. Only implemented on Windows.
+  Future<bool> endBatch(Printer device) {
+    throw UnimplementedError('endBatch() has not been implemented.');
+  }
+
+  /// How long [device]'s worker waits for more writes to merge into the
+  /// document it is about to send. Only implemented on Windows.
+  Future<bool> setBatchWindow(Printer device, Duration window) {
+    throw UnimplementedError('setBatchWindow() has not been implemented.');
+  }
+
+  /// Stores [template] natively under its name, replacing any template
+  /// registered before with that name. Only implemented on Windows.
+  Future<bool> registerTemplate(PrintTemplate template) {
+    throw UnimplementedError('registerTemplate() has not been implemented.');
+  }
+
+  /// Drops the template registered as [name]. Only implemented on Windows.
+  Future<bool> removeTemplate(String name) {
+    throw UnimplementedError('removeTemplate() has not been implemented.');
+  }
+
+  /// Prints template [name] with [values] spliced into its fields. Only
+  /// implemented on Windows.
+  Future<bool> printTemplate(
+    Printer device,
+    String name,
+    Map<String, Uint8List> values, {
+    int priority = 0,
+  }) {
+    throw UnimplementedError('printTemplate() has not been implemented.');
+  }
+
+  /// Rasterizes RGBA [pixels] into [device]'s non-volatile graphics memory
+  /// under the two-character [key]. Completes with false without writing
+  /// if the plugin already stored this image there, unless [force]. Only
+  /// implemented on Windows.
+  Future<bool> storeLogo(
+    Printer device,
+    String key,
+    Uint8List pixels, {
+    required int width,
+    required int height,
+    DitherMode dither = DitherMode.threshold,
+    int threshold = 128,
+    int? scaleWidth,
+    bool force = false,
+  }) {
+    throw UnimplementedError('storeLogo() has not been implemented.');
+  }
+
+  /// Prints the logo stored under [key] by [storeLogo]. Only implemented on
+  /// Windows.
+  Future<bool> printLogo(Printer device, String key) {
+    throw UnimplementedError('printLogo() has not been implemented.');
+  }
+
+  /// Stage timings and per-printer percentiles of native print jobs,
+  /// optionally for one [printer]. Only implemented on Windows.
+  Future<JobStatsSnapshot> getJobStats({String? printer}) {
+    throw UnimplementedError('getJobStats() has not been implemented.');
+  }
+
+  /// Does the native first-use work (printer enumeration, raster setup, and
+  /// each of [devices]' buffers and spooler handle) in the background, and
+  /// reports how long each step took. Only implemented on Windows.
+  Future<WarmUpReport> warmUp(List<Printer> devices) {
+    throw UnimplementedError('warmUp() has not been implemented.');
+  }
+
+  /// Routes later jobs for [device] through [transport], after any that are
+  /// already queued. Only implemented on Windows.
+  Future<bool> setTransport(
+    Printer device,
+    PrinterTransport transport, {
+    String? devicePath,
+    int? chunkSize,
+    int? maxInFlight,
+    String? host,
+    int? port,
+    Duration? connectTimeout,
+    String? path,
+    int? baudRate,
+    Duration? latency,
+  }) {
+    throw UnimplementedError('setTransport() has not been implemented.');
+  }
+
+  /// Snapshot of the natively cached print queues. Only implemented on
+  /// Windows.
+  Future<List<WindowsPrinterInfo>> getPrinterDetails() {
+    throw UnimplementedError('getPrinterDetails() has not been implemented.');
+  }
+
+  /// The status the plugin last polled from [device], without waiting on
+  /// the printer. Only implemented on Windows.
+  Future<PrinterStatus> getStatus(Printer device) {
+    throw UnimplementedError('getStatus() has not been implemented.');
+  }
+
+  /// Encodes [receipt] to ESC/POS bytes natively. Only implemented on
+  /// Windows.
+  Future<Uint8List> encodeText(ReceiptText receipt) {
+    throw UnimplementedError('encodeText() has not been implemented.');
+  }
+
+  /// Prints [data] on every printer in [devices] at once and completes when
+  /// all of them are done, with each printer's name mapped to null if it
+  /// printed or to why it did not. Only implemented on Windows.
+  Future<Map<String, String?>> printToMany(
+    List<Printer> devices,
+    Uint8List data, {
+    int priority = 0,
+  }) {
+    throw UnimplementedError('printToMany() has not been implemented.');
+  }
 }
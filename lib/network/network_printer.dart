@@ -1,7 +1,11 @@
 import 'dart:io';
 import 'network_print_result.dart';
 
-/// Optimized network thermal printer with improved connection management
+/// Optimized network thermal printer with improved connection management.
+///
+/// On Windows, printing a `ConnectionType.NETWORK` printer through
+/// `FlutterThermalPrinter` uses the plugin's native TCP engine instead,
+/// which queues jobs like USB and keeps the connection open between tickets.
 class FlutterThermalPrinterNetwork {
   FlutterThermalPrinterNetwork(
     String host, {
@@ -6,11 +6,20 @@ import 'dart:io';
 
 import 'package:flutter/services.dart';
 
-import 'Windows/windows_platform.dart'
-    if (dart.library.html) 'Windows/windows_stub.dart';
+import 'Windows/native_buffer_pool.dart';
 import 'flutter_thermal_printer_platform_interface.dart';
 import 'utils/ble_config.dart';
+import 'utils/dither_mode.dart';
+import 'utils/job_stats.dart';
+import 'utils/nv_logo.dart';
+import 'utils/print_job_event.dart';
+import 'utils/printer_change_event.dart';
+import 'utils/windows_printer_info.dart';
+import 'utils/print_template.dart';
 import 'utils/printer.dart';
+import 'utils/printer_status.dart';
+import 'utils/printer_transport.dart';
+import 'utils/receipt_text.dart';
 
 /// Printer manager for USB and network. BLE not supported (universal_ble removed).
 class PrinterManager {
@@ -41,6 +50,155 @@ class PrinterManager {
   static const String _channelName = 'flutter_thermal_printer/events';
   final EventChannel _eventChannel = const EventChannel(_channelName);
 
+  static const String _jobChannelName = 'flutter_thermal_printer/jobs';
+  final EventChannel _jobEventChannel = const EventChannel(_jobChannelName);
+
+  static const String _printerChannelName = 'flutter_thermal_printer/printers';
+  final EventChannel _printerEventChannel =
+      const EventChannel(_printerChannelName);
+
+  /// Completions of jobs queued with [submitPrintJob] (Windows only).
+  Stream<PrintJobEvent> get jobEvents => _jobEventChannel
+      .receiveBroadcastStream()
+      .map((event) => PrintJobEvent.fromMap(event as Map));
+
+  static const String _statsChannelName = 'flutter_thermal_printer/stats';
+  final EventChannel _statsEventChannel = const EventChannel(_statsChannelName);
+
+  /// Stage timings of every native print job as it finishes (Windows only).
+  /// Nothing is sent while no one listens.
+  Stream<JobStageTimes> get jobStats => _statsEventChannel
+      .receiveBroadcastStream()
+      .map((event) => JobStageTimes.fromMap(event as Map));
+
+  /// Per-printer p50/p95/p99 of each job stage (queue, raster, spool, total)
+  /// plus the latest jobs, optionally for one [printer] (Windows only).
+  Future<JobStatsSnapshot> getJobStats({String? printer}) {
+    if (!Platform.isWindows) {
+      throw UnsupportedError('getJobStats is only supported on Windows');
+    }
+    return FlutterThermalPrinterPlatform.instance.getJobStats(
+      printer: printer,
+    );
+  }
+
+  /// Does the work the first print of the day would otherwise wait for:
+  /// the printer enumeration, the raster threads and kernels, and for each
+  /// of [printers] its buffer pool and spooler handle. It runs on native
+  /// background threads; call it once the app's first frame is up, e.g.
+  /// from `WidgetsBinding.instance.addPostFrameCallback`. The report says
+  /// how long each step took, and how little of it was spent on the
+  /// platform thread (Windows only).
+  Future<WarmUpReport> warmUp([List<Printer> printers = const []]) {
+    if (!Platform.isWindows) {
+      throw UnsupportedError('warmUp is only supported on Windows');
+    }
+    if (printers.any((p) => p.name?.isEmpty ?? true)) {
+      throw ArgumentError.value(printers, 'printers', 'must be named');
+    }
+    return FlutterThermalPrinterPlatform.instance.warmUp(printers);
+  }
+
+  /// Switches how bytes reach [device]: through the spooler (the default),
+  /// straight to its usbprint device, over raw TCP or to a loopback sink.
+  /// [devicePath] overrides the `\\?\USB#...` interface path that is otherwise
+  /// found from the queue's port. For USB, [chunkSize] bytes go out per write
+  /// with up to [maxInFlight] writes queued on the device, so the pipe never
+  /// idles between chunks. For the network, [host] and [port] (default: the
+  /// printer's address, port 9100) name the printer and [connectTimeout] bounds
+  /// each connect. The loopback transport needs no printer: it discards the
+  /// bytes, or appends them to the file or named pipe at [path], taking them at
+  /// [baudRate] after [latency] per document (Windows only).
+  Future<bool> setTransport(
+    Printer device,
+    PrinterTransport transport, {
+    String? devicePath,
+    int? chunkSize,
+    int? maxInFlight,
+    String? host,
+    int? port,
+    Duration? connectTimeout,
+    String? path,
+    int? baudRate,
+    Duration? latency,
+  }) {
+    if (!Platform.isWindows) {
+      throw UnsupportedError('setTransport is only supported on Windows');
+    }
+    return FlutterThermalPrinterPlatform.instance.setTransport(
+      device,
+      transport,
+      devicePath: devicePath,
+      chunkSize: chunkSize,
+      maxInFlight: maxInFlight,
+      host: host,
+      port: port,
+      connectTimeout: connectTimeout,
+      path: path,
+      baudRate: baudRate,
+      latency: latency,
+    );
+  }
+
+  // Network printers already switched to the native TCP transport, by the
+  // key the plugin files their jobs under (name, else address).
+  final Set<String> _nativeNetworkPrinters = <String>{};
+
+  /// On Windows, network printers print through the plugin's TCP engine, so
+  /// they share the native job queue with USB and keep one pooled,
+  /// keep-alive connection between tickets. The first use of a printer
+  /// selects that transport from its `host[:port]` address.
+  Future<bool> _useNativeNetwork(Printer printer) async {
+    final key = printer.name ?? printer.address;
+    final endpoint = _networkEndpoint(printer.address);
+    if (key == null || endpoint == null) {
+      return false;
+    }
+    if (_nativeNetworkPrinters.contains(key)) {
+      return true;
+    }
+    final selected = await setTransport(
+      printer,
+      PrinterTransport.network,
+      host: endpoint.host,
+      port: endpoint.port,
+    );
+    if (selected) {
+      _nativeNetworkPrinters.add(key);
+    }
+    return selected;
+  }
+
+  /// Splits `host`, `host:port` or `[v6]:port`; a bare IPv6 address has no
+  /// port.
+  static ({String host, int? port})? _networkEndpoint(String? address) {
+    if (address == null || address.isEmpty) {
+      return null;
+    }
+    if (address.startsWith('[')) {
+      final close = address.indexOf(']');
+      if (close < 0) {
+        return null;
+      }
+      final rest = address.substring(close + 1);
+      return (
+        host: address.substring(1, close),
+        port: rest.startsWith(':') ? int.tryParse(rest.substring(1)) : null,
+      );
+    }
+    final colon = address.indexOf(':');
+    if (colon < 0 || colon != address.lastIndexOf(':')) {
+      return (host: address, port: null);
+    }
+    return (
+      host: address.substring(0, colon),
+      port: int.tryParse(address.substring(colon + 1)),
+    );
+  }
+
+  bool _isWindowsNetwork(Printer printer) =>
+      Platform.isWindows && printer.connectionType == ConnectionType.NETWORK;
+
   final List<Printer> _devices = [];
 
   /// Initialize the manager (BLE not supported).
@@ -83,12 +241,12 @@ class PrinterManager {
     Duration? connectionStabilizationDelay,
   }) async {
     if (device.connectionType == ConnectionType.USB) {
-      if (Platform.isWindows) {
-        // Windows USB connection - device is already available, no connection needed
-        return true;
-      } else {
-        return FlutterThermalPrinterPlatform.instance.connect(device);
-      }
+      // On Windows this opens and caches the spooler handle natively.
+      return FlutterThermalPrinterPlatform.instance.connect(device);
+    } else if (_isWindowsNetwork(device)) {
+      // Opens (or takes from the pool) the printer's TCP connection.
+      return await _useNativeNetwork(device) &&
+          await FlutterThermalPrinterPlatform.instance.connect(device);
     } else if (device.connectionType == ConnectionType.BLE) {
       log('BLE not supported (universal_ble removed)');
       return false;
@@ -99,20 +257,27 @@ class PrinterManager {
   /// Check if a device is connected
   Future<bool> isConnected(Printer device) async {
     if (device.connectionType == ConnectionType.USB) {
-      if (Platform.isWindows) {
-        // For Windows USB printers, they're always "connected" if they're available
-        return true;
-      } else {
-        return FlutterThermalPrinterPlatform.instance.isConnected(device);
-      }
+      return FlutterThermalPrinterPlatform.instance.isConnected(device);
+    } else if (_isWindowsNetwork(device)) {
+      return await _useNativeNetwork(device) &&
+          await FlutterThermalPrinterPlatform.instance.isConnected(device);
     } else if (device.connectionType == ConnectionType.BLE) {
       return false;
     }
     return false;
   }
 
-  /// Disconnect from a printer device (USB does not require explicit disconnect).
-  Future<void> disconnect(Printer device) async {}
+  /// Disconnect from a printer device.
+  ///
+  /// Only Windows keeps per-printer state (a cached spooler handle, or a
+  /// network printer's connection, which goes back to the pool); other
+  /// platforms do not require an explicit USB disconnect.
+  Future<void> disconnect(Printer device) async {
+    if ((device.connectionType == ConnectionType.USB && Platform.isWindows) ||
+        _isWindowsNetwork(device)) {
+      await FlutterThermalPrinterPlatform.instance.disconnect(device);
+    }
+  }
 
   /// Print data to printer device
   Future<void> printData(
@@ -121,30 +286,293 @@ class PrinterManager {
     bool longData = false,
     int? chunkSize,
   }) async {
-    if (printer.connectionType == ConnectionType.USB) {
-      if (Platform.isWindows) {
-        // Windows USB printing using Win32 API
-        using((alloc) {
-          RawPrinter(printer.name!, alloc).printEscPosWin32(bytes);
-        });
-        return;
-      } else {
-        // Non-Windows USB printing
-        try {
-          await FlutterThermalPrinterPlatform.instance.printText(
-            printer,
-            Uint8List.fromList(bytes),
-            path: printer.address,
-          );
-        } catch (e) {
-          log('FlutterThermalPrinter: Unable to Print Data $e');
+    final network = _isWindowsNetwork(printer);
+    if (printer.connectionType == ConnectionType.USB || network) {
+      // Windows writes through the native spooler path with a cached handle,
+      // or through the native TCP engine for network printers.
+      try {
+        if (network && !await _useNativeNetwork(printer)) {
+          log('FlutterThermalPrinter: Unable to reach ${printer.address}');
+          return;
         }
+        await FlutterThermalPrinterPlatform.instance.printText(
+          printer,
+          bytes is Uint8List ? bytes : Uint8List.fromList(bytes),
+          path: printer.address,
+        );
+      } catch (e) {
+        log('FlutterThermalPrinter: Unable to Print Data $e');
       }
     } else if (printer.connectionType == ConnectionType.BLE) {
       log('BLE printing not supported (universal_ble removed)');
     }
   }
 
+  /// Print a payload that [fill] writes straight into a pooled native buffer
+  /// of [capacity] bytes; [fill] returns how many bytes it wrote.
+  ///
+  /// Skips the list copies of [printData], and the buffer is recycled by
+  /// the printer's pool once written. Windows USB printers only.
+  Future<void> printPooled(
+    Printer printer,
+    int capacity,
+    int Function(Uint8List buffer) fill,
+  ) async {
+    if (!Platform.isWindows || printer.connectionType != ConnectionType.USB) {
+      throw UnsupportedError(
+        'printPooled is only supported for Windows USB printers',
+      );
+    }
+    final pool = NativeBufferPool.instance;
+    final buffer = pool.lease(printer.name ?? '', capacity);
+    if (buffer == null) {
+      // Every lease is in use; print through the regular path instead.
+      final bytes = Uint8List(capacity);
+      final length = fill(bytes);
+      return printData(printer, Uint8List.sublistView(bytes, 0, length));
+    }
+    final int length;
+    try {
+      length = fill(buffer.bytes);
+    } catch (_) {
+      pool.release(buffer);
+      rethrow;
+    }
+    // The plugin owns the lease from here, even if the call fails.
+    await FlutterThermalPrinterPlatform.instance.printBuffer(
+      printer,
+      buffer.lease,
+      length,
+    );
+  }
+
+  /// Collect every write to [printer] until [endBatch] into one spooler
+  /// document, e.g. a header, body, QR code and cut sent as separate
+  /// [printData] calls. Writes in the batch complete immediately; their
+  /// outcome is reported by [endBatch]. Windows USB printers only.
+  Future<void> beginBatch(Printer printer) {
+    _requireWindowsUsb(printer, 'beginBatch');
+    return FlutterThermalPrinterPlatform.instance.beginBatch(printer);
+  }
+
+  /// Send the writes since [beginBatch] as one document; throws a
+  /// [PlatformException] if it could not be spooled.
+  Future<void> endBatch(Printer printer) {
+    _requireWindowsUsb(printer, 'endBatch');
+    return FlutterThermalPrinterPlatform.instance.endBatch(printer);
+  }
+
+  /// Merge writes to [printer] that arrive within [window] of each other
+  /// into one document (at most one second; [Duration.zero] turns it off).
+  /// Suits writes that are not awaited one by one, such as
+  /// [submitPrintJob]. Windows USB printers only.
+  Future<void> setBatchWindow(Printer printer, Duration window) {
+    _requireWindowsUsb(printer, 'setBatchWindow');
+    return FlutterThermalPrinterPlatform.instance.setBatchWindow(
+      printer,
+      window,
+    );
+  }
+
+  /// Store [template] in the Windows plugin so later tickets only send
+  /// their field values. Registering a name again replaces it; tickets
+  /// already queued still print the old version.
+  Future<void> registerTemplate(PrintTemplate template) {
+    if (!Platform.isWindows) {
+      throw UnsupportedError('registerTemplate is only supported on Windows');
+    }
+    return FlutterThermalPrinterPlatform.instance.registerTemplate(template);
+  }
+
+  /// Free the native copy of the template registered as [name].
+  Future<bool> removeTemplate(String name) {
+    if (!Platform.isWindows) {
+      throw UnsupportedError('removeTemplate is only supported on Windows');
+    }
+    return FlutterThermalPrinterPlatform.instance.removeTemplate(name);
+  }
+
+  /// Print template [name] with [values] (field name to ESC/POS bytes) spliced
+  /// in; fields without a value print nothing. Windows USB printers only.
+  Future<void> printTemplate(
+    Printer printer,
+    String name,
+    Map<String, List<int>> values, {
+    int priority = 0,
+  }) {
+    _requireWindowsUsb(printer, 'printTemplate');
+    return FlutterThermalPrinterPlatform.instance.printTemplate(
+      printer,
+      name,
+      values.map(
+        (field, bytes) => MapEntry(
+          field,
+          bytes is Uint8List ? bytes : Uint8List.fromList(bytes),
+        ),
+      ),
+      priority: priority,
+    );
+  }
+
+  /// Upload an RGBA logo to [printer]'s non-volatile graphics memory under
+  /// the two-character [key], so tickets print it with [printLogo] (or
+  /// `nvLogoCommand`) instead of sending its raster. The upload is skipped,
+  /// returning false, when this session already stored the same image
+  /// there; pass [force] after the printer was reset or swapped. NV memory
+  /// wears with each write, so avoid re-uploading on every start.
+  /// [scaleWidth] stores the logo resampled to that many dots wide.
+  /// Windows USB printers only.
+  Future<bool> storeLogo(
+    Printer printer,
+    String key,
+    Uint8List pixels, {
+    required int width,
+    required int height,
+    DitherMode dither = DitherMode.threshold,
+    int? scaleWidth,
+    bool force = false,
+  }) {
+    _requireWindowsUsb(printer, 'storeLogo');
+    if (!isValidNvLogoKey(key)) {
+      throw ArgumentError.value(key, 'key', 'must be two printable characters');
+    }
+    return FlutterThermalPrinterPlatform.instance.storeLogo(
+      printer,
+      key,
+      pixels,
+      width: width,
+      height: height,
+      dither: dither,
+      scaleWidth: scaleWidth,
+      force: force,
+    );
+  }
+
+  /// Print the logo stored under [key] with [storeLogo]; only a few bytes
+  /// go to the printer. Windows USB printers only.
+  Future<void> printLogo(Printer printer, String key) {
+    _requireWindowsUsb(printer, 'printLogo');
+    return FlutterThermalPrinterPlatform.instance.printLogo(printer, key);
+  }
+
+  void _requireWindowsUsb(Printer printer, String method) {
+    if (!Platform.isWindows || printer.connectionType != ConnectionType.USB) {
+      throw UnsupportedError(
+        '$method is only supported for Windows USB printers',
+      );
+    }
+  }
+
+  /// Queue [bytes] on the native print worker and return its job id as soon
+  /// as it is queued. The outcome is reported on [jobEvents].
+  ///
+  /// Jobs with a higher [priority] jump ahead of queued lower ones, so a
+  /// kitchen ticket need not wait behind a reprinted invoice. Throws a
+  /// [PlatformException] with code `BUSY` when the queue is over its
+  /// [setQueueLimit].
+  ///
+  /// Only Windows USB printers have a native job queue.
+  Future<int> submitPrintJob(
+    Printer printer,
+    List<int> bytes, {
+    int priority = 0,
+  }) {
+    if (!Platform.isWindows || printer.connectionType != ConnectionType.USB) {
+      throw UnsupportedError(
+        'submitPrintJob is only supported for Windows USB printers',
+      );
+    }
+    return FlutterThermalPrinterPlatform.instance.submitPrintJob(
+      printer,
+      Uint8List.fromList(bytes),
+      priority: priority,
+    );
+  }
+
+  /// Cancel a job returned by [submitPrintJob] before it prints; its event
+  /// on [jobEvents] reports `cancelled`. Completes with false once the job
+  /// is in the spooler or done. Windows only.
+  Future<bool> cancelJob(int jobId) {
+    if (!Platform.isWindows) {
+      throw UnsupportedError('cancelJob is only supported on Windows');
+    }
+    return FlutterThermalPrinterPlatform.instance.cancelJob(jobId);
+  }
+
+  /// Cap the memory [printer]'s unfinished jobs may hold at [maxBytes]
+  /// (32 MB by default; zero for no cap). Past it, new jobs fail at once
+  /// with a `BUSY` [PlatformException] instead of piling up behind a stuck
+  /// printer. A job is always accepted when the queue is empty. Windows
+  /// USB printers only.
+  Future<void> setQueueLimit(Printer printer, int maxBytes) {
+    _requireWindowsUsb(printer, 'setQueueLimit');
+    if (maxBytes < 0) {
+      throw ArgumentError.value(maxBytes, 'maxBytes', 'must not be negative');
+    }
+    return FlutterThermalPrinterPlatform.instance.setQueueLimit(
+      printer,
+      maxBytes,
+    );
+  }
+
+  /// Cached metadata (port, driver, status, RAW-capable USB) for every
+  /// Windows print queue. Served from the plugin's cache, so it is safe to
+  /// call on every rebuild.
+  Future<List<WindowsPrinterInfo>> getPrinterDetails() {
+    if (!Platform.isWindows) {
+      throw UnsupportedError(
+        'getPrinterDetails is only supported on Windows',
+      );
+    }
+    return FlutterThermalPrinterPlatform.instance.getPrinterDetails();
+  }
+
+  /// Paper, cover and online state of [printer] as the plugin last polled
+  /// it over the USB or TCP back-channel; answered from the cache, so it
+  /// never waits on the printer. While the status blocks printing, queued
+  /// jobs are held until it clears. Printers on the spooler transport
+  /// report [PrinterStatus.isSupported] false (Windows only).
+  Future<PrinterStatus> getStatus(Printer printer) {
+    if (!Platform.isWindows) {
+      throw UnsupportedError('getStatus is only supported on Windows');
+    }
+    return FlutterThermalPrinterPlatform.instance.getStatus(printer);
+  }
+
+  /// Encode [receipt] to ESC/POS bytes in the Windows plugin: columns are
+  /// padded and wrapped, and text is converted to the code page, natively.
+  /// Print the result with [printData] (Windows only).
+  Future<Uint8List> encodeText(ReceiptText receipt) {
+    if (!Platform.isWindows) {
+      throw UnsupportedError('encodeText is only supported on Windows');
+    }
+    return FlutterThermalPrinterPlatform.instance.encodeText(receipt);
+  }
+
+  /// Print [bytes] on all of [printers] in parallel, e.g. a kitchen, bar and
+  /// counter copy of one order. The bytes cross the channel once and every
+  /// printer's queue shares them. Completes when every printer is done with
+  /// a map from printer name to null on success, or to the error (`BUSY`,
+  /// `CANCELLED` or `PRINT_FAILED: ...`) that stopped that printer, so one
+  /// jammed printer does not fail the others (Windows only).
+  Future<Map<String, String?>> printToMany(
+    List<Printer> printers,
+    List<int> bytes, {
+    int priority = 0,
+  }) {
+    if (!Platform.isWindows) {
+      throw UnsupportedError('printToMany is only supported on Windows');
+    }
+    if (printers.isEmpty || printers.any((p) => p.name?.isEmpty ?? true)) {
+      throw ArgumentError.value(printers, 'printers', 'must be named');
+    }
+    return FlutterThermalPrinterPlatform.instance.printToMany(
+      printers,
+      bytes is Uint8List ? bytes : Uint8List.fromList(bytes),
+      priority: priority,
+    );
+  }
+
   /// Get Printers from BT and USB
   Future<void> getPrinters({
     Duration refreshDuration = const Duration(seconds: 2),
@@ -170,31 +598,13 @@ class PrinterManager {
   Future<void> _getUSBPrinters(Duration refreshDuration) async {
     try {
       if (Platform.isWindows) {
-        // Windows USB printer discovery using Win32 API
+        // The plugin enumerates once, then pushes only changes as the
+        // spooler and USB stack report them; [refreshDuration] is unused.
         await _usbSubscription?.cancel();
-        _usbSubscription =
-            Stream.periodic(refreshDuration, (x) => x).listen((event) async {
-          final devices = PrinterNames(PRINTER_ENUM_LOCAL);
-          final tempList = <Printer>[];
-
-          for (final printerName in devices.all()) {
-            final device = Printer(
-              vendorId: printerName,
-              productId: 'N/A',
-              name: printerName,
-              connectionType: ConnectionType.USB,
-              address: printerName,
-              isConnected: true,
-            );
-            tempList.add(device);
-          }
-
-          // Update devices list and stream
-          for (final printer in tempList) {
-            _updateOrAddPrinter(printer);
-          }
-          sortDevices();
-        });
+        _usbSubscription = _printerEventChannel
+            .receiveBroadcastStream()
+            .map((event) => PrinterChangeEvent.fromMap(event as Map))
+            .listen(_applyPrinterChanges);
       } else {
         // Non-Windows USB printer discovery
         final devices =
@@ -274,6 +684,19 @@ class PrinterManager {
     }
   }
 
+  void _applyPrinterChanges(PrinterChangeEvent event) {
+    final removed = event.removed.toSet();
+    _devices.removeWhere(
+      (device) =>
+          device.connectionType == ConnectionType.USB &&
+          removed.contains(device.address),
+    );
+    for (final printer in [...event.added, ...event.changed]) {
+      _updateOrAddPrinter(printer.toPrinter());
+    }
+    sortDevices();
+  }
+
   /// Update or add printer to the devices list
   void _updateOrAddPrinter(Printer printer) {
     final index = _devices.indexWhere(
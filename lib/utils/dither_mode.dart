@@ -0,0 +1,14 @@
+/// How gray levels are turned into printed dots by the native raster engine.
+///
+/// The index is sent over the method channel, so keep the order in sync with
+/// `DitherMode` in `windows/raster_engine.h`.
+enum DitherMode {
+  /// Dots darker than the threshold print black. Best for text and logos.
+  threshold,
+
+  /// Floyd–Steinberg error diffusion. Best for photos.
+  floydSteinberg,
+
+  /// 8x8 Bayer matrix. Cheaper than error diffusion with even shading.
+  ordered,
+}
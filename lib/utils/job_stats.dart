@@ -0,0 +1,123 @@
+/// Stage timings of one finished native print job (Windows).
+class JobStageTimes {
+  const JobStageTimes({
+    required this.jobId,
+    required this.printer,
+    this.bytes = 0,
+    this.success = false,
+    this.queueMs = 0,
+    this.rasterMs = 0,
+    this.spoolMs = 0,
+    this.totalMs = 0,
+  });
+
+  factory JobStageTimes.fromMap(Map<dynamic, dynamic> map) => JobStageTimes(
+        jobId: (map['jobId'] as num).toInt(),
+        printer: map['printer'] as String? ?? '',
+        bytes: (map['bytes'] as num?)?.toInt() ?? 0,
+        success: map['success'] as bool? ?? false,
+        queueMs: (map['queueMs'] as num?)?.toDouble() ?? 0,
+        rasterMs: (map['rasterMs'] as num?)?.toDouble() ?? 0,
+        spoolMs: (map['spoolMs'] as num?)?.toDouble() ?? 0,
+        totalMs: (map['totalMs'] as num?)?.toDouble() ?? 0,
+      );
+
+  final int jobId;
+  final String printer;
+
+  /// Bytes handed to the spooler.
+  final int bytes;
+
+  final bool success;
+
+  /// Waiting behind earlier jobs for the printer's worker.
+  final double queueMs;
+
+  /// Native rasterization inside the job (`printImage` only).
+  final double rasterMs;
+
+  /// From opening the spooler document to closing it.
+  final double spoolMs;
+
+  /// From the native call being handled to its completion.
+  final double totalMs;
+
+  @override
+  String toString() =>
+      'JobStageTimes(jobId: $jobId, printer: $printer, bytes: $bytes, '
+      'queue: ${queueMs}ms, raster: ${rasterMs}ms, spool: ${spoolMs}ms, '
+      'total: ${totalMs}ms)';
+}
+
+/// p50/p95/p99 of one stage, in milliseconds.
+class LatencyPercentiles {
+  const LatencyPercentiles({this.p50 = 0, this.p95 = 0, this.p99 = 0});
+
+  factory LatencyPercentiles.fromMap(Map<dynamic, dynamic>? map) =>
+      LatencyPercentiles(
+        p50: (map?['p50'] as num?)?.toDouble() ?? 0,
+        p95: (map?['p95'] as num?)?.toDouble() ?? 0,
+        p99: (map?['p99'] as num?)?.toDouble() ?? 0,
+      );
+
+  final double p50;
+  final double p95;
+  final double p99;
+}
+
+/// Aggregate counters for one printer. Counts cover every job since the
+/// plugin started; percentiles cover its most recent jobs.
+class PrinterJobSummary {
+  const PrinterJobSummary({
+    this.jobs = 0,
+    this.failures = 0,
+    this.bytes = 0,
+    this.queueMs = const LatencyPercentiles(),
+    this.rasterMs = const LatencyPercentiles(),
+    this.spoolMs = const LatencyPercentiles(),
+    this.totalMs = const LatencyPercentiles(),
+  });
+
+  factory PrinterJobSummary.fromMap(Map<dynamic, dynamic> map) =>
+      PrinterJobSummary(
+        jobs: (map['jobs'] as num?)?.toInt() ?? 0,
+        failures: (map['failures'] as num?)?.toInt() ?? 0,
+        bytes: (map['bytes'] as num?)?.toInt() ?? 0,
+        queueMs: LatencyPercentiles.fromMap(map['queueMs'] as Map?),
+        rasterMs: LatencyPercentiles.fromMap(map['rasterMs'] as Map?),
+        spoolMs: LatencyPercentiles.fromMap(map['spoolMs'] as Map?),
+        totalMs: LatencyPercentiles.fromMap(map['totalMs'] as Map?),
+      );
+
+  final int jobs;
+  final int failures;
+  final int bytes;
+  final LatencyPercentiles queueMs;
+  final LatencyPercentiles rasterMs;
+  final LatencyPercentiles spoolMs;
+  final LatencyPercentiles totalMs;
+}
+
+/// Result of `getJobStats`.
+class JobStatsSnapshot {
+  const JobStatsSnapshot({this.printers = const {}, this.recent = const []});
+
+  factory JobStatsSnapshot.fromMap(Map<dynamic, dynamic> map) =>
+      JobStatsSnapshot(
+        printers: (map['printers'] as Map? ?? const {}).map(
+          (name, summary) => MapEntry(
+            name as String,
+            PrinterJobSummary.fromMap(summary as Map),
+          ),
+        ),
+        recent: (map['recent'] as List? ?? const [])
+            .map((times) => JobStageTimes.fromMap(times as Map))
+            .toList(),
+      );
+
+  /// Keyed by printer name.
+  final Map<String, PrinterJobSummary> printers;
+
+  /// Latest finished jobs, oldest first.
+  final List<JobStageTimes> recent;
+}
@@ -0,0 +1,16 @@
+/// ESC/POS bytes that print the NV graphic stored under [key] with
+/// `storeLogo` (`GS ( L` function 69, normal size).
+///
+/// Use it to place a stored logo inside a larger ticket, for example a
+/// `PrintTemplate`, instead of sending its raster every time. [key] is two
+/// printable ASCII characters.
+List<int> nvLogoCommand(String key) {
+  if (!isValidNvLogoKey(key)) {
+    throw ArgumentError.value(key, 'key', 'must be two printable characters');
+  }
+  return [0x1D, 0x28, 0x4C, 0x06, 0x00, 0x30, 0x45, ...key.codeUnits, 1, 1];
+}
+
+/// Whether [key] can address an NV graphic: two ASCII characters 32-126.
+bool isValidNvLogoKey(String key) =>
+    key.length == 2 && key.codeUnits.every((c) => c >= 32 && c <= 126);
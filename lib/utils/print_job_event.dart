@@ -0,0 +1,38 @@
+/// Completion of a job queued with `PrinterManager.submitPrintJob`.
+class PrintJobEvent {
+  const PrintJobEvent({
+    required this.jobId,
+    required this.printer,
+    required this.success,
+    this.cancelled = false,
+    this.error,
+  });
+
+  factory PrintJobEvent.fromMap(Map<dynamic, dynamic> map) => PrintJobEvent(
+        jobId: (map['jobId'] as num).toInt(),
+        printer: map['printer'] as String? ?? '',
+        success: map['success'] as bool? ?? false,
+        cancelled: map['cancelled'] as bool? ?? false,
+        error: map['error'] as String?,
+      );
+
+  /// Id returned by `submitPrintJob`.
+  final int jobId;
+
+  /// Queue name the job was sent to.
+  final String printer;
+
+  final bool success;
+
+  /// Whether the job failed because `cancelJob` removed it.
+  final bool cancelled;
+
+  /// Native error description when [success] is false.
+  final String? error;
+
+  @override
+  String toString() =>
+      'PrintJobEvent(jobId: $jobId, printer: $printer, success: $success'
+      '${cancelled ? ', cancelled' : ''}'
+      '${error == null ? '' : ', error: $error'})';
+}
@@ -0,0 +1,50 @@
+import 'dart:typed_data';
+
+/// An insertion point in a [PrintTemplate]: the value for [name] is written
+/// before byte [offset] of the template.
+class PrintTemplateField {
+  const PrintTemplateField(this.name, this.offset);
+
+  final String name;
+  final int offset;
+
+  Map<String, Object> toMap() => {'name': name, 'offset': offset};
+}
+
+/// A pre-encoded ticket (logo raster, header, footer) with named fields for
+/// the parts that change, such as line items and totals.
+///
+/// Register it once with `registerTemplate`; each `printTemplate` then only
+/// sends the field values, and the plugin splices them in natively.
+///
+/// ```dart
+/// final receipt = PrintTemplate('receipt')
+///   ..add(generator.image(logo))
+///   ..add(generator.text('Shop'))
+///   ..field('items')
+///   ..add(generator.text('Total:'))
+///   ..field('total')
+///   ..add(generator.cut());
+/// ```
+class PrintTemplate {
+  PrintTemplate(this.name);
+
+  /// Key the template is registered and printed under.
+  final String name;
+
+  final BytesBuilder _bytes = BytesBuilder(copy: false);
+  final List<PrintTemplateField> _fields = [];
+
+  /// Appends static bytes.
+  void add(List<int> bytes) => _bytes.add(bytes);
+
+  /// Marks where the value of [fieldName] goes. A name may be used more
+  /// than once; every occurrence gets the same value.
+  void field(String fieldName) =>
+      _fields.add(PrintTemplateField(fieldName, _bytes.length));
+
+  /// The static bytes so far.
+  Uint8List get bytes => _bytes.toBytes();
+
+  List<PrintTemplateField> get fields => List.unmodifiable(_fields);
+}
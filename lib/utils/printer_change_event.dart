@@ -0,0 +1,34 @@
+import 'windows_printer_info.dart';
+
+/// One batch of Windows print queue changes pushed by the plugin. The first
+/// batch after listening lists every printer in [added].
+class PrinterChangeEvent {
+  const PrinterChangeEvent({
+    this.added = const [],
+    this.changed = const [],
+    this.removed = const [],
+  });
+
+  factory PrinterChangeEvent.fromMap(Map<dynamic, dynamic> map) =>
+      PrinterChangeEvent(
+        added: _printers(map['added']),
+        changed: _printers(map['changed']),
+        removed: (map['removed'] as List? ?? const [])
+            .map((name) => name as String)
+            .toList(),
+      );
+
+  /// Printers that appeared since the last batch.
+  final List<WindowsPrinterInfo> added;
+
+  /// Printers whose status, port, driver or attributes changed.
+  final List<WindowsPrinterInfo> changed;
+
+  /// Queue names that no longer exist.
+  final List<String> removed;
+
+  static List<WindowsPrinterInfo> _printers(Object? list) =>
+      (list as List? ?? const [])
+          .map((entry) => WindowsPrinterInfo.fromMap(entry as Map))
+          .toList();
+}
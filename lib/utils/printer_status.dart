@@ -0,0 +1,56 @@
+/// A printer's real-time state as the Windows plugin last polled it
+/// (`DLE EOT` over the USB or TCP back-channel).
+class PrinterStatus {
+  const PrinterStatus({
+    this.isSupported = true,
+    this.isKnown = false,
+    this.isOnline = false,
+    this.isCoverOpen = false,
+    this.isPaperOut = false,
+    this.isPaperNearEnd = false,
+    this.hasError = false,
+    this.age,
+  });
+
+  factory PrinterStatus.fromMap(Map<dynamic, dynamic> map) {
+    final ageMs = (map['ageMs'] as num?)?.toInt() ?? -1;
+    return PrinterStatus(
+      isSupported: map['supported'] as bool? ?? true,
+      isKnown: map['known'] as bool? ?? false,
+      isOnline: map['online'] as bool? ?? false,
+      isCoverOpen: map['coverOpen'] as bool? ?? false,
+      isPaperOut: map['paperOut'] as bool? ?? false,
+      isPaperNearEnd: map['paperNearEnd'] as bool? ?? false,
+      hasError: map['error'] as bool? ?? false,
+      age: ageMs < 0 ? null : Duration(milliseconds: ageMs),
+    );
+  }
+
+  /// False when the printer's transport cannot read from it (the spooler).
+  final bool isSupported;
+
+  /// False until the printer answered a poll; the flags below mean nothing
+  /// then.
+  final bool isKnown;
+
+  final bool isOnline;
+  final bool isCoverOpen;
+  final bool isPaperOut;
+  final bool isPaperNearEnd;
+
+  /// A cutter jam, overheated head or other error that stops printing.
+  final bool hasError;
+
+  /// Time since the status was read; null while it is not known.
+  final Duration? age;
+
+  /// Whether the plugin is holding this printer's queued jobs until it
+  /// recovers.
+  bool get blocksPrinting =>
+      isKnown && (!isOnline || isCoverOpen || isPaperOut || hasError);
+
+  @override
+  String toString() => 'PrinterStatus(known: $isKnown, online: $isOnline, '
+      'coverOpen: $isCoverOpen, paperOut: $isPaperOut, '
+      'paperNearEnd: $isPaperNearEnd, error: $hasError)';
+}
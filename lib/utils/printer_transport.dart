@@ -0,0 +1,22 @@
+/// How the Windows plugin delivers bytes to a printer.
+///
+/// The name is sent over the method channel; keep it in sync with
+/// `HandleSetTransport` in `windows/flutter_thermal_printer_plugin.cpp`.
+enum PrinterTransport {
+  /// A RAW document through the Windows print spooler. Works for every
+  /// installed queue and shows up in the print queue UI.
+  spooler,
+
+  /// Direct overlapped writes to the printer's usbprint device, skipping the
+  /// spooler's job creation and port monitor. USB printers only.
+  usb,
+
+  /// Raw TCP to a network printer (port 9100 unless told otherwise), over a
+  /// pooled connection kept open between tickets.
+  network,
+
+  /// No printer: bytes are discarded or written to a file or named pipe, at
+  /// an optional simulated line speed. For measuring the queue and testing
+  /// without hardware.
+  loopback,
+}
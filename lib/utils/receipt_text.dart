@@ -0,0 +1,122 @@
+import 'package:esc_pos_utils_plus/esc_pos_utils_plus.dart';
+
+/// Character tables the Windows text encoder can print in.
+enum ReceiptCodePage {
+  /// US and box drawing; every printer's power-on default.
+  cp437,
+
+  /// Western European, with the euro sign.
+  cp858,
+
+  /// Arabic, printed in isolated letter forms.
+  cp864,
+
+  /// Devanagari (ISCII). Printers number this table differently, so set
+  /// [ReceiptText.codePageId] to the one in the printer's manual.
+  iscii,
+}
+
+/// One cell of a [ReceiptText.row], taking [flex] shares of the line.
+class ReceiptColumn {
+  const ReceiptColumn(this.text, {this.flex = 1, this.align = PosAlign.left});
+
+  final String text;
+  final int flex;
+  final PosAlign align;
+
+  Map<String, Object> toMap() =>
+      {'text': text, 'flex': flex, 'align': align.index};
+}
+
+/// A text-mode receipt that the Windows plugin encodes to ESC/POS bytes
+/// natively with `encodeText`, instead of a Dart `Generator`.
+///
+/// ```dart
+/// final receipt = ReceiptText(charsPerLine: 48)
+///   ..text('Shop', align: PosAlign.center, bold: true, width: 2, height: 2)
+///   ..rule()
+///   ..row([
+///     ReceiptColumn('Masala chai', flex: 3),
+///     ReceiptColumn('2', align: PosAlign.center),
+///     ReceiptColumn('3.00', align: PosAlign.right),
+///   ])
+///   ..feed(2)
+///   ..cut();
+/// ```
+class ReceiptText {
+  ReceiptText({
+    this.codePage = ReceiptCodePage.cp437,
+    this.codePageId,
+    this.charsPerLine = 48,
+  });
+
+  final ReceiptCodePage codePage;
+
+  /// The `ESC t` table number; null for the usual one for [codePage].
+  final int? codePageId;
+
+  /// Characters per line at normal width: 48 on 80 mm paper, 32 on 58 mm.
+  final int charsPerLine;
+
+  final List<Map<String, Object>> _rows = [];
+
+  /// A line of text; the printer wraps it if it is too long.
+  void text(
+    String text, {
+    PosAlign align = PosAlign.left,
+    bool bold = false,
+    bool underline = false,
+    bool invert = false,
+    int width = 1,
+    int height = 1,
+  }) =>
+      _rows.add({
+        'text': text,
+        ..._style(align, bold, underline, invert, width, height),
+      });
+
+  /// A row of [columns], each padded to its share of the line and wrapped
+  /// at spaces when it does not fit.
+  void row(
+    List<ReceiptColumn> columns, {
+    bool bold = false,
+    bool underline = false,
+    bool invert = false,
+    int width = 1,
+    int height = 1,
+  }) =>
+      _rows.add({
+        'columns': columns.map((column) => column.toMap()).toList(),
+        ..._style(PosAlign.left, bold, underline, invert, width, height),
+      });
+
+  /// A full-width line of [character].
+  void rule({String character = '-', bool bold = false, int width = 1}) =>
+      _rows.add({
+        'rule': character,
+        ..._style(PosAlign.left, bold, false, false, width, 1),
+      });
+
+  void feed(int lines) => _rows.add({'feed': lines});
+
+  void cut({bool partial = false}) =>
+      _rows.add({'cut': true, 'partial': partial});
+
+  Map<String, Object> toMap() => {
+        'codePage': codePage.name,
+        if (codePageId != null) 'codePageId': codePageId!,
+        'charsPerLine': charsPerLine,
+        'rows': List.of(_rows),
+      };
+
+  static Map<String, Object> _style(PosAlign align, bool bold,
+          bool underline, bool invert, int width, int height) =>
+      {
+        if (align != PosAlign.left) 'align': align.index,
+        if (bold) 'bold': true,
+        if (underline) 'underline': true,
+        if (invert) 'invert': true,
+        if (width != 1) 'width': width,
+        if (height != 1) 'height': height,
+      };
+}
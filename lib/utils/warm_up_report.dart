@@ -0,0 +1,64 @@
+/// One step of a native `warmUp` (Windows).
+class WarmUpStep {
+  const WarmUpStep({
+    required this.step,
+    this.printer,
+    this.ms = 0,
+    this.success = true,
+    this.error,
+  });
+
+  factory WarmUpStep.fromMap(Map<dynamic, dynamic> map) => WarmUpStep(
+        step: map['step'] as String? ?? '',
+        printer: map['printer'] as String?,
+        ms: (map['ms'] as num?)?.toDouble() ?? 0,
+        success: map['success'] as bool? ?? false,
+        error: map['error'] as String?,
+      );
+
+  /// `platformThread`, `enumeratePrinters`, `rasterKernels`, or the
+  /// per-printer `bufferPool` and `openPrinter`.
+  final String step;
+
+  /// The printer a per-printer step prepared; null for the others.
+  final String? printer;
+
+  /// How long the step took. For `platformThread`, the time the call held
+  /// the thread that also runs the app's UI.
+  final double ms;
+
+  final bool success;
+
+  /// Why the step failed, e.g. a spooler that could not open the printer.
+  final String? error;
+
+  @override
+  String toString() => 'WarmUpStep($step${printer == null ? '' : ' $printer'}: '
+      '${ms}ms${success ? '' : ', $error'})';
+}
+
+/// Result of `warmUp`.
+class WarmUpReport {
+  const WarmUpReport({this.steps = const [], this.totalMs = 0});
+
+  factory WarmUpReport.fromMap(Map<dynamic, dynamic> map) => WarmUpReport(
+        steps: (map['steps'] as List? ?? const [])
+            .map((step) => WarmUpStep.fromMap(step as Map))
+            .toList(),
+        totalMs: (map['totalMs'] as num?)?.toDouble() ?? 0,
+      );
+
+  /// In the order they finished.
+  final List<WarmUpStep> steps;
+
+  /// From the call being handled to the last step finishing.
+  final double totalMs;
+
+  /// Time spent on the platform thread; everything else ran off it.
+  double get platformThreadMs => steps
+      .where((step) => step.step == 'platformThread')
+      .fold(0, (total, step) => total + step.ms);
+
+  /// Whether every step succeeded.
+  bool get success => steps.every((step) => step.success);
+}
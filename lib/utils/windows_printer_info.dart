@@ -0,0 +1,58 @@
+import 'printer.dart';
+
+/// Metadata the Windows plugin caches for one print queue.
+class WindowsPrinterInfo {
+  const WindowsPrinterInfo({
+    required this.name,
+    this.port = '',
+    this.driver = '',
+    this.status = 0,
+    this.attributes = 0,
+    this.isOffline = false,
+    this.isRawUsb = false,
+  });
+
+  factory WindowsPrinterInfo.fromMap(Map<dynamic, dynamic> map) =>
+      WindowsPrinterInfo(
+        name: map['name'] as String,
+        port: map['port'] as String? ?? '',
+        driver: map['driver'] as String? ?? '',
+        status: (map['status'] as num?)?.toInt() ?? 0,
+        attributes: (map['attributes'] as num?)?.toInt() ?? 0,
+        isOffline: map['offline'] as bool? ?? false,
+        isRawUsb: map['rawUsb'] as bool? ?? false,
+      );
+
+  /// Queue name, used as the printer's address.
+  final String name;
+
+  /// Port the queue prints to, e.g. `USB001`.
+  final String port;
+
+  final String driver;
+
+  /// `PRINTER_INFO_2` status and attribute bits.
+  final int status;
+  final int attributes;
+
+  /// Paused, offline, or the port reports no device.
+  final bool isOffline;
+
+  /// On a USB port and accepts RAW ESC/POS documents.
+  final bool isRawUsb;
+
+  /// The queue as a USB [Printer] for the devices list.
+  Printer toPrinter() => Printer(
+        vendorId: name,
+        productId: 'N/A',
+        name: name,
+        connectionType: ConnectionType.USB,
+        address: name,
+        isConnected: !isOffline,
+      );
+
+  @override
+  String toString() =>
+      'WindowsPrinterInfo(name: $name, port: $port, driver: $driver, '
+      'offline: $isOffline, rawUsb: $isRawUsb)';
+}
@@ -39,6 +39,155 @@ class MockFlutterThermalPrinterPlatform
 
   @override
   Future<void> getPrinters() async {}
+
+  @override
+  Future<int> submitPrintJob(
+    Printer device,
+    Uint8List data, {
+    int priority = 0,
+  }) async =>
+      1;
+
+  @override
+  Future<bool> cancelJob(int jobId) async => true;
+
+  @override
+  Future<bool> setQueueLimit(Printer device, int maxBytes) async => true;
+
+  @override
+  Future<Uint8List> rasterizeImage(
+    Uint8List pixels, {
+    required int width,
+    required int height,
+    DitherMode dither = DitherMode.threshold,
+    int threshold = 128,
+    int? scaleWidth,
+    bool feedBlankRows = false,
+  }) async =>
+      Uint8List(0);
+
+  @override
+  Future<Uint8List> rasterizeEncodedImage(
+    Uint8List encoded, {
+    DitherMode dither = DitherMode.threshold,
+    int threshold = 128,
+    int? scaleWidth,
+    bool feedBlankRows = false,
+  }) async =>
+      Uint8List(0);
+
+  @override
+  Future<void> printEncodedImage(
+    Printer device,
+    Uint8List encoded, {
+    DitherMode dither = DitherMode.threshold,
+    int threshold = 128,
+    int? scaleWidth,
+    bool feedBlankRows = false,
+    Uint8List? prefix,
+    Uint8List? suffix,
+  }) async {}
+
+  @override
+  Future<void> printImage(
+    Printer device,
+    Uint8List pixels, {
+    required int width,
+    required int height,
+    DitherMode dither = DitherMode.threshold,
+    int threshold = 128,
+    int? scaleWidth,
+    bool feedBlankRows = false,
+    Uint8List? prefix,
+    Uint8List? suffix,
+  }) async {}
+
+  @override
+  Future<bool> printBuffer(Printer device, int buffer, int length) async =>
+      true;
+
+  @override
+  Future<bool> beginBatch(Printer device) async => true;
+
+  @override
+  Future<bool> endBatch(Printer device) async => true;
+
+  @override
+  Future<bool> setBatchWindow(Printer device, Duration window) async => true;
+
+  @override
+  Future<bool> registerTemplate(PrintTemplate template) async => true;
+
+  @override
+  Future<bool> removeTemplate(String name) async => true;
+
+  @override
+  Future<bool> printTemplate(
+    Printer device,
+    String name,
+    Map<String, Uint8List> values, {
+    int priority = 0,
+  }) async =>
+      true;
+
+  @override
+  Future<bool> storeLogo(
+    Printer device,
+    String key,
+    Uint8List pixels, {
+    required int width,
+    required int height,
+    DitherMode dither = DitherMode.threshold,
+    int threshold = 128,
+    int? scaleWidth,
+    bool force = false,
+  }) async =>
+      true;
+
+  @override
+  Future<bool> printLogo(Printer device, String key) async => true;
+
+  @override
+  Future<JobStatsSnapshot> getJobStats({String? printer}) async =>
+      const JobStatsSnapshot();
+
+  @override
+  Future<WarmUpReport> warmUp(List<Printer> devices) async =>
+      const WarmUpReport();
+
+  @override
+  Future<bool> setTransport(
+    Printer device,
+    PrinterTransport transport, {
+    String? devicePath,
+    int? chunkSize,
+    int? maxInFlight,
+    String? host,
+    int? port,
+    Duration? connectTimeout,
+    String? path,
+    int? baudRate,
+    Duration? latency,
+  }) async =>
+      true;
+
+  @override
+  Future<List<WindowsPrinterInfo>> getPrinterDetails() async => const [];
+
+  @override
+  Future<PrinterStatus> getStatus(Printer device) async =>
+      const PrinterStatus();
+
+  @override
+  Future<Uint8List> encodeText(ReceiptText receipt) async => Uint8List(0);
+
+  @override
+  Future<Map<String, String?>> printToMany(
+    List<Printer> devices,
+    Uint8List data, {
+    int priority = 0,
+  }) async =>
+      const {};
 }
 
 void main() {
@@ -1,7 +1,15 @@
 import 'dart:typed_data';
 
 import 'package:flutter_thermal_printer/flutter_thermal_printer_platform_interface.dart';
+import 'package:flutter_thermal_printer/utils/dither_mode.dart';
+import 'package:flutter_thermal_printer/utils/job_stats.dart';
+import 'package:flutter_thermal_printer/utils/print_template.dart';
 import 'package:flutter_thermal_printer/utils/printer.dart';
+import 'package:flutter_thermal_printer/utils/printer_status.dart';
+import 'package:flutter_thermal_printer/utils/printer_transport.dart';
+import 'package:flutter_thermal_printer/utils/receipt_text.dart';
+import 'package:flutter_thermal_printer/utils/warm_up_report.dart';
+import 'package:flutter_thermal_printer/utils/windows_printer_info.dart';
 import 'package:plugin_platform_interface/plugin_platform_interface.dart';
 
 class MockFlutterThermalPrinterPlatform extends FlutterThermalPrinterPlatform
@@ -68,6 +76,31 @@ class MockFlutterThermalPrinterPlatform extends FlutterThermalPrinterPlatform
     methodArguments.add({'device': device, 'data': data, 'path': path});
   }
 
+  @override
+  Future<int> submitPrintJob(
+    Printer device,
+    Uint8List data, {
+    int priority = 0,
+  }) async {
+    methodCalls.add('submitPrintJob');
+    methodArguments.add({'device': device, 'data': data, 'priority': priority});
+    return methodCalls.length;
+  }
+
+  @override
+  Future<bool> cancelJob(int jobId) async {
+    methodCalls.add('cancelJob');
+    methodArguments.add(jobId);
+    return true;
+  }
+
+  @override
+  Future<bool> setQueueLimit(Printer device, int maxBytes) async {
+    methodCalls.add('setQueueLimit');
+    methodArguments.add({'device': device, 'maxBytes': maxBytes});
+    return true;
+  }
+
   @override
   Future<dynamic> convertImageToGrayscale(Uint8List? value) async {
     methodCalls.add('convertImageToGrayscale');
@@ -75,6 +108,100 @@ class MockFlutterThermalPrinterPlatform extends FlutterThermalPrinterPlatform
     return convertImageResult ?? value;
   }
 
+  @override
+  Future<Uint8List> rasterizeImage(
+    Uint8List pixels, {
+    required int width,
+    required int height,
+    DitherMode dither = DitherMode.threshold,
+    int threshold = 128,
+    int? scaleWidth,
+    bool feedBlankRows = false,
+  }) async {
+    methodCalls.add('rasterizeImage');
+    methodArguments.add({
+      'pixels': pixels,
+      'width': width,
+      'height': height,
+      'dither': dither,
+      'threshold': threshold,
+      'scaleWidth': scaleWidth,
+      'feedBlankRows': feedBlankRows,
+    });
+    return Uint8List(0);
+  }
+
+  @override
+  Future<Uint8List> rasterizeEncodedImage(
+    Uint8List encoded, {
+    DitherMode dither = DitherMode.threshold,
+    int threshold = 128,
+    int? scaleWidth,
+    bool feedBlankRows = false,
+  }) async {
+    methodCalls.add('rasterizeEncodedImage');
+    methodArguments.add({
+      'encoded': encoded,
+      'dither': dither,
+      'threshold': threshold,
+      'scaleWidth': scaleWidth,
+      'feedBlankRows': feedBlankRows,
+    });
+    return Uint8List(0);
+  }
+
+  @override
+  Future<void> printEncodedImage(
+    Printer device,
+    Uint8List encoded, {
+    DitherMode dither = DitherMode.threshold,
+    int threshold = 128,
+    int? scaleWidth,
+    bool feedBlankRows = false,
+    Uint8List? prefix,
+    Uint8List? suffix,
+  }) async {
+    methodCalls.add('printEncodedImage');
+    methodArguments.add({
+      'device': device,
+      'encoded': encoded,
+      'dither': dither,
+      'threshold': threshold,
+      'scaleWidth': scaleWidth,
+      'feedBlankRows': feedBlankRows,
+      'prefix': prefix,
+      'suffix': suffix,
+    });
+  }
+
+  @override
+  Future<void> printImage(
+    Printer device,
+    Uint8List pixels, {
+    required int width,
+    required int height,
+    DitherMode dither = DitherMode.threshold,
+    int threshold = 128,
+    int? scaleWidth,
+    bool feedBlankRows = false,
+    Uint8List? prefix,
+    Uint8List? suffix,
+  }) async {
+    methodCalls.add('printImage');
+    methodArguments.add({
+      'device': device,
+      'pixels': pixels,
+      'width': width,
+      'height': height,
+      'dither': dither,
+      'threshold': threshold,
+      'scaleWidth': scaleWidth,
+      'feedBlankRows': feedBlankRows,
+      'prefix': prefix,
+      'suffix': suffix,
+    });
+  }
+
   @override
   Future<void> stopScan() async {
     methodCalls.add('stopScan');
@@ -84,4 +211,175 @@ class MockFlutterThermalPrinterPlatform extends FlutterThermalPrinterPlatform
   Future<void> getPrinters() async {
     methodCalls.add('getPrinters');
   }
+
+  @override
+  Future<bool> printBuffer(Printer device, int buffer, int length) async {
+    methodCalls.add('printBuffer');
+    methodArguments.add({'device': device, 'buffer': buffer, 'length': length});
+    return true;
+  }
+
+  @override
+  Future<bool> beginBatch(Printer device) async {
+    methodCalls.add('beginBatch');
+    methodArguments.add({'device': device});
+    return true;
+  }
+
+  @override
+  Future<bool> endBatch(Printer device) async {
+    methodCalls.add('endBatch');
+    methodArguments.add({'device': device});
+    return true;
+  }
+
+  @override
+  Future<bool> setBatchWindow(Printer device, Duration window) async {
+    methodCalls.add('setBatchWindow');
+    methodArguments.add({'device': device, 'window': window});
+    return true;
+  }
+
+  @override
+  Future<bool> registerTemplate(PrintTemplate template) async {
+    methodCalls.add('registerTemplate');
+    methodArguments.add({'template': template});
+    return true;
+  }
+
+  @override
+  Future<bool> removeTemplate(String name) async {
+    methodCalls.add('removeTemplate');
+    methodArguments.add({'name': name});
+    return true;
+  }
+
+  @override
+  Future<bool> printTemplate(
+    Printer device,
+    String name,
+    Map<String, Uint8List> values, {
+    int priority = 0,
+  }) async {
+    methodCalls.add('printTemplate');
+    methodArguments.add({
+      'device': device,
+      'name': name,
+      'values': values,
+      'priority': priority,
+    });
+    return true;
+  }
+
+  @override
+  Future<bool> storeLogo(
+    Printer device,
+    String key,
+    Uint8List pixels, {
+    required int width,
+    required int height,
+    DitherMode dither = DitherMode.threshold,
+    int threshold = 128,
+    int? scaleWidth,
+    bool force = false,
+  }) async {
+    methodCalls.add('storeLogo');
+    methodArguments.add({
+      'device': device,
+      'key': key,
+      'pixels': pixels,
+      'width': width,
+      'height': height,
+      'scaleWidth': scaleWidth,
+      'force': force,
+    });
+    return true;
+  }
+
+  @override
+  Future<bool> printLogo(Printer device, String key) async {
+    methodCalls.add('printLogo');
+    methodArguments.add({'device': device, 'key': key});
+    return true;
+  }
+
+  @override
+  Future<JobStatsSnapshot> getJobStats({String? printer}) async {
+    methodCalls.add('getJobStats');
+    methodArguments.add({'printer': printer});
+    return const JobStatsSnapshot();
+  }
+
+  @override
+  Future<WarmUpReport> warmUp(List<Printer> devices) async {
+    methodCalls.add('warmUp');
+    methodArguments.add({'devices': devices});
+    return const WarmUpReport();
+  }
+
+  @override
+  Future<bool> setTransport(
+    Printer device,
+    PrinterTransport transport, {
+    String? devicePath,
+    int? chunkSize,
+    int? maxInFlight,
+    String? host,
+    int? port,
+    Duration? connectTimeout,
+    String? path,
+    int? baudRate,
+    Duration? latency,
+  }) async {
+    methodCalls.add('setTransport');
+    methodArguments.add({
+      'device': device,
+      'transport': transport,
+      'devicePath': devicePath,
+      'chunkSize': chunkSize,
+      'maxInFlight': maxInFlight,
+      'host': host,
+      'port': port,
+      'connectTimeout': connectTimeout,
+      'path': path,
+      'baudRate': baudRate,
+      'latency': latency,
+    });
+    return true;
+  }
+
+  @override
+  Future<List<WindowsPrinterInfo>> getPrinterDetails() async {
+    methodCalls.add('getPrinterDetails');
+    return const [WindowsPrinterInfo(name: 'POS-80', isRawUsb: true)];
+  }
+
+  @override
+  Future<PrinterStatus> getStatus(Printer device) async {
+    methodCalls.add('getStatus');
+    methodArguments.add({'device': device});
+    return const PrinterStatus(isKnown: true, isOnline: true);
+  }
+
+  @override
+  Future<Uint8List> encodeText(ReceiptText receipt) async {
+    methodCalls.add('encodeText');
+    methodArguments.add({'receipt': receipt});
+    return Uint8List.fromList([0x1B, 0x40]);
+  }
+
+  @override
+  Future<Map<String, String?>> printToMany(
+    List<Printer> devices,
+    Uint8List data, {
+    int priority = 0,
+  }) async {
+    methodCalls.add('printToMany');
+    methodArguments.add({
+      'devices': devices,
+      'data': data,
+      'priority': priority,
+    });
+    return {for (final device in devices) device.name!: null};
+  }
 }
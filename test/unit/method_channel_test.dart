@@ -1,7 +1,14 @@
+import 'package:esc_pos_utils_plus/esc_pos_utils_plus.dart' show PosAlign;
+import 'package:flutter/foundation.dart';
 import 'package:flutter/services.dart';
 import 'package:flutter_test/flutter_test.dart';
 import 'package:flutter_thermal_printer/flutter_thermal_printer_method_channel.dart';
+import 'package:flutter_thermal_printer/utils/dither_mode.dart';
+import 'package:flutter_thermal_printer/utils/nv_logo.dart';
+import 'package:flutter_thermal_printer/utils/print_template.dart';
 import 'package:flutter_thermal_printer/utils/printer.dart';
+import 'package:flutter_thermal_printer/utils/printer_transport.dart';
+import 'package:flutter_thermal_printer/utils/receipt_text.dart';
 
 void main() {
   TestWidgetsFlutterBinding.ensureInitialized();
@@ -32,10 +39,100 @@ void main() {
             return true;
           case 'printText':
             return true;
+          case 'submitJob':
+            return 7;
+          case 'cancelJob':
+          case 'setQueueLimit':
+            return true;
           case 'isConnected':
             return true;
           case 'convertimage':
-            return [1, 2, 3, 4];
+            final args = methodCall.arguments as Map;
+            return args.containsKey('pixels') || args.containsKey('encoded')
+                ? Uint8List.fromList([0x1D, 0x76, 0x30, 0x00])
+                : [1, 2, 3, 4];
+          case 'printImage':
+            return true;
+          case 'setTransport':
+            return true;
+          case 'getStatus':
+            return {
+              'supported': true,
+              'known': true,
+              'online': false,
+              'coverOpen': false,
+              'paperOut': true,
+              'paperNearEnd': true,
+              'error': false,
+              'ageMs': 120,
+            };
+          case 'encodeText':
+            return Uint8List.fromList([0x1B, 0x40]);
+          case 'printToMany':
+            return {'Kitchen': null, 'Bar': 'BUSY'};
+          case 'printBuffer':
+            return true;
+          case 'registerTemplate':
+          case 'removeTemplate':
+          case 'printTemplate':
+            return true;
+          case 'storeLogo':
+          case 'printLogo':
+            return true;
+          case 'beginBatch':
+          case 'endBatch':
+          case 'setBatchWindow':
+            return true;
+          case 'getJobStats':
+            return {
+              'printers': {
+                'POS-80': {
+                  'jobs': 3,
+                  'failures': 1,
+                  'bytes': 900,
+                  'queueMs': {'p50': 1.0, 'p95': 2.0, 'p99': 3.0},
+                  'spoolMs': {'p50': 10.0, 'p95': 20.0, 'p99': 30.0},
+                },
+              },
+              'recent': [
+                {
+                  'jobId': 5,
+                  'printer': 'POS-80',
+                  'bytes': 300,
+                  'success': true,
+                  'queueMs': 1.5,
+                  'rasterMs': 0.0,
+                  'spoolMs': 12.0,
+                  'totalMs': 14.0,
+                },
+              ],
+            };
+          case 'warmUp':
+            return {
+              'steps': [
+                {'step': 'platformThread', 'ms': 0.2, 'success': true},
+                {
+                  'step': 'openPrinter',
+                  'printer': 'POS-80',
+                  'ms': 35.0,
+                  'success': false,
+                  'error': 'OpenPrinter failed (Win32 error 1801).',
+                },
+              ],
+              'totalMs': 40.0,
+            };
+          case 'getPrinters':
+            return [
+              {
+                'name': 'POS-80',
+                'port': 'USB001',
+                'driver': 'POS-80 Driver',
+                'status': 0,
+                'attributes': 0,
+                'offline': false,
+                'rawUsb': true,
+              },
+            ];
           case 'disconnect':
             return true;
           default:
@@ -162,6 +259,68 @@ void main() {
         expect(args['data'], [1, 2, 3, 4, 5]);
         expect(args['data'], isList);
       });
+
+      test('sends Uint8List unchanged on Windows', () async {
+        debugDefaultTargetPlatformOverride = TargetPlatform.windows;
+        addTearDown(() => debugDefaultTargetPlatformOverride = null);
+        final data = Uint8List.fromList([1, 2, 3, 4, 5]);
+
+        await platform.printText(Printer(), data);
+
+        final args = log.first.arguments as Map;
+        expect(args['data'], isA<Uint8List>());
+        expect(args['data'], [1, 2, 3, 4, 5]);
+      });
+    });
+
+    group('submitPrintJob', () {
+      test('invokes submitJob with name and data', () async {
+        final printer = Printer(name: 'Test Printer');
+        final data = Uint8List.fromList([27, 64, 10]);
+
+        await platform.submitPrintJob(printer, data);
+
+        expect(log.length, 1);
+        expect(log.first.method, 'submitJob');
+        final args = log.first.arguments as Map;
+        expect(args['name'], 'Test Printer');
+        expect(args['data'], [27, 64, 10]);
+        expect(args.containsKey('priority'), false);
+      });
+
+      test('returns the native job id', () async {
+        final jobId =
+            await platform.submitPrintJob(Printer(), Uint8List.fromList([1]));
+        expect(jobId, 7);
+      });
+
+      test('sends a non-default priority', () async {
+        await platform.submitPrintJob(
+          Printer(name: 'KOT'),
+          Uint8List.fromList([1]),
+          priority: 5,
+        );
+        expect((log.single.arguments as Map)['priority'], 5);
+      });
+    });
+
+    group('queue control', () {
+      test('cancelJob sends the job id', () async {
+        final cancelled = await platform.cancelJob(7);
+
+        expect(cancelled, true);
+        expect(log.single.method, 'cancelJob');
+        expect((log.single.arguments as Map)['jobId'], 7);
+      });
+
+      test('setQueueLimit sends the printer and byte limit', () async {
+        await platform.setQueueLimit(Printer(name: 'POS-80'), 1 << 20);
+
+        expect(log.single.method, 'setQueueLimit');
+        final args = log.single.arguments as Map;
+        expect(args['name'], 'POS-80');
+        expect(args['maxBytes'], 1 << 20);
+      });
     });
 
     group('isConnected', () {
@@ -206,6 +365,433 @@ void main() {
       });
     });
 
+    group('rasterizeImage', () {
+      test('invokes convertimage with pixels and options', () async {
+        final pixels = Uint8List(8 * 2 * 4);
+
+        await platform.rasterizeImage(
+          pixels,
+          width: 8,
+          height: 2,
+          dither: DitherMode.floydSteinberg,
+          threshold: 100,
+        );
+
+        expect(log.length, 1);
+        expect(log.first.method, 'convertimage');
+        final args = log.first.arguments as Map;
+        expect(args['pixels'], isA<Uint8List>());
+        expect(args['width'], 8);
+        expect(args['height'], 2);
+        expect(args['dither'], DitherMode.floydSteinberg.index);
+        expect(args['threshold'], 100);
+      });
+
+      test('returns raster bytes', () async {
+        final raster = await platform.rasterizeImage(
+          Uint8List(4),
+          width: 1,
+          height: 1,
+        );
+        expect(raster, [0x1D, 0x76, 0x30, 0x00]);
+      });
+    });
+
+    group('printImage', () {
+      test('invokes printImage with pixels, options and framing', () async {
+        final printer = Printer(name: 'POS-80');
+        final pixels = Uint8List(8 * 2 * 4);
+
+        await platform.printImage(
+          printer,
+          pixels,
+          width: 8,
+          height: 2,
+          dither: DitherMode.ordered,
+          suffix: Uint8List.fromList([0x1D, 0x56, 0x00]),
+        );
+
+        expect(log.length, 1);
+        expect(log.first.method, 'printImage');
+        final args = log.first.arguments as Map;
+        expect(args['name'], 'POS-80');
+        expect(args['pixels'], isA<Uint8List>());
+        expect(args['width'], 8);
+        expect(args['height'], 2);
+        expect(args['dither'], DitherMode.ordered.index);
+        expect(args['threshold'], 128);
+        expect(args.containsKey('prefix'), false);
+        expect(args['suffix'], [0x1D, 0x56, 0x00]);
+      });
+    });
+
+    group('encoded images', () {
+      test('rasterizeEncodedImage sends the PNG bytes, not pixels', () async {
+        final png = Uint8List.fromList([0x89, 0x50, 0x4E, 0x47]);
+
+        await platform.rasterizeEncodedImage(png, dither: DitherMode.ordered);
+
+        expect(log.single.method, 'convertimage');
+        final args = log.single.arguments as Map;
+        expect(args['encoded'], png);
+        expect(args.containsKey('pixels'), false);
+        expect(args.containsKey('width'), false);
+        expect(args['dither'], DitherMode.ordered.index);
+        expect(args.containsKey('scaleWidth'), false);
+      });
+
+      test('sends scaleWidth only when given', () async {
+        final png = Uint8List.fromList([0x89, 0x50, 0x4E, 0x47]);
+
+        await platform.rasterizeEncodedImage(png, scaleWidth: 576);
+        await platform.printImage(
+          Printer(name: 'POS-80'),
+          Uint8List(8 * 2 * 4),
+          width: 8,
+          height: 2,
+          scaleWidth: 384,
+        );
+
+        expect((log[0].arguments as Map)['scaleWidth'], 576);
+        expect((log[1].arguments as Map)['scaleWidth'], 384);
+      });
+
+      test('sends feedBlankRows only when set', () async {
+        final png = Uint8List.fromList([0x89, 0x50, 0x4E, 0x47]);
+
+        await platform.rasterizeEncodedImage(png);
+        await platform.printEncodedImage(
+          Printer(name: 'POS-80'),
+          png,
+          feedBlankRows: true,
+        );
+
+        expect((log[0].arguments as Map).containsKey('feedBlankRows'), false);
+        expect((log[1].arguments as Map)['feedBlankRows'], true);
+      });
+
+      test('printEncodedImage goes through printImage', () async {
+        final png = Uint8List.fromList([0x89, 0x50, 0x4E, 0x47]);
+
+        await platform.printEncodedImage(
+          Printer(name: 'POS-80'),
+          png,
+          suffix: Uint8List.fromList([0x1D, 0x56, 0x00]),
+        );
+
+        expect(log.single.method, 'printImage');
+        final args = log.single.arguments as Map;
+        expect(args['name'], 'POS-80');
+        expect(args['encoded'], png);
+        expect(args['suffix'], [0x1D, 0x56, 0x00]);
+      });
+    });
+
+    group('printBuffer', () {
+      test('sends the lease and the filled length', () async {
+        final result = await platform.printBuffer(
+          Printer(name: 'POS-80'),
+          3,
+          120,
+        );
+
+        expect(result, true);
+        expect(log.single.method, 'printBuffer');
+        expect(log.single.arguments, {
+          'name': 'POS-80',
+          'buffer': 3,
+          'length': 120,
+        });
+      });
+    });
+
+    group('templates', () {
+      test('registerTemplate sends bytes and field offsets', () async {
+        final template = PrintTemplate('receipt')
+          ..add([0x1B, 0x40])
+          ..field('items')
+          ..add([0x0A])
+          ..field('total');
+
+        await platform.registerTemplate(template);
+
+        expect(log.single.method, 'registerTemplate');
+        final args = log.single.arguments as Map;
+        expect(args['template'], 'receipt');
+        expect(args['bytes'], [0x1B, 0x40, 0x0A]);
+        expect(args['fields'], [
+          {'name': 'items', 'offset': 2},
+          {'name': 'total', 'offset': 3},
+        ]);
+      });
+
+      test('printTemplate sends only the field values', () async {
+        await platform.printTemplate(
+          Printer(name: 'POS-80'),
+          'receipt',
+          {'total': Uint8List.fromList([0x34, 0x32])},
+        );
+
+        final args = log.single.arguments as Map;
+        expect(args['name'], 'POS-80');
+        expect(args['template'], 'receipt');
+        expect(args['values'], {
+          'total': [0x34, 0x32],
+        });
+      });
+    });
+
+    group('NV logos', () {
+      test('storeLogo sends the key, pixels and options', () async {
+        final uploaded = await platform.storeLogo(
+          Printer(name: 'POS-80'),
+          'L1',
+          Uint8List(8 * 4),
+          width: 8,
+          height: 1,
+          force: true,
+        );
+
+        expect(uploaded, true);
+        final args = log.single.arguments as Map;
+        expect(log.single.method, 'storeLogo');
+        expect(args['name'], 'POS-80');
+        expect(args['key'], 'L1');
+        expect(args['width'], 8);
+        expect(args['height'], 1);
+        expect(args['dither'], DitherMode.threshold.index);
+        expect(args['force'], true);
+      });
+
+      test('printLogo addresses the logo by key', () async {
+        await platform.printLogo(Printer(name: 'POS-80'), 'L1');
+
+        expect(log.single.arguments, {'name': 'POS-80', 'key': 'L1'});
+      });
+
+      test('nvLogoCommand matches the native print-by-key bytes', () {
+        expect(
+          nvLogoCommand('L1'),
+          [0x1D, 0x28, 0x4C, 0x06, 0x00, 0x30, 0x45, 0x4C, 0x31, 0x01, 0x01],
+        );
+        expect(() => nvLogoCommand('L'), throwsArgumentError);
+      });
+    });
+
+    group('batching', () {
+      test('begin and end address the printer by name', () async {
+        final printer = Printer(name: 'POS-80');
+        expect(await platform.beginBatch(printer), true);
+        expect(await platform.endBatch(printer), true);
+
+        expect(log.map((call) => call.method), ['beginBatch', 'endBatch']);
+        expect(log.first.arguments, {'name': 'POS-80'});
+      });
+
+      test('setBatchWindow sends milliseconds', () async {
+        await platform.setBatchWindow(
+          Printer(name: 'POS-80'),
+          const Duration(milliseconds: 40),
+        );
+
+        expect(log.single.arguments, {'name': 'POS-80', 'windowMs': 40});
+      });
+    });
+
+    group('setTransport', () {
+      test('sends the transport name and optional device path', () async {
+        final result = await platform.setTransport(
+          Printer(name: 'POS-80'),
+          PrinterTransport.usb,
+          devicePath: r'\\?\usb#vid_0416&pid_5011',
+          chunkSize: 16384,
+          maxInFlight: 6,
+        );
+
+        expect(result, true);
+        expect(log.single.method, 'setTransport');
+        final args = log.single.arguments as Map;
+        expect(args['name'], 'POS-80');
+        expect(args['transport'], 'usb');
+        expect(args['devicePath'], r'\\?\usb#vid_0416&pid_5011');
+        expect(args['chunkSize'], 16384);
+        expect(args['maxInFlight'], 6);
+      });
+
+      test('omits the device path by default', () async {
+        await platform.setTransport(
+          Printer(name: 'POS-80'),
+          PrinterTransport.spooler,
+        );
+
+        final args = log.single.arguments as Map;
+        expect(args['transport'], 'spooler');
+        expect(args.containsKey('devicePath'), false);
+        expect(args.containsKey('chunkSize'), false);
+        expect(args.containsKey('maxInFlight'), false);
+        expect(args.containsKey('host'), false);
+        expect(args.containsKey('connectTimeoutMs'), false);
+      });
+
+      test('sends the network endpoint and connect timeout', () async {
+        await platform.setTransport(
+          Printer(
+            name: 'Kitchen',
+            address: '192.168.1.50',
+            connectionType: ConnectionType.NETWORK,
+          ),
+          PrinterTransport.network,
+          host: '192.168.1.50',
+          port: 9101,
+          connectTimeout: const Duration(seconds: 2),
+        );
+
+        final args = log.single.arguments as Map;
+        expect(args['transport'], 'network');
+        expect(args['address'], '192.168.1.50');
+        expect(args['host'], '192.168.1.50');
+        expect(args['port'], 9101);
+        expect(args['connectTimeoutMs'], 2000);
+      });
+
+      test('sends the loopback path and simulated line', () async {
+        await platform.setTransport(
+          Printer(name: 'Bench'),
+          PrinterTransport.loopback,
+          path: r'\\.\pipe\bench',
+          baudRate: 115200,
+          latency: const Duration(milliseconds: 30),
+        );
+
+        final args = log.single.arguments as Map;
+        expect(args['transport'], 'loopback');
+        expect(args['path'], r'\\.\pipe\bench');
+        expect(args['baudRate'], 115200);
+        expect(args['latencyMs'], 30);
+      });
+    });
+
+    group('getJobStats', () {
+      test('passes the printer filter and parses the snapshot', () async {
+        final stats = await platform.getJobStats(printer: 'POS-80');
+
+        expect(log.single.method, 'getJobStats');
+        expect((log.single.arguments as Map)['printer'], 'POS-80');
+        final summary = stats.printers['POS-80']!;
+        expect(summary.jobs, 3);
+        expect(summary.failures, 1);
+        expect(summary.spoolMs.p95, 20.0);
+        expect(summary.rasterMs.p99, 0);
+        final job = stats.recent.single;
+        expect(job.jobId, 5);
+        expect(job.totalMs, 14.0);
+      });
+
+      test('omits the filter when no printer is given', () async {
+        await platform.getJobStats();
+
+        expect(log.single.arguments, isEmpty);
+      });
+    });
+
+    group('warmUp', () {
+      test('sends the printer names and parses the report', () async {
+        final report = await platform.warmUp([Printer(name: 'POS-80')]);
+
+        expect(log.single.method, 'warmUp');
+        expect((log.single.arguments as Map)['printers'], ['POS-80']);
+        expect(report.totalMs, 40.0);
+        expect(report.platformThreadMs, 0.2);
+        expect(report.success, isFalse);
+        final open = report.steps.last;
+        expect(open.step, 'openPrinter');
+        expect(open.printer, 'POS-80');
+        expect(open.error, contains('1801'));
+      });
+    });
+
+    group('getPrinterDetails', () {
+      test('invokes getPrinters and parses the snapshot', () async {
+        final printers = await platform.getPrinterDetails();
+
+        expect(log.single.method, 'getPrinters');
+        expect(printers.single.name, 'POS-80');
+        expect(printers.single.port, 'USB001');
+        expect(printers.single.driver, 'POS-80 Driver');
+        expect(printers.single.isRawUsb, true);
+      });
+    });
+
+    group('getStatus', () {
+      test('sends the printer name and parses the status', () async {
+        final status = await platform.getStatus(Printer(name: 'POS-80'));
+
+        expect(log.single.method, 'getStatus');
+        expect((log.single.arguments as Map)['name'], 'POS-80');
+        expect(status.isKnown, true);
+        expect(status.isOnline, false);
+        expect(status.isPaperOut, true);
+        expect(status.isPaperNearEnd, true);
+        expect(status.age, const Duration(milliseconds: 120));
+        expect(status.blocksPrinting, true);
+      });
+    });
+
+    group('encodeText', () {
+      test('sends the receipt rows', () async {
+        final receipt = ReceiptText(
+          codePage: ReceiptCodePage.cp858,
+          charsPerLine: 32,
+        )
+          ..text('Shop', align: PosAlign.center, bold: true, width: 2)
+          ..row([
+            const ReceiptColumn('Tea', flex: 3),
+            const ReceiptColumn('1.50', align: PosAlign.right),
+          ])
+          ..rule(character: '=')
+          ..feed(2)
+          ..cut(partial: true);
+
+        final bytes = await platform.encodeText(receipt);
+
+        expect(bytes, [0x1B, 0x40]);
+        expect(log.single.method, 'encodeText');
+        final args = log.single.arguments as Map;
+        expect(args['codePage'], 'cp858');
+        expect(args.containsKey('codePageId'), false);
+        expect(args['charsPerLine'], 32);
+        final rows = args['rows'] as List;
+        expect(rows[0],
+            {'text': 'Shop', 'align': 1, 'bold': true, 'width': 2});
+        expect(rows[1], {
+          'columns': [
+            {'text': 'Tea', 'flex': 3, 'align': 0},
+            {'text': '1.50', 'flex': 1, 'align': 2},
+          ],
+        });
+        expect(rows[2], {'rule': '='});
+        expect(rows[3], {'feed': 2});
+        expect(rows[4], {'cut': true, 'partial': true});
+      });
+    });
+
+    group('printToMany', () {
+      test('sends the printer names and the bytes once', () async {
+        final outcomes = await platform.printToMany(
+          [Printer(name: 'Kitchen'), Printer(name: 'Bar')],
+          Uint8List.fromList([0x1B, 0x40]),
+          priority: 5,
+        );
+
+        expect(outcomes, {'Kitchen': null, 'Bar': 'BUSY'});
+        expect(log.single.method, 'printToMany');
+        final args = log.single.arguments as Map;
+        expect(args['printers'], ['Kitchen', 'Bar']);
+        expect(args['data'], [0x1B, 0x40]);
+        expect(args['priority'], 5);
+      });
+    });
+
     group('disconnect', () {
       test('invokes disconnect with vendorId and productId', () async {
         final printer = Printer(
@@ -221,6 +807,15 @@ void main() {
         final args = log.first.arguments as Map;
         expect(args['vendorId'], '1234');
         expect(args['productId'], '5678');
+        expect(args.containsKey('name'), false);
+      });
+
+      test('sends the name the printer\'s jobs are queued under', () async {
+        await platform.disconnect(
+          Printer(name: 'Kitchen', connectionType: ConnectionType.NETWORK),
+        );
+
+        expect((log.first.arguments as Map)['name'], 'Kitchen');
       });
 
       test('returns disconnect result', () async {
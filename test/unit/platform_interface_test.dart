@@ -3,7 +3,10 @@ import 'dart:typed_data';
 import 'package:flutter_test/flutter_test.dart';
 import 'package:flutter_thermal_printer/flutter_thermal_printer_method_channel.dart';
 import 'package:flutter_thermal_printer/flutter_thermal_printer_platform_interface.dart';
+import 'package:flutter_thermal_printer/utils/print_template.dart';
 import 'package:flutter_thermal_printer/utils/printer.dart';
+import 'package:flutter_thermal_printer/utils/printer_transport.dart';
+import 'package:flutter_thermal_printer/utils/receipt_text.dart';
 import 'package:plugin_platform_interface/plugin_platform_interface.dart';
 
 class MockFlutterThermalPrinterPlatform extends FlutterThermalPrinterPlatform
@@ -116,6 +119,146 @@ void main() {
           throwsA(isA<UnimplementedError>()),
         );
       });
+
+      test('getJobStats throws UnimplementedError', () async {
+        expect(
+          () => basePlatform.getJobStats(),
+          throwsA(isA<UnimplementedError>()),
+        );
+      });
+
+      test('printBuffer throws UnimplementedError', () async {
+        expect(
+          () => basePlatform.printBuffer(Printer(name: 'POS-80'), 1, 10),
+          throwsA(isA<UnimplementedError>()),
+        );
+      });
+
+      test('template methods throw UnimplementedError', () async {
+        expect(
+          () => basePlatform.registerTemplate(PrintTemplate('receipt')),
+          throwsA(isA<UnimplementedError>()),
+        );
+        expect(
+          () => basePlatform.removeTemplate('receipt'),
+          throwsA(isA<UnimplementedError>()),
+        );
+        expect(
+          () => basePlatform.printTemplate(
+            Printer(name: 'POS-80'),
+            'receipt',
+            const {},
+          ),
+          throwsA(isA<UnimplementedError>()),
+        );
+      });
+
+      test('encoded image methods throw UnimplementedError', () async {
+        expect(
+          () => basePlatform.rasterizeEncodedImage(Uint8List(4)),
+          throwsA(isA<UnimplementedError>()),
+        );
+        expect(
+          () => basePlatform.printEncodedImage(
+            Printer(name: 'POS-80'),
+            Uint8List(4),
+          ),
+          throwsA(isA<UnimplementedError>()),
+        );
+      });
+
+      test('logo methods throw UnimplementedError', () async {
+        final printer = Printer(name: 'POS-80');
+        expect(
+          () => basePlatform.storeLogo(
+            printer,
+            'L1',
+            Uint8List(4),
+            width: 1,
+            height: 1,
+          ),
+          throwsA(isA<UnimplementedError>()),
+        );
+        expect(
+          () => basePlatform.printLogo(printer, 'L1'),
+          throwsA(isA<UnimplementedError>()),
+        );
+      });
+
+      test('batch methods throw UnimplementedError', () async {
+        final printer = Printer(name: 'POS-80');
+        expect(
+          () => basePlatform.beginBatch(printer),
+          throwsA(isA<UnimplementedError>()),
+        );
+        expect(
+          () => basePlatform.endBatch(printer),
+          throwsA(isA<UnimplementedError>()),
+        );
+        expect(
+          () => basePlatform.setBatchWindow(printer, Duration.zero),
+          throwsA(isA<UnimplementedError>()),
+        );
+      });
+
+      test('queue control throws UnimplementedError', () async {
+        expect(
+          () => basePlatform.cancelJob(1),
+          throwsA(isA<UnimplementedError>()),
+        );
+        expect(
+          () => basePlatform.setQueueLimit(Printer(name: 'POS-80'), 0),
+          throwsA(isA<UnimplementedError>()),
+        );
+      });
+
+      test('setTransport throws UnimplementedError', () async {
+        expect(
+          () => basePlatform.setTransport(
+            Printer(name: 'POS-80'),
+            PrinterTransport.usb,
+          ),
+          throwsA(isA<UnimplementedError>()),
+        );
+      });
+
+      test('getPrinterDetails throws UnimplementedError', () async {
+        expect(
+          () => basePlatform.getPrinterDetails(),
+          throwsA(isA<UnimplementedError>()),
+        );
+      });
+
+      test('getStatus throws UnimplementedError', () async {
+        expect(
+          () => basePlatform.getStatus(Printer(name: 'POS-80')),
+          throwsA(isA<UnimplementedError>()),
+        );
+      });
+
+      test('encodeText throws UnimplementedError', () async {
+        expect(
+          () => basePlatform.encodeText(ReceiptText()),
+          throwsA(isA<UnimplementedError>()),
+        );
+      });
+
+      test('warmUp throws UnimplementedError', () async {
+        expect(
+          () => basePlatform.warmUp([Printer(name: 'POS-80')]),
+          throwsA(isA<UnimplementedError>()),
+        );
+      });
+
+      test('printToMany throws UnimplementedError', () async {
+        expect(
+          () => basePlatform.printToMany(
+            [Printer(name: 'POS-80')],
+            Uint8List(4),
+          ),
+          throwsA(isA<UnimplementedError>()),
+        );
+      });
     });
 
     group('base class getPlatformVersion', () {
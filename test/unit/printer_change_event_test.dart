@@ -0,0 +1,56 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:flutter_thermal_printer/utils/printer.dart';
+import 'package:flutter_thermal_printer/utils/printer_change_event.dart';
+import 'package:flutter_thermal_printer/utils/windows_printer_info.dart';
+
+void main() {
+  group('PrinterChangeEvent', () {
+    test('fromMap reads added, changed and removed queues', () {
+      final event = PrinterChangeEvent.fromMap({
+        'added': [
+          {
+            'name': 'POS-80',
+            'port': 'USB001',
+            'driver': 'Generic / Text Only',
+            'status': 0,
+            'attributes': 0,
+            'offline': false,
+            'rawUsb': true,
+          },
+        ],
+        'changed': [
+          {'name': 'Kitchen', 'status': 0x80, 'attributes': 0, 'offline': true},
+        ],
+        'removed': ['Old'],
+      });
+
+      final added = event.added.single;
+      expect(added.name, 'POS-80');
+      expect(added.port, 'USB001');
+      expect(added.driver, 'Generic / Text Only');
+      expect(added.isRawUsb, true);
+      expect(event.changed.single.isOffline, true);
+      expect(event.changed.single.port, '');
+      expect(event.removed, ['Old']);
+    });
+
+    test('toPrinter maps a queue to a USB printer keyed by name', () {
+      const info = WindowsPrinterInfo(name: 'POS-80', isOffline: true);
+      final printer = info.toPrinter();
+
+      expect(printer.name, 'POS-80');
+      expect(printer.address, 'POS-80');
+      expect(printer.vendorId, 'POS-80');
+      expect(printer.connectionType, ConnectionType.USB);
+      expect(printer.isConnected, false);
+    });
+
+    test('fromMap tolerates missing lists', () {
+      final event = PrinterChangeEvent.fromMap({});
+
+      expect(event.added, isEmpty);
+      expect(event.changed, isEmpty);
+      expect(event.removed, isEmpty);
+    });
+  });
+}
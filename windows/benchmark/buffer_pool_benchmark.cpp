@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "buffer_pool.h"
+
+namespace flutter_thermal_printer {
+namespace bench {
+
+// Arg: buffer bytes. A payload's round trip through a warm pool.
+void BM_PoolAcquireRelease(::benchmark::State &state) {
+  const size_t size = static_cast<size_t>(state.range(0));
+  BufferPool pool(PrinterBuffers::kMaxRetainedPerPrinter);
+  pool.Release(pool.Acquire(size));
+  for (auto _ : state) {
+    std::vector<uint8_t> buffer = pool.Acquire(size);
+    buffer.resize(size);
+    ::benchmark::DoNotOptimize(buffer.data());
+    pool.Release(std::move(buffer));
+  }
+  state.counters["hit_rate"] =
+      static_cast<double>(pool.hits()) / (pool.hits() + pool.misses());
+}
+BENCHMARK(BM_PoolAcquireRelease)->RangeMultiplier(8)->Range(4 << 10, 4 << 20);
+
+// Arg: buffer bytes. What the pool saves: a fresh allocation per payload.
+void BM_HeapAllocateFree(::benchmark::State &state) {
+  const size_t size = static_cast<size_t>(state.range(0));
+  for (auto _ : state) {
+    std::vector<uint8_t> buffer;
+    buffer.reserve(size);
+    buffer.resize(size);
+    ::benchmark::DoNotOptimize(buffer.data());
+  }
+}
+BENCHMARK(BM_HeapAllocateFree)->RangeMultiplier(8)->Range(4 << 10, 4 << 20);
+
+// The plugin's pools are shared by the platform thread, the raster helpers
+// and each printer's worker.
+void BM_PoolContended(::benchmark::State &state) {
+  static BufferPool *pool = nullptr;
+  if (state.thread_index() == 0) {
+    pool = new BufferPool(PrinterBuffers::kMaxRetainedPerPrinter);
+  }
+  for (auto _ : state) {
+    std::vector<uint8_t> buffer = pool->Acquire(64 << 10);
+    ::benchmark::DoNotOptimize(buffer.data());
+    pool->Release(std::move(buffer));
+  }
+  if (state.thread_index() == 0) {
+    delete pool;
+    pool = nullptr;
+  }
+}
+BENCHMARK(BM_PoolContended)->ThreadRange(1, 4);
+
+}  // namespace bench
+}  // namespace flutter_thermal_printer
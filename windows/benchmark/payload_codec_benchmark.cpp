@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+#include <flutter/method_call.h>
+#include <flutter/standard_method_codec.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "benchmark/reference_receipts.h"
+#include "buffer_pool.h"
+#include "payload_codec.h"
+
+namespace flutter_thermal_printer {
+namespace bench {
+
+namespace {
+
+using flutter::EncodableList;
+using flutter::EncodableMap;
+using flutter::EncodableValue;
+using flutter::MethodCall;
+
+std::unique_ptr<std::vector<uint8_t>> EncodeCall(const EncodableValue &data) {
+  EncodableMap args = {{EncodableValue("name"), EncodableValue("POS-80")},
+                       {EncodableValue("data"), data}};
+  return flutter::StandardMethodCodec::GetInstance().EncodeMethodCall(
+      MethodCall<EncodableValue>("printText",
+                                 std::make_unique<EncodableValue>(args)));
+}
+
+std::vector<uint8_t> Payload(size_t size) {
+  std::vector<uint8_t> payload(size);
+  for (size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<uint8_t>(i * 31);
+  }
+  return payload;
+}
+
+// Decodes |encoded| and extracts `data` the way the plugin's handlers do.
+void DecodeAndRead(::benchmark::State &state,
+                   const std::vector<uint8_t> &encoded, size_t payload_size,
+                   BufferPool *buffers) {
+  const auto &codec = flutter::StandardMethodCodec::GetInstance();
+  std::vector<uint8_t> payload;
+  for (auto _ : state) {
+    auto call = codec.DecodeMethodCall(encoded.data(), encoded.size());
+    const auto *args = std::get_if<EncodableMap>(call->arguments());
+    if (args == nullptr || !ReadPayload(*args, "data", &payload, buffers)) {
+      state.SkipWithError("ReadPayload failed");
+      break;
+    }
+    ::benchmark::DoNotOptimize(payload.data());
+    if (buffers != nullptr) {
+      buffers->Release(std::move(payload));
+      payload = {};
+    }
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(payload_size));
+}
+
+}  // namespace
+
+// Arg: payload bytes. Encoding is what Dart's side of the channel costs.
+void BM_EncodeUint8List(::benchmark::State &state) {
+  const EncodableValue data(Payload(static_cast<size_t>(state.range(0))));
+  for (auto _ : state) {
+    ::benchmark::DoNotOptimize(EncodeCall(data));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EncodeUint8List)->RangeMultiplier(8)->Range(4 << 10, 2 << 20);
+
+// Arg: payload bytes. Arg 2: whether the copy lands in a pooled buffer.
+void BM_DecodeUint8List(::benchmark::State &state) {
+  const size_t size = static_cast<size_t>(state.range(0));
+  BufferPool pool(PrinterBuffers::kMaxRetainedPerPrinter);
+  DecodeAndRead(state, *EncodeCall(EncodableValue(Payload(size))), size,
+                state.range(1) != 0 ? &pool : nullptr);
+}
+BENCHMARK(BM_DecodeUint8List)
+    ->ArgNames({"bytes", "pooled"})
+    ->ArgsProduct({{4 << 10, 256 << 10, 2 << 20}, {0, 1}});
+
+// The same payload sent as a Dart List<int>, which every byte boxes.
+void BM_DecodeBoxedIntList(::benchmark::State &state) {
+  const std::vector<uint8_t> payload =
+      Payload(static_cast<size_t>(state.range(0)));
+  EncodableList boxed;
+  boxed.reserve(payload.size());
+  for (uint8_t byte : payload) {
+    boxed.emplace_back(static_cast<int32_t>(byte));
+  }
+  DecodeAndRead(state, *EncodeCall(EncodableValue(boxed)), payload.size(),
+                nullptr);
+}
+BENCHMARK(BM_DecodeBoxedIntList)->Arg(4 << 10)->Arg(256 << 10);
+
+// The reference text receipt, the most common call.
+void BM_DecodeTextReceipt(::benchmark::State &state) {
+  DecodeAndRead(state, *EncodeCall(EncodableValue(TextReceipt())),
+                TextReceipt().size(), nullptr);
+}
+BENCHMARK(BM_DecodeTextReceipt);
+
+}  // namespace bench
+}  // namespace flutter_thermal_printer
@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/reference_receipts.h"
+#include "raster_engine.h"
+#include "thread_pool.h"
+
+namespace flutter_thermal_printer {
+namespace bench {
+
+namespace {
+
+constexpr int kGradientRows = 512;
+
+// Same helper count as the plugin's raster pool.
+constexpr size_t kHelperThreads = 3;
+
+void SetImageCounters(::benchmark::State &state, const ReferenceImage &image) {
+  state.SetItemsProcessed(state.iterations() * image.height);
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(image.rgba.size()));
+}
+
+void Rasterize(::benchmark::State &state, const ReferenceImage &image,
+               const RasterOptions &options, ThreadPool *pool) {
+  std::vector<uint8_t> out;
+  for (auto _ : state) {
+    out.clear();
+    RasterizeRgba(image.rgba.data(), image.rgba.size(), image.width,
+                  image.height, options, &out, pool);
+    ::benchmark::DoNotOptimize(out.data());
+  }
+  SetImageCounters(state, image);
+}
+
+}  // namespace
+
+// Args: paper width in dots, DitherMode. Serial, so the kernels are what is
+// measured.
+void BM_RasterizeWidth(::benchmark::State &state) {
+  const ReferenceImage image =
+      GradientImage(static_cast<int>(state.range(0)), kGradientRows);
+  RasterOptions options;
+  options.dither = static_cast<DitherMode>(state.range(1));
+  Rasterize(state, image, options, nullptr);
+}
+BENCHMARK(BM_RasterizeWidth)
+    ->ArgNames({"width", "dither"})
+    ->ArgsProduct({{384, 576, 640, 832}, {0, 1, 2}});
+
+// Arg: DitherMode. Banded across the helper threads, as the plugin prints.
+void BM_RasterizeLogo(::benchmark::State &state) {
+  ThreadPool pool(kHelperThreads);
+  RasterOptions options;
+  options.dither = static_cast<DitherMode>(state.range(0));
+  Rasterize(state, LogoImage(), options, &pool);
+}
+BENCHMARK(BM_RasterizeLogo)
+    ->ArgName("dither")
+    ->DenseRange(0, 2)
+    ->UseRealTime();
+
+// Arg: whether blank rows become paper feeds.
+void BM_RasterizeLongWidget(::benchmark::State &state) {
+  ThreadPool pool(kHelperThreads);
+  RasterOptions options;
+  options.feed_blank_rows = state.range(0) != 0;
+  std::vector<uint8_t> out;
+  RasterizeRgba(LongWidgetImage().rgba.data(), LongWidgetImage().rgba.size(),
+                LongWidgetImage().width, LongWidgetImage().height, options,
+                &out, &pool);
+  state.counters["output_bytes"] = static_cast<double>(out.size());
+  Rasterize(state, LongWidgetImage(), options, &pool);
+}
+BENCHMARK(BM_RasterizeLongWidget)
+    ->ArgName("feed_blank_rows")
+    ->DenseRange(0, 1)
+    ->UseRealTime();
+
+// The streaming path printImage takes for tall images.
+void BM_RasterizeLongWidgetBands(::benchmark::State &state) {
+  const ReferenceImage &image = LongWidgetImage();
+  for (auto _ : state) {
+    size_t bytes = 0;
+    RasterizeRgbaBands(image.rgba.data(), image.rgba.size(), image.width,
+                       image.height, RasterOptions(),
+                       [&bytes](std::vector<uint8_t> band) {
+                         bytes += band.size();
+                         return true;
+                       });
+    ::benchmark::DoNotOptimize(bytes);
+  }
+  SetImageCounters(state, image);
+}
+BENCHMARK(BM_RasterizeLongWidgetBands);
+
+}  // namespace bench
+}  // namespace flutter_thermal_printer
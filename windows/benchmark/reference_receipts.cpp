@@ -0,0 +1,126 @@
+#include "benchmark/reference_receipts.h"
+
+#include <string>
+
+#include "text_encoder.h"
+
+namespace flutter_thermal_printer {
+namespace bench {
+
+namespace {
+
+constexpr int kPaperWidth = 576;
+
+void Fill(ReferenceImage *image, int x, int y, int width, int height,
+          uint8_t gray) {
+  for (int row = y; row < y + height && row < image->height; ++row) {
+    for (int col = x; col < x + width && col < image->width; ++col) {
+      uint8_t *pixel =
+          &image->rgba[(static_cast<size_t>(row) * image->width + col) * 4];
+      pixel[0] = pixel[1] = pixel[2] = gray;
+      pixel[3] = 0xFF;
+    }
+  }
+}
+
+ReferenceImage WhiteImage(int width, int height) {
+  ReferenceImage image;
+  image.width = width;
+  image.height = height;
+  image.rgba.assign(static_cast<size_t>(width) * height * 4, 0xFF);
+  return image;
+}
+
+}  // namespace
+
+const std::vector<uint8_t>& TextReceipt() {
+  static const std::vector<uint8_t> receipt = [] {
+    TextEncoder encoder(CodePage::kCp858, DefaultCodePageId(CodePage::kCp858),
+                        48);
+    TextStyle title;
+    title.align = TextAlign::kCenter;
+    title.bold = true;
+    title.width = 2;
+    title.height = 2;
+    encoder.Text("Apna Bill Book", title);
+    TextStyle centered;
+    centered.align = TextAlign::kCenter;
+    encoder.Text("12 Market Road, Pune - GSTIN 27ABCDE1234F1Z5", centered);
+    const TextStyle plain;
+    encoder.Rule('-', plain);
+    for (int i = 1; i <= 40; ++i) {
+      encoder.Columns({{"Item " + std::to_string(i) + " with a long name", 3,
+                        TextAlign::kLeft},
+                       {std::to_string(i % 4 + 1), 1, TextAlign::kRight},
+                       {std::to_string(i * 12) + ".50", 1, TextAlign::kRight}},
+                      plain);
+    }
+    encoder.Rule('=', plain);
+    TextStyle total;
+    total.bold = true;
+    encoder.Columns({{"Total", 3, TextAlign::kLeft},
+                     {"5,432.00", 2, TextAlign::kRight}},
+                    total);
+    encoder.Feed(3);
+    encoder.Cut(true);
+    return encoder.bytes();
+  }();
+  return receipt;
+}
+
+const ReferenceImage& LogoImage() {
+  static const ReferenceImage logo = [] {
+    ReferenceImage image = WhiteImage(kPaperWidth, 192);
+    for (int row = 0; row < image.height; ++row) {
+      for (int col = 0; col < image.width; ++col) {
+        const int gray = 255 - (col * 160 / image.width) - (row * 64 / 192);
+        Fill(&image, col, row, 1, 1, static_cast<uint8_t>(gray));
+      }
+    }
+    Fill(&image, 48, 32, 128, 128, 0x00);
+    Fill(&image, 224, 64, 304, 24, 0x20);
+    Fill(&image, 224, 112, 240, 16, 0x40);
+    return image;
+  }();
+  return logo;
+}
+
+const ReferenceImage& LongWidgetImage() {
+  static const ReferenceImage widget = [] {
+    ReferenceImage image = WhiteImage(kPaperWidth, 4096);
+    int y = 16;
+    int line = 0;
+    while (y + 24 < image.height) {
+      // A text line: glyph-sized strokes with word gaps.
+      for (int x = 8; x < image.width - 16; x += 12) {
+        if ((x / 12 + line) % 7 != 0) {
+          Fill(&image, x, y, 8, 20, 0x00);
+        }
+      }
+      y += 32;
+      // A blank gap between sections every eight lines.
+      if (++line % 8 == 0) {
+        y += 96;
+      }
+    }
+    return image;
+  }();
+  return widget;
+}
+
+ReferenceImage GradientImage(int width, int height) {
+  ReferenceImage image = WhiteImage(width, height);
+  uint32_t noise = 1;
+  for (int row = 0; row < height; ++row) {
+    for (int col = 0; col < width; ++col) {
+      noise = noise * 1664525u + 1013904223u;
+      const int gray = col * 255 / width + static_cast<int>(noise >> 28) - 8;
+      Fill(&image, col, row, 1, 1,
+           static_cast<uint8_t>(gray < 0 ? 0 : gray > 255 ? 255 : gray));
+    }
+  }
+  return image;
+}
+
+}  // namespace bench
+}  // namespace flutter_thermal_printer
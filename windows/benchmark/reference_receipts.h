@@ -0,0 +1,40 @@
+#ifndef FLUTTER_PLUGIN_BENCHMARK_REFERENCE_RECEIPTS_H_
+#define FLUTTER_PLUGIN_BENCHMARK_REFERENCE_RECEIPTS_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace flutter_thermal_printer {
+namespace bench {
+
+/// A tightly packed RGBA image.
+struct ReferenceImage {
+  int width = 0;
+  int height = 0;
+  std::vector<uint8_t> rgba;
+};
+
+/// The tickets the benchmarks are measured on, built in code so the numbers
+/// do not depend on files next to the binary. All are 576 dots (80 mm) wide
+/// and identical on every run.
+
+/// A 40-item text-mode invoice from TextEncoder: header, item columns,
+/// totals, feed and cut. About 3 KB.
+const std::vector<uint8_t>& TextReceipt();
+
+/// A 576 x 192 logo: a gray-level gradient behind solid shapes, the case
+/// dithering is for.
+const ReferenceImage& LogoImage();
+
+/// A 576 x 4096 screenshot of a widget receipt: black text-like strokes on
+/// white with blank gaps between sections, mostly white like the real ones.
+const ReferenceImage& LongWidgetImage();
+
+/// A |width| x |height| gray gradient with some noise, for the per-width
+/// raster runs.
+ReferenceImage GradientImage(int width, int height);
+
+}  // namespace bench
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_BENCHMARK_REFERENCE_RECEIPTS_H_
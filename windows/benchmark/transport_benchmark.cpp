@@ -0,0 +1,171 @@
+#include <benchmark/benchmark.h>
+#include <windows.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark/reference_receipts.h"
+#include "buffer_pool.h"
+#include "loopback_printer.h"
+#include "print_template.h"
+#include "printer_worker.h"
+#include "raster_engine.h"
+
+namespace flutter_thermal_printer {
+namespace bench {
+
+namespace {
+
+std::unique_ptr<LoopbackPrinter> Loopback(uint32_t baud_rate = 0) {
+  LoopbackOptions options;
+  options.baud_rate = baud_rate;
+  return std::make_unique<LoopbackPrinter>(L"loopback", options);
+}
+
+// Counts completed jobs across worker threads.
+class Completions {
+ public:
+  std::function<void(DWORD)> Callback() {
+    return [this](DWORD) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++count_;
+      done_.notify_all();
+    };
+  }
+
+  void WaitFor(int64_t expected) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&] { return count_ >= expected; });
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable done_;
+  int64_t count_ = 0;
+};
+
+std::vector<uint8_t> LongWidgetRaster() {
+  std::vector<uint8_t> raster;
+  const ReferenceImage &image = LongWidgetImage();
+  RasterizeRgba(image.rgba.data(), image.rgba.size(), image.width,
+                image.height, RasterOptions(), &raster);
+  return raster;
+}
+
+// Queues |jobs| copies of |document| per iteration and waits for the
+// worker to write them all.
+void PrintThroughLoopback(::benchmark::State &state,
+                          const std::vector<uint8_t> &document, int jobs,
+                          std::chrono::milliseconds batch_window) {
+  auto buffers = std::make_shared<BufferPool>(
+      PrinterBuffers::kMaxRetainedPerPrinter);
+  PrinterWorker worker(Loopback(), buffers);
+  worker.SetBatchWindow(batch_window);
+  Completions completions;
+  int64_t queued = 0;
+  for (auto _ : state) {
+    for (int i = 0; i < jobs; ++i) {
+      PrintJob job;
+      job.data = buffers->Acquire(document.size());
+      job.data.assign(document.begin(), document.end());
+      job.on_complete = completions.Callback();
+      worker.Enqueue(std::move(job));
+    }
+    queued += jobs;
+    completions.WaitFor(queued);
+  }
+  state.SetItemsProcessed(queued);
+  state.SetBytesProcessed(queued * static_cast<int64_t>(document.size()));
+}
+
+}  // namespace
+
+// Args: jobs queued at once, batch window in ms. Jobs arriving together
+// are coalesced into one document.
+void BM_LoopbackTextReceipts(::benchmark::State &state) {
+  PrintThroughLoopback(state, TextReceipt(), static_cast<int>(state.range(0)),
+                       std::chrono::milliseconds(state.range(1)));
+}
+BENCHMARK(BM_LoopbackTextReceipts)
+    ->ArgNames({"jobs", "window_ms"})
+    ->ArgsProduct({{1, 16, 128}, {0}})
+    ->UseRealTime();
+
+void BM_LoopbackLongWidget(::benchmark::State &state) {
+  PrintThroughLoopback(state, LongWidgetRaster(), 1,
+                       std::chrono::milliseconds(0));
+}
+BENCHMARK(BM_LoopbackLongWidget)->UseRealTime();
+
+// One payload shared by several printers' workers, as printToMany does.
+void BM_LoopbackFanOut(::benchmark::State &state) {
+  const int printers = static_cast<int>(state.range(0));
+  std::vector<std::unique_ptr<PrinterWorker>> workers;
+  for (int i = 0; i < printers; ++i) {
+    workers.push_back(std::make_unique<PrinterWorker>(
+        Loopback(),
+        std::make_shared<BufferPool>(0)));
+  }
+  const std::vector<uint8_t> raster = LongWidgetRaster();
+  Completions completions;
+  auto document = PrintTemplate::Create(raster, {});
+  int64_t queued = 0;
+  for (auto _ : state) {
+    for (auto &worker : workers) {
+      PrintJob job;
+      job.print_template = document;
+      job.on_complete = completions.Callback();
+      worker->Enqueue(std::move(job));
+    }
+    queued += printers;
+    completions.WaitFor(queued);
+  }
+  state.SetBytesProcessed(queued * static_cast<int64_t>(raster.size()));
+}
+BENCHMARK(BM_LoopbackFanOut)
+    ->ArgName("printers")
+    ->Arg(1)
+    ->Arg(4)
+    ->UseRealTime();
+
+// Arg: queue limit in KB. A producer faster than a 1 Mbaud line: what
+// share of tickets the queue turns away with BUSY, and the bytes that
+// still get through.
+void BM_LoopbackBackpressure(::benchmark::State &state) {
+  PrinterWorker worker(Loopback(1000000), std::make_shared<BufferPool>(0));
+  worker.SetMaxQueuedBytes(static_cast<size_t>(state.range(0)) << 10);
+  const std::vector<uint8_t> &receipt = TextReceipt();
+  Completions completions;
+  int64_t accepted = 0;
+  int64_t refused = 0;
+  for (auto _ : state) {
+    PrintJob job;
+    job.data = receipt;
+    job.on_complete = completions.Callback();
+    if (worker.Enqueue(std::move(job))) {
+      ++accepted;
+    } else {
+      ++refused;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(500));
+  }
+  completions.WaitFor(accepted);
+  state.counters["refused"] = ::benchmark::Counter(
+      static_cast<double>(refused) / (accepted + refused));
+  state.SetBytesProcessed(accepted * static_cast<int64_t>(receipt.size()));
+}
+BENCHMARK(BM_LoopbackBackpressure)
+    ->ArgName("limit_kb")
+    ->Arg(16)
+    ->Arg(256)
+    ->UseRealTime();
+
+}  // namespace bench
+}  // namespace flutter_thermal_printer
@@ -0,0 +1,162 @@
+#include "buffer_pool.h"
+
+#include <utility>
+
+namespace flutter_thermal_printer {
+
+namespace {
+
+// Index of the smallest slab holding |size| bytes.
+size_t SlabClassFor(size_t size) {
+  size_t index = 0;
+  for (size_t slab = BufferPool::kMinSlab; slab < size; slab <<= 1) {
+    ++index;
+  }
+  return index;
+}
+
+size_t SlabSize(size_t index) { return BufferPool::kMinSlab << index; }
+
+}  // namespace
+
+BufferPool::BufferPool(size_t max_retained_bytes)
+    : max_retained_bytes_(max_retained_bytes) {}
+
+std::vector<uint8_t> BufferPool::Acquire(size_t size) {
+  std::vector<uint8_t> buffer;
+  if (size > kMaxSlab) {
+    buffer.reserve(size);
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++misses_;
+    return buffer;
+  }
+  const size_t index = SlabClassFor(size);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Any idle slab at least as big will do; prefer the tightest fit.
+    for (size_t i = index; i < kSlabClasses; ++i) {
+      if (!free_[i].empty()) {
+        buffer = std::move(free_[i].back());
+        free_[i].pop_back();
+        retained_bytes_ -= buffer.capacity();
+        ++hits_;
+        return buffer;
+      }
+    }
+    ++misses_;
+  }
+  buffer.reserve(SlabSize(index));
+  return buffer;
+}
+
+void BufferPool::Release(std::vector<uint8_t> buffer) {
+  const size_t capacity = buffer.capacity();
+  if (capacity < kMinSlab || capacity > kMaxSlab * 2) {
+    return;
+  }
+  // File under the largest slab it can serve, so Acquire() never gets a
+  // buffer smaller than its class.
+  size_t index = SlabClassFor(capacity);
+  if (index >= kSlabClasses || SlabSize(index) > capacity) {
+    --index;
+  }
+  buffer.clear();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (retained_bytes_ + capacity > max_retained_bytes_) {
+    return;
+  }
+  retained_bytes_ += capacity;
+  free_[index].push_back(std::move(buffer));
+}
+
+size_t BufferPool::retained_bytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return retained_bytes_;
+}
+
+uint64_t BufferPool::hits() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hits_;
+}
+
+uint64_t BufferPool::misses() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return misses_;
+}
+
+PrinterBuffers& PrinterBuffers::Get() {
+  static PrinterBuffers* buffers = new PrinterBuffers();
+  return *buffers;
+}
+
+std::shared_ptr<BufferPool> PrinterBuffers::PoolFor(
+    const std::string &printer) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::shared_ptr<BufferPool> &pool = pools_[printer];
+  if (!pool) {
+    pool = std::make_shared<BufferPool>(kMaxRetainedPerPrinter);
+  }
+  return pool;
+}
+
+uint8_t* PrinterBuffers::Lease(const std::string &printer, size_t size,
+                               int64_t *lease) {
+  if (size == 0) {
+    return nullptr;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (leases_.size() >= kMaxLeases) {
+      return nullptr;
+    }
+  }
+  Leased leased;
+  leased.pool = PoolFor(printer);
+  leased.buffer = leased.pool->Acquire(size);
+  leased.buffer.resize(size);
+  uint8_t *data = leased.buffer.data();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (leases_.size() >= kMaxLeases) {
+    leased.pool->Release(std::move(leased.buffer));
+    return nullptr;
+  }
+  *lease = next_lease_++;
+  // The vector's heap block moves with it, so |data| stays valid.
+  leases_.emplace(*lease, std::move(leased));
+  return data;
+}
+
+bool PrinterBuffers::Take(int64_t lease, size_t length,
+                          std::vector<uint8_t> *out) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = leases_.find(lease);
+  if (it == leases_.end() || length > it->second.buffer.size()) {
+    return false;
+  }
+  *out = std::move(it->second.buffer);
+  out->resize(length);
+  leases_.erase(it);
+  return true;
+}
+
+void PrinterBuffers::Release(int64_t lease) {
+  Leased leased;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = leases_.find(lease);
+    if (it == leases_.end()) {
+      return;
+    }
+    leased = std::move(it->second);
+    leases_.erase(it);
+  }
+  leased.pool->Release(std::move(leased.buffer));
+}
+
+size_t PrinterBuffers::outstanding_leases() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return leases_.size();
+}
+
+}  // namespace flutter_thermal_printer
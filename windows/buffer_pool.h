@@ -0,0 +1,111 @@
+#ifndef FLUTTER_PLUGIN_BUFFER_POOL_H_
+#define FLUTTER_PLUGIN_BUFFER_POOL_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace flutter_thermal_printer {
+
+/// Recycles byte buffers between the code that fills print payloads (the
+/// channel codec, the rasterizer, Dart through a lease) and the worker that
+/// writes them, so a long-running app stops allocating a fresh heap block
+/// for every ticket.
+///
+/// Capacities are rounded up to power-of-two slabs from kMinSlab to
+/// kMaxSlab, which keeps the set of block sizes small and the heap from
+/// fragmenting. Larger requests are plain allocations that are never kept.
+/// At most |max_retained_bytes| sit idle in the pool. Thread-safe.
+class BufferPool {
+ public:
+  static constexpr size_t kMinSlab = 4u * 1024u;
+  static constexpr size_t kMaxSlab = 4u * 1024u * 1024u;
+
+  explicit BufferPool(size_t max_retained_bytes);
+
+  BufferPool(const BufferPool&) = delete;
+  BufferPool& operator=(const BufferPool&) = delete;
+
+  /// An empty buffer with capacity for at least |size| bytes.
+  std::vector<uint8_t> Acquire(size_t size);
+
+  /// Returns |buffer|'s storage to the pool. Callers may pass any buffer;
+  /// ones too small, too large or over budget are simply freed.
+  void Release(std::vector<uint8_t> buffer);
+
+  /// Bytes of capacity currently idle in the pool.
+  size_t retained_bytes() const;
+
+  /// Acquire() calls served from the pool / that had to allocate.
+  uint64_t hits() const;
+  uint64_t misses() const;
+
+ private:
+  static constexpr size_t kSlabClasses = 11;  // 4 KB .. 4 MB
+
+  const size_t max_retained_bytes_;
+
+  mutable std::mutex mutex_;
+  std::array<std::vector<std::vector<uint8_t>>, kSlabClasses> free_;
+  size_t retained_bytes_ = 0;
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+};
+
+/// Process-wide owner of every printer's BufferPool, and of the buffers
+/// leased to Dart through the C API so it can write a payload straight
+/// into native memory. Process-wide because the C exports carry no plugin
+/// instance. Thread-safe.
+class PrinterBuffers {
+ public:
+  /// Idle bytes each printer's pool may keep.
+  static constexpr size_t kMaxRetainedPerPrinter = 8u * 1024u * 1024u;
+
+  /// Leases outstanding at once; guards against Dart code that leases and
+  /// never submits or releases (e.g. across a hot restart).
+  static constexpr size_t kMaxLeases = 32;
+
+  static PrinterBuffers& Get();
+
+  PrinterBuffers() = default;
+  PrinterBuffers(const PrinterBuffers&) = delete;
+  PrinterBuffers& operator=(const PrinterBuffers&) = delete;
+
+  /// |printer|'s pool, created on first use and kept for the process.
+  std::shared_ptr<BufferPool> PoolFor(const std::string &printer);
+
+  /// Hands out |size| writable bytes from |printer|'s pool. The pointer
+  /// stays valid until the lease is taken or released. Returns nullptr
+  /// when |size| is 0 or kMaxLeases are outstanding.
+  uint8_t* Lease(const std::string &printer, size_t size, int64_t *lease);
+
+  /// Ends |lease|, moving its first |length| bytes into |out|. Fails for
+  /// an unknown lease or a |length| larger than what was leased; the lease
+  /// then stays outstanding unless it was unknown.
+  bool Take(int64_t lease, size_t length, std::vector<uint8_t> *out);
+
+  /// Ends |lease| and recycles its buffer. Unknown leases are ignored.
+  void Release(int64_t lease);
+
+  size_t outstanding_leases() const;
+
+ private:
+  struct Leased {
+    std::shared_ptr<BufferPool> pool;
+    std::vector<uint8_t> buffer;
+  };
+
+  mutable std::mutex mutex_;
+  std::map<std::string, std::shared_ptr<BufferPool>> pools_;
+  std::map<int64_t, Leased> leases_;
+  int64_t next_lease_ = 1;
+};
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_BUFFER_POOL_H_
@@ -0,0 +1,201 @@
+#include "code_pages.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+namespace flutter_thermal_printer {
+
+namespace {
+
+// Unicode for bytes 0x80-0xFF of each table; 0 where it has no character.
+constexpr char16_t kCp437[128] = {
+    0x00C7, 0x00FC, 0x00E9, 0x00E2, 0x00E4, 0x00E0, 0x00E5, 0x00E7,
+    0x00EA, 0x00EB, 0x00E8, 0x00EF, 0x00EE, 0x00EC, 0x00C4, 0x00C5,
+    0x00C9, 0x00E6, 0x00C6, 0x00F4, 0x00F6, 0x00F2, 0x00FB, 0x00F9,
+    0x00FF, 0x00D6, 0x00DC, 0x00A2, 0x00A3, 0x00A5, 0x20A7, 0x0192,
+    0x00E1, 0x00ED, 0x00F3, 0x00FA, 0x00F1, 0x00D1, 0x00AA, 0x00BA,
+    0x00BF, 0x2310, 0x00AC, 0x00BD, 0x00BC, 0x00A1, 0x00AB, 0x00BB,
+    0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x2561, 0x2562, 0x2556,
+    0x2555, 0x2563, 0x2551, 0x2557, 0x255D, 0x255C, 0x255B, 0x2510,
+    0x2514, 0x2534, 0x252C, 0x251C, 0x2500, 0x253C, 0x255E, 0x255F,
+    0x255A, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256C, 0x2567,
+    0x2568, 0x2564, 0x2565, 0x2559, 0x2558, 0x2552, 0x2553, 0x256B,
+    0x256A, 0x2518, 0x250C, 0x2588, 0x2584, 0x258C, 0x2590, 0x2580,
+    0x03B1, 0x00DF, 0x0393, 0x03C0, 0x03A3, 0x03C3, 0x00B5, 0x03C4,
+    0x03A6, 0x0398, 0x03A9, 0x03B4, 0x221E, 0x03C6, 0x03B5, 0x2229,
+    0x2261, 0x00B1, 0x2265, 0x2264, 0x2320, 0x2321, 0x00F7, 0x2248,
+    0x00B0, 0x2219, 0x00B7, 0x221A, 0x207F, 0x00B2, 0x25A0, 0x00A0,
+};
+
+constexpr char16_t kCp858[128] = {
+    0x00C7, 0x00FC, 0x00E9, 0x00E2, 0x00E4, 0x00E0, 0x00E5, 0x00E7,
+    0x00EA, 0x00EB, 0x00E8, 0x00EF, 0x00EE, 0x00EC, 0x00C4, 0x00C5,
+    0x00C9, 0x00E6, 0x00C6, 0x00F4, 0x00F6, 0x00F2, 0x00FB, 0x00F9,
+    0x00FF, 0x00D6, 0x00DC, 0x00F8, 0x00A3, 0x00D8, 0x00D7, 0x0192,
+    0x00E1, 0x00ED, 0x00F3, 0x00FA, 0x00F1, 0x00D1, 0x00AA, 0x00BA,
+    0x00BF, 0x00AE, 0x00AC, 0x00BD, 0x00BC, 0x00A1, 0x00AB, 0x00BB,
+    0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x00C1, 0x00C2, 0x00C0,
+    0x00A9, 0x2563, 0x2551, 0x2557, 0x255D, 0x00A2, 0x00A5, 0x2510,
+    0x2514, 0x2534, 0x252C, 0x251C, 0x2500, 0x253C, 0x00E3, 0x00C3,
+    0x255A, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256C, 0x00A4,
+    0x00F0, 0x00D0, 0x00CA, 0x00CB, 0x00C8, 0x20AC, 0x00CD, 0x00CE,
+    0x00CF, 0x2518, 0x250C, 0x2588, 0x2584, 0x00A6, 0x00CC, 0x2580,
+    0x00D3, 0x00DF, 0x00D4, 0x00D2, 0x00F5, 0x00D5, 0x00B5, 0x00FE,
+    0x00DE, 0x00DA, 0x00DB, 0x00D9, 0x00FD, 0x00DD, 0x00AF, 0x00B4,
+    0x00AD, 0x00B1, 0x2017, 0x00BE, 0x00B6, 0x00A7, 0x00F7, 0x00B8,
+    0x00B0, 0x00A8, 0x00B7, 0x00B9, 0x00B3, 0x00B2, 0x25A0, 0x00A0,
+};
+
+constexpr char16_t kCp864[128] = {
+    0x00B0, 0x00B7, 0x2219, 0x221A, 0x2592, 0x2500, 0x2502, 0x253C,
+    0x2524, 0x252C, 0x251C, 0x2534, 0x2510, 0x250C, 0x2514, 0x2518,
+    0x03B2, 0x221E, 0x03C6, 0x00B1, 0x00BD, 0x00BC, 0x2248, 0x00AB,
+    0x00BB, 0xFEF7, 0xFEF8, 0,      0,      0xFEFB, 0xFEFC, 0,
+    0x00A0, 0x00AD, 0xFE82, 0x00A3, 0x00A4, 0xFE84, 0,      0,
+    0xFE8E, 0xFE8F, 0xFE95, 0xFE99, 0x060C, 0xFE9D, 0xFEA1, 0xFEA5,
+    0x0660, 0x0661, 0x0662, 0x0663, 0x0664, 0x0665, 0x0666, 0x0667,
+    0x0668, 0x0669, 0xFED1, 0x061B, 0xFEB1, 0xFEB5, 0xFEB9, 0x061F,
+    0x00A2, 0xFE80, 0xFE81, 0xFE83, 0xFE85, 0xFECA, 0xFE8B, 0xFE8D,
+    0xFE91, 0xFE93, 0xFE97, 0xFE9B, 0xFE9F, 0xFEA3, 0xFEA7, 0xFEA9,
+    0xFEAB, 0xFEAD, 0xFEAF, 0xFEB3, 0xFEB7, 0xFEBB, 0xFEBF, 0xFEC1,
+    0xFEC5, 0xFECB, 0xFECF, 0x00A6, 0x00AC, 0x00F7, 0x00D7, 0xFEC9,
+    0x0640, 0xFED3, 0xFED7, 0xFEDB, 0xFEDF, 0xFEE3, 0xFEE7, 0xFEEB,
+    0xFEED, 0xFEEF, 0xFEF3, 0xFEBD, 0xFECC, 0xFECE, 0xFECD, 0xFEE1,
+    0xFE7D, 0x0651, 0xFEE5, 0xFEE9, 0xFEEC, 0xFEF0, 0xFEF2, 0xFED0,
+    0xFED5, 0xFEF5, 0xFEF6, 0xFEDD, 0xFED9, 0xFEF1, 0x25A0, 0,
+};
+
+// IS 13194:1991 assigns Devanagari from 0xA1; 0xD9 (INV) and 0xF0 (ATR)
+// are control codes with no character of their own.
+constexpr char16_t kIscii[128] = {
+    0,      0,      0,      0,      0,      0,      0,      0,
+    0,      0,      0,      0,      0,      0,      0,      0,
+    0,      0,      0,      0,      0,      0,      0,      0,
+    0,      0,      0,      0,      0,      0,      0,      0,
+    0,      0x0901, 0x0902, 0x0903, 0x0905, 0x0906, 0x0907, 0x0908,
+    0x0909, 0x090A, 0x090B, 0x090E, 0x090F, 0x0910, 0x090D, 0x0912,
+    0x0913, 0x0914, 0x0911, 0x0915, 0x0916, 0x0917, 0x0918, 0x0919,
+    0x091A, 0x091B, 0x091C, 0x091D, 0x091E, 0x091F, 0x0920, 0x0921,
+    0x0922, 0x0923, 0x0924, 0x0925, 0x0926, 0x0927, 0x0928, 0x0929,
+    0x092A, 0x092B, 0x092C, 0x092D, 0x092E, 0x092F, 0x095F, 0x0930,
+    0x0931, 0x0932, 0x0933, 0x0934, 0x0935, 0x0936, 0x0937, 0x0938,
+    0x0939, 0,      0x093E, 0x093F, 0x0940, 0x0941, 0x0942, 0x0943,
+    0x0946, 0x0947, 0x0948, 0x0945, 0x094A, 0x094B, 0x094C, 0x0949,
+    0x094D, 0x093C, 0x0964, 0,      0,      0,      0,      0,
+    0,      0x0966, 0x0967, 0x0968, 0x0969, 0x096A, 0x096B, 0x096C,
+    0x096D, 0x096E, 0x096F, 0,      0,      0,      0,      0,
+};
+
+// Isolated presentation form of each Arabic letter U+0621-U+064A, which
+// CP864 prints in place of the letter; 0 for code points between them.
+constexpr char16_t kArabicIsolated[] = {
+    0xFE80, 0xFE81, 0xFE83, 0xFE85, 0xFE87, 0xFE89, 0xFE8D, 0xFE8F,
+    0xFE93, 0xFE95, 0xFE99, 0xFE9D, 0xFEA1, 0xFEA5, 0xFEA9, 0xFEAB,
+    0xFEAD, 0xFEAF, 0xFEB1, 0xFEB5, 0xFEB9, 0xFEBD, 0xFEC1, 0xFEC5,
+    0xFEC9, 0xFECD, 0,      0,      0,      0,      0,      0x0640,
+    0xFED1, 0xFED5, 0xFED9, 0xFEDD, 0xFEE1, 0xFEE5, 0xFEE9, 0xFEED,
+    0xFEEF, 0xFEF1,
+};
+constexpr char32_t kArabicFirst = 0x0621;
+constexpr char32_t kArabicLast = 0x064A;
+static_assert(sizeof(kArabicIsolated) / sizeof(kArabicIsolated[0]) ==
+                  kArabicLast - kArabicFirst + 1,
+              "one entry per code point");
+
+struct Mapping {
+  char16_t code_point;
+  uint8_t byte;
+};
+using ReverseTable = std::array<Mapping, 128>;
+
+// Sorts a table by code point at compile time, so encoding is a binary
+// search instead of a scan of all 128 entries.
+constexpr ReverseTable Reverse(const char16_t (&high)[128]) {
+  ReverseTable table = {};
+  for (size_t i = 0; i < 128; ++i) {
+    const Mapping entry = {high[i], static_cast<uint8_t>(0x80 + i)};
+    size_t j = i;
+    for (; j > 0 && table[j - 1].code_point > entry.code_point; --j) {
+      table[j] = table[j - 1];
+    }
+    table[j] = entry;
+  }
+  return table;
+}
+
+constexpr ReverseTable kCp437Reverse = Reverse(kCp437);
+constexpr ReverseTable kCp858Reverse = Reverse(kCp858);
+constexpr ReverseTable kCp864Reverse = Reverse(kCp864);
+constexpr ReverseTable kIsciiReverse = Reverse(kIscii);
+static_assert(kCp437Reverse[0].code_point == 0x00A0 &&
+                  kCp437Reverse[127].code_point == 0x25A0,
+              "tables are sorted at compile time");
+
+const ReverseTable &TableFor(CodePage page) {
+  switch (page) {
+    case CodePage::kCp858:
+      return kCp858Reverse;
+    case CodePage::kCp864:
+      return kCp864Reverse;
+    case CodePage::kIscii:
+      return kIsciiReverse;
+    case CodePage::kCp437:
+      break;
+  }
+  return kCp437Reverse;
+}
+
+}  // namespace
+
+bool CodePageFromName(const std::string &name, CodePage *page) {
+  if (name == "cp437") {
+    *page = CodePage::kCp437;
+  } else if (name == "cp858") {
+    *page = CodePage::kCp858;
+  } else if (name == "cp864") {
+    *page = CodePage::kCp864;
+  } else if (name == "iscii") {
+    *page = CodePage::kIscii;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+int DefaultCodePageId(CodePage page) {
+  switch (page) {
+    case CodePage::kCp437:
+      return 0;
+    case CodePage::kCp858:
+      return 19;
+    case CodePage::kCp864:
+      return 38;
+    case CodePage::kIscii:
+      break;
+  }
+  return -1;
+}
+
+uint8_t EncodeCodePoint(CodePage page, char32_t code_point) {
+  if (code_point < 0x80) {
+    return static_cast<uint8_t>(code_point);
+  }
+  if (page == CodePage::kCp864 && code_point >= kArabicFirst &&
+      code_point <= kArabicLast &&
+      kArabicIsolated[code_point - kArabicFirst] != 0) {
+    code_point = kArabicIsolated[code_point - kArabicFirst];
+  }
+  if (code_point > 0xFFFF) {
+    return '?';
+  }
+  const ReverseTable &table = TableFor(page);
+  const auto it = std::lower_bound(
+      table.begin(), table.end(), code_point,
+      [](const Mapping &entry, char32_t value) {
+        return entry.code_point < value;
+      });
+  return it != table.end() && it->code_point == code_point ? it->byte : '?';
+}
+
+}  // namespace flutter_thermal_printer
@@ -0,0 +1,31 @@
+#ifndef FLUTTER_PLUGIN_CODE_PAGES_H_
+#define FLUTTER_PLUGIN_CODE_PAGES_H_
+
+#include <cstdint>
+#include <string>
+
+namespace flutter_thermal_printer {
+
+/// Single-byte character tables the text encoder can target. Bytes below
+/// 0x80 are ASCII on all of them.
+enum class CodePage {
+  kCp437,  // US / box drawing; every printer's power-on default.
+  kCp858,  // Western European, CP850 with the euro sign.
+  kCp864,  // Arabic, in presentation forms.
+  kIscii,  // Devanagari, IS 13194.
+};
+
+/// Parses the channel names `cp437`, `cp858`, `cp864` and `iscii`.
+bool CodePageFromName(const std::string &name, CodePage *page);
+
+/// The `ESC t` table number for |page| on Epson-compatible printers, or -1
+/// if there is no common one (ISCII), so the printer's own default applies.
+int DefaultCodePageId(CodePage page);
+
+/// The byte |code_point| prints as on |page|, or '?' when the table has no
+/// such character. Arabic letters are printed in their isolated form.
+uint8_t EncodeCodePoint(CodePage page, char32_t code_point);
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_CODE_PAGES_H_
@@ -0,0 +1,67 @@
+#include "document_stream.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace flutter_thermal_printer {
+
+DocumentStream::DocumentStream(size_t max_chunks)
+    : max_chunks_(std::max<size_t>(max_chunks, 1)) {}
+
+bool DocumentStream::Push(std::vector<uint8_t> chunk) {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    writable_.wait(lock,
+                   [this] { return aborted_ || chunks_.size() < max_chunks_; });
+    if (aborted_ || finished_) {
+      return false;
+    }
+    chunks_.push_back(std::move(chunk));
+  }
+  readable_.notify_one();
+  return true;
+}
+
+void DocumentStream::Finish(bool complete) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (finished_) {
+      return;
+    }
+    finished_ = true;
+    complete_ = complete;
+  }
+  readable_.notify_all();
+}
+
+bool DocumentStream::Pop(std::vector<uint8_t> *chunk) {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    readable_.wait(lock,
+                   [this] { return aborted_ || finished_ || !chunks_.empty(); });
+    if (aborted_ || chunks_.empty()) {
+      return false;
+    }
+    *chunk = std::move(chunks_.front());
+    chunks_.pop_front();
+  }
+  writable_.notify_one();
+  return true;
+}
+
+void DocumentStream::Abort() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    aborted_ = true;
+    chunks_.clear();
+  }
+  writable_.notify_all();
+  readable_.notify_all();
+}
+
+bool DocumentStream::complete() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return finished_ && complete_ && !aborted_ && chunks_.empty();
+}
+
+}  // namespace flutter_thermal_printer
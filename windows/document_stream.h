@@ -0,0 +1,57 @@
+#ifndef FLUTTER_PLUGIN_DOCUMENT_STREAM_H_
+#define FLUTTER_PLUGIN_DOCUMENT_STREAM_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace flutter_thermal_printer {
+
+/// Bounded hand-off of one document's bytes from the thread producing them
+/// (e.g. the rasterizer) to the print worker writing them. At most
+/// |max_chunks| are buffered, so memory grows with chunk size rather than
+/// document size. One producer, one consumer.
+class DocumentStream {
+ public:
+  explicit DocumentStream(size_t max_chunks);
+
+  DocumentStream(const DocumentStream&) = delete;
+  DocumentStream& operator=(const DocumentStream&) = delete;
+
+  /// Producer: queues |chunk|, blocking while the buffer is full. Returns
+  /// false (dropping the chunk) once the consumer has aborted.
+  bool Push(std::vector<uint8_t> chunk);
+
+  /// Producer: no more chunks. |complete| false means the document was cut
+  /// short and should not be printed.
+  void Finish(bool complete);
+
+  /// Consumer: waits for the next chunk. Returns false when the producer
+  /// has finished and everything queued was taken, or after Abort().
+  bool Pop(std::vector<uint8_t> *chunk);
+
+  /// Consumer: stops the producer and discards anything still queued.
+  void Abort();
+
+  /// After Pop() returned false: whether every chunk of a complete
+  /// document was delivered.
+  bool complete() const;
+
+ private:
+  const size_t max_chunks_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable readable_;
+  std::condition_variable writable_;
+  std::deque<std::vector<uint8_t>> chunks_;
+  bool finished_ = false;
+  bool complete_ = false;
+  bool aborted_ = false;
+};
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_DOCUMENT_STREAM_H_
@@ -3,47 +3,678 @@
 #include <windows.h>
 #include <VersionHelpers.h>
 
+#include <flutter/event_channel.h>
+#include <flutter/event_stream_handler_functions.h>
 #include <flutter/method_channel.h>
+#include <flutter/method_result_functions.h>
 #include <flutter/plugin_registrar_windows.h>
 #include <flutter/standard_method_codec.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <sstream>
+#include <utility>
+#include <vector>
+
+#include "buffer_pool.h"
+#include "loopback_printer.h"
+#include "payload_codec.h"
+#include "perf_counter.h"
+#include "raster_engine.h"
+#include "raster_kernels.h"
+#include "spooler_printer.h"
+#include "string_utils.h"
+#include "text_encoder.h"
+#include "usb_printer.h"
+#include "wic_image_decoder.h"
 
 namespace flutter_thermal_printer {
 
+namespace {
+
+using flutter::EncodableMap;
+using flutter::EncodableValue;
+
+const std::string* GetStringArg(const EncodableMap &args, const char *key) {
+  auto it = args.find(EncodableValue(key));
+  if (it == args.end()) {
+    return nullptr;
+  }
+  return std::get_if<std::string>(&it->second);
+}
+
+int64_t GetIntArg(const EncodableMap &args, const char *key,
+                  int64_t fallback) {
+  auto it = args.find(EncodableValue(key));
+  if (it == args.end()) {
+    return fallback;
+  }
+  if (const auto *value = std::get_if<int32_t>(&it->second)) {
+    return *value;
+  }
+  if (const auto *value = std::get_if<int64_t>(&it->second)) {
+    return *value;
+  }
+  return fallback;
+}
+
+bool GetBoolArg(const EncodableMap &args, const char *key,
+                bool fallback = false) {
+  auto it = args.find(EncodableValue(key));
+  if (it == args.end()) {
+    return fallback;
+  }
+  const auto *value = std::get_if<bool>(&it->second);
+  return value != nullptr ? *value : fallback;
+}
+
+// Windows printers are enumerated by queue name, which Dart sends as
+// `name`, `address` or `vendorId` depending on the call site.
+std::string PrinterNameFromArgs(const EncodableMap &args) {
+  for (const char *key : {"name", "address", "vendorId"}) {
+    const std::string *value = GetStringArg(args, key);
+    if (value != nullptr && !value->empty()) {
+      return *value;
+    }
+  }
+  return std::string();
+}
+
+// Widest `scaleWidth` accepted; the widest receipt printers have 832 dots.
+constexpr int64_t kMaxScaleWidth = 4096;
+
+// Image arguments shared by `convertimage` and `printImage`.
+struct ImageRequest {
+  int width = 0;
+  int height = 0;
+  RasterOptions options;
+};
+
+bool ReadRasterOptions(const EncodableMap &args, RasterOptions *options) {
+  const int64_t dither = GetIntArg(args, "dither", 0);
+  const int64_t threshold = GetIntArg(args, "threshold", 128);
+  const int64_t band_rows = GetIntArg(args, "bandRows", 0);
+  const int64_t scale_width = GetIntArg(args, "scaleWidth", 0);
+  if (dither < 0 || dither > static_cast<int64_t>(DitherMode::kOrdered) ||
+      threshold < 0 || threshold > 255 || band_rows < 0 ||
+      band_rows > INT32_MAX || scale_width < 0 ||
+      scale_width > kMaxScaleWidth) {
+    return false;
+  }
+  options->dither = static_cast<DitherMode>(dither);
+  options->threshold = static_cast<uint8_t>(threshold);
+  options->band_rows = static_cast<int>(band_rows);
+  options->scale_width = static_cast<int>(scale_width);
+  options->feed_blank_rows = GetBoolArg(args, "feedBlankRows");
+  return true;
+}
+
+bool ReadImageRequest(const EncodableMap &args, ImageRequest *request) {
+  const int64_t width = GetIntArg(args, "width", 0);
+  const int64_t height = GetIntArg(args, "height", 0);
+  if (width <= 0 || height <= 0 || width > INT32_MAX || height > INT32_MAX) {
+    return false;
+  }
+  request->width = static_cast<int>(width);
+  request->height = static_cast<int>(height);
+  return ReadRasterOptions(args, &request->options);
+}
+
+// `convertimage` and `printImage` take raw RGBA `pixels` with their size,
+// or an `encoded` image (the PNG of a widget capture) that is decoded
+// natively, a band of rows at a time.
+bool ReadImageArgs(const EncodableMap &args, std::vector<uint8_t> *image,
+                   bool *encoded, ImageRequest *request) {
+  *encoded = ReadPayload(args, "encoded", image);
+  if (*encoded) {
+    return !image->empty() && ReadRasterOptions(args, &request->options);
+  }
+  return ReadPayload(args, "pixels", image) &&
+         ReadImageRequest(args, request) &&
+         image->size() == static_cast<size_t>(request->width) *
+                              static_cast<size_t>(request->height) * 4;
+}
+
+// Opens |image| for conversion: a decoder for encoded bytes (filling in
+// the size), or the buffer itself. COM must be initialized for the former.
+bool OpenRowSource(const std::vector<uint8_t> &image, bool encoded,
+                   ImageRequest *request,
+                   std::unique_ptr<WicImageDecoder> *decoder,
+                   RgbaRowSource *source) {
+  if (encoded) {
+    if (FAILED(WicImageDecoder::Open(image.data(), image.size(), decoder))) {
+      return false;
+    }
+    WicImageDecoder *rows = decoder->get();
+    request->width = rows->width();
+    request->height = rows->height();
+    *source = [rows](int first_row, int count) {
+      return rows->ReadRows(first_row, count);
+    };
+    return true;
+  }
+  const size_t stride = static_cast<size_t>(request->width) * 4;
+  const uint8_t *pixels = image.data();
+  *source = [pixels, stride](int first_row, int) {
+    return pixels + stride * first_row;
+  };
+  return true;
+}
+
+// Producer side of `printImage`: pushes |key|'s raster from |cache| as one
+// chunk, or converts it band by band from |source|, keeping a copy for
+// next time unless it is too big for the cache to hold anyway.
+bool StreamRaster(const RasterCache::Key &key, const RgbaRowSource &source,
+                  const ImageRequest &request, RasterCache *cache,
+                  BufferPool *buffers, DocumentStream *stream,
+                  JobTrace *trace) {
+  // Only conversion counts as raster time, not waiting on a full stream.
+  int64_t mark = PerfCounterNow();
+  if (RasterCache::Raster cached = cache->Find(key)) {
+    std::vector<uint8_t> raster = buffers->Acquire(cached->size());
+    raster.assign(cached->begin(), cached->end());
+    trace->raster_ticks.fetch_add(PerfCounterNow() - mark,
+                                  std::memory_order_relaxed);
+    return stream->Push(std::move(raster));
+  }
+  int out_width = 0;
+  int out_height = 0;
+  RasterOutputSize(request.width, request.height, request.options,
+                   &out_width, &out_height);
+  const size_t raster_rows_bytes = static_cast<size_t>((out_width + 7) / 8) *
+                                   static_cast<size_t>(out_height);
+  std::shared_ptr<std::vector<uint8_t>> copy;
+  if (raster_rows_bytes < cache->max_entry_bytes()) {
+    copy = std::make_shared<std::vector<uint8_t>>();
+  }
+  const bool ok = RasterizeRgbaRowBands(
+      source, request.width, request.height, request.options,
+      [&](std::vector<uint8_t> band) {
+        if (copy) {
+          copy->insert(copy->end(), band.begin(), band.end());
+        }
+        trace->raster_ticks.fetch_add(PerfCounterNow() - mark,
+                                      std::memory_order_relaxed);
+        const bool pushed = stream->Push(std::move(band));
+        mark = PerfCounterNow();
+        return pushed;
+      },
+      buffers);
+  if (ok && copy) {
+    cache->Insert(key, std::move(copy));
+  }
+  return ok;
+}
+
+// Bands buffered between a stream producer and the print worker.
+constexpr size_t kMaxQueuedBands = 4;
+
+// Bounds for `setTransport`'s USB write window; each slot owns one chunk.
+constexpr int64_t kMaxUsbChunkSize = 1 << 20;
+constexpr int64_t kMaxUsbInFlight = 16;
+
+// Raw TCP printers listen here unless `setTransport` names another port.
+constexpr int64_t kDefaultTcpPort = 9100;
+constexpr int64_t kMaxTcpConnectTimeoutMs = 60000;
+
+// Bounds for the `loopback` transport's simulated line.
+constexpr int64_t kMaxLoopbackBaudRate = 100000000;
+constexpr int64_t kMaxLoopbackLatencyMs = 10000;
+
+// Longest `setBatchWindow` delay; each unbatched write may wait this long.
+constexpr int64_t kMaxBatchWindowMs = 1000;
+
+// `priority` is clamped to this range; higher prints first.
+constexpr int64_t kMaxJobPriority = 100;
+
+// Largest `setQueueLimit`; zero lifts the limit instead.
+constexpr int64_t kMaxQueueLimitBytes = int64_t{1} << 32;
+
+int JobPriority(const EncodableMap &args) {
+  return static_cast<int>(std::clamp<int64_t>(GetIntArg(args, "priority", 0),
+                                              -kMaxJobPriority,
+                                              kMaxJobPriority));
+}
+
+// Most printers one `printToMany` call may fan out to.
+constexpr size_t kMaxFanOutPrinters = 32;
+
+// Most printers one `warmUp` call may prepare.
+constexpr size_t kMaxWarmUpPrinters = 32;
+
+// `warmUp` leaves one buffer of every slab class up to this size in each
+// printer's pool: enough for text receipts and logos.
+constexpr size_t kWarmUpMaxSlab = 64u * 1024u;
+
+// Reads the optional `printers` list into |names|, without repeats. Fails
+// unless every entry is a non-empty string.
+bool ReadPrinterNames(const EncodableMap &args,
+                      std::vector<std::string> *names) {
+  auto it = args.find(EncodableValue("printers"));
+  if (it == args.end() || it->second.IsNull()) {
+    return true;
+  }
+  const auto *list = std::get_if<flutter::EncodableList>(&it->second);
+  if (list == nullptr) {
+    return false;
+  }
+  for (const EncodableValue &value : *list) {
+    const auto *name = std::get_if<std::string>(&value);
+    if (name == nullptr || name->empty()) {
+      return false;
+    }
+    if (std::find(names->begin(), names->end(), *name) == names->end()) {
+      names->push_back(*name);
+    }
+  }
+  return true;
+}
+
+double MsSince(int64_t start) {
+  return static_cast<double>(PerfCounterNow() - start) * 1000.0 /
+         static_cast<double>(PerfCounterFrequency());
+}
+
+// Bounds for `encodeText`. A line wider than 255 characters is no
+// receipt printer's.
+constexpr int64_t kDefaultCharsPerLine = 48;
+constexpr int64_t kMinCharsPerLine = 8;
+constexpr int64_t kMaxCharsPerLine = 255;
+constexpr size_t kMaxTextRows = 4096;
+constexpr size_t kMaxTextColumns = 8;
+constexpr int64_t kMaxColumnFlex = 64;
+
+bool ReadTextAlign(const EncodableMap &args, TextAlign *align) {
+  const int64_t value = GetIntArg(args, "align", 0);
+  if (value < 0 || value > static_cast<int64_t>(TextAlign::kRight)) {
+    return false;
+  }
+  *align = static_cast<TextAlign>(value);
+  return true;
+}
+
+bool ReadTextStyle(const EncodableMap &args, TextStyle *style) {
+  const int64_t width = GetIntArg(args, "width", 1);
+  const int64_t height = GetIntArg(args, "height", 1);
+  if (!ReadTextAlign(args, &style->align) || width < 1 ||
+      width > kMaxTextScale || height < 1 || height > kMaxTextScale) {
+    return false;
+  }
+  style->bold = GetBoolArg(args, "bold");
+  style->underline = GetBoolArg(args, "underline");
+  style->invert = GetBoolArg(args, "invert");
+  style->width = static_cast<int>(width);
+  style->height = static_cast<int>(height);
+  return true;
+}
+
+bool ReadTextColumns(const EncodableValue &value,
+                     std::vector<TextColumn> *columns) {
+  const auto *list = std::get_if<flutter::EncodableList>(&value);
+  if (list == nullptr || list->empty() || list->size() > kMaxTextColumns) {
+    return false;
+  }
+  columns->reserve(list->size());
+  for (const EncodableValue &entry : *list) {
+    const auto *cell = std::get_if<EncodableMap>(&entry);
+    const std::string *text =
+        cell != nullptr ? GetStringArg(*cell, "text") : nullptr;
+    TextColumn column;
+    const int64_t flex = text != nullptr ? GetIntArg(*cell, "flex", 1) : 0;
+    if (text == nullptr || flex < 1 || flex > kMaxColumnFlex ||
+        !ReadTextAlign(*cell, &column.align)) {
+      return false;
+    }
+    column.text = *text;
+    column.flex = static_cast<int>(flex);
+    columns->push_back(std::move(column));
+  }
+  return true;
+}
+
+// Adds one `encodeText` row: a map with `text`, `columns`, a one-character
+// `rule`, a `feed` line count or `cut`, plus the style keys.
+bool AddTextRow(const EncodableValue &value, TextEncoder *encoder) {
+  const auto *row = std::get_if<EncodableMap>(&value);
+  TextStyle style;
+  if (row == nullptr || !ReadTextStyle(*row, &style)) {
+    return false;
+  }
+  if (const std::string *text = GetStringArg(*row, "text")) {
+    encoder->Text(*text, style);
+    return true;
+  }
+  auto columns_arg = row->find(EncodableValue("columns"));
+  if (columns_arg != row->end()) {
+    std::vector<TextColumn> columns;
+    if (!ReadTextColumns(columns_arg->second, &columns)) {
+      return false;
+    }
+    encoder->Columns(columns, style);
+    return true;
+  }
+  if (const std::string *rule = GetStringArg(*row, "rule")) {
+    const std::u32string character = DecodeUtf8(*rule);
+    if (character.size() != 1) {
+      return false;
+    }
+    encoder->Rule(character[0], style);
+    return true;
+  }
+  const int64_t feed = GetIntArg(*row, "feed", -1);
+  if (feed >= 0 && feed <= 255) {
+    encoder->Feed(static_cast<int>(feed));
+    return true;
+  }
+  if (GetBoolArg(*row, "cut")) {
+    encoder->Cut(GetBoolArg(*row, "partial"));
+    return true;
+  }
+  return false;
+}
+
+// The raster queue thread joins in too, so this means up to 4 cores.
+constexpr size_t kMaxRasterHelperThreads = 3;
+
+EncodableValue EncodePrinter(const PrinterInfo &printer) {
+  return EncodableValue(EncodableMap{
+      {EncodableValue("name"), EncodableValue(printer.name)},
+      {EncodableValue("port"), EncodableValue(printer.port)},
+      {EncodableValue("driver"), EncodableValue(printer.driver)},
+      {EncodableValue("status"),
+       EncodableValue(static_cast<int64_t>(printer.status))},
+      {EncodableValue("attributes"),
+       EncodableValue(static_cast<int64_t>(printer.attributes))},
+      {EncodableValue("offline"), EncodableValue(printer.offline())},
+      {EncodableValue("rawUsb"), EncodableValue(printer.raw_usb())},
+  });
+}
+
+flutter::EncodableList EncodePrinters(const std::vector<PrinterInfo> &printers) {
+  flutter::EncodableList list;
+  list.reserve(printers.size());
+  for (const PrinterInfo &printer : printers) {
+    list.push_back(EncodePrinter(printer));
+  }
+  return list;
+}
+
+EncodableValue EncodePercentiles(const Percentiles &percentiles) {
+  return EncodableValue(EncodableMap{
+      {EncodableValue("p50"), EncodableValue(percentiles.p50)},
+      {EncodableValue("p95"), EncodableValue(percentiles.p95)},
+      {EncodableValue("p99"), EncodableValue(percentiles.p99)},
+  });
+}
+
+EncodableValue EncodeJobStageTimes(const JobStageTimes &times) {
+  return EncodableValue(EncodableMap{
+      {EncodableValue("jobId"), EncodableValue(times.job_id)},
+      {EncodableValue("printer"), EncodableValue(times.printer)},
+      {EncodableValue("bytes"),
+       EncodableValue(static_cast<int64_t>(times.bytes))},
+      {EncodableValue("success"), EncodableValue(times.success)},
+      {EncodableValue("queueMs"), EncodableValue(times.queue_ms)},
+      {EncodableValue("rasterMs"), EncodableValue(times.raster_ms)},
+      {EncodableValue("spoolMs"), EncodableValue(times.spool_ms)},
+      {EncodableValue("totalMs"), EncodableValue(times.total_ms)},
+  });
+}
+
+EncodableValue EncodePrinterJobSummary(const PrinterJobSummary &summary) {
+  return EncodableValue(EncodableMap{
+      {EncodableValue("jobs"), EncodableValue(static_cast<int64_t>(summary.jobs))},
+      {EncodableValue("failures"),
+       EncodableValue(static_cast<int64_t>(summary.failures))},
+      {EncodableValue("bytes"),
+       EncodableValue(static_cast<int64_t>(summary.bytes))},
+      {EncodableValue("queueMs"), EncodePercentiles(summary.queue_ms)},
+      {EncodableValue("rasterMs"), EncodePercentiles(summary.raster_ms)},
+      {EncodableValue("spoolMs"), EncodePercentiles(summary.spool_ms)},
+      {EncodableValue("totalMs"), EncodePercentiles(summary.total_ms)},
+  });
+}
+
+EncodableValue EncodePrinterStatus(DWORD error, const PrinterStatus &status) {
+  int64_t age_ms = -1;
+  if (status.known) {
+    age_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                 std::chrono::steady_clock::now() - status.updated)
+                 .count();
+  }
+  return EncodableValue(EncodableMap{
+      {EncodableValue("supported"),
+       EncodableValue(error != ERROR_NOT_SUPPORTED)},
+      {EncodableValue("known"), EncodableValue(status.known)},
+      {EncodableValue("online"), EncodableValue(status.online)},
+      {EncodableValue("coverOpen"), EncodableValue(status.cover_open)},
+      {EncodableValue("paperOut"), EncodableValue(status.paper_out)},
+      {EncodableValue("paperNearEnd"), EncodableValue(status.paper_near_end)},
+      {EncodableValue("error"), EncodableValue(status.error)},
+      {EncodableValue("ageMs"), EncodableValue(age_ms)},
+  });
+}
+
+EncodableValue EncodePrinterChanges(const PrinterChanges &changes) {
+  flutter::EncodableList removed;
+  for (const std::string &name : changes.removed) {
+    removed.push_back(EncodableValue(name));
+  }
+  return EncodableValue(EncodableMap{
+      {EncodableValue("added"), EncodableValue(EncodePrinters(changes.added))},
+      {EncodableValue("changed"),
+       EncodableValue(EncodePrinters(changes.changed))},
+      {EncodableValue("removed"), EncodableValue(removed)},
+  });
+}
+
+std::string Win32ErrorMessage(const char *what, DWORD error) {
+  std::ostringstream message;
+  message << what << " failed (Win32 error " << error << ").";
+  return message.str();
+}
+
+// Answers a call that came in through HandleMessage(). The envelope is
+// encoded on whichever thread sets the result; only handing it to the
+// messenger waits for the platform thread.
+class EnvelopeResult : public flutter::MethodResult<EncodableValue> {
+ public:
+  EnvelopeResult(flutter::BinaryReply reply, PlatformTaskRunner *runner)
+      : reply_(std::move(reply)), runner_(runner) {}
+
+ protected:
+  void SuccessInternal(const EncodableValue *result) override {
+    Send(flutter::StandardMethodCodec::GetInstance().EncodeSuccessEnvelope(
+        result));
+  }
+
+  void ErrorInternal(const std::string &code, const std::string &message,
+                     const EncodableValue *details) override {
+    Send(flutter::StandardMethodCodec::GetInstance().EncodeErrorEnvelope(
+        code, message, details));
+  }
+
+  // An empty reply is how the channel says "not implemented".
+  void NotImplementedInternal() override { Send(nullptr); }
+
+ private:
+  void Send(std::unique_ptr<std::vector<uint8_t>> envelope) {
+    std::shared_ptr<std::vector<uint8_t>> bytes = std::move(envelope);
+    runner_->PostTask([reply = std::move(reply_), bytes]() {
+      reply(bytes ? bytes->data() : nullptr, bytes ? bytes->size() : 0);
+    });
+  }
+
+  flutter::BinaryReply reply_;
+  PlatformTaskRunner *runner_;
+};
+
+}  // namespace
+
 // --- Registration: ONLY register. No BLE, WinRT, COM, threads, or globals. ---
 void FlutterThermalPrinterPlugin::RegisterWithRegistrar(
     flutter::PluginRegistrarWindows *registrar) {
-  auto channel =
-      std::make_unique<flutter::MethodChannel<flutter::EncodableValue>>(
-          registrar->messenger(), "flutter_thermal_printer",
+  auto job_channel =
+      std::make_unique<flutter::EventChannel<flutter::EncodableValue>>(
+          registrar->messenger(), "flutter_thermal_printer/jobs",
+          &flutter::StandardMethodCodec::GetInstance());
+  auto stats_channel =
+      std::make_unique<flutter::EventChannel<flutter::EncodableValue>>(
+          registrar->messenger(), "flutter_thermal_printer/stats",
+          &flutter::StandardMethodCodec::GetInstance());
+  auto printer_channel =
+      std::make_unique<flutter::EventChannel<flutter::EncodableValue>>(
+          registrar->messenger(), "flutter_thermal_printer/printers",
           &flutter::StandardMethodCodec::GetInstance());
 
   auto plugin = std::make_unique<FlutterThermalPrinterPlugin>();
 
-  channel->SetMethodCallHandler(
-      [plugin_ptr = plugin.get()](const auto &call, auto result) {
-        if (!plugin_ptr->is_alive()) {
-          result->Error("DISPOSED", "Plugin disposed.");
-          return;
-        }
-        plugin_ptr->HandleMethodCall(call, std::move(result));
+  // A raw handler rather than SetMethodCallHandler(), which would decode
+  // every call on the platform thread before the plugin sees it.
+  registrar->messenger()->SetMessageHandler(
+      "flutter_thermal_printer",
+      [plugin_ptr = plugin.get()](const uint8_t *message, size_t message_size,
+                                  flutter::BinaryReply reply) {
+        plugin_ptr->HandleMessage(message, message_size, std::move(reply));
       });
 
+  job_channel->SetStreamHandler(
+      std::make_unique<flutter::StreamHandlerFunctions<flutter::EncodableValue>>(
+          [plugin_ptr = plugin.get()](const flutter::EncodableValue *arguments,
+                                      std::unique_ptr<flutter::EventSink<
+                                          flutter::EncodableValue>> &&events)
+              -> std::unique_ptr<
+                  flutter::StreamHandlerError<flutter::EncodableValue>> {
+            if (plugin_ptr->is_alive()) {
+              plugin_ptr->job_events_ = std::move(events);
+            }
+            return nullptr;
+          },
+          [plugin_ptr = plugin.get()](const flutter::EncodableValue *arguments)
+              -> std::unique_ptr<
+                  flutter::StreamHandlerError<flutter::EncodableValue>> {
+            if (plugin_ptr->is_alive()) {
+              plugin_ptr->job_events_.reset();
+            }
+            return nullptr;
+          }));
+
+  stats_channel->SetStreamHandler(
+      std::make_unique<flutter::StreamHandlerFunctions<flutter::EncodableValue>>(
+          [plugin_ptr = plugin.get()](const flutter::EncodableValue *arguments,
+                                      std::unique_ptr<flutter::EventSink<
+                                          flutter::EncodableValue>> &&events)
+              -> std::unique_ptr<
+                  flutter::StreamHandlerError<flutter::EncodableValue>> {
+            if (plugin_ptr->is_alive()) {
+              plugin_ptr->stats_events_ = std::move(events);
+            }
+            return nullptr;
+          },
+          [plugin_ptr = plugin.get()](const flutter::EncodableValue *arguments)
+              -> std::unique_ptr<
+                  flutter::StreamHandlerError<flutter::EncodableValue>> {
+            if (plugin_ptr->is_alive()) {
+              plugin_ptr->stats_events_.reset();
+            }
+            return nullptr;
+          }));
+
+  printer_channel->SetStreamHandler(
+      std::make_unique<flutter::StreamHandlerFunctions<flutter::EncodableValue>>(
+          [plugin_ptr = plugin.get()](const flutter::EncodableValue *arguments,
+                                      std::unique_ptr<flutter::EventSink<
+                                          flutter::EncodableValue>> &&events)
+              -> std::unique_ptr<
+                  flutter::StreamHandlerError<flutter::EncodableValue>> {
+            if (plugin_ptr->is_alive()) {
+              plugin_ptr->StartPrinterEvents(std::move(events));
+            }
+            return nullptr;
+          },
+          [plugin_ptr = plugin.get()](const flutter::EncodableValue *arguments)
+              -> std::unique_ptr<
+                  flutter::StreamHandlerError<flutter::EncodableValue>> {
+            if (plugin_ptr->is_alive()) {
+              plugin_ptr->StopPrinterEvents();
+            }
+            return nullptr;
+          }));
+
   registrar->AddPlugin(std::move(plugin));
 }
 
 // Constructor must do NOTHING. No WinRT, COM, BLE, or threads.
 FlutterThermalPrinterPlugin::FlutterThermalPrinterPlugin() {}
 
-// Full cleanup: mark dead first so no callback touches us; no watchers/threads here.
+// Full cleanup: mark dead first so no callback touches us, then join the
+// print workers before the task runner their completions post to.
 FlutterThermalPrinterPlugin::~FlutterThermalPrinterPlugin() {
   alive_.store(false, std::memory_order_release);
+  job_events_.reset();
+  stats_events_.reset();
+  printer_watcher_.reset();
+  printer_events_.reset();
+  workers_.clear();
+  message_queue_.reset();
+  raster_queue_.reset();
+  raster_pool_.reset();
+  task_runner_.reset();
 }
 
 void FlutterThermalPrinterPlugin::EnsureInitialized() {
-  // This plugin has no native BLE/WinRT; nothing to lazy-init.
+  if (!task_runner_) {
+    task_runner_ = std::make_unique<PlatformTaskRunner>();
+  }
+}
+
+void FlutterThermalPrinterPlugin::HandleMessage(const uint8_t *message,
+                                                size_t message_size,
+                                                flutter::BinaryReply reply) {
+  const auto &codec = flutter::StandardMethodCodec::GetInstance();
+  if (!is_alive()) {
+    auto envelope = codec.EncodeErrorEnvelope("DISPOSED", "Plugin disposed.");
+    reply(envelope->data(), envelope->size());
+    return;
+  }
+  EnsureInitialized();
+  if (!task_runner_->is_valid()) {
+    auto envelope = codec.EncodeErrorEnvelope(
+        "UNAVAILABLE", "Print worker could not be started.");
+    reply(envelope->data(), envelope->size());
+    return;
+  }
+  if (!message_queue_) {
+    message_queue_ = std::make_unique<TaskQueue>();
+  }
+  // |message| is only valid during this call.
+  auto bytes =
+      std::make_shared<std::vector<uint8_t>>(message, message + message_size);
+  PlatformTaskRunner *runner = task_runner_.get();
+  message_queue_->PostTask([this, runner, bytes, reply]() {
+    MethodResultPtr result = std::make_shared<EnvelopeResult>(reply, runner);
+    std::shared_ptr<flutter::MethodCall<EncodableValue>> call =
+        flutter::StandardMethodCodec::GetInstance().DecodeMethodCall(
+            bytes->data(), bytes->size());
+    if (call == nullptr) {
+      result->Error("INVALID_ARGUMENT", "Malformed method call.");
+      return;
+    }
+    const auto *args = std::get_if<EncodableMap>(call->arguments());
+    if (call->method_name() == "encodeText" && args != nullptr) {
+      HandleEncodeText(*args, result);
+      return;
+    }
+    runner->PostTask([this, call, result]() {
+      if (!is_alive()) {
+        result->Error("DISPOSED", "Plugin disposed.");
+        return;
+      }
+      DispatchMethodCall(*call, result);
+    });
+  });
 }
 
 void FlutterThermalPrinterPlugin::HandleMethodCall(
@@ -54,7 +685,14 @@ void FlutterThermalPrinterPlugin::HandleMethodCall(
     return;
   }
   EnsureInitialized();
-  if (method_call.method_name().compare("getPlatformVersion") == 0) {
+  DispatchMethodCall(method_call, MethodResultPtr(std::move(result)));
+}
+
+void FlutterThermalPrinterPlugin::DispatchMethodCall(
+    const flutter::MethodCall<flutter::EncodableValue> &method_call,
+    MethodResultPtr result) {
+  const std::string &method = method_call.method_name();
+  if (method.compare("getPlatformVersion") == 0) {
     std::ostringstream version_stream;
     version_stream << "Windows ";
     if (IsWindows10OrGreater()) {
@@ -65,8 +703,1158 @@ void FlutterThermalPrinterPlugin::HandleMethodCall(
       version_stream << "7";
     }
     result->Success(flutter::EncodableValue(version_stream.str()));
-  } else {
+    return;
+  }
+  if (method == "getPrinters") {
+    HandleGetPrinters(std::move(result));
+    return;
+  }
+
+  using Handler = void (FlutterThermalPrinterPlugin::*)(const EncodableMap &,
+                                                        MethodResultPtr);
+  Handler handler = nullptr;
+  if (method == "connect") {
+    handler = &FlutterThermalPrinterPlugin::HandleConnect;
+  } else if (method == "disconnect") {
+    handler = &FlutterThermalPrinterPlugin::HandleDisconnect;
+  } else if (method == "isConnected") {
+    handler = &FlutterThermalPrinterPlugin::HandleIsConnected;
+  } else if (method == "getStatus") {
+    handler = &FlutterThermalPrinterPlugin::HandleGetStatus;
+  } else if (method == "printText") {
+    handler = &FlutterThermalPrinterPlugin::HandlePrintText;
+  } else if (method == "submitJob") {
+    handler = &FlutterThermalPrinterPlugin::HandleSubmitJob;
+  } else if (method == "cancelJob") {
+    handler = &FlutterThermalPrinterPlugin::HandleCancelJob;
+  } else if (method == "setQueueLimit") {
+    handler = &FlutterThermalPrinterPlugin::HandleSetQueueLimit;
+  } else if (method == "encodeText") {
+    handler = &FlutterThermalPrinterPlugin::HandleEncodeText;
+  } else if (method == "convertimage") {
+    handler = &FlutterThermalPrinterPlugin::HandleConvertImage;
+  } else if (method == "printImage") {
+    handler = &FlutterThermalPrinterPlugin::HandlePrintImage;
+  } else if (method == "getJobStats") {
+    handler = &FlutterThermalPrinterPlugin::HandleGetJobStats;
+  } else if (method == "warmUp") {
+    handler = &FlutterThermalPrinterPlugin::HandleWarmUp;
+  } else if (method == "setTransport") {
+    handler = &FlutterThermalPrinterPlugin::HandleSetTransport;
+  } else if (method == "printBuffer") {
+    handler = &FlutterThermalPrinterPlugin::HandlePrintBuffer;
+  } else if (method == "beginBatch") {
+    handler = &FlutterThermalPrinterPlugin::HandleBeginBatch;
+  } else if (method == "endBatch") {
+    handler = &FlutterThermalPrinterPlugin::HandleEndBatch;
+  } else if (method == "setBatchWindow") {
+    handler = &FlutterThermalPrinterPlugin::HandleSetBatchWindow;
+  } else if (method == "registerTemplate") {
+    handler = &FlutterThermalPrinterPlugin::HandleRegisterTemplate;
+  } else if (method == "removeTemplate") {
+    handler = &FlutterThermalPrinterPlugin::HandleRemoveTemplate;
+  } else if (method == "printToMany") {
+    handler = &FlutterThermalPrinterPlugin::HandlePrintToMany;
+  } else if (method == "printTemplate") {
+    handler = &FlutterThermalPrinterPlugin::HandlePrintTemplate;
+  } else if (method == "storeLogo") {
+    handler = &FlutterThermalPrinterPlugin::HandleStoreLogo;
+  } else if (method == "printLogo") {
+    handler = &FlutterThermalPrinterPlugin::HandlePrintLogo;
+  }
+  if (handler == nullptr) {
     result->NotImplemented();
+    return;
+  }
+
+  const auto *args = std::get_if<EncodableMap>(method_call.arguments());
+  if (args == nullptr) {
+    result->Error("INVALID_ARGUMENT", "Expected a map of arguments.");
+    return;
+  }
+  if (!task_runner_->is_valid()) {
+    result->Error("UNAVAILABLE", "Print worker could not be started.");
+    return;
+  }
+  (this->*handler)(*args, std::move(result));
+}
+
+PrinterWorker* FlutterThermalPrinterPlugin::GetWorker(const std::string &name) {
+  auto it = workers_.find(name);
+  if (it == workers_.end()) {
+    auto printer = std::make_unique<SpoolerPrinter>(Utf8ToWide(name));
+    auto worker = std::make_unique<PrinterWorker>(
+        std::move(printer), PrinterBuffers::Get().PoolFor(name));
+    it = workers_.emplace(name, std::move(worker)).first;
+  }
+  return it->second.get();
+}
+
+bool FlutterThermalPrinterPlugin::EnqueueJob(
+    const std::string &name, PrintJob job,
+    std::function<void(DWORD error)> on_done) {
+  PlatformTaskRunner *runner = task_runner_.get();
+  // Documents are traced for getJobStats; open/close jobs are not.
+  std::shared_ptr<JobTrace> trace;
+  if (job.type == PrintJob::Type::kPrint ||
+      job.type == PrintJob::Type::kStream) {
+    if (!job.trace) {
+      job.trace = std::make_shared<JobTrace>();
+    }
+    job.trace->received = PerfCounterNow();
+    trace = job.trace;
+  }
+  job.on_complete = [this, runner, job_id = job.id, name, trace,
+                     on_done = std::move(on_done)](DWORD error) {
+    // Worker thread: hop to the platform thread before touching results.
+    runner->PostTask([this, job_id, name, trace, on_done, error]() {
+      if (!is_alive()) {
+        return;
+      }
+      if (trace) {
+        trace->finished = PerfCounterNow();
+        RecordJobStats(job_id, name, error, *trace);
+      }
+      on_done(error);
+    });
+  };
+  return GetWorker(name)->Enqueue(std::move(job));
+}
+
+bool FlutterThermalPrinterPlugin::EnqueueSpooled(
+    const std::string &name, PrintJob job, MethodResultPtr result,
+    std::function<void(DWORD error)> on_done) {
+  auto batch = batches_.find(name);
+  std::function<void(DWORD error)> reply;
+  if (batch == batches_.end()) {
+    // Replies once the spooler has accepted the document.
+    reply = [result](DWORD error) {
+      if (error == ERROR_CANCELLED) {
+        result->Error("CANCELLED", "The print job was cancelled.");
+      } else if (error != ERROR_SUCCESS) {
+        result->Error("PRINT_FAILED", Win32ErrorMessage("WritePrinter", error));
+      } else {
+        result->Success(EncodableValue(true));
+      }
+    };
+  } else {
+    reply = [batch_error = batch->second](DWORD error) {
+      if (*batch_error == ERROR_SUCCESS) {
+        *batch_error = error;
+      }
+    };
+  }
+  if (on_done) {
+    reply = [on_done = std::move(on_done), reply](DWORD error) {
+      on_done(error);
+      reply(error);
+    };
+  }
+  if (!EnqueueJob(name, std::move(job), std::move(reply))) {
+    ReplyBusy(name, result);
+    return false;
+  }
+  if (batch != batches_.end()) {
+    // A batched job is written at `endBatch`, so waiting here would stall
+    // a caller that awaits each write. Its failure is reported by
+    // `endBatch`.
+    result->Success(EncodableValue(true));
+  }
+  return true;
+}
+
+void FlutterThermalPrinterPlugin::ReplyBusy(const std::string &name,
+                                            MethodResultPtr result) {
+  result->Error("BUSY", "The print queue for " + name + " is full (" +
+                            std::to_string(GetWorker(name)->pending_bytes()) +
+                            " bytes pending); retry once it drains.");
+}
+
+void FlutterThermalPrinterPlugin::HandleBeginBatch(const EncodableMap &args,
+                                                   MethodResultPtr result) {
+  const std::string name = PrinterNameFromArgs(args);
+  if (name.empty()) {
+    result->Error("INVALID_ARGUMENT", "Missing printer name.");
+    return;
+  }
+  if (batches_.find(name) == batches_.end()) {
+    batches_.emplace(name, std::make_shared<DWORD>(ERROR_SUCCESS));
+    GetWorker(name)->HoldBatch();
+  }
+  result->Success(EncodableValue(true));
+}
+
+void FlutterThermalPrinterPlugin::HandleEndBatch(const EncodableMap &args,
+                                                 MethodResultPtr result) {
+  const std::string name = PrinterNameFromArgs(args);
+  auto batch = batches_.find(name);
+  if (batch == batches_.end()) {
+    result->Success(EncodableValue(true));
+    return;
+  }
+  std::shared_ptr<DWORD> batch_error = batch->second;
+  batches_.erase(batch);
+  GetWorker(name)->ReleaseBatch();
+  // The barrier completes after every batched job, in order.
+  PrintJob job;
+  job.type = PrintJob::Type::kBarrier;
+  EnqueueJob(name, std::move(job), [result, batch_error](DWORD error) {
+    if (*batch_error != ERROR_SUCCESS) {
+      result->Error("PRINT_FAILED",
+                    Win32ErrorMessage("WritePrinter", *batch_error));
+      return;
+    }
+    result->Success(EncodableValue(true));
+  });
+}
+
+void FlutterThermalPrinterPlugin::HandleSetBatchWindow(const EncodableMap &args,
+                                                       MethodResultPtr result) {
+  const std::string name = PrinterNameFromArgs(args);
+  const int64_t window_ms = GetIntArg(args, "windowMs", -1);
+  if (name.empty() || window_ms < 0 || window_ms > kMaxBatchWindowMs) {
+    result->Error("INVALID_ARGUMENT", "Missing printer name or bad windowMs.");
+    return;
+  }
+  GetWorker(name)->SetBatchWindow(std::chrono::milliseconds(window_ms));
+  result->Success(EncodableValue(true));
+}
+
+void FlutterThermalPrinterPlugin::HandleConnect(const EncodableMap &args,
+                                                MethodResultPtr result) {
+  const std::string name = PrinterNameFromArgs(args);
+  if (name.empty()) {
+    result->Error("INVALID_ARGUMENT", "Missing printer name.");
+    return;
+  }
+  PrintJob job;
+  job.type = PrintJob::Type::kOpen;
+  EnqueueJob(name, std::move(job), [result](DWORD error) {
+    result->Success(EncodableValue(error == ERROR_SUCCESS));
+  });
+}
+
+void FlutterThermalPrinterPlugin::HandleDisconnect(const EncodableMap &args,
+                                                   MethodResultPtr result) {
+  const std::string name = PrinterNameFromArgs(args);
+  if (workers_.find(name) == workers_.end()) {
+    result->Success(EncodableValue(true));
+    return;
+  }
+  // Queued behind outstanding jobs, so pending receipts still print.
+  PrintJob job;
+  job.type = PrintJob::Type::kClose;
+  EnqueueJob(name, std::move(job), [result](DWORD error) {
+    result->Success(EncodableValue(true));
+  });
+}
+
+void FlutterThermalPrinterPlugin::HandleSetTransport(const EncodableMap &args,
+                                                     MethodResultPtr result) {
+  const std::string name = PrinterNameFromArgs(args);
+  const std::string *transport = GetStringArg(args, "transport");
+  if (name.empty() || transport == nullptr) {
+    result->Error("INVALID_ARGUMENT", "Missing printer name or transport.");
+    return;
+  }
+  PrintJob job;
+  job.type = PrintJob::Type::kSetTransport;
+  if (*transport == "spooler") {
+    job.transport = std::make_unique<SpoolerPrinter>(Utf8ToWide(name));
+  } else if (*transport == "usb") {
+    const std::string *device_path = GetStringArg(args, "devicePath");
+    // 0 keeps the OverlappedWriter defaults.
+    const int64_t chunk_size = GetIntArg(args, "chunkSize", 0);
+    const int64_t max_in_flight = GetIntArg(args, "maxInFlight", 0);
+    if (chunk_size < 0 || chunk_size > kMaxUsbChunkSize || max_in_flight < 0 ||
+        max_in_flight > kMaxUsbInFlight) {
+      result->Error("INVALID_ARGUMENT",
+                    "chunkSize or maxInFlight out of range.");
+      return;
+    }
+    OverlappedWriteOptions write_options;
+    write_options.chunk_size = static_cast<size_t>(chunk_size);
+    write_options.max_in_flight = static_cast<size_t>(max_in_flight);
+    job.transport = std::make_unique<UsbPrinter>(
+        Utf8ToWide(name),
+        device_path != nullptr ? Utf8ToWide(*device_path) : std::wstring(),
+        write_options);
+  } else if (*transport == "network") {
+    const std::string *host = GetStringArg(args, "host");
+    if (host == nullptr) {
+      host = GetStringArg(args, "address");
+    }
+    const int64_t port = GetIntArg(args, "port", kDefaultTcpPort);
+    TcpOptions tcp_options;
+    const int64_t connect_timeout = GetIntArg(
+        args, "connectTimeoutMs", tcp_options.connect_timeout_ms);
+    if (host == nullptr || host->empty() || port < 1 || port > 0xFFFF ||
+        connect_timeout < 1 || connect_timeout > kMaxTcpConnectTimeoutMs) {
+      result->Error("INVALID_ARGUMENT",
+                    "Missing host, or port or connectTimeoutMs out of range.");
+      return;
+    }
+    tcp_options.connect_timeout_ms = static_cast<DWORD>(connect_timeout);
+    if (!tcp_pool_) {
+      tcp_pool_ = std::make_shared<TcpConnectionPool>();
+    }
+    job.transport = std::make_unique<TcpPrinter>(
+        Utf8ToWide(name), *host, static_cast<uint16_t>(port), tcp_pool_,
+        tcp_options);
+  } else if (*transport == "loopback") {
+    const std::string *path = GetStringArg(args, "path");
+    const int64_t baud_rate = GetIntArg(args, "baudRate", 0);
+    const int64_t latency_ms = GetIntArg(args, "latencyMs", 0);
+    if (baud_rate < 0 || baud_rate > kMaxLoopbackBaudRate || latency_ms < 0 ||
+        latency_ms > kMaxLoopbackLatencyMs) {
+      result->Error("INVALID_ARGUMENT", "baudRate or latencyMs out of range.");
+      return;
+    }
+    LoopbackOptions loopback_options;
+    if (path != nullptr) {
+      loopback_options.path = Utf8ToWide(*path);
+    }
+    loopback_options.baud_rate = static_cast<uint32_t>(baud_rate);
+    loopback_options.latency_ms = static_cast<uint32_t>(latency_ms);
+    job.transport =
+        std::make_unique<LoopbackPrinter>(Utf8ToWide(name), loopback_options);
+  } else {
+    result->Error("INVALID_ARGUMENT", "Unknown transport: " + *transport);
+    return;
+  }
+  EnqueueJob(name, std::move(job), [result](DWORD error) {
+    result->Success(EncodableValue(error == ERROR_SUCCESS));
+  });
+}
+
+void FlutterThermalPrinterPlugin::HandleIsConnected(const EncodableMap &args,
+                                                    MethodResultPtr result) {
+  const std::string name = PrinterNameFromArgs(args);
+  if (name.empty()) {
+    result->Success(EncodableValue(false));
+    return;
+  }
+  // A printer that answered its last status poll said whether it is
+  // online; anything else is settled by opening it behind the queued jobs.
+  auto it = workers_.find(name);
+  PrinterStatus status;
+  if (it != workers_.end() &&
+      it->second->GetStatus(&status) == ERROR_SUCCESS && status.known) {
+    result->Success(EncodableValue(status.online));
+    return;
+  }
+  PrintJob job;
+  job.type = PrintJob::Type::kOpen;
+  EnqueueJob(name, std::move(job), [result](DWORD error) {
+    result->Success(EncodableValue(error == ERROR_SUCCESS));
+  });
+}
+
+void FlutterThermalPrinterPlugin::HandleGetStatus(const EncodableMap &args,
+                                                  MethodResultPtr result) {
+  const std::string name = PrinterNameFromArgs(args);
+  if (name.empty()) {
+    result->Error("INVALID_ARGUMENT", "Missing printer name.");
+    return;
+  }
+  PrinterStatus status;
+  DWORD error = ERROR_NOT_READY;
+  auto it = workers_.find(name);
+  if (it != workers_.end()) {
+    error = it->second->GetStatus(&status);
+  }
+  result->Success(EncodePrinterStatus(error, status));
+}
+
+void FlutterThermalPrinterPlugin::HandlePrintText(const EncodableMap &args,
+                                                  MethodResultPtr result) {
+  const std::string name = PrinterNameFromArgs(args);
+  if (name.empty()) {
+    result->Error("INVALID_ARGUMENT", "Missing printer name.");
+    return;
+  }
+  PrintJob job;
+  BufferPool *buffers = PrinterBuffers::Get().PoolFor(name).get();
+  if (!ReadPayload(args, "data", &job.data, buffers)) {
+    result->Error("INVALID_ARGUMENT", "Expected `data` as a Uint8List.");
+    return;
+  }
+  job.id = next_job_id_++;
+  job.priority = JobPriority(args);
+  EnqueueSpooled(name, std::move(job), result);
+}
+
+void FlutterThermalPrinterPlugin::HandleSubmitJob(const EncodableMap &args,
+                                                  MethodResultPtr result) {
+  const std::string name = PrinterNameFromArgs(args);
+  if (name.empty()) {
+    result->Error("INVALID_ARGUMENT", "Missing printer name.");
+    return;
+  }
+  PrintJob job;
+  BufferPool *buffers = PrinterBuffers::Get().PoolFor(name).get();
+  if (!ReadPayload(args, "data", &job.data, buffers)) {
+    result->Error("INVALID_ARGUMENT", "Expected `data` as a Uint8List.");
+    return;
+  }
+  job.id = next_job_id_++;
+  job.priority = JobPriority(args);
+  // Replies with the job id right away; completion goes to the jobs stream.
+  const int64_t job_id = job.id;
+  if (!EnqueueJob(name, std::move(job), [this, job_id, name](DWORD error) {
+        SendJobEvent(job_id, name, error);
+      })) {
+    ReplyBusy(name, result);
+    return;
+  }
+  result->Success(EncodableValue(job_id));
+}
+
+void FlutterThermalPrinterPlugin::HandlePrintToMany(
+    const EncodableMap &args, MethodResultPtr result) {
+  std::vector<std::string> names;
+  if (!ReadPrinterNames(args, &names) || names.empty() ||
+      names.size() > kMaxFanOutPrinters) {
+    result->Error("INVALID_ARGUMENT",
+                  "Expected `printers` as a list of 1 to " +
+                      std::to_string(kMaxFanOutPrinters) + " printer names.");
+    return;
+  }
+  std::vector<uint8_t> data;
+  if (!ReadPayload(args, "data", &data)) {
+    result->Error("INVALID_ARGUMENT", "Expected `data` as a Uint8List.");
+    return;
+  }
+  // A template without fields is an immutable, shared document: every
+  // printer's job holds a reference to the one copy and the workers write
+  // it from there.
+  std::shared_ptr<const PrintTemplate> document =
+      PrintTemplate::Create(std::move(data), {});
+  const int priority = JobPriority(args);
+
+  // Platform thread only, like every on_done.
+  struct FanOut {
+    MethodResultPtr result;
+    EncodableMap outcomes;
+    size_t remaining = 0;
+  };
+  auto fan_out = std::make_shared<FanOut>();
+  fan_out->result = result;
+  fan_out->remaining = names.size();
+  auto finish = [fan_out](const std::string &name, EncodableValue outcome) {
+    fan_out->outcomes[EncodableValue(name)] = std::move(outcome);
+    if (--fan_out->remaining == 0) {
+      fan_out->result->Success(EncodableValue(std::move(fan_out->outcomes)));
+    }
+  };
+  for (const std::string &name : names) {
+    PrintJob job;
+    job.id = next_job_id_++;
+    job.priority = priority;
+    job.print_template = document;
+    const bool queued =
+        EnqueueJob(name, std::move(job), [finish, name](DWORD error) {
+          if (error == ERROR_SUCCESS) {
+            finish(name, EncodableValue());
+          } else if (error == ERROR_CANCELLED) {
+            finish(name, EncodableValue("CANCELLED"));
+          } else {
+            finish(name, EncodableValue(
+                             "PRINT_FAILED: " +
+                             Win32ErrorMessage("WritePrinter", error)));
+          }
+        });
+    if (!queued) {
+      finish(name, EncodableValue("BUSY"));
+    }
+  }
+}
+
+void FlutterThermalPrinterPlugin::HandleCancelJob(const EncodableMap &args,
+                                                  MethodResultPtr result) {
+  const int64_t job_id = GetIntArg(args, "jobId", 0);
+  if (job_id <= 0) {
+    result->Error("INVALID_ARGUMENT", "Expected a positive `jobId`.");
+    return;
+  }
+  // Ids are unique across printers, so the owner needn't be named.
+  bool cancelled = false;
+  for (auto &entry : workers_) {
+    if (entry.second->Cancel(job_id)) {
+      cancelled = true;
+      break;
+    }
+  }
+  result->Success(EncodableValue(cancelled));
+}
+
+void FlutterThermalPrinterPlugin::HandleSetQueueLimit(const EncodableMap &args,
+                                                      MethodResultPtr result) {
+  const std::string name = PrinterNameFromArgs(args);
+  const int64_t max_bytes = GetIntArg(args, "maxBytes", -1);
+  if (name.empty() || max_bytes < 0 || max_bytes > kMaxQueueLimitBytes) {
+    result->Error("INVALID_ARGUMENT", "Missing printer name or bad maxBytes.");
+    return;
+  }
+  GetWorker(name)->SetMaxQueuedBytes(static_cast<size_t>(max_bytes));
+  result->Success(EncodableValue(true));
+}
+
+void FlutterThermalPrinterPlugin::HandlePrintBuffer(const EncodableMap &args,
+                                                    MethodResultPtr result) {
+  const std::string name = PrinterNameFromArgs(args);
+  const int64_t lease = GetIntArg(args, "buffer", 0);
+  const int64_t length = GetIntArg(args, "length", -1);
+  PrinterBuffers &buffers = PrinterBuffers::Get();
+  PrintJob job;
+  if (name.empty() || length < 0 ||
+      !buffers.Take(lease, static_cast<size_t>(length), &job.data)) {
+    // Dart has handed the lease over either way; don't leak it.
+    buffers.Release(lease);
+    result->Error("INVALID_ARGUMENT", "Unknown buffer lease or bad length.");
+    return;
+  }
+  job.id = next_job_id_++;
+  job.priority = JobPriority(args);
+  EnqueueSpooled(name, std::move(job), result);
+}
+
+void FlutterThermalPrinterPlugin::HandleRegisterTemplate(
+    const EncodableMap &args, MethodResultPtr result) {
+  const std::string *template_name = GetStringArg(args, "template");
+  std::vector<uint8_t> bytes;
+  auto fields_arg = args.find(EncodableValue("fields"));
+  const auto *field_list =
+      fields_arg != args.end()
+          ? std::get_if<flutter::EncodableList>(&fields_arg->second)
+          : nullptr;
+  if (template_name == nullptr || template_name->empty() ||
+      !ReadPayload(args, "bytes", &bytes) || field_list == nullptr) {
+    result->Error("INVALID_ARGUMENT",
+                  "Expected `template`, `bytes` and a list of `fields`.");
+    return;
+  }
+  std::vector<PrintTemplate::Field> fields;
+  fields.reserve(field_list->size());
+  for (const EncodableValue &entry : *field_list) {
+    const auto *field = std::get_if<EncodableMap>(&entry);
+    const std::string *field_name =
+        field != nullptr ? GetStringArg(*field, "name") : nullptr;
+    const int64_t offset = field != nullptr ? GetIntArg(*field, "offset", -1)
+                                            : -1;
+    if (field_name == nullptr || offset < 0) {
+      result->Error("INVALID_ARGUMENT",
+                    "Each field needs a `name` and an `offset`.");
+      return;
+    }
+    fields.push_back({*field_name, static_cast<size_t>(offset)});
+  }
+  auto print_template =
+      PrintTemplate::Create(std::move(bytes), std::move(fields));
+  if (print_template == nullptr) {
+    result->Error("INVALID_ARGUMENT", "A field offset is past the template.");
+    return;
+  }
+  if (!templates_.Register(*template_name, std::move(print_template))) {
+    result->Error("INVALID_ARGUMENT", "Template too large or store full.");
+    return;
+  }
+  result->Success(EncodableValue(true));
+}
+
+void FlutterThermalPrinterPlugin::HandleRemoveTemplate(
+    const EncodableMap &args, MethodResultPtr result) {
+  const std::string *template_name = GetStringArg(args, "template");
+  result->Success(EncodableValue(template_name != nullptr &&
+                                 templates_.Remove(*template_name)));
+}
+
+void FlutterThermalPrinterPlugin::HandlePrintTemplate(
+    const EncodableMap &args, MethodResultPtr result) {
+  const std::string name = PrinterNameFromArgs(args);
+  const std::string *template_name = GetStringArg(args, "template");
+  if (name.empty() || template_name == nullptr) {
+    result->Error("INVALID_ARGUMENT", "Missing printer or template name.");
+    return;
+  }
+  PrintJob job;
+  job.print_template = templates_.Find(*template_name);
+  if (job.print_template == nullptr) {
+    result->Error("INVALID_ARGUMENT", "Unknown template: " + *template_name);
+    return;
+  }
+  auto values_arg = args.find(EncodableValue("values"));
+  if (values_arg != args.end()) {
+    const auto *values = std::get_if<EncodableMap>(&values_arg->second);
+    if (values == nullptr) {
+      result->Error("INVALID_ARGUMENT", "Expected `values` as a map.");
+      return;
+    }
+    for (const auto &[key, value] : *values) {
+      const auto *field = std::get_if<std::string>(&key);
+      if (field == nullptr || !job.print_template->HasField(*field)) {
+        result->Error("INVALID_ARGUMENT", "Unknown template field.");
+        return;
+      }
+      // ReadPayload looks values up by key, so wrap this one.
+      const EncodableMap single = {{EncodableValue("value"), value}};
+      if (!ReadPayload(single, "value", &job.fields[*field])) {
+        result->Error("INVALID_ARGUMENT",
+                      "Template values must be Uint8List bytes.");
+        return;
+      }
+    }
+  }
+  job.id = next_job_id_++;
+  job.priority = JobPriority(args);
+  EnqueueSpooled(name, std::move(job), result);
+}
+
+void FlutterThermalPrinterPlugin::HandleStoreLogo(const EncodableMap &args,
+                                                  MethodResultPtr result) {
+  const std::string name = PrinterNameFromArgs(args);
+  const std::string *key = GetStringArg(args, "key");
+  if (name.empty() || key == nullptr || !IsValidNvGraphicsKey(*key)) {
+    result->Error("INVALID_ARGUMENT",
+                  "Expected a printer name and a two-character `key`.");
+    return;
+  }
+  auto pixels = std::make_shared<std::vector<uint8_t>>();
+  if (!ReadPayload(args, "pixels", pixels.get())) {
+    result->Error("INVALID_ARGUMENT", "Expected `pixels` as RGBA Uint8List.");
+    return;
+  }
+  ImageRequest request;
+  if (!ReadImageRequest(args, &request) ||
+      pixels->size() != static_cast<size_t>(request.width) *
+                            static_cast<size_t>(request.height) * 4) {
+    result->Error("INVALID_ARGUMENT", "Invalid logo size or raster options.");
+    return;
+  }
+  const uint64_t hash =
+      NvGraphicsHash(pixels->data(), pixels->size(), request.width,
+                     request.height, request.options);
+  if (!GetBoolArg(args, "force") && nv_graphics_.Holds(name, *key, hash)) {
+    result->Success(EncodableValue(false));
+    return;
+  }
+
+  PrintJob job;
+  job.type = PrintJob::Type::kStream;
+  job.id = next_job_id_++;
+  job.queued_bytes = pixels->size();
+  job.stream = std::make_shared<DocumentStream>(kMaxQueuedBands);
+  std::shared_ptr<DocumentStream> stream = job.stream;
+  std::shared_ptr<BufferPool> buffers = PrinterBuffers::Get().PoolFor(name);
+
+  PrinterWorker *worker = GetWorker(name);
+  if (!EnqueueSpooled(name, std::move(job), result,
+                      [this, name, key = *key, hash](DWORD error) {
+                        if (error != ERROR_SUCCESS) {
+                          nv_graphics_.Forget(name, key, hash);
+                        }
+                      })) {
+    return;
+  }
+  // Recorded now so a printLogo queued behind the upload is accepted.
+  nv_graphics_.Record(name, *key, hash);
+  worker->PostProducer([stream, pixels, request, buffers, key = *key]() {
+    std::vector<uint8_t> define = buffers->Acquire(pixels->size() / 32 + 64);
+    const bool ok = AppendNvGraphicsDefine(key, pixels->data(),
+                                           pixels->size(), request.width,
+                                           request.height, request.options,
+                                           &define) &&
+                    stream->Push(std::move(define));
+    stream->Finish(ok);
+  });
+}
+
+void FlutterThermalPrinterPlugin::HandlePrintLogo(const EncodableMap &args,
+                                                  MethodResultPtr result) {
+  const std::string name = PrinterNameFromArgs(args);
+  const std::string *key = GetStringArg(args, "key");
+  if (name.empty() || key == nullptr || !IsValidNvGraphicsKey(*key)) {
+    result->Error("INVALID_ARGUMENT",
+                  "Expected a printer name and a two-character `key`.");
+    return;
+  }
+  if (!nv_graphics_.HasKey(name, *key)) {
+    result->Error("INVALID_ARGUMENT",
+                  "No logo stored under `" + *key + "` on " + name + ".");
+    return;
+  }
+  PrintJob job;
+  job.id = next_job_id_++;
+  AppendNvGraphicsPrint(*key, &job.data);
+  EnqueueSpooled(name, std::move(job), result);
+}
+
+void FlutterThermalPrinterPlugin::HandleEncodeText(const EncodableMap &args,
+                                                  MethodResultPtr result) {
+  const std::string *page_name = GetStringArg(args, "codePage");
+  CodePage page = CodePage::kCp437;
+  if (page_name != nullptr && !CodePageFromName(*page_name, &page)) {
+    result->Error("INVALID_ARGUMENT", "Unknown code page: " + *page_name);
+    return;
+  }
+  const int64_t page_id =
+      GetIntArg(args, "codePageId", DefaultCodePageId(page));
+  const int64_t chars_per_line =
+      GetIntArg(args, "charsPerLine", kDefaultCharsPerLine);
+  auto rows_arg = args.find(EncodableValue("rows"));
+  const auto *rows =
+      rows_arg != args.end()
+          ? std::get_if<flutter::EncodableList>(&rows_arg->second)
+          : nullptr;
+  if (page_id < -1 || page_id > 255 || chars_per_line < kMinCharsPerLine ||
+      chars_per_line > kMaxCharsPerLine || rows == nullptr ||
+      rows->size() > kMaxTextRows) {
+    result->Error("INVALID_ARGUMENT",
+                  "Expected a list of `rows`, `charsPerLine` from 8 to 255 "
+                  "and a `codePageId` from 0 to 255.");
+    return;
+  }
+  TextEncoder encoder(page, static_cast<int>(page_id),
+                      static_cast<int>(chars_per_line));
+  for (size_t i = 0; i < rows->size(); ++i) {
+    if (!AddTextRow((*rows)[i], &encoder)) {
+      result->Error("INVALID_ARGUMENT",
+                    "Row " + std::to_string(i) +
+                        " needs one of `text`, `columns`, `rule`, `feed` or "
+                        "`cut`, with a valid style.");
+      return;
+    }
+  }
+  result->Success(EncodableValue(encoder.bytes()));
+}
+
+void FlutterThermalPrinterPlugin::EnsureRasterQueue() {
+  if (!raster_queue_) {
+    raster_queue_ = std::make_unique<TaskQueue>();
+    raster_pool_ = std::make_unique<ThreadPool>(
+        ThreadPool::DefaultThreadCount(kMaxRasterHelperThreads));
+  }
+}
+
+void FlutterThermalPrinterPlugin::HandleConvertImage(const EncodableMap &args,
+                                                    MethodResultPtr result) {
+  auto image = std::make_shared<std::vector<uint8_t>>();
+  bool encoded = false;
+  ImageRequest request;
+  if (!ReadImageArgs(args, image.get(), &encoded, &request)) {
+    result->Error("INVALID_ARGUMENT",
+                  "Expected RGBA `pixels` matching width * height * 4 or "
+                  "`encoded` image bytes, and valid raster options.");
+    return;
+  }
+
+  EnsureRasterQueue();
+  PlatformTaskRunner *runner = task_runner_.get();
+  ThreadPool *pool = raster_pool_.get();
+  std::shared_ptr<RasterCache> cache = raster_cache_;
+  raster_queue_->PostTask([this, runner, pool, cache, result, image, encoded,
+                           request]() mutable {
+    RasterCache::Raster raster;
+    bool ok = true;
+    if (!encoded) {
+      const RasterCache::Key key =
+          RasterCache::KeyFor(image->data(), image->size(), request.width,
+                              request.height, request.options);
+      raster = cache->Find(key);
+      if (raster == nullptr) {
+        auto fresh = std::make_shared<std::vector<uint8_t>>();
+        ok = RasterizeRgba(image->data(), image->size(), request.width,
+                           request.height, request.options, fresh.get(),
+                           pool);
+        if (ok) {
+          cache->Insert(key, fresh);
+        }
+        raster = std::move(fresh);
+      }
+    } else {
+      // Decoded rows are converted in order, so diffusion is the serial
+      // kind; the compressed bytes identify the image just as well.
+      ScopedComInitializer com;
+      std::unique_ptr<WicImageDecoder> decoder;
+      RgbaRowSource source;
+      ok = OpenRowSource(*image, encoded, &request, &decoder, &source);
+      request.options.serial_diffusion = true;
+      const RasterCache::Key key =
+          RasterCache::KeyFor(image->data(), image->size(), request.width,
+                              request.height, request.options);
+      raster = ok ? cache->Find(key) : nullptr;
+      if (ok && raster == nullptr) {
+        RasterOptions options = request.options;
+        if (options.band_rows == 0) {
+          options.band_rows = request.height;
+        }
+        auto fresh = std::make_shared<std::vector<uint8_t>>();
+        ok = RasterizeRgbaRowBands(
+            source, request.width, request.height, options,
+            [&fresh](std::vector<uint8_t> band) {
+              if (fresh->empty()) {
+                *fresh = std::move(band);
+              } else {
+                fresh->insert(fresh->end(), band.begin(), band.end());
+              }
+              return true;
+            });
+        if (ok) {
+          cache->Insert(key, fresh);
+        }
+        raster = std::move(fresh);
+      }
+    }
+    runner->PostTask([this, result, raster, ok, encoded]() {
+      if (!is_alive()) {
+        return;
+      }
+      if (!ok) {
+        result->Error("INVALID_ARGUMENT",
+                      encoded ? "Could not decode the `encoded` image."
+                              : "Image too wide for `GS v 0`.");
+        return;
+      }
+      result->Success(EncodableValue(*raster));
+    });
+  });
+}
+
+void FlutterThermalPrinterPlugin::HandlePrintImage(const EncodableMap &args,
+                                                   MethodResultPtr result) {
+  const std::string name = PrinterNameFromArgs(args);
+  if (name.empty()) {
+    result->Error("INVALID_ARGUMENT", "Missing printer name.");
+    return;
+  }
+  auto image = std::make_shared<std::vector<uint8_t>>();
+  bool encoded = false;
+  ImageRequest request;
+  if (!ReadImageArgs(args, image.get(), &encoded, &request)) {
+    result->Error("INVALID_ARGUMENT",
+                  "Expected RGBA `pixels` matching width * height * 4 or "
+                  "`encoded` image bytes, and valid raster options.");
+    return;
+  }
+  // Spell out what RasterizeRgbaBands() does by default so the cache key
+  // says exactly which bytes it holds.
+  if (request.options.band_rows == 0) {
+    request.options.band_rows = kStreamBandRows;
+  }
+  request.options.serial_diffusion = true;
+  // Optional raw bytes around the image, e.g. alignment before and a cut
+  // after, so the whole ticket is one document.
+  std::shared_ptr<BufferPool> buffers = PrinterBuffers::Get().PoolFor(name);
+  auto prefix = std::make_shared<std::vector<uint8_t>>();
+  auto suffix = std::make_shared<std::vector<uint8_t>>();
+  if ((args.count(EncodableValue("prefix")) != 0 &&
+       !ReadPayload(args, "prefix", prefix.get(), buffers.get())) ||
+      (args.count(EncodableValue("suffix")) != 0 &&
+       !ReadPayload(args, "suffix", suffix.get(), buffers.get()))) {
+    buffers->Release(std::move(*prefix));
+    buffers->Release(std::move(*suffix));
+    result->Error("INVALID_ARGUMENT",
+                  "Expected `prefix` and `suffix` as Uint8Lists.");
+    return;
+  }
+
+  PrintJob job;
+  job.type = PrintJob::Type::kStream;
+  job.id = next_job_id_++;
+  job.stream = std::make_shared<DocumentStream>(kMaxQueuedBands);
+  job.priority = JobPriority(args);
+  job.queued_bytes = image->size() + prefix->size() + suffix->size();
+  job.trace = std::make_shared<JobTrace>();
+  std::shared_ptr<DocumentStream> stream = job.stream;
+  std::shared_ptr<JobTrace> trace = job.trace;
+
+  PrinterWorker *worker = GetWorker(name);
+  if (!EnqueueSpooled(name, std::move(job), result)) {
+    return;
+  }
+  // Each band is written while the next one converts; Push() blocks once
+  // the worker falls kMaxQueuedBands behind. Encoded images are decoded
+  // here too, one band of rows ahead of the rasterizer.
+  worker->PostProducer([stream, trace, image, encoded, prefix, suffix,
+                        request, buffers, cache = raster_cache_]() mutable {
+    bool ok = prefix->empty() || stream->Push(std::move(*prefix));
+    std::unique_ptr<ScopedComInitializer> com;
+    if (encoded) {
+      com = std::make_unique<ScopedComInitializer>();
+    }
+    std::unique_ptr<WicImageDecoder> decoder;
+    RgbaRowSource source;
+    ok = ok && OpenRowSource(*image, encoded, &request, &decoder, &source);
+    if (ok) {
+      const RasterCache::Key key =
+          RasterCache::KeyFor(image->data(), image->size(), request.width,
+                              request.height, request.options);
+      ok = StreamRaster(key, source, request, cache.get(), buffers.get(),
+                        stream.get(), trace.get());
+    }
+    // Release the decoder before leaving the COM apartment.
+    decoder.reset();
+    com.reset();
+    ok = ok && (suffix->empty() || stream->Push(std::move(*suffix)));
+    stream->Finish(ok);
+  });
+}
+
+void FlutterThermalPrinterPlugin::HandleGetJobStats(const EncodableMap &args,
+                                                   MethodResultPtr result) {
+  // An optional `printer` narrows both the summaries and the recent jobs.
+  const std::string *only = GetStringArg(args, "printer");
+  EncodableMap printers;
+  for (const std::string &name : job_stats_.printers()) {
+    if (only == nullptr || *only == name) {
+      printers[EncodableValue(name)] =
+          EncodePrinterJobSummary(job_stats_.Summary(name));
+    }
+  }
+  flutter::EncodableList recent;
+  for (const JobStageTimes &times : job_stats_.recent()) {
+    if (only == nullptr || *only == times.printer) {
+      recent.push_back(EncodeJobStageTimes(times));
+    }
+  }
+  result->Success(EncodableValue(EncodableMap{
+      {EncodableValue("printers"), EncodableValue(printers)},
+      {EncodableValue("recent"), EncodableValue(recent)},
+  }));
+}
+
+void FlutterThermalPrinterPlugin::HandleWarmUp(const EncodableMap &args,
+                                               MethodResultPtr result) {
+  const int64_t start = PerfCounterNow();
+  std::vector<std::string> names;
+  if (!ReadPrinterNames(args, &names) || names.size() > kMaxWarmUpPrinters) {
+    result->Error("INVALID_ARGUMENT",
+                  "Expected `printers` as a list of up to " +
+                      std::to_string(kMaxWarmUpPrinters) + " printer names.");
+    return;
+  }
+
+  // Platform thread only, like every on_done.
+  struct WarmUp {
+    MethodResultPtr result;
+    int64_t start = 0;
+    flutter::EncodableList steps;
+    size_t remaining = 0;
+  };
+  auto warm_up = std::make_shared<WarmUp>();
+  warm_up->result = result;
+  warm_up->start = start;
+  // This call itself, the enumeration, the kernels, and a pool and a
+  // spooler handle per printer.
+  warm_up->remaining = 3 + 2 * names.size();
+  // |error| is empty if the step succeeded.
+  auto finish = [warm_up](const std::string &step, const std::string &printer,
+                          double ms, const std::string &error) {
+    EncodableMap entry = {
+        {EncodableValue("step"), EncodableValue(step)},
+        {EncodableValue("ms"), EncodableValue(ms)},
+        {EncodableValue("success"), EncodableValue(error.empty())},
+    };
+    if (!printer.empty()) {
+      entry[EncodableValue("printer")] = EncodableValue(printer);
+    }
+    if (!error.empty()) {
+      entry[EncodableValue("error")] = EncodableValue(error);
+    }
+    warm_up->steps.push_back(EncodableValue(std::move(entry)));
+    if (--warm_up->remaining == 0) {
+      warm_up->result->Success(EncodableValue(EncodableMap{
+          {EncodableValue("steps"), EncodableValue(std::move(warm_up->steps))},
+          {EncodableValue("totalMs"), EncodableValue(MsSince(warm_up->start))},
+      }));
+    }
+  };
+
+  // The watcher enumerates on its own thread; a getPrinters call that is
+  // only answered by its first batch times it.
+  const int64_t enumerate_start = PerfCounterNow();
+  HandleGetPrinters(std::make_shared<flutter::MethodResultFunctions<>>(
+      [finish, enumerate_start](const EncodableValue *printers) {
+        finish("enumeratePrinters", std::string(), MsSince(enumerate_start),
+               std::string());
+      },
+      [finish, enumerate_start](const std::string &code,
+                                const std::string &message,
+                                const EncodableValue *details) {
+        finish("enumeratePrinters", std::string(), MsSince(enumerate_start),
+               code + ": " + message);
+      },
+      nullptr));
+
+  // Starting the threads is cheap; the first-use work runs on them.
+  EnsureRasterQueue();
+  PlatformTaskRunner *runner = task_runner_.get();
+  raster_queue_->PostTask([this, runner, names, finish]() {
+    int64_t mark = PerfCounterNow();
+    GetRasterKernels();
+    const double kernels_ms = MsSince(mark);
+    std::vector<double> pool_ms;
+    for (const std::string &name : names) {
+      mark = PerfCounterNow();
+      std::shared_ptr<BufferPool> pool = PrinterBuffers::Get().PoolFor(name);
+      for (size_t size = BufferPool::kMinSlab; size <= kWarmUpMaxSlab;
+           size *= 2) {
+        pool->Release(pool->Acquire(size));
+      }
+      pool_ms.push_back(MsSince(mark));
+    }
+    runner->PostTask([this, names, finish, kernels_ms, pool_ms]() {
+      if (!is_alive()) {
+        return;
+      }
+      finish("rasterKernels", std::string(), kernels_ms, std::string());
+      for (size_t i = 0; i < names.size(); ++i) {
+        finish("bufferPool", names[i], pool_ms[i], std::string());
+      }
+    });
+  });
+
+  // Queued behind any jobs already waiting, like `connect`.
+  for (const std::string &name : names) {
+    PrintJob job;
+    job.type = PrintJob::Type::kOpen;
+    const int64_t open_start = PerfCounterNow();
+    const bool queued = EnqueueJob(
+        name, std::move(job), [finish, name, open_start](DWORD error) {
+          finish("openPrinter", name, MsSince(open_start),
+                 error == ERROR_SUCCESS
+                     ? std::string()
+                     : Win32ErrorMessage("OpenPrinter", error));
+        });
+    if (!queued) {
+      finish("openPrinter", name, 0, "BUSY");
+    }
+  }
+
+  // Last, so the reply cannot go out before this step is counted.
+  finish("platformThread", std::string(), MsSince(start), std::string());
+}
+
+void FlutterThermalPrinterPlugin::RecordJobStats(int64_t job_id,
+                                                 const std::string &printer,
+                                                 DWORD error,
+                                                 const JobTrace &trace) {
+  JobStageTimes times = ToStageTimes(trace, PerfCounterFrequency());
+  times.job_id = job_id;
+  times.printer = printer;
+  times.success = error == ERROR_SUCCESS;
+  job_stats_.Record(times);
+  if (stats_events_) {
+    stats_events_->Success(EncodeJobStageTimes(times));
+  }
+}
+
+void FlutterThermalPrinterPlugin::SendJobEvent(int64_t job_id,
+                                               const std::string &printer,
+                                               DWORD error) {
+  if (!job_events_) {
+    return;
+  }
+  EncodableMap event = {
+      {EncodableValue("jobId"), EncodableValue(job_id)},
+      {EncodableValue("printer"), EncodableValue(printer)},
+      {EncodableValue("success"), EncodableValue(error == ERROR_SUCCESS)},
+      {EncodableValue("cancelled"), EncodableValue(error == ERROR_CANCELLED)},
+  };
+  if (error != ERROR_SUCCESS) {
+    event[EncodableValue("error")] =
+        EncodableValue(Win32ErrorMessage("WritePrinter", error));
+  }
+  job_events_->Success(EncodableValue(event));
+}
+
+void FlutterThermalPrinterPlugin::HandleGetPrinters(MethodResultPtr result) {
+  if (!printers_ready_) {
+    if (!task_runner_->is_valid()) {
+      result->Error("UNAVAILABLE", "Printer watcher could not be started.");
+      return;
+    }
+    EnsurePrinterWatcher();
+    if (!printer_watcher_->is_running()) {
+      result->Error("UNAVAILABLE", "Printer watcher could not be started.");
+      return;
+    }
+    if (printers_error_ != ERROR_SUCCESS) {
+      result->Error("UNAVAILABLE",
+                    Win32ErrorMessage("EnumPrinters", printers_error_));
+      return;
+    }
+    // Replied to by the watcher's first batch.
+    pending_printer_results_.push_back(std::move(result));
+    return;
+  }
+  flutter::EncodableList printers;
+  printers.reserve(printers_.size());
+  for (const auto &entry : printers_) {
+    printers.push_back(EncodePrinter(entry.second));
+  }
+  result->Success(EncodableValue(printers));
+}
+
+void FlutterThermalPrinterPlugin::StartPrinterEvents(
+    std::unique_ptr<flutter::EventSink<flutter::EncodableValue>> events) {
+  printer_events_ = std::move(events);
+  if (!printers_ready_) {
+    // The first batch lists every printer as added.
+    EnsurePrinterWatcher();
+    return;
+  }
+  PrinterChanges snapshot;
+  for (const auto &entry : printers_) {
+    snapshot.added.push_back(entry.second);
+  }
+  printer_events_->Success(EncodePrinterChanges(snapshot));
+}
+
+void FlutterThermalPrinterPlugin::StopPrinterEvents() {
+  printer_events_.reset();
+}
+
+void FlutterThermalPrinterPlugin::EnsurePrinterWatcher() {
+  EnsureInitialized();
+  if (printer_watcher_) {
+    return;
+  }
+  PlatformTaskRunner *runner = task_runner_.get();
+  printer_watcher_ = std::make_unique<PrinterWatcher>(
+      [this, runner](const PrinterChanges &changes) {
+        // Watcher thread: hop to the platform thread before touching state.
+        runner->PostTask([this, changes]() {
+          if (!is_alive()) {
+            return;
+          }
+          OnPrinterChanges(changes);
+        });
+      });
+}
+
+void FlutterThermalPrinterPlugin::OnPrinterChanges(
+    const PrinterChanges &changes) {
+  std::vector<MethodResultPtr> pending;
+  pending.swap(pending_printer_results_);
+  if (changes.error != ERROR_SUCCESS) {
+    // Only sent before the first list. Later calls fail at once until the
+    // watcher's retry succeeds; stream listeners just keep waiting.
+    printers_error_ = changes.error;
+    for (MethodResultPtr &result : pending) {
+      result->Error("UNAVAILABLE",
+                    Win32ErrorMessage("EnumPrinters", changes.error));
+    }
+    return;
+  }
+  ApplyPrinterChanges(changes, &printers_);
+  printers_ready_ = true;
+  printers_error_ = ERROR_SUCCESS;
+  for (MethodResultPtr &result : pending) {
+    HandleGetPrinters(std::move(result));
+  }
+  if (printer_events_ && !changes.empty()) {
+    printer_events_->Success(EncodePrinterChanges(changes));
   }
 }
 
@@ -1,19 +1,45 @@
 #ifndef FLUTTER_PLUGIN_FLUTTER_THERMAL_PRINTER_PLUGIN_H_
 #define FLUTTER_PLUGIN_FLUTTER_THERMAL_PRINTER_PLUGIN_H_
 
+#include <flutter/binary_messenger.h>
+#include <flutter/event_channel.h>
 #include <flutter/method_channel.h>
 #include <flutter/plugin_registrar_windows.h>
 
 #include <atomic>
+#include <cstdint>
+#include <map>
 #include <memory>
+#include <string>
+#include <vector>
+
+#include "job_stats.h"
+#include "nv_graphics.h"
+#include "platform_task_runner.h"
+#include "print_template.h"
+#include "printer_info.h"
+#include "printer_watcher.h"
+#include "printer_worker.h"
+#include "raster_cache.h"
+#include "task_queue.h"
+#include "tcp_printer.h"
+#include "thread_pool.h"
 
 namespace flutter_thermal_printer {
 
-/// Windows plugin: USB printer via Win32 only. No BLE, WinRT, or COM.
+/// Windows plugin. Each printer has a PrinterWorker driving one transport:
+/// the Win32 spooler (the default), the usbprint device directly, raw TCP
+/// (port 9100) through a shared connection pool, or a loopback sink for
+/// tests. Encoded images are decoded with WIC, with COM initialized only
+/// on the raster queue and print producer threads that decode. No BLE or
+/// WinRT.
 /// Constructor and RegisterWithRegistrar() do no work; safe at DLL load.
 /// All async/callbacks must check is_alive() before touching plugin state.
 class FlutterThermalPrinterPlugin : public flutter::Plugin {
  public:
+  using MethodResultPtr =
+      std::shared_ptr<flutter::MethodResult<flutter::EncodableValue>>;
+
   static void RegisterWithRegistrar(flutter::PluginRegistrarWindows *registrar);
 
   FlutterThermalPrinterPlugin();
@@ -29,11 +55,222 @@ class FlutterThermalPrinterPlugin : public flutter::Plugin {
       const flutter::MethodCall<flutter::EncodableValue> &method_call,
       std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
 
+  /// The method channel's raw handler; platform thread. Copies |message|
+  /// and decodes it on the message queue, so a large payload never stalls
+  /// the window's message loop, then dispatches the call back on the
+  /// platform thread. The reply is encoded wherever the result is set and
+  /// handed to |reply| on the platform thread.
+  void HandleMessage(const uint8_t *message, size_t message_size,
+                     flutter::BinaryReply reply);
+
  private:
-  /// No-op for this plugin (no native BLE/WinRT). Call from method handlers if needed.
+  /// Lazily creates the platform task runner that print workers report
+  /// back through. Must run on the platform thread.
   void EnsureInitialized();
 
+  /// HandleMethodCall() once the call is known to be for this plugin.
+  void DispatchMethodCall(
+      const flutter::MethodCall<flutter::EncodableValue> &method_call,
+      MethodResultPtr result);
+
+  /// Worker (and its thread) for |name|, started on first use.
+  PrinterWorker* GetWorker(const std::string &name);
+
+  /// Queues |job| on |name|'s worker; the worker's completion is marshalled
+  /// back to the platform thread and handed to |on_done|. Returns false,
+  /// without calling |on_done|, if the printer's queue is full.
+  bool EnqueueJob(const std::string &name, PrintJob job,
+                  std::function<void(DWORD error)> on_done);
+
+  /// Queues a document job that Dart awaits: |result| gets true when it is
+  /// spooled, or at once if |name| is inside a batch. |on_done|, if set,
+  /// sees the job's result first. Replies BUSY and returns false if the
+  /// printer's queue is full.
+  bool EnqueueSpooled(const std::string &name, PrintJob job,
+                      MethodResultPtr result,
+                      std::function<void(DWORD error)> on_done = nullptr);
+
+  /// The BUSY error for a job |name|'s worker refused.
+  void ReplyBusy(const std::string &name, MethodResultPtr result);
+
+  void HandleConnect(const flutter::EncodableMap &args,
+                     MethodResultPtr result);
+  void HandleDisconnect(const flutter::EncodableMap &args,
+                        MethodResultPtr result);
+  /// `isConnected`: if the printer answered its last status poll, whether
+  /// it reported itself online, at once. Otherwise, including always on
+  /// the spooler transport, which cannot poll, opens it behind the queued
+  /// jobs and replies whether that worked.
+  void HandleIsConnected(const flutter::EncodableMap &args,
+                         MethodResultPtr result);
+  /// `getStatus`: the status the printer's worker last polled (paper,
+  /// cover, online), without waiting on the printer.
+  void HandleGetStatus(const flutter::EncodableMap &args,
+                       MethodResultPtr result);
+  void HandlePrintText(const flutter::EncodableMap &args,
+                       MethodResultPtr result);
+  void HandleSubmitJob(const flutter::EncodableMap &args,
+                       MethodResultPtr result);
+  /// `cancelJob`: drops a queued job, or aborts a streaming one, by id.
+  /// Replies false if it already reached the spooler or finished.
+  void HandleCancelJob(const flutter::EncodableMap &args,
+                       MethodResultPtr result);
+  /// `setQueueLimit`: bytes a printer's unfinished jobs may hold before
+  /// new ones are refused with BUSY; zero for no limit.
+  void HandleSetQueueLimit(const flutter::EncodableMap &args,
+                           MethodResultPtr result);
+  /// `printBuffer`: prints a buffer Dart filled in place through
+  /// FlutterThermalPrinterLeaseBuffer(); replies when it is spooled.
+  void HandlePrintBuffer(const flutter::EncodableMap &args,
+                         MethodResultPtr result);
+  /// `encodeText`: lays out receipt `rows` (styled text, columns, rules,
+  /// feeds, cuts) as ESC/POS bytes in the requested code page. Touches no
+  /// plugin state, so HandleMessage() runs it on the message queue.
+  void HandleEncodeText(const flutter::EncodableMap &args,
+                        MethodResultPtr result);
+  /// `convertimage`: RGBA pixels -> `GS v 0` raster bytes, off-thread.
+  void HandleConvertImage(const flutter::EncodableMap &args,
+                          MethodResultPtr result);
+  /// `printImage`: rasterizes band by band straight into one spooler
+  /// document, replying when the document is spooled.
+  void HandlePrintImage(const flutter::EncodableMap &args,
+                        MethodResultPtr result);
+
+  /// `setTransport`: switches a printer between the spooler, direct
+  /// usbprint writes and raw TCP, after the jobs already queued for it. For
+  /// USB, `chunkSize` and `maxInFlight` size the overlapped write window;
+  /// for the network, `host` (default: the printer's address), `port`
+  /// (default 9100) and `connectTimeoutMs` pick and reach the printer.
+  void HandleSetTransport(const flutter::EncodableMap &args,
+                          MethodResultPtr result);
+
+  /// `beginBatch` / `endBatch`: jobs queued in between are written as one
+  /// document; `endBatch` replies once it is spooled.
+  void HandleBeginBatch(const flutter::EncodableMap &args,
+                        MethodResultPtr result);
+  void HandleEndBatch(const flutter::EncodableMap &args,
+                      MethodResultPtr result);
+  /// `setBatchWindow`: how long the worker waits to merge more writes.
+  void HandleSetBatchWindow(const flutter::EncodableMap &args,
+                            MethodResultPtr result);
+
+  /// `registerTemplate` / `removeTemplate`: pre-encoded tickets kept in
+  /// |templates_| with named field offsets.
+  void HandleRegisterTemplate(const flutter::EncodableMap &args,
+                              MethodResultPtr result);
+  void HandleRemoveTemplate(const flutter::EncodableMap &args,
+                            MethodResultPtr result);
+  /// `printToMany`: one document to several printers at once. The bytes
+  /// are read once and shared by every printer's job; replies when all of
+  /// them finish with each printer's outcome (null, or why it failed).
+  void HandlePrintToMany(const flutter::EncodableMap &args,
+                         MethodResultPtr result);
+  /// `printTemplate`: a registered template with only the field values sent
+  /// over the channel; replies when it is spooled.
+  void HandlePrintTemplate(const flutter::EncodableMap &args,
+                           MethodResultPtr result);
+
+  /// `storeLogo`: rasterizes an image into the printer's NV graphics memory
+  /// under a two-character key, unless |nv_graphics_| says the printer
+  /// already holds it. Replies true once uploaded, false if skipped.
+  void HandleStoreLogo(const flutter::EncodableMap &args,
+                       MethodResultPtr result);
+  /// `printLogo`: prints a stored NV graphic by key; a few bytes instead of
+  /// the raster.
+  void HandlePrintLogo(const flutter::EncodableMap &args,
+                       MethodResultPtr result);
+
+  /// `getJobStats`: per-printer stage percentiles and the latest jobs.
+  void HandleGetJobStats(const flutter::EncodableMap &args,
+                         MethodResultPtr result);
+
+  /// `warmUp`: does the work a first print would otherwise pay for, off the
+  /// platform thread: the printer enumeration, the raster kernel dispatch
+  /// and threads, and each listed printer's buffer pool and spooler handle.
+  /// Replies once all of it is done with how long each step took.
+  void HandleWarmUp(const flutter::EncodableMap &args, MethodResultPtr result);
+
+  /// Starts |raster_queue_| and |raster_pool_| if they are not running.
+  void EnsureRasterQueue();
+
+  /// Folds a finished job's trace into |job_stats_| and, if Dart listens,
+  /// sends it on `flutter_thermal_printer/stats`.
+  void RecordJobStats(int64_t job_id, const std::string &printer, DWORD error,
+                      const JobTrace &trace);
+
+  /// Sends a job completion to the `flutter_thermal_printer/jobs` stream.
+  void SendJobEvent(int64_t job_id, const std::string &printer, DWORD error);
+
+  /// `getPrinters`: the cached printer list. Answered without a syscall
+  /// once the watcher has reported its first enumeration; fails with
+  /// UNAVAILABLE while the watcher cannot run or enumerate.
+  void HandleGetPrinters(MethodResultPtr result);
+
+  /// `flutter_thermal_printer/printers` listen/cancel. Platform thread only.
+  void StartPrinterEvents(
+      std::unique_ptr<flutter::EventSink<flutter::EncodableValue>> events);
+  void StopPrinterEvents();
+
+  /// Starts the printer watcher that keeps |printers_| current.
+  void EnsurePrinterWatcher();
+
+  /// Platform thread: folds one watcher batch into |printers_| and forwards
+  /// it to Dart.
+  void OnPrinterChanges(const PrinterChanges &changes);
+
   std::atomic<bool> alive_{true};
+
+  std::unique_ptr<PlatformTaskRunner> task_runner_;
+
+  // Keyed by the UTF-8 queue name Dart uses. Each owns a cached spooler
+  // handle and a thread; destroyed before |task_runner_|.
+  std::map<std::string, std::unique_ptr<PrinterWorker>> workers_;
+
+  // Started by the first HandleMessage(). Decodes method calls in the
+  // order they arrived; destroyed before |task_runner_|.
+  std::unique_ptr<TaskQueue> message_queue_;
+
+  // Started on the first `convertimage` or `warmUp` call. The queue
+  // serializes requests; the pool converts bands of one request in parallel.
+  std::unique_ptr<TaskQueue> raster_queue_;
+  std::unique_ptr<ThreadPool> raster_pool_;
+
+  // Finished rasters of repeated images, shared with the raster queue and
+  // the print workers' producers.
+  std::shared_ptr<RasterCache> raster_cache_ = std::make_shared<RasterCache>();
+
+  // Connections to network printers, kept open between tickets. Shared
+  // with the TcpPrinter transports on the print workers.
+  std::shared_ptr<TcpConnectionPool> tcp_pool_;
+
+  int64_t next_job_id_ = 1;
+
+  // Printers between `beginBatch` and `endBatch`, each with the first error
+  // of its batched jobs. Platform thread only.
+  std::map<std::string, std::shared_ptr<DWORD>> batches_;
+
+  // Platform thread only. Queued jobs hold their own reference.
+  TemplateStore templates_;
+
+  // NV graphics uploaded per printer since startup. Platform thread only.
+  NvGraphicsRegistry nv_graphics_;
+
+  std::unique_ptr<flutter::EventSink<flutter::EncodableValue>> job_events_;
+
+  // Platform thread only.
+  JobStats job_stats_;
+  std::unique_ptr<flutter::EventSink<flutter::EncodableValue>> stats_events_;
+
+  // Started by the first `getPrinters` call or printer stream listener and
+  // kept running; it only wakes when the spooler or USB stack reports a
+  // change. |printers_| mirrors its last enumeration.
+  std::unique_ptr<PrinterWatcher> printer_watcher_;
+  PrinterMap printers_;
+  bool printers_ready_ = false;
+  // Why the last enumeration failed while |printers_ready_| is false.
+  DWORD printers_error_ = ERROR_SUCCESS;
+  std::vector<MethodResultPtr> pending_printer_results_;
+  std::unique_ptr<flutter::EventSink<flutter::EncodableValue>> printer_events_;
 };
 
 }  // namespace flutter_thermal_printer
@@ -2,6 +2,7 @@
 
 #include <flutter/plugin_registrar_windows.h>
 
+#include "buffer_pool.h"
 #include "flutter_thermal_printer_plugin.h"
 
 void FlutterThermalPrinterPluginCApiRegisterWithRegistrar(
@@ -10,3 +11,16 @@ void FlutterThermalPrinterPluginCApiRegisterWithRegistrar(
       flutter::PluginRegistrarManager::GetInstance()
           ->GetRegistrar<flutter::PluginRegistrarWindows>(registrar));
 }
+
+uint8_t* FlutterThermalPrinterLeaseBuffer(const char* printer, size_t size,
+                                          int64_t* lease) {
+  if (printer == nullptr || lease == nullptr) {
+    return nullptr;
+  }
+  return flutter_thermal_printer::PrinterBuffers::Get().Lease(printer, size,
+                                                              lease);
+}
+
+void FlutterThermalPrinterReleaseBuffer(int64_t lease) {
+  flutter_thermal_printer::PrinterBuffers::Get().Release(lease);
+}
@@ -2,6 +2,8 @@
 #define FLUTTER_PLUGIN_FLUTTER_THERMAL_PRINTER_PLUGIN_C_API_H_
 
 #include <flutter_plugin_registrar.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #ifdef FLUTTER_PLUGIN_IMPL
 #define FLUTTER_PLUGIN_EXPORT __declspec(dllexport)
@@ -16,6 +18,17 @@ extern "C" {
 FLUTTER_PLUGIN_EXPORT void FlutterThermalPrinterPluginCApiRegisterWithRegistrar(
     FlutterDesktopPluginRegistrarRef registrar);
 
+// Called from Dart through dart:ffi. Leases |size| writable bytes from the
+// buffer pool of |printer| (a UTF-8 queue name) and stores the lease id in
+// |lease|. The bytes are printed with the `printBuffer` method, which ends
+// the lease, or returned with FlutterThermalPrinterReleaseBuffer(). Returns
+// NULL if no buffer is available. Thread-safe.
+FLUTTER_PLUGIN_EXPORT uint8_t* FlutterThermalPrinterLeaseBuffer(
+    const char* printer, size_t size, int64_t* lease);
+
+// Ends |lease| without printing it.
+FLUTTER_PLUGIN_EXPORT void FlutterThermalPrinterReleaseBuffer(int64_t lease);
+
 #if defined(__cplusplus)
 }  // extern "C"
 #endif
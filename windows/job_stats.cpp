@@ -0,0 +1,107 @@
+#include "job_stats.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace flutter_thermal_printer {
+
+namespace {
+
+double TicksToMs(int64_t ticks, int64_t frequency) {
+  if (ticks <= 0 || frequency <= 0) {
+    return 0;
+  }
+  return static_cast<double>(ticks) * 1000.0 / static_cast<double>(frequency);
+}
+
+double Between(int64_t from, int64_t to, int64_t frequency) {
+  return from != 0 && to >= from ? TicksToMs(to - from, frequency) : 0;
+}
+
+// Nearest rank on a sorted prefix; |samples| must be non-empty.
+double Rank(std::vector<double> *samples, double percentile) {
+  const size_t n = samples->size();
+  size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * n));
+  rank = std::min(std::max<size_t>(rank, 1), n) - 1;
+  std::nth_element(samples->begin(), samples->begin() + rank, samples->end());
+  return (*samples)[rank];
+}
+
+}  // namespace
+
+JobStageTimes ToStageTimes(const JobTrace &trace, int64_t frequency) {
+  JobStageTimes times;
+  times.bytes = trace.bytes;
+  times.queue_ms = Between(trace.received, trace.started, frequency);
+  times.raster_ms =
+      TicksToMs(trace.raster_ticks.load(std::memory_order_relaxed), frequency);
+  times.spool_ms = Between(trace.spool_begin, trace.spool_end, frequency);
+  times.total_ms = Between(trace.received, trace.finished, frequency);
+  return times;
+}
+
+Percentiles ComputePercentiles(std::vector<double> *samples) {
+  Percentiles result;
+  if (samples->empty()) {
+    return result;
+  }
+  result.p50 = Rank(samples, 50);
+  result.p95 = Rank(samples, 95);
+  result.p99 = Rank(samples, 99);
+  return result;
+}
+
+void JobStats::Record(const JobStageTimes &times) {
+  PrinterHistory &history = printers_[times.printer];
+  ++history.jobs;
+  if (!times.success) {
+    ++history.failures;
+  }
+  history.bytes += times.bytes;
+  history.window.push_back(times);
+  if (history.window.size() > kWindow) {
+    history.window.pop_front();
+  }
+  recent_.push_back(times);
+  if (recent_.size() > kRecent) {
+    recent_.pop_front();
+  }
+}
+
+std::vector<std::string> JobStats::printers() const {
+  std::vector<std::string> names;
+  names.reserve(printers_.size());
+  for (const auto &entry : printers_) {
+    names.push_back(entry.first);
+  }
+  return names;
+}
+
+PrinterJobSummary JobStats::Summary(const std::string &printer) const {
+  PrinterJobSummary summary;
+  auto it = printers_.find(printer);
+  if (it == printers_.end()) {
+    return summary;
+  }
+  const PrinterHistory &history = it->second;
+  summary.jobs = history.jobs;
+  summary.failures = history.failures;
+  summary.bytes = history.bytes;
+
+  std::vector<double> samples;
+  samples.reserve(history.window.size());
+  auto percentiles = [&](double JobStageTimes::*stage) {
+    samples.clear();
+    for (const JobStageTimes &times : history.window) {
+      samples.push_back(times.*stage);
+    }
+    return ComputePercentiles(&samples);
+  };
+  summary.queue_ms = percentiles(&JobStageTimes::queue_ms);
+  summary.raster_ms = percentiles(&JobStageTimes::raster_ms);
+  summary.spool_ms = percentiles(&JobStageTimes::spool_ms);
+  summary.total_ms = percentiles(&JobStageTimes::total_ms);
+  return summary;
+}
+
+}  // namespace flutter_thermal_printer
@@ -0,0 +1,102 @@
+#ifndef FLUTTER_PLUGIN_JOB_STATS_H_
+#define FLUTTER_PLUGIN_JOB_STATS_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace flutter_thermal_printer {
+
+/// High-resolution timestamps (QueryPerformanceCounter ticks) for one job
+/// as it moves through the pipeline. Zero means the stage did not happen.
+/// Each field is written by one thread and read on the platform thread
+/// after the job's completion has been posted there. |raster_ticks| is
+/// atomic because a failed job completes while its producer may still run.
+struct JobTrace {
+  int64_t received = 0;  // Method call handled (platform thread).
+  int64_t started = 0;   // Worker took the job off its queue.
+  std::atomic<int64_t> raster_ticks{0};  // Producer time spent rasterizing.
+  int64_t spool_begin = 0;               // Document opened with the spooler.
+  int64_t spool_end = 0;  // Document closed (or the write failed).
+  int64_t finished = 0;   // Completion seen on the platform thread.
+  uint64_t bytes = 0;     // Bytes handed to the spooler.
+};
+
+/// Per-stage durations of one finished job, in milliseconds.
+struct JobStageTimes {
+  int64_t job_id = 0;
+  std::string printer;
+  uint64_t bytes = 0;
+  bool success = false;
+
+  double queue_ms = 0;   // received -> started
+  double raster_ms = 0;  // rasterization inside the job
+  double spool_ms = 0;   // spool_begin -> spool_end
+  double total_ms = 0;   // received -> finished
+};
+
+/// Converts |trace| to durations using the tick |frequency| (ticks per
+/// second).
+JobStageTimes ToStageTimes(const JobTrace &trace, int64_t frequency);
+
+struct Percentiles {
+  double p50 = 0;
+  double p95 = 0;
+  double p99 = 0;
+};
+
+/// Aggregate view of one printer's recent jobs.
+struct PrinterJobSummary {
+  uint64_t jobs = 0;      // Since the plugin started.
+  uint64_t failures = 0;  // Since the plugin started.
+  uint64_t bytes = 0;     // Since the plugin started.
+
+  // Over the last JobStats::kWindow jobs.
+  Percentiles queue_ms;
+  Percentiles raster_ms;
+  Percentiles spool_ms;
+  Percentiles total_ms;
+};
+
+/// Nearest-rank percentiles of |samples| (which is reordered).
+Percentiles ComputePercentiles(std::vector<double> *samples);
+
+/// Rolling per-printer job statistics. Not thread-safe; the plugin only
+/// touches it from the platform thread.
+class JobStats {
+ public:
+  /// Samples kept per printer for the percentiles.
+  static constexpr size_t kWindow = 512;
+
+  /// Most recent jobs kept for recent().
+  static constexpr size_t kRecent = 64;
+
+  void Record(const JobStageTimes &times);
+
+  /// Latest jobs, oldest first.
+  const std::deque<JobStageTimes> &recent() const { return recent_; }
+
+  std::vector<std::string> printers() const;
+
+  /// Summary for |printer|; all zeros if it has no jobs.
+  PrinterJobSummary Summary(const std::string &printer) const;
+
+ private:
+  struct PrinterHistory {
+    uint64_t jobs = 0;
+    uint64_t failures = 0;
+    uint64_t bytes = 0;
+    std::deque<JobStageTimes> window;
+  };
+
+  std::map<std::string, PrinterHistory> printers_;
+  std::deque<JobStageTimes> recent_;
+};
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_JOB_STATS_H_
@@ -0,0 +1,183 @@
+#include "loopback_printer.h"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+namespace flutter_thermal_printer {
+
+namespace {
+
+bool IsPipePath(const std::wstring &path) {
+  return path.rfind(L"\\\\.\\pipe\\", 0) == 0;
+}
+
+}  // namespace
+
+LoopbackRecord::LoopbackRecord(size_t max_captured_bytes)
+    : max_captured_bytes_(max_captured_bytes) {}
+
+uint64_t LoopbackRecord::documents() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return documents_;
+}
+
+uint64_t LoopbackRecord::bytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return bytes_;
+}
+
+uint64_t LoopbackRecord::aborted() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return aborted_;
+}
+
+std::vector<std::vector<uint8_t>> LoopbackRecord::captured() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return captured_;
+}
+
+void LoopbackRecord::Begin() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  open_.clear();
+  capturing_ = captured_bytes_ < max_captured_bytes_;
+}
+
+void LoopbackRecord::Append(const uint8_t *data, size_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  bytes_ += size;
+  if (!capturing_) {
+    return;
+  }
+  if (captured_bytes_ + open_.size() + size > max_captured_bytes_) {
+    capturing_ = false;
+    open_ = {};
+    return;
+  }
+  open_.insert(open_.end(), data, data + size);
+}
+
+void LoopbackRecord::End() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++documents_;
+  if (capturing_) {
+    captured_bytes_ += open_.size();
+    captured_.push_back(std::move(open_));
+  }
+  open_ = {};
+  capturing_ = false;
+}
+
+void LoopbackRecord::Abort() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++aborted_;
+  open_ = {};
+  capturing_ = false;
+}
+
+LoopbackPrinter::LoopbackPrinter(std::wstring name, LoopbackOptions options,
+                                 std::shared_ptr<LoopbackRecord> record)
+    : name_(std::move(name)),
+      options_(std::move(options)),
+      record_(std::move(record)) {}
+
+LoopbackPrinter::~LoopbackPrinter() { Close(); }
+
+DWORD LoopbackPrinter::Open() {
+  if (open_) {
+    return ERROR_SUCCESS;
+  }
+  if (!options_.path.empty()) {
+    // Pipes must already be listening; files collect every document.
+    const bool pipe = IsPipePath(options_.path);
+    file_ = CreateFileW(options_.path.c_str(),
+                        pipe ? GENERIC_WRITE : FILE_APPEND_DATA,
+                        FILE_SHARE_READ, nullptr,
+                        pipe ? OPEN_EXISTING : OPEN_ALWAYS,
+                        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE) {
+      return GetLastError();
+    }
+  }
+  open_ = true;
+  line_free_at_ = std::chrono::steady_clock::now();
+  return ERROR_SUCCESS;
+}
+
+void LoopbackPrinter::Close() {
+  if (file_ != INVALID_HANDLE_VALUE) {
+    CloseHandle(file_);
+    file_ = INVALID_HANDLE_VALUE;
+  }
+  open_ = false;
+}
+
+DWORD LoopbackPrinter::WriteDocument(const uint8_t* data, size_t size) {
+  DWORD error = BeginDocument();
+  if (error == ERROR_SUCCESS) {
+    error = Write(data, size);
+  }
+  if (error != ERROR_SUCCESS) {
+    AbortDocument();
+    return error;
+  }
+  return EndDocument();
+}
+
+DWORD LoopbackPrinter::BeginDocument() {
+  const DWORD error = Open();
+  if (error != ERROR_SUCCESS) {
+    return error;
+  }
+  const auto now = std::chrono::steady_clock::now();
+  line_free_at_ = std::max(line_free_at_, now) +
+                  std::chrono::milliseconds(options_.latency_ms);
+  if (record_) {
+    record_->Begin();
+  }
+  return ERROR_SUCCESS;
+}
+
+DWORD LoopbackPrinter::Write(const uint8_t* data, size_t size) {
+  if (!open_) {
+    return ERROR_INVALID_HANDLE;
+  }
+  size_t written = 0;
+  while (file_ != INVALID_HANDLE_VALUE && written < size) {
+    const DWORD chunk =
+        static_cast<DWORD>(std::min<size_t>(size - written, 1u << 30));
+    DWORD sent = 0;
+    if (!WriteFile(file_, data + written, chunk, &sent, nullptr)) {
+      return GetLastError();
+    }
+    written += sent;
+  }
+  if (record_) {
+    record_->Append(data, size);
+  }
+  if (options_.baud_rate != 0) {
+    const auto busy = std::chrono::duration_cast<
+        std::chrono::steady_clock::duration>(std::chrono::duration<double>(
+        static_cast<double>(size) * 10.0 / options_.baud_rate));
+    line_free_at_ =
+        std::max(line_free_at_, std::chrono::steady_clock::now()) + busy;
+  }
+  std::this_thread::sleep_until(line_free_at_);
+  return ERROR_SUCCESS;
+}
+
+DWORD LoopbackPrinter::EndDocument() {
+  std::this_thread::sleep_until(line_free_at_);
+  if (record_) {
+    record_->End();
+  }
+  return ERROR_SUCCESS;
+}
+
+void LoopbackPrinter::AbortDocument() {
+  if (record_) {
+    record_->Abort();
+  }
+}
+
+}  // namespace flutter_thermal_printer
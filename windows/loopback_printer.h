@@ -0,0 +1,108 @@
+#ifndef FLUTTER_PLUGIN_LOOPBACK_PRINTER_H_
+#define FLUTTER_PLUGIN_LOOPBACK_PRINTER_H_
+
+#include <windows.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "printer_transport.h"
+
+namespace flutter_thermal_printer {
+
+struct LoopbackOptions {
+  /// Where documents go: empty discards them, anything else is a file to
+  /// append to or a named pipe (`\\.\pipe\...`) for a harness to read.
+  std::wstring path;
+  /// Simulated serial line speed, ten bit times per byte (8N1); 0 takes
+  /// bytes as fast as they come.
+  uint32_t baud_rate = 0;
+  /// Added before each document's first byte, like a spooler or network
+  /// round trip.
+  uint32_t latency_ms = 0;
+};
+
+/// What a LoopbackPrinter was sent, shared with whoever created it.
+/// Thread-safe.
+class LoopbackRecord {
+ public:
+  /// Keeps the bytes of the first documents up to |max_captured_bytes| in
+  /// total; 0 only counts.
+  explicit LoopbackRecord(size_t max_captured_bytes = 0);
+
+  uint64_t documents() const;
+  uint64_t bytes() const;
+  uint64_t aborted() const;
+
+  /// The captured documents, in the order they finished.
+  std::vector<std::vector<uint8_t>> captured() const;
+
+ private:
+  friend class LoopbackPrinter;
+
+  void Begin();
+  void Append(const uint8_t *data, size_t size);
+  void End();
+  void Abort();
+
+  const size_t max_captured_bytes_;
+  mutable std::mutex mutex_;
+  uint64_t documents_ = 0;
+  uint64_t bytes_ = 0;
+  uint64_t aborted_ = 0;
+  size_t captured_bytes_ = 0;
+  std::vector<std::vector<uint8_t>> captured_;
+  // The document being written; dropped when it would pass the cap.
+  std::vector<uint8_t> open_;
+  bool capturing_ = false;
+};
+
+/// A printer without hardware: consumes documents at a configurable pace
+/// and writes them to nowhere, a file or a pipe, so the queue, batching and
+/// backpressure can be measured deterministically. Not thread-safe;
+/// callers serialize.
+class LoopbackPrinter : public PrinterTransport {
+ public:
+  /// |record| may be null.
+  LoopbackPrinter(std::wstring name, LoopbackOptions options,
+                  std::shared_ptr<LoopbackRecord> record = nullptr);
+  ~LoopbackPrinter() override;
+
+  LoopbackPrinter(const LoopbackPrinter&) = delete;
+  LoopbackPrinter& operator=(const LoopbackPrinter&) = delete;
+
+  const std::wstring& name() const override { return name_; }
+  bool is_open() const override { return open_; }
+
+  /// Opens |path|; always succeeds when there is none.
+  DWORD Open() override;
+  void Close() override;
+
+  DWORD WriteDocument(const uint8_t* data, size_t size) override;
+  DWORD BeginDocument() override;
+
+  /// Returns once the simulated line has carried |data|.
+  DWORD Write(const uint8_t* data, size_t size) override;
+  DWORD EndDocument() override;
+  void AbortDocument() override;
+
+  const LoopbackOptions& options() const { return options_; }
+
+ private:
+  std::wstring name_;
+  const LoopbackOptions options_;
+  std::shared_ptr<LoopbackRecord> record_;
+  bool open_ = false;
+  HANDLE file_ = INVALID_HANDLE_VALUE;
+  // When the simulated line finishes the bytes already written.
+  std::chrono::steady_clock::time_point line_free_at_;
+};
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_LOOPBACK_PRINTER_H_
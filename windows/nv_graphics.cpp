@@ -0,0 +1,133 @@
+#include "nv_graphics.h"
+
+#include "raster_cache.h"
+#include "raster_resampler.h"
+
+namespace flutter_thermal_printer {
+
+namespace {
+
+// m fn a kc1 kc2 b xL xH yL yH c: the function 67 bytes before the dots.
+constexpr size_t kDefineParamBytes = 11;
+
+// `GS ( L` carries a 16-bit parameter length; `GS 8 L` a 32-bit one.
+constexpr size_t kMaxShortParamBytes = 0xFFFF;
+
+void AppendLength(size_t value, int bytes, std::vector<uint8_t> *out) {
+  for (int i = 0; i < bytes; ++i) {
+    out->push_back(static_cast<uint8_t>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+}  // namespace
+
+bool IsValidNvGraphicsKey(const std::string &key) {
+  if (key.size() != 2) {
+    return false;
+  }
+  for (char c : key) {
+    if (c < 32 || c > 126) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool AppendNvGraphicsDefine(const std::string &key, const uint8_t *rgba,
+                            size_t size, int width, int height,
+                            const RasterOptions &options,
+                            std::vector<uint8_t> *out) {
+  if (!IsValidNvGraphicsKey(key) || width <= 0 || height <= 0 ||
+      size != static_cast<size_t>(width) * static_cast<size_t>(height) * 4) {
+    return false;
+  }
+  int dots = 0;
+  int rows = 0;
+  RasterOutputSize(width, height, options, &dots, &rows);
+  if (dots > kMaxNvGraphicsWidth || rows > kMaxNvGraphicsHeight) {
+    return false;
+  }
+  RasterEncoder encoder(dots, options);
+  const size_t row_bytes = static_cast<size_t>(encoder.bytes_per_row());
+  const size_t params = kDefineParamBytes + row_bytes * rows;
+
+  out->reserve(out->size() + 7 + params);
+  if (params <= kMaxShortParamBytes) {
+    out->insert(out->end(), {0x1D, 0x28, 0x4C});
+    AppendLength(params, 2, out);
+  } else {
+    out->insert(out->end(), {0x1D, 0x38, 0x4C});
+    AppendLength(params, 4, out);
+  }
+  // m=48, fn=67 (define NV graphics), a=48 (raster), key, b=1 color.
+  out->insert(out->end(), {0x30, 0x43, 0x30});
+  out->push_back(static_cast<uint8_t>(key[0]));
+  out->push_back(static_cast<uint8_t>(key[1]));
+  out->push_back(0x01);
+  AppendLength(static_cast<size_t>(dots), 2, out);
+  AppendLength(static_cast<size_t>(rows), 2, out);
+  out->push_back(0x31);  // c=49: the dots print in the first color.
+
+  size_t offset = out->size();
+  out->resize(offset + row_bytes * rows);
+  const size_t src_stride = static_cast<size_t>(width) * 4;
+  if (dots == width) {
+    for (int y = 0; y < height; ++y, offset += row_bytes) {
+      encoder.EncodeRgbaRow(rgba + src_stride * y, out->data() + offset);
+    }
+    return true;
+  }
+  ScaledGrayRows scaled(
+      [rgba, src_stride](int first_row, int) {
+        return rgba + src_stride * first_row;
+      },
+      width, height, dots, rows);
+  for (int y = 0; y < rows; ++y, offset += row_bytes) {
+    encoder.EncodeGrayRow(scaled.Row(y), out->data() + offset);
+  }
+  return true;
+}
+
+void AppendNvGraphicsPrint(const std::string &key, std::vector<uint8_t> *out) {
+  // m=48, fn=69, key, horizontal and vertical scale 1.
+  out->insert(out->end(), {0x1D, 0x28, 0x4C, 0x06, 0x00, 0x30, 0x45});
+  out->push_back(static_cast<uint8_t>(key[0]));
+  out->push_back(static_cast<uint8_t>(key[1]));
+  out->insert(out->end(), {0x01, 0x01});
+}
+
+uint64_t NvGraphicsHash(const uint8_t *rgba, size_t size, int width,
+                        int height, const RasterOptions &options) {
+  const uint64_t seed =
+      (static_cast<uint64_t>(options.scale_width) << 48) |
+      (static_cast<uint64_t>(width) << 32) |
+      (static_cast<uint64_t>(height) << 16) |
+      (static_cast<uint64_t>(options.dither) << 8) | options.threshold;
+  return HashBytes(rgba, size, seed);
+}
+
+bool NvGraphicsRegistry::Holds(const std::string &printer,
+                               const std::string &key, uint64_t hash) const {
+  auto it = held_.find({printer, key});
+  return it != held_.end() && it->second == hash;
+}
+
+bool NvGraphicsRegistry::HasKey(const std::string &printer,
+                                const std::string &key) const {
+  return held_.find({printer, key}) != held_.end();
+}
+
+void NvGraphicsRegistry::Record(const std::string &printer,
+                                const std::string &key, uint64_t hash) {
+  held_[{printer, key}] = hash;
+}
+
+void NvGraphicsRegistry::Forget(const std::string &printer,
+                                const std::string &key, uint64_t hash) {
+  auto it = held_.find({printer, key});
+  if (it != held_.end() && it->second == hash) {
+    held_.erase(it);
+  }
+}
+
+}  // namespace flutter_thermal_printer
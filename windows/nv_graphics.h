@@ -0,0 +1,67 @@
+#ifndef FLUTTER_PLUGIN_NV_GRAPHICS_H_
+#define FLUTTER_PLUGIN_NV_GRAPHICS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "raster_engine.h"
+
+namespace flutter_thermal_printer {
+
+/// Largest graphic `GS ( L` function 67 accepts, in dots.
+constexpr int kMaxNvGraphicsWidth = 8192;
+constexpr int kMaxNvGraphicsHeight = 2304;
+
+/// NV graphics are addressed by two printable ASCII characters (32-126).
+bool IsValidNvGraphicsKey(const std::string &key);
+
+/// Appends the `GS ( L` / `GS 8 L` function 67 command that stores an RGBA
+/// image in the printer's non-volatile memory under |key|, one bit per dot
+/// as the raster engine converts it (resampled to |options.scale_width|
+/// when set). The `GS 8 L` form is used once the data outgrows a 16-bit
+/// length. Returns false for an invalid key, a size that does not match
+/// |size| or a graphic larger than the printer takes.
+bool AppendNvGraphicsDefine(const std::string &key, const uint8_t *rgba,
+                            size_t size, int width, int height,
+                            const RasterOptions &options,
+                            std::vector<uint8_t> *out);
+
+/// Appends `GS ( L` function 69: print the NV graphic stored under |key|
+/// at normal size. |key| must be valid.
+void AppendNvGraphicsPrint(const std::string &key, std::vector<uint8_t> *out);
+
+/// Identifies an NV upload: the pixels and every option that changes the
+/// stored dots.
+uint64_t NvGraphicsHash(const uint8_t *rgba, size_t size, int width,
+                        int height, const RasterOptions &options);
+
+/// Which image (by NvGraphicsHash) each printer holds under each key, so a
+/// logo is written to printer memory once instead of with every ticket.
+/// Entries are recorded when the upload is queued, so a print by key right
+/// behind it is accepted, and dropped again if the upload fails. Only
+/// covers uploads made since the plugin started. Not thread-safe.
+class NvGraphicsRegistry {
+ public:
+  bool Holds(const std::string &printer, const std::string &key,
+             uint64_t hash) const;
+  bool HasKey(const std::string &printer, const std::string &key) const;
+
+  void Record(const std::string &printer, const std::string &key,
+              uint64_t hash);
+
+  /// Forgets |key| on |printer| if it still refers to |hash|; a newer
+  /// upload under the same key is kept.
+  void Forget(const std::string &printer, const std::string &key,
+              uint64_t hash);
+
+ private:
+  std::map<std::pair<std::string, std::string>, uint64_t> held_;
+};
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_NV_GRAPHICS_H_
@@ -0,0 +1,160 @@
+#include "overlapped_writer.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace flutter_thermal_printer {
+
+namespace {
+
+OverlappedWriteOptions Normalize(OverlappedWriteOptions options) {
+  const OverlappedWriteOptions defaults;
+  if (options.chunk_size == 0) {
+    options.chunk_size = defaults.chunk_size;
+  }
+  if (options.max_in_flight == 0) {
+    options.max_in_flight = defaults.max_in_flight;
+  }
+  if (options.timeout_ms == 0) {
+    options.timeout_ms = defaults.timeout_ms;
+  }
+  return options;
+}
+
+}  // namespace
+
+OverlappedWriter::OverlappedWriter(OverlappedWriteOptions options)
+    : options_(Normalize(options)) {}
+
+OverlappedWriter::~OverlappedWriter() { Detach(); }
+
+DWORD OverlappedWriter::Attach(HANDLE device) {
+  Detach();
+  HANDLE port = CreateIoCompletionPort(device, nullptr, 0, 1);
+  if (port == nullptr) {
+    return GetLastError();
+  }
+  device_ = device;
+  port_ = port;
+  error_ = ERROR_SUCCESS;
+  return ERROR_SUCCESS;
+}
+
+void OverlappedWriter::Detach() {
+  if (port_ == nullptr) {
+    return;
+  }
+  Cancel();
+  CloseHandle(port_);
+  port_ = nullptr;
+  device_ = INVALID_HANDLE_VALUE;
+}
+
+OverlappedWriter::Slot* OverlappedWriter::FreeSlot() {
+  for (const auto& slot : slots_) {
+    if (!slot->busy) {
+      return slot.get();
+    }
+  }
+  if (slots_.size() < options_.max_in_flight) {
+    slots_.push_back(std::make_unique<Slot>());
+    slots_.back()->buffer.resize(options_.chunk_size);
+    return slots_.back().get();
+  }
+  return nullptr;
+}
+
+DWORD OverlappedWriter::Write(const uint8_t* data, size_t size) {
+  if (port_ == nullptr) {
+    return ERROR_INVALID_HANDLE;
+  }
+  size_t offset = 0;
+  while (offset < size && error_ == ERROR_SUCCESS) {
+    Slot* slot = FreeSlot();
+    if (slot == nullptr) {
+      if (!ReapOne(options_.timeout_ms)) {
+        Cancel();
+        RecordError(ERROR_TIMEOUT);
+      }
+      continue;
+    }
+    const DWORD length =
+        static_cast<DWORD>(std::min(size - offset, options_.chunk_size));
+    std::memcpy(slot->buffer.data(), data + offset, length);
+    slot->overlapped = OVERLAPPED{};
+    slot->length = length;
+    // A write that completes at once still posts its packet to the port, so
+    // every accepted write is reaped the same way.
+    if (!WriteFile(device_, slot->buffer.data(), length, nullptr,
+                   &slot->overlapped)) {
+      const DWORD error = GetLastError();
+      if (error != ERROR_IO_PENDING) {
+        RecordError(error);
+        break;
+      }
+    }
+    slot->busy = true;
+    ++in_flight_;
+    offset += length;
+  }
+  return error_;
+}
+
+DWORD OverlappedWriter::Flush() {
+  while (in_flight_ > 0) {
+    if (!ReapOne(options_.timeout_ms)) {
+      Cancel();
+      RecordError(ERROR_TIMEOUT);
+      break;
+    }
+  }
+  const DWORD error = error_;
+  error_ = ERROR_SUCCESS;
+  return error;
+}
+
+void OverlappedWriter::Cancel() {
+  if (in_flight_ > 0) {
+    CancelIoEx(device_, nullptr);
+    // The slots' OVERLAPPEDs and buffers belong to the kernel until their
+    // packets arrive, cancelled or not.
+    while (in_flight_ > 0 && ReapOne(INFINITE)) {
+    }
+  }
+  error_ = ERROR_SUCCESS;
+}
+
+bool OverlappedWriter::ReapOne(DWORD timeout_ms) {
+  DWORD transferred = 0;
+  ULONG_PTR key = 0;
+  OVERLAPPED* overlapped = nullptr;
+  const BOOL ok = GetQueuedCompletionStatus(port_, &transferred, &key,
+                                            &overlapped, timeout_ms);
+  if (overlapped == nullptr) {
+    // Timed out, or the port itself failed; nothing was dequeued.
+    return false;
+  }
+  for (const auto& slot : slots_) {
+    if (&slot->overlapped != overlapped) {
+      continue;
+    }
+    slot->busy = false;
+    --in_flight_;
+    completed_bytes_ += transferred;
+    if (!ok) {
+      RecordError(GetLastError());
+    } else if (transferred != slot->length) {
+      RecordError(ERROR_WRITE_FAULT);
+    }
+    break;
+  }
+  return true;
+}
+
+void OverlappedWriter::RecordError(DWORD error) {
+  if (error_ == ERROR_SUCCESS) {
+    error_ = error;
+  }
+}
+
+}  // namespace flutter_thermal_printer
@@ -0,0 +1,101 @@
+#ifndef FLUTTER_PLUGIN_OVERLAPPED_WRITER_H_
+#define FLUTTER_PLUGIN_OVERLAPPED_WRITER_H_
+
+#include <windows.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace flutter_thermal_printer {
+
+/// Limits for OverlappedWriter. Values of 0 take the defaults.
+struct OverlappedWriteOptions {
+  /// Bytes per WriteFile. usbprint turns each into bulk OUT transfers.
+  size_t chunk_size = 64u * 1024u;
+
+  /// Chunks queued on the device at once. Two is enough to hide the
+  /// completion round trip; more absorbs scheduling jitter.
+  size_t max_in_flight = 4;
+
+  /// Longest wait for any one completion before the writes are cancelled.
+  /// A printer out of paper simply stops taking data.
+  DWORD timeout_ms = 10000;
+};
+
+/// Keeps up to |max_in_flight| overlapped WriteFile calls outstanding on
+/// one handle, reaping them through an I/O completion port, so the device
+/// always has the next chunk queued when the current one finishes.
+///
+/// Write() copies into per-slot buffers that are reused for the life of the
+/// writer and returns as soon as the bytes are queued; Flush() waits for
+/// the device to take them. A failure is sticky until Flush() reports it
+/// or Cancel() discards it. Not thread-safe; one thread drives it.
+class OverlappedWriter {
+ public:
+  explicit OverlappedWriter(OverlappedWriteOptions options = {});
+  ~OverlappedWriter();
+
+  OverlappedWriter(const OverlappedWriter&) = delete;
+  OverlappedWriter& operator=(const OverlappedWriter&) = delete;
+
+  /// Binds to |device|, which must be opened with FILE_FLAG_OVERLAPPED.
+  /// A handle can join only one completion port, so each newly opened
+  /// handle gets a fresh port.
+  DWORD Attach(HANDLE device);
+
+  /// Cancels and reaps outstanding writes and releases the port. The
+  /// device handle is left to its owner.
+  void Detach();
+
+  bool attached() const { return port_ != nullptr; }
+
+  const OverlappedWriteOptions& options() const { return options_; }
+
+  /// Queues |size| bytes, blocking only while every slot is in flight.
+  DWORD Write(const uint8_t* data, size_t size);
+
+  /// Waits for every queued chunk. Returns the first error since the last
+  /// Flush() or Cancel().
+  DWORD Flush();
+
+  /// Cancels outstanding writes and waits for the cancellations; bytes the
+  /// device already took stay sent.
+  void Cancel();
+
+  size_t in_flight() const { return in_flight_; }
+
+  /// Bytes the device has taken since the writer was created, counted as
+  /// their writes complete. A caller compares two readings to learn
+  /// whether any of a document reached the device.
+  uint64_t completed_bytes() const { return completed_bytes_; }
+
+ private:
+  struct Slot {
+    OVERLAPPED overlapped = {};
+    std::vector<uint8_t> buffer;
+    DWORD length = 0;
+    bool busy = false;
+  };
+
+  Slot* FreeSlot();
+
+  /// Reaps one completion, waiting up to |timeout_ms|. Returns false on
+  /// timeout or if the port failed.
+  bool ReapOne(DWORD timeout_ms);
+
+  void RecordError(DWORD error);
+
+  const OverlappedWriteOptions options_;
+  HANDLE device_ = INVALID_HANDLE_VALUE;
+  HANDLE port_ = nullptr;
+  std::vector<std::unique_ptr<Slot>> slots_;
+  size_t in_flight_ = 0;
+  DWORD error_ = ERROR_SUCCESS;
+  uint64_t completed_bytes_ = 0;
+};
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_OVERLAPPED_WRITER_H_
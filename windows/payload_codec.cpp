@@ -0,0 +1,45 @@
+#include "payload_codec.h"
+
+#include "buffer_pool.h"
+
+namespace flutter_thermal_printer {
+
+using flutter::EncodableList;
+using flutter::EncodableValue;
+
+bool ReadPayload(const flutter::EncodableMap &args, const char *key,
+                 std::vector<uint8_t> *out, BufferPool *buffers) {
+  auto it = args.find(EncodableValue(key));
+  if (it == args.end()) {
+    return false;
+  }
+  const auto reserve = [out, buffers](size_t size) {
+    if (buffers != nullptr && out->capacity() < size) {
+      *out = buffers->Acquire(size);
+    }
+  };
+  if (const auto *bytes = std::get_if<std::vector<uint8_t>>(&it->second)) {
+    reserve(bytes->size());
+    out->assign(bytes->begin(), bytes->end());
+    return true;
+  }
+  const auto *list = std::get_if<EncodableList>(&it->second);
+  if (list == nullptr) {
+    return false;
+  }
+  reserve(list->size());
+  out->clear();
+  out->reserve(list->size());
+  for (const EncodableValue &item : *list) {
+    if (const auto *value = std::get_if<int32_t>(&item)) {
+      out->push_back(static_cast<uint8_t>(*value));
+    } else if (const auto *wide_value = std::get_if<int64_t>(&item)) {
+      out->push_back(static_cast<uint8_t>(*wide_value));
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace flutter_thermal_printer
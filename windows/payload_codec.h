@@ -0,0 +1,24 @@
+#ifndef FLUTTER_PLUGIN_PAYLOAD_CODEC_H_
+#define FLUTTER_PLUGIN_PAYLOAD_CODEC_H_
+
+#include <flutter/encodable_value.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace flutter_thermal_printer {
+
+class BufferPool;
+
+/// Extracts the byte payload stored under |key|.
+///
+/// A Dart `Uint8List` arrives as a `std::vector<uint8_t>` and is taken with a
+/// single memcpy. A legacy `List<int>` (EncodableList of boxed ints) is still
+/// accepted but has to be unboxed element by element. If |out| is too
+/// small, its storage is taken from |buffers| when one is given.
+bool ReadPayload(const flutter::EncodableMap &args, const char *key,
+                 std::vector<uint8_t> *out, BufferPool *buffers = nullptr);
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_PAYLOAD_CODEC_H_
@@ -0,0 +1,29 @@
+#ifndef FLUTTER_PLUGIN_PERF_COUNTER_H_
+#define FLUTTER_PLUGIN_PERF_COUNTER_H_
+
+#include <windows.h>
+
+#include <cstdint>
+
+namespace flutter_thermal_printer {
+
+/// QueryPerformanceCounter ticks; comparable across threads.
+inline int64_t PerfCounterNow() {
+  LARGE_INTEGER value;
+  QueryPerformanceCounter(&value);
+  return value.QuadPart;
+}
+
+/// Ticks per second. Fixed at boot, so it is read once.
+inline int64_t PerfCounterFrequency() {
+  static const int64_t frequency = [] {
+    LARGE_INTEGER value;
+    QueryPerformanceFrequency(&value);
+    return value.QuadPart;
+  }();
+  return frequency;
+}
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_PERF_COUNTER_H_
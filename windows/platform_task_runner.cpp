@@ -0,0 +1,90 @@
+#include "platform_task_runner.h"
+
+#include <utility>
+
+namespace flutter_thermal_printer {
+
+namespace {
+
+constexpr wchar_t kWindowClassName[] = L"FlutterThermalPrinterTaskRunner";
+constexpr UINT kRunTasksMessage = WM_APP + 0x51;
+
+HINSTANCE GetPluginModule() {
+  HMODULE module = nullptr;
+  GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS |
+                         GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                     reinterpret_cast<LPCWSTR>(&GetPluginModule), &module);
+  return module;
+}
+
+}  // namespace
+
+PlatformTaskRunner::PlatformTaskRunner() {
+  HINSTANCE instance = GetPluginModule();
+  WNDCLASSEXW window_class = {};
+  window_class.cbSize = sizeof(window_class);
+  window_class.lpfnWndProc = &PlatformTaskRunner::WndProc;
+  window_class.hInstance = instance;
+  window_class.lpszClassName = kWindowClassName;
+  // Fails with ERROR_CLASS_ALREADY_EXISTS after the first runner; harmless.
+  RegisterClassExW(&window_class);
+
+  window_ = CreateWindowExW(0, kWindowClassName, L"", 0, 0, 0, 0, 0,
+                            HWND_MESSAGE, nullptr, instance, nullptr);
+  if (window_ != nullptr) {
+    SetWindowLongPtrW(window_, GWLP_USERDATA,
+                      reinterpret_cast<LONG_PTR>(this));
+  }
+}
+
+PlatformTaskRunner::~PlatformTaskRunner() {
+  if (window_ != nullptr) {
+    SetWindowLongPtrW(window_, GWLP_USERDATA, 0);
+    DestroyWindow(window_);
+    window_ = nullptr;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  tasks_.clear();
+}
+
+void PlatformTaskRunner::PostTask(Task task) {
+  if (window_ == nullptr) {
+    return;
+  }
+  bool was_empty = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    was_empty = tasks_.empty();
+    tasks_.push_back(std::move(task));
+  }
+  // One wake-up message per batch; RunPendingTasks() drains everything.
+  if (was_empty) {
+    PostMessageW(window_, kRunTasksMessage, 0, 0);
+  }
+}
+
+void PlatformTaskRunner::RunPendingTasks() {
+  std::deque<Task> tasks;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks.swap(tasks_);
+  }
+  for (Task &task : tasks) {
+    task();
+  }
+}
+
+LRESULT CALLBACK PlatformTaskRunner::WndProc(HWND hwnd, UINT message,
+                                             WPARAM wparam, LPARAM lparam) {
+  if (message == kRunTasksMessage) {
+    auto *runner = reinterpret_cast<PlatformTaskRunner *>(
+        GetWindowLongPtrW(hwnd, GWLP_USERDATA));
+    if (runner != nullptr) {
+      runner->RunPendingTasks();
+    }
+    return 0;
+  }
+  return DefWindowProcW(hwnd, message, wparam, lparam);
+}
+
+}  // namespace flutter_thermal_printer
@@ -0,0 +1,43 @@
+#ifndef FLUTTER_PLUGIN_PLATFORM_TASK_RUNNER_H_
+#define FLUTTER_PLUGIN_PLATFORM_TASK_RUNNER_H_
+
+#include <windows.h>
+
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace flutter_thermal_printer {
+
+/// Runs closures on the thread that created it (the Flutter platform thread),
+/// via a message-only window. PostTask() may be called from any thread.
+/// Tasks still queued when the runner is destroyed are dropped, not run.
+class PlatformTaskRunner {
+ public:
+  using Task = std::function<void()>;
+
+  /// Must be called on the platform thread.
+  PlatformTaskRunner();
+  ~PlatformTaskRunner();
+
+  PlatformTaskRunner(const PlatformTaskRunner&) = delete;
+  PlatformTaskRunner& operator=(const PlatformTaskRunner&) = delete;
+
+  /// False if the message window could not be created; PostTask() then drops.
+  bool is_valid() const { return window_ != nullptr; }
+
+  void PostTask(Task task);
+
+ private:
+  static LRESULT CALLBACK WndProc(HWND hwnd, UINT message, WPARAM wparam,
+                                  LPARAM lparam);
+  void RunPendingTasks();
+
+  HWND window_ = nullptr;
+  std::mutex mutex_;
+  std::deque<Task> tasks_;
+};
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_PLATFORM_TASK_RUNNER_H_
@@ -0,0 +1,87 @@
+#include "print_template.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace flutter_thermal_printer {
+
+std::shared_ptr<const PrintTemplate> PrintTemplate::Create(
+    std::vector<uint8_t> bytes, std::vector<Field> fields) {
+  for (const Field &field : fields) {
+    if (field.offset > bytes.size()) {
+      return nullptr;
+    }
+  }
+  std::stable_sort(fields.begin(), fields.end(),
+                   [](const Field &a, const Field &b) {
+                     return a.offset < b.offset;
+                   });
+  return std::shared_ptr<const PrintTemplate>(
+      new PrintTemplate(std::move(bytes), std::move(fields)));
+}
+
+PrintTemplate::PrintTemplate(std::vector<uint8_t> bytes,
+                             std::vector<Field> fields)
+    : bytes_(std::move(bytes)), fields_(std::move(fields)) {}
+
+bool PrintTemplate::HasField(const std::string &name) const {
+  return std::any_of(fields_.begin(), fields_.end(),
+                     [&name](const Field &field) { return field.name == name; });
+}
+
+size_t PrintTemplate::RenderedSize(const Values &values) const {
+  size_t size = bytes_.size();
+  for (const Field &field : fields_) {
+    auto value = values.find(field.name);
+    if (value != values.end()) {
+      size += value->second.size();
+    }
+  }
+  return size;
+}
+
+bool PrintTemplate::Render(const Values &values, const SpanSink &sink) const {
+  size_t offset = 0;
+  for (const Field &field : fields_) {
+    if (field.offset > offset) {
+      if (!sink(bytes_.data() + offset, field.offset - offset)) {
+        return false;
+      }
+      offset = field.offset;
+    }
+    auto value = values.find(field.name);
+    if (value != values.end() && !value->second.empty() &&
+        !sink(value->second.data(), value->second.size())) {
+      return false;
+    }
+  }
+  if (offset < bytes_.size()) {
+    return sink(bytes_.data() + offset, bytes_.size() - offset);
+  }
+  return true;
+}
+
+bool TemplateStore::Register(
+    const std::string &name,
+    std::shared_ptr<const PrintTemplate> print_template) {
+  if (!print_template ||
+      print_template->bytes().size() > kMaxTemplateBytes ||
+      (templates_.size() >= kMaxTemplates &&
+       templates_.find(name) == templates_.end())) {
+    return false;
+  }
+  templates_[name] = std::move(print_template);
+  return true;
+}
+
+bool TemplateStore::Remove(const std::string &name) {
+  return templates_.erase(name) > 0;
+}
+
+std::shared_ptr<const PrintTemplate> TemplateStore::Find(
+    const std::string &name) const {
+  auto it = templates_.find(name);
+  return it != templates_.end() ? it->second : nullptr;
+}
+
+}  // namespace flutter_thermal_printer
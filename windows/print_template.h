@@ -0,0 +1,86 @@
+#ifndef FLUTTER_PLUGIN_PRINT_TEMPLATE_H_
+#define FLUTTER_PLUGIN_PRINT_TEMPLATE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace flutter_thermal_printer {
+
+/// A pre-encoded ESC/POS document (logo raster, header, footer) with named
+/// insertion points for the parts that change per ticket. Immutable once
+/// built, so print jobs share it with the store without copying.
+class PrintTemplate {
+ public:
+  /// Where a field's bytes go: before |bytes()[offset]|. A name may appear
+  /// more than once, e.g. a total printed at the top and the bottom.
+  struct Field {
+    std::string name;
+    size_t offset = 0;
+  };
+
+  /// Field values by name. Missing fields insert nothing.
+  using Values = std::map<std::string, std::vector<uint8_t>>;
+
+  /// Receives the pieces of a rendered ticket in order; false stops.
+  using SpanSink = std::function<bool(const uint8_t *data, size_t size)>;
+
+  /// Fails (returns nullptr) if an offset is past the end of |bytes|.
+  static std::shared_ptr<const PrintTemplate> Create(std::vector<uint8_t> bytes,
+                                                     std::vector<Field> fields);
+
+  const std::vector<uint8_t>& bytes() const { return bytes_; }
+
+  /// Sorted by offset; fields at the same offset keep their given order.
+  const std::vector<Field>& fields() const { return fields_; }
+
+  /// Whether the template has a field called |name|.
+  bool HasField(const std::string &name) const;
+
+  /// Size of the ticket Render() produces for |values|.
+  size_t RenderedSize(const Values &values) const;
+
+  /// Hands the ticket to |sink| as alternating template runs and field
+  /// values, without assembling it in one buffer. Returns false if |sink|
+  /// stopped early.
+  bool Render(const Values &values, const SpanSink &sink) const;
+
+ private:
+  PrintTemplate(std::vector<uint8_t> bytes, std::vector<Field> fields);
+
+  const std::vector<uint8_t> bytes_;
+  const std::vector<Field> fields_;
+};
+
+/// Registered templates by name. Platform thread only.
+class TemplateStore {
+ public:
+  /// Bounds what Dart can pin in native memory.
+  static constexpr size_t kMaxTemplates = 64;
+  static constexpr size_t kMaxTemplateBytes = 8u * 1024u * 1024u;
+
+  /// Adds or replaces |name|. Jobs already queued keep printing the old
+  /// version. Returns false if the store is full or |print_template| is
+  /// over kMaxTemplateBytes.
+  bool Register(const std::string &name,
+                std::shared_ptr<const PrintTemplate> print_template);
+
+  /// Returns false if there was no such template.
+  bool Remove(const std::string &name);
+
+  /// nullptr if |name| is not registered.
+  std::shared_ptr<const PrintTemplate> Find(const std::string &name) const;
+
+  size_t size() const { return templates_.size(); }
+
+ private:
+  std::map<std::string, std::shared_ptr<const PrintTemplate>> templates_;
+};
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_PRINT_TEMPLATE_H_
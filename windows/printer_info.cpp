@@ -0,0 +1,76 @@
+#include "printer_info.h"
+
+#include <cctype>
+
+namespace flutter_thermal_printer {
+
+namespace {
+
+// Values from winspool.h, repeated so this file builds without windows.h.
+constexpr uint32_t kStatusPaused = 0x00000001;       // PRINTER_STATUS_PAUSED
+constexpr uint32_t kStatusOffline = 0x00000080;      // PRINTER_STATUS_OFFLINE
+constexpr uint32_t kStatusNotAvailable = 0x00001000; // PRINTER_STATUS_NOT_AVAILABLE
+constexpr uint32_t kAttributeWorkOffline = 0x00000400;  // PRINTER_ATTRIBUTE_WORK_OFFLINE
+
+}  // namespace
+
+bool PrinterInfo::offline() const {
+  return (status & (kStatusPaused | kStatusOffline | kStatusNotAvailable)) !=
+             0 ||
+         (attributes & kAttributeWorkOffline) != 0;
+}
+
+bool PrinterInfo::usb() const {
+  static constexpr char kUsbPortPrefix[] = "USB";
+  for (size_t i = 0; kUsbPortPrefix[i] != '\0'; ++i) {
+    if (i >= port.size() ||
+        std::toupper(static_cast<unsigned char>(port[i])) != kUsbPortPrefix[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool PrinterInfo::operator==(const PrinterInfo &other) const {
+  return name == other.name && port == other.port && driver == other.driver &&
+         status == other.status && attributes == other.attributes &&
+         raw == other.raw;
+}
+
+PrinterChanges DiffPrinters(const PrinterMap &before, const PrinterMap &after) {
+  PrinterChanges changes;
+  auto old_it = before.begin();
+  auto new_it = after.begin();
+  // Both maps are sorted by name, so one merge pass finds every change.
+  while (old_it != before.end() || new_it != after.end()) {
+    if (new_it == after.end() ||
+        (old_it != before.end() && old_it->first < new_it->first)) {
+      changes.removed.push_back(old_it->first);
+      ++old_it;
+    } else if (old_it == before.end() || new_it->first < old_it->first) {
+      changes.added.push_back(new_it->second);
+      ++new_it;
+    } else {
+      if (old_it->second != new_it->second) {
+        changes.changed.push_back(new_it->second);
+      }
+      ++old_it;
+      ++new_it;
+    }
+  }
+  return changes;
+}
+
+void ApplyPrinterChanges(const PrinterChanges &changes, PrinterMap *printers) {
+  for (const std::string &name : changes.removed) {
+    printers->erase(name);
+  }
+  for (const PrinterInfo &printer : changes.added) {
+    (*printers)[printer.name] = printer;
+  }
+  for (const PrinterInfo &printer : changes.changed) {
+    (*printers)[printer.name] = printer;
+  }
+}
+
+}  // namespace flutter_thermal_printer
@@ -0,0 +1,66 @@
+#ifndef FLUTTER_PLUGIN_PRINTER_INFO_H_
+#define FLUTTER_PLUGIN_PRINTER_INFO_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace flutter_thermal_printer {
+
+/// What the plugin reports about one print queue.
+struct PrinterInfo {
+  /// UTF-8 queue name; the key Dart uses for every other call.
+  std::string name;
+
+  /// UTF-8 PRINTER_INFO_2 `pPortName` and `pDriverName`.
+  std::string port;
+  std::string driver;
+
+  /// PRINTER_INFO_2 `Status` and `Attributes` bits.
+  uint32_t status = 0;
+  uint32_t attributes = 0;
+
+  /// The queue accepts RAW documents (its default datatype is RAW, or it
+  /// uses the stock winprint processor, which passes RAW through).
+  bool raw = false;
+
+  /// Paused by the user, marked offline, or the port reports no device.
+  bool offline() const;
+
+  /// Attached through the USB port monitor (`USB001`, ...).
+  bool usb() const;
+
+  /// A USB queue that takes RAW ESC/POS, i.e. one this plugin can drive.
+  bool raw_usb() const { return raw && usb(); }
+
+  bool operator==(const PrinterInfo &other) const;
+  bool operator!=(const PrinterInfo &other) const { return !(*this == other); }
+};
+
+/// Printers keyed by name.
+using PrinterMap = std::map<std::string, PrinterInfo>;
+
+/// Difference between two enumerations, in name order.
+struct PrinterChanges {
+  std::vector<PrinterInfo> added;
+  std::vector<PrinterInfo> changed;
+  std::vector<std::string> removed;
+
+  /// Win32 error of an enumeration that failed; the lists are empty then.
+  uint32_t error = 0;
+
+  bool empty() const {
+    return added.empty() && changed.empty() && removed.empty();
+  }
+};
+
+PrinterChanges DiffPrinters(const PrinterMap &before, const PrinterMap &after);
+
+/// Updates |printers| in place so it matches the enumeration |changes| was
+/// computed against.
+void ApplyPrinterChanges(const PrinterChanges &changes, PrinterMap *printers);
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_PRINTER_INFO_H_
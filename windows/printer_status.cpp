@@ -0,0 +1,36 @@
+#include "printer_status.h"
+
+namespace flutter_thermal_printer {
+
+namespace {
+
+// Every `DLE EOT` reply has bits 1 and 4 set and bits 0 and 7 clear, which
+// tells it apart from stray data on the back-channel.
+bool IsStatusByte(uint8_t value) { return (value & 0x93) == 0x12; }
+
+}  // namespace
+
+bool ParseStatusReplies(const uint8_t *replies, size_t size,
+                        PrinterStatus *status) {
+  if (size < kStatusReplyBytes) {
+    return false;
+  }
+  const uint8_t printer = replies[0];
+  const uint8_t offline = replies[1];
+  const uint8_t paper = replies[2];
+  if (!IsStatusByte(printer) || !IsStatusByte(offline) ||
+      !IsStatusByte(paper)) {
+    return false;
+  }
+  status->known = true;
+  status->online = (printer & 0x08) == 0;
+  status->cover_open = (offline & 0x04) != 0;
+  // Bit 5 of the offline cause is "stopped at paper end"; the roll sensor
+  // reports the same in bits 5 and 6.
+  status->paper_out = (offline & 0x20) != 0 || (paper & 0x60) != 0;
+  status->paper_near_end = (paper & 0x0C) != 0;
+  status->error = (offline & 0x40) != 0;
+  return true;
+}
+
+}  // namespace flutter_thermal_printer
@@ -0,0 +1,49 @@
+#ifndef FLUTTER_PLUGIN_PRINTER_STATUS_H_
+#define FLUTTER_PLUGIN_PRINTER_STATUS_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace flutter_thermal_printer {
+
+/// The real-time status request sent over a printer's back-channel:
+/// `DLE EOT 1` (printer), `DLE EOT 2` (offline cause) and `DLE EOT 4`
+/// (roll paper sensor). Printers answer real-time commands even while
+/// offline, one byte per request, in order.
+constexpr uint8_t kStatusQuery[] = {0x10, 0x04, 0x01, 0x10, 0x04,
+                                    0x02, 0x10, 0x04, 0x04};
+constexpr size_t kStatusReplyBytes = 3;
+
+/// Longest a transport waits for the status replies.
+constexpr unsigned kStatusReplyTimeoutMs = 500;
+
+/// What the printer last reported about itself.
+struct PrinterStatus {
+  /// False until a status reply was read; the flags below mean nothing then.
+  bool known = false;
+  bool online = false;
+  bool cover_open = false;
+  bool paper_out = false;
+  bool paper_near_end = false;
+  /// A cutter jam, head overheat or other error that stops printing.
+  bool error = false;
+  /// When the status was read.
+  std::chrono::steady_clock::time_point updated;
+
+  /// Whether a document sent now would not print until someone fixes the
+  /// printer.
+  bool blocks_printing() const {
+    return known && (!online || cover_open || paper_out || error);
+  }
+};
+
+/// Fills |status| from the kStatusReplyBytes replies to kStatusQuery.
+/// Returns false if |size| is short or a byte is not a status reply
+/// (its fixed bits are wrong), leaving |status| untouched.
+bool ParseStatusReplies(const uint8_t *replies, size_t size,
+                        PrinterStatus *status);
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_PRINTER_STATUS_H_
@@ -0,0 +1,56 @@
+#ifndef FLUTTER_PLUGIN_PRINTER_TRANSPORT_H_
+#define FLUTTER_PLUGIN_PRINTER_TRANSPORT_H_
+
+#include <windows.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "printer_status.h"
+
+namespace flutter_thermal_printer {
+
+/// A byte sink for one printer: the print spooler, or the device itself.
+/// Owned and driven by a single PrinterWorker thread, so implementations
+/// need not be thread-safe. Errors are Win32 codes; ERROR_SUCCESS is ok.
+class PrinterTransport {
+ public:
+  virtual ~PrinterTransport() = default;
+
+  /// Queue name the transport was created for.
+  virtual const std::wstring& name() const = 0;
+
+  virtual bool is_open() const = 0;
+
+  /// Opens the underlying handle if needed.
+  virtual DWORD Open() = 0;
+
+  /// Releases the handle. Safe to call when already closed.
+  virtual void Close() = 0;
+
+  /// Sends |size| bytes as one complete document.
+  virtual DWORD WriteDocument(const uint8_t* data, size_t size) = 0;
+
+  /// Piecewise form of WriteDocument(): BeginDocument(), any number of
+  /// Write() calls, then EndDocument() or AbortDocument().
+  virtual DWORD BeginDocument() = 0;
+  virtual DWORD Write(const uint8_t* data, size_t size) = 0;
+  virtual DWORD EndDocument() = 0;
+
+  /// Drops the open document where the transport can; bytes already on
+  /// the wire stay sent.
+  virtual void AbortDocument() = 0;
+
+  /// Sends kStatusQuery over the back-channel of an open transport and
+  /// parses the replies into |status|, waiting at most
+  /// kStatusReplyTimeoutMs. Only called between documents. Transports that
+  /// cannot read from the printer keep this default.
+  virtual DWORD QueryStatus(PrinterStatus* status) {
+    return ERROR_NOT_SUPPORTED;
+  }
+};
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_PRINTER_TRANSPORT_H_
@@ -0,0 +1,217 @@
+#include "printer_watcher.h"
+
+#include <winspool.h>
+
+#include <cwchar>
+#include <string>
+#include <utility>
+
+#include "string_utils.h"
+
+namespace flutter_thermal_printer {
+
+namespace {
+
+// {28D78FAD-5A12-11D1-AE5B-0000F803A8C2}, GUID_DEVINTERFACE_USBPRINT.
+constexpr GUID kUsbPrintInterface = {
+    0x28d78fad, 0x5a12, 0x11d1, {0xae, 0x5b, 0x00, 0x00, 0xf8, 0x03, 0xa8, 0xc2}};
+
+// Installing a USB printer fires a burst of notifications; wait for the
+// burst to settle so it costs one enumeration.
+constexpr DWORD kSettleMs = 100;
+
+// Used while the spooler gives no working change notification handle and
+// before the first enumeration succeeds.
+constexpr DWORD kFallbackPollMs = 2000;
+
+constexpr DWORD kEnumFlags = PRINTER_ENUM_LOCAL;
+
+std::string OptionalUtf8(const wchar_t *value) {
+  return value != nullptr ? WideToUtf8(value) : std::string();
+}
+
+bool AcceptsRaw(const PRINTER_INFO_2W &entry) {
+  return (entry.pDatatype != nullptr && _wcsicmp(entry.pDatatype, L"RAW") == 0) ||
+         (entry.pPrintProcessor != nullptr &&
+          _wcsicmp(entry.pPrintProcessor, L"winprint") == 0);
+}
+
+// Opens the local print server and a change notification on it. |*change|
+// stays INVALID_HANDLE_VALUE if the spooler is down or refuses one.
+void OpenChangeNotification(HANDLE *server, HANDLE *change) {
+  if (*server == nullptr && !OpenPrinterW(nullptr, server, nullptr)) {
+    *server = nullptr;
+    return;
+  }
+  *change = FindFirstPrinterChangeNotification(*server, PRINTER_CHANGE_PRINTER,
+                                               0, nullptr);
+}
+
+void CloseChangeNotification(HANDLE *server, HANDLE *change) {
+  if (*change != INVALID_HANDLE_VALUE) {
+    FindClosePrinterChangeNotification(*change);
+    *change = INVALID_HANDLE_VALUE;
+  }
+  if (*server != nullptr) {
+    ClosePrinter(*server);
+    *server = nullptr;
+  }
+}
+
+}  // namespace
+
+PrinterWatcher::PrinterWatcher(ChangeCallback on_change)
+    : on_change_(std::move(on_change)),
+      stop_event_(CreateEventW(nullptr, TRUE, FALSE, nullptr)),
+      device_event_(CreateEventW(nullptr, FALSE, FALSE, nullptr)) {
+  if (device_event_ != nullptr) {
+    CM_NOTIFY_FILTER filter = {};
+    filter.cbSize = sizeof(filter);
+    filter.FilterType = CM_NOTIFY_FILTER_TYPE_DEVICEINTERFACE;
+    filter.u.DeviceInterface.ClassGuid = kUsbPrintInterface;
+    if (CM_Register_Notification(&filter, this, &OnDeviceNotification,
+                                 &device_notification_) != CR_SUCCESS) {
+      device_notification_ = nullptr;
+    }
+  }
+  if (stop_event_ != nullptr) {
+    thread_ = std::thread(&PrinterWatcher::Run, this);
+  }
+}
+
+PrinterWatcher::~PrinterWatcher() {
+  // Unregistering waits for callbacks in progress, so none outlives us.
+  if (device_notification_ != nullptr) {
+    CM_Unregister_Notification(device_notification_);
+  }
+  if (stop_event_ != nullptr) {
+    SetEvent(stop_event_);
+  }
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  if (device_event_ != nullptr) {
+    CloseHandle(device_event_);
+  }
+  if (stop_event_ != nullptr) {
+    CloseHandle(stop_event_);
+  }
+}
+
+DWORD CALLBACK PrinterWatcher::OnDeviceNotification(
+    HCMNOTIFICATION notification, PVOID context, CM_NOTIFY_ACTION action,
+    PCM_NOTIFY_EVENT_DATA data, DWORD data_size) {
+  if (action == CM_NOTIFY_ACTION_DEVICEINTERFACEARRIVAL ||
+      action == CM_NOTIFY_ACTION_DEVICEINTERFACEREMOVAL) {
+    SetEvent(static_cast<PrinterWatcher *>(context)->device_event_);
+  }
+  return ERROR_SUCCESS;
+}
+
+void PrinterWatcher::Run() {
+  HANDLE server = nullptr;
+  HANDLE change = INVALID_HANDLE_VALUE;
+  Refresh();
+  for (;;) {
+    if (change == INVALID_HANDLE_VALUE) {
+      OpenChangeNotification(&server, &change);
+    }
+    HANDLE handles[3] = {stop_event_};
+    DWORD count = 1;
+    if (change != INVALID_HANDLE_VALUE) {
+      handles[count++] = change;
+    }
+    if (device_event_ != nullptr) {
+      handles[count++] = device_event_;
+    }
+    // Polls until the first enumeration succeeds, so a transient failure
+    // is retried even if no printer ever changes.
+    const DWORD timeout = change != INVALID_HANDLE_VALUE && reported_
+                              ? INFINITE
+                              : kFallbackPollMs;
+
+    DWORD wait = WaitForMultipleObjects(count, handles, FALSE, timeout);
+    // Drain the burst before enumerating; the change handle must be re-armed
+    // with FindNextPrinterChangeNotification every time it fires.
+    bool rearmed = true;
+    while (wait != WAIT_OBJECT_0 && wait != WAIT_TIMEOUT &&
+           wait != WAIT_FAILED) {
+      if (handles[wait - WAIT_OBJECT_0] == change) {
+        DWORD what = 0;
+        if (!FindNextPrinterChangeNotification(change, &what, nullptr,
+                                               nullptr)) {
+          rearmed = false;
+          break;
+        }
+      }
+      wait = WaitForMultipleObjects(count, handles, FALSE, kSettleMs);
+    }
+    if (wait == WAIT_OBJECT_0) {
+      break;
+    }
+    if (!rearmed || wait == WAIT_FAILED) {
+      if (change == INVALID_HANDLE_VALUE) {
+        // Only the watcher's own events were waited on; nothing to reopen.
+        break;
+      }
+      // The spooler restarted under the change handle. Open fresh ones on
+      // the next pass, polling until that works.
+      CloseChangeNotification(&server, &change);
+    }
+    Refresh();
+  }
+  CloseChangeNotification(&server, &change);
+}
+
+void PrinterWatcher::Refresh() {
+  DWORD needed = 0;
+  DWORD returned = 0;
+  // The buffer is kept between refreshes and only grows when a larger
+  // enumeration needs it.
+  while (!EnumPrintersW(kEnumFlags, nullptr, 2, enum_buffer_.data(),
+                        static_cast<DWORD>(enum_buffer_.size()), &needed,
+                        &returned)) {
+    DWORD error = GetLastError();
+    if (error != ERROR_INSUFFICIENT_BUFFER || needed <= enum_buffer_.size()) {
+      if (error == ERROR_SUCCESS || error == ERROR_INSUFFICIENT_BUFFER) {
+        error = ERROR_INVALID_DATA;
+      }
+      // A cached list outlives a failure; before the first one, whoever
+      // waits for it must hear why there is none.
+      if (!reported_ && error != last_error_) {
+        last_error_ = error;
+        PrinterChanges failed;
+        failed.error = error;
+        on_change_(failed);
+      }
+      return;
+    }
+    enum_buffer_.resize(needed);
+  }
+
+  PrinterMap printers;
+  const auto *entries = reinterpret_cast<const PRINTER_INFO_2W *>(
+      enum_buffer_.data());
+  for (DWORD i = 0; i < returned; ++i) {
+    if (entries[i].pPrinterName == nullptr) {
+      continue;
+    }
+    PrinterInfo info;
+    info.name = WideToUtf8(entries[i].pPrinterName);
+    info.port = OptionalUtf8(entries[i].pPortName);
+    info.driver = OptionalUtf8(entries[i].pDriverName);
+    info.status = entries[i].Status;
+    info.attributes = entries[i].Attributes;
+    info.raw = AcceptsRaw(entries[i]);
+    printers.emplace(info.name, std::move(info));
+  }
+
+  PrinterChanges changes = DiffPrinters(printers_, printers);
+  printers_ = std::move(printers);
+  if (!changes.empty() || !reported_) {
+    reported_ = true;
+    on_change_(changes);
+  }
+}
+
+}  // namespace flutter_thermal_printer
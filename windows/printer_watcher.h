@@ -0,0 +1,71 @@
+#ifndef FLUTTER_PLUGIN_PRINTER_WATCHER_H_
+#define FLUTTER_PLUGIN_PRINTER_WATCHER_H_
+
+#include <windows.h>
+#include <cfgmgr32.h>
+
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "printer_info.h"
+
+namespace flutter_thermal_printer {
+
+/// Tracks the local print queues without polling. It enumerates once, then
+/// waits on a spooler change notification (queues added, removed or
+/// reconfigured) and on USB printer interface arrival/removal, and
+/// re-enumerates only when one of them fires. While the spooler is down,
+/// restarting or has not yet been enumerated, it polls instead.
+///
+/// |on_change| runs on the watcher thread: first with every printer as
+/// `added` (even if there are none), then only with what changed. Until an
+/// enumeration succeeds, each new error is reported instead, in a batch
+/// with only `error` set.
+class PrinterWatcher {
+ public:
+  using ChangeCallback = std::function<void(const PrinterChanges &changes)>;
+
+  explicit PrinterWatcher(ChangeCallback on_change);
+  ~PrinterWatcher();
+
+  PrinterWatcher(const PrinterWatcher&) = delete;
+  PrinterWatcher& operator=(const PrinterWatcher&) = delete;
+
+  /// False if the watcher thread could not be started; |on_change| is then
+  /// never called.
+  bool is_running() const { return thread_.joinable(); }
+
+ private:
+  static DWORD CALLBACK OnDeviceNotification(HCMNOTIFICATION notification,
+                                             PVOID context,
+                                             CM_NOTIFY_ACTION action,
+                                             PCM_NOTIFY_EVENT_DATA data,
+                                             DWORD data_size);
+
+  void Run();
+
+  /// Re-enumerates and reports the difference from the last snapshot.
+  void Refresh();
+
+  ChangeCallback on_change_;
+  HANDLE stop_event_ = nullptr;
+  HANDLE device_event_ = nullptr;
+  HCMNOTIFICATION device_notification_ = nullptr;
+
+  // Watcher thread only.
+  PrinterMap printers_;
+  std::vector<BYTE> enum_buffer_;
+  bool reported_ = false;
+  // Error of the last failed enumeration before |reported_|, so a spooler
+  // that stays down is reported once.
+  DWORD last_error_ = ERROR_SUCCESS;
+
+  // Declared last so every member above exists before Run() starts.
+  std::thread thread_;
+};
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_PRINTER_WATCHER_H_
@@ -0,0 +1,429 @@
+#include "printer_worker.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include "perf_counter.h"
+
+namespace flutter_thermal_printer {
+
+namespace {
+
+// Caps one coalesced document so a burst of jobs can't pin unbounded memory
+// in the spooler before anything prints.
+constexpr size_t kMaxBatchBytes = 4u * 1024u * 1024u;
+
+size_t JobBytes(const PrintJob &job) {
+  return job.print_template ? job.print_template->RenderedSize(job.fields)
+                            : job.data.size();
+}
+
+bool IsDocument(const PrintJob &job) {
+  return job.type == PrintJob::Type::kPrint ||
+         job.type == PrintJob::Type::kStream;
+}
+
+void CompleteCancelled(PrintJob &job) {
+  if (job.stream) {
+    job.stream->Abort();
+  }
+  if (job.on_complete) {
+    job.on_complete(ERROR_CANCELLED);
+  }
+}
+
+}  // namespace
+
+PrinterWorker::PrinterWorker(std::unique_ptr<PrinterTransport> printer,
+                             std::shared_ptr<BufferPool> buffers)
+    : printer_(std::move(printer)),
+      buffers_(std::move(buffers)),
+      thread_(&PrinterWorker::Run, this) {}
+
+PrinterWorker::~PrinterWorker() {
+  std::deque<PrintJob> dropped;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+    dropped.swap(queue_);
+  }
+  wake_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  for (PrintJob &job : dropped) {
+    CompleteCancelled(job);
+  }
+  // Every stream is finished or aborted by now, so no producer is blocked.
+  producer_.reset();
+}
+
+bool PrinterWorker::Enqueue(PrintJob job) {
+  if (job.type == PrintJob::Type::kPrint) {
+    job.queued_bytes = std::max(job.queued_bytes, JobBytes(job));
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const bool idle = queue_.empty() && in_flight_ == 0;
+    if (IsDocument(job) && !idle && max_queued_bytes_ != 0 &&
+        pending_bytes_ + job.queued_bytes > max_queued_bytes_) {
+      buffers_->Release(std::move(job.data));
+      return false;
+    }
+    pending_bytes_ += job.queued_bytes;
+    // Behind every job of at least its priority, and never ahead of a
+    // control job. Nor of another stream: the producers run in queue
+    // order on one thread, so a stream taken before the one whose
+    // producer is running would wait on it forever.
+    auto pos = queue_.end();
+    if (IsDocument(job)) {
+      while (pos != queue_.begin()) {
+        const PrintJob &before = *std::prev(pos);
+        if (!IsDocument(before) || before.priority >= job.priority ||
+            (job.type == PrintJob::Type::kStream &&
+             before.type == PrintJob::Type::kStream)) {
+          break;
+        }
+        --pos;
+      }
+    }
+    queue_.insert(pos, std::move(job));
+  }
+  wake_.notify_one();
+  return true;
+}
+
+bool PrinterWorker::Cancel(int64_t id) {
+  PrintJob cancelled;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::find_if(queue_.begin(), queue_.end(),
+                           [id](const PrintJob &job) { return job.id == id; });
+    if (it == queue_.end()) {
+      if (in_flight_stream_ && in_flight_stream_id_ == id) {
+        // WriteStream() sees the abort on its next Pop() and fails the
+        // document; the job completes from Run() as usual.
+        in_flight_stream_->Abort();
+        return true;
+      }
+      return false;
+    }
+    cancelled = std::move(*it);
+    queue_.erase(it);
+    pending_bytes_ -= cancelled.queued_bytes;
+  }
+  // Wakes a worker waiting out a batch window on this job.
+  wake_.notify_one();
+  buffers_->Release(std::move(cancelled.data));
+  CompleteCancelled(cancelled);
+  return true;
+}
+
+void PrinterWorker::SetMaxQueuedBytes(size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  max_queued_bytes_ = bytes;
+}
+
+void PrinterWorker::PostProducer(TaskQueue::Task task) {
+  if (!producer_) {
+    producer_ = std::make_unique<TaskQueue>();
+  }
+  producer_->PostTask(std::move(task));
+}
+
+size_t PrinterWorker::pending_jobs() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return queue_.size() + in_flight_;
+}
+
+size_t PrinterWorker::pending_bytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pending_bytes_;
+}
+
+void PrinterWorker::SetBatchWindow(std::chrono::milliseconds window) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  batch_window_ = window;
+}
+
+void PrinterWorker::HoldBatch() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  hold_ = true;
+  hold_deadline_ = std::chrono::steady_clock::now() + kMaxBatchHold;
+}
+
+void PrinterWorker::ReleaseBatch() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    hold_ = false;
+  }
+  wake_.notify_one();
+}
+
+void PrinterWorker::SetStatusInterval(std::chrono::milliseconds interval) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    status_interval_ = interval;
+    next_status_poll_ = std::chrono::steady_clock::time_point();
+  }
+  wake_.notify_one();
+}
+
+DWORD PrinterWorker::GetStatus(PrinterStatus *status) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  *status = status_;
+  return status_error_;
+}
+
+bool PrinterWorker::CanPollStatus() const {
+  return status_supported_ && status_interval_.count() > 0 &&
+         printer_->is_open();
+}
+
+void PrinterWorker::PollStatus(std::unique_lock<std::mutex> &lock) {
+  lock.unlock();
+  PrinterStatus status;
+  const DWORD error = printer_->QueryStatus(&status);
+  const auto now = std::chrono::steady_clock::now();
+  lock.lock();
+  status.updated = now;
+  status_ = status;
+  status_error_ = error;
+  if (error == ERROR_NOT_SUPPORTED) {
+    status_supported_ = false;
+  }
+  next_status_poll_ =
+      now + (status_.blocks_printing()
+                 ? std::min<std::chrono::milliseconds>(status_interval_,
+                                                       kOfflineStatusInterval)
+                 : status_interval_);
+}
+
+void PrinterWorker::Run() {
+  using Clock = std::chrono::steady_clock;
+  for (;;) {
+    std::vector<PrintJob> batch;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (!stopping_) {
+        const Clock::time_point now = Clock::now();
+        if (hold_ && now >= hold_deadline_) {
+          hold_ = false;
+        }
+        const bool polling = CanPollStatus();
+        if (!polling && status_supported_) {
+          // Closed or no longer polled: an old offline status must not
+          // hold jobs it can never release.
+          status_ = PrinterStatus();
+          status_error_ = ERROR_NOT_READY;
+        }
+        const bool ready =
+            !hold_ && !queue_.empty() &&
+            !(status_.blocks_printing() && IsDocument(queue_.front()));
+        // Polls wait for an idle moment, except right after a failure,
+        // which is checked before the next document goes the same way.
+        if (polling && now >= next_status_poll_ &&
+            (!ready || recheck_status_)) {
+          recheck_status_ = false;
+          PollStatus(lock);
+          continue;
+        }
+        if (ready) {
+          break;
+        }
+        Clock::time_point wake = Clock::time_point::max();
+        if (hold_) {
+          wake = hold_deadline_;
+        }
+        if (polling) {
+          wake = std::min(wake, next_status_poll_);
+        }
+        if (wake == Clock::time_point::max()) {
+          wake_.wait(lock);
+        } else {
+          wake_.wait_until(lock, wake);
+        }
+      }
+      if (stopping_) {
+        break;
+      }
+      batch.push_back(std::move(queue_.front()));
+      queue_.pop_front();
+      if (batch.front().type == PrintJob::Type::kPrint) {
+        CollectBatch(lock, &batch);
+      } else if (batch.front().type == PrintJob::Type::kStream) {
+        in_flight_stream_id_ = batch.front().id;
+        in_flight_stream_ = batch.front().stream;
+      }
+      in_flight_ = batch.size();
+    }
+    const int64_t started = PerfCounterNow();
+    for (PrintJob &job : batch) {
+      if (job.trace) {
+        job.trace->started = started;
+      }
+    }
+
+    // Templates are always written piecewise, even on their own.
+    const bool piecewise =
+        batch.size() > 1 || batch.front().print_template != nullptr;
+    const DWORD error = piecewise ? WriteBatch(batch) : Execute(batch.front());
+    {
+      // Released before the callbacks, so a caller reacting to one finds
+      // the room it freed.
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const PrintJob &job : batch) {
+        pending_bytes_ -= job.queued_bytes;
+      }
+      in_flight_ = 0;
+      in_flight_stream_.reset();
+      // A failed job may be the first sign of an empty roll; a fresh
+      // connection should report its state at once.
+      const PrintJob::Type type = batch.front().type;
+      if (error != ERROR_SUCCESS || type == PrintJob::Type::kOpen ||
+          type == PrintJob::Type::kSetTransport) {
+        next_status_poll_ = Clock::time_point();
+      }
+      recheck_status_ = error != ERROR_SUCCESS;
+    }
+    for (PrintJob &job : batch) {
+      if (job.on_complete) {
+        job.on_complete(error);
+      }
+    }
+  }
+  printer_->Close();
+}
+
+void PrinterWorker::CollectBatch(std::unique_lock<std::mutex> &lock,
+                                 std::vector<PrintJob> *batch) {
+  size_t bytes = JobBytes(batch->front());
+  const auto deadline = std::chrono::steady_clock::now() + batch_window_;
+  for (;;) {
+    while (!queue_.empty() && queue_.front().type == PrintJob::Type::kPrint &&
+           bytes + JobBytes(queue_.front()) <= kMaxBatchBytes) {
+      bytes += JobBytes(queue_.front());
+      batch->push_back(std::move(queue_.front()));
+      queue_.pop_front();
+    }
+    if (!queue_.empty() || stopping_ ||
+        std::chrono::steady_clock::now() >= deadline) {
+      return;
+    }
+    wake_.wait_until(lock, deadline);
+  }
+}
+
+DWORD PrinterWorker::Execute(PrintJob &job) {
+  switch (job.type) {
+    case PrintJob::Type::kOpen:
+      return printer_->Open();
+    case PrintJob::Type::kBarrier:
+      return ERROR_SUCCESS;
+    case PrintJob::Type::kClose:
+      printer_->Close();
+      return ERROR_SUCCESS;
+    case PrintJob::Type::kSetTransport:
+      if (!job.transport) {
+        return ERROR_INVALID_PARAMETER;
+      }
+      printer_->Close();
+      printer_ = std::move(job.transport);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        status_supported_ = true;
+        status_ = PrinterStatus();
+        status_error_ = ERROR_NOT_READY;
+      }
+      return ERROR_SUCCESS;
+    case PrintJob::Type::kStream:
+      return WriteStream(*job.stream, job.trace.get());
+    case PrintJob::Type::kPrint:
+      break;
+  }
+  JobTrace *trace = job.trace.get();
+  if (trace != nullptr) {
+    trace->spool_begin = PerfCounterNow();
+    trace->bytes = job.data.size();
+  }
+  const DWORD error = printer_->WriteDocument(job.data.data(), job.data.size());
+  if (trace != nullptr) {
+    trace->spool_end = PerfCounterNow();
+  }
+  buffers_->Release(std::move(job.data));
+  return error;
+}
+
+DWORD PrinterWorker::WriteBatch(std::vector<PrintJob> &batch) {
+  const int64_t spool_begin = PerfCounterNow();
+  DWORD error = printer_->BeginDocument();
+  for (PrintJob &job : batch) {
+    if (error == ERROR_SUCCESS) {
+      error = WriteJobBytes(job);
+    }
+    if (job.trace) {
+      job.trace->spool_begin = spool_begin;
+      job.trace->bytes = JobBytes(job);
+    }
+  }
+  if (error != ERROR_SUCCESS) {
+    printer_->AbortDocument();
+  } else {
+    error = printer_->EndDocument();
+  }
+  const int64_t spool_end = PerfCounterNow();
+  for (PrintJob &job : batch) {
+    if (job.trace) {
+      job.trace->spool_end = spool_end;
+    }
+    buffers_->Release(std::move(job.data));
+  }
+  return error;
+}
+
+DWORD PrinterWorker::WriteJobBytes(const PrintJob &job) {
+  if (!job.print_template) {
+    return printer_->Write(job.data.data(), job.data.size());
+  }
+  // Static runs go straight from the shared template; nothing is spliced
+  // into a scratch buffer.
+  DWORD error = ERROR_SUCCESS;
+  job.print_template->Render(job.fields,
+                             [this, &error](const uint8_t *data, size_t size) {
+                               error = printer_->Write(data, size);
+                               return error == ERROR_SUCCESS;
+                             });
+  return error;
+}
+
+DWORD PrinterWorker::WriteStream(DocumentStream &stream, JobTrace *trace) {
+  if (trace != nullptr) {
+    trace->spool_begin = PerfCounterNow();
+  }
+  DWORD error = printer_->BeginDocument();
+  std::vector<uint8_t> chunk;
+  uint64_t bytes = 0;
+  while (error == ERROR_SUCCESS && stream.Pop(&chunk)) {
+    error = printer_->Write(chunk.data(), chunk.size());
+    bytes += chunk.size();
+    // Transports copy or finish with the bytes inside Write().
+    buffers_->Release(std::move(chunk));
+  }
+  if (error == ERROR_SUCCESS && !stream.complete()) {
+    error = ERROR_CANCELLED;
+  }
+  if (error != ERROR_SUCCESS) {
+    stream.Abort();
+    printer_->AbortDocument();
+  } else {
+    error = printer_->EndDocument();
+  }
+  if (trace != nullptr) {
+    trace->spool_end = PerfCounterNow();
+    trace->bytes = bytes;
+  }
+  return error;
+}
+
+}  // namespace flutter_thermal_printer
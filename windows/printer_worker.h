@@ -0,0 +1,209 @@
+#ifndef FLUTTER_PLUGIN_PRINTER_WORKER_H_
+#define FLUTTER_PLUGIN_PRINTER_WORKER_H_
+
+#include <windows.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "buffer_pool.h"
+#include "document_stream.h"
+#include "job_stats.h"
+#include "print_template.h"
+#include "printer_transport.h"
+#include "task_queue.h"
+
+namespace flutter_thermal_printer {
+
+/// A unit of work for one printer. Print jobs carry the bytes of one RAW
+/// document, or a template and its field values; stream jobs write a
+/// document as its producer delivers it. Open/close and transport jobs are
+/// serialized with them so the printer handle is only ever touched from
+/// the worker thread. A barrier does nothing; it completes once every job
+/// queued before it has.
+struct PrintJob {
+  enum class Type { kPrint, kStream, kOpen, kClose, kSetTransport, kBarrier };
+
+  Type type = Type::kPrint;
+  int64_t id = 0;
+  std::vector<uint8_t> data;
+
+  /// Documents with a higher priority are queued ahead of lower ones
+  /// (e.g. a kitchen ticket ahead of a reprinted invoice). They never
+  /// overtake a job of another type, so open, transport and barrier jobs
+  /// still apply to everything queued after them, and a stream job never
+  /// overtakes another stream, whose producer runs first. Equal priorities
+  /// keep their order.
+  int priority = 0;
+
+  /// Memory the job holds until it completes, counted against the queue
+  /// limit. Print jobs count at least their payload; stream jobs set it to
+  /// the input their producer keeps alive.
+  size_t queued_bytes = 0;
+
+  /// kPrint only. When set, the document is |print_template| rendered with
+  /// |fields|, written span by span instead of from |data|.
+  std::shared_ptr<const PrintTemplate> print_template;
+  PrintTemplate::Values fields;
+
+  /// kStream only. The worker aborts it if the job fails or is dropped, so
+  /// a blocked producer always wakes up.
+  std::shared_ptr<DocumentStream> stream;
+
+  /// kSetTransport only. Replaces the worker's transport once every job
+  /// queued before it has been written; the old one is closed.
+  std::unique_ptr<PrinterTransport> transport;
+
+  /// Optional. The worker stamps the queue and spool stages into it.
+  std::shared_ptr<JobTrace> trace;
+
+  /// Invoked on the worker thread with ERROR_SUCCESS or a Win32 error.
+  /// Jobs cancelled or dropped at shutdown complete with ERROR_CANCELLED.
+  std::function<void(DWORD error)> on_complete;
+};
+
+/// Priority-ordered job queue for one printer, served by a dedicated
+/// background thread that owns the printer's transport. The thread starts
+/// with the worker and is joined by the destructor. Written payloads and
+/// stream chunks go back to |buffers| for the next job to fill.
+///
+/// Consecutive print jobs are coalesced into one document: every one that
+/// is already queued when the worker gets to them, plus any arriving within
+/// the batch window, or all those queued while a batch is held.
+///
+/// While idle with an open transport, the worker also polls the printer's
+/// real-time status every status interval and caches it. Documents wait in
+/// the queue while the last status says the printer cannot print (offline,
+/// cover open, out of paper), polled more often until it recovers.
+class PrinterWorker {
+ public:
+  PrinterWorker(std::unique_ptr<PrinterTransport> printer,
+                std::shared_ptr<BufferPool> buffers);
+  ~PrinterWorker();
+
+  PrinterWorker(const PrinterWorker&) = delete;
+  PrinterWorker& operator=(const PrinterWorker&) = delete;
+
+  /// Default for SetMaxQueuedBytes().
+  static constexpr size_t kDefaultMaxQueuedBytes = 32u * 1024u * 1024u;
+
+  /// Queues |job| in priority order. Returns false, dropping the job
+  /// without completing it, when the bytes of the unfinished jobs would
+  /// pass the queue limit; a job is always accepted when nothing else is
+  /// pending, however large. Thread-safe. Never blocks on the spooler.
+  bool Enqueue(PrintJob job);
+
+  /// Cancels job |id|: a queued job is removed and completes with
+  /// ERROR_CANCELLED; a stream being written is aborted, which fails its
+  /// document. Returns false if the job is unknown, finished or a print
+  /// job already in the spooler. Thread-safe.
+  bool Cancel(int64_t id);
+
+  /// Most bytes the unfinished jobs may hold before Enqueue() refuses
+  /// more; zero removes the limit. Thread-safe.
+  void SetMaxQueuedBytes(size_t bytes);
+
+  /// How long the worker waits for more print jobs before it sends a
+  /// document. Zero (the default) only merges jobs that are already queued.
+  /// Thread-safe.
+  void SetBatchWindow(std::chrono::milliseconds window);
+
+  /// Holds queued jobs until ReleaseBatch(), so they go out together. A
+  /// hold lapses on its own after kMaxBatchHold. Thread-safe.
+  void HoldBatch();
+  void ReleaseBatch();
+
+  /// Longest a forgotten HoldBatch() can stall the printer.
+  static constexpr std::chrono::seconds kMaxBatchHold{30};
+
+  /// Default for SetStatusInterval(), and the interval while documents are
+  /// held for an offline printer.
+  static constexpr std::chrono::seconds kDefaultStatusInterval{5};
+  static constexpr std::chrono::seconds kOfflineStatusInterval{1};
+
+  /// How often an idle worker asks the printer for its status; zero stops
+  /// polling and holding. Thread-safe.
+  void SetStatusInterval(std::chrono::milliseconds interval);
+
+  /// The last status polled into |status|, and that poll's error:
+  /// ERROR_NOT_READY before the first poll or while the transport is
+  /// closed, ERROR_NOT_SUPPORTED if it cannot read from the printer.
+  /// Never waits on the printer. Thread-safe.
+  DWORD GetStatus(PrinterStatus *status) const;
+
+  /// Pool that this printer's payloads should be filled from. Thread-safe.
+  BufferPool* buffers() const { return buffers_.get(); }
+
+  /// Jobs accepted but not yet finished, including the one being written.
+  size_t pending_jobs() const;
+  /// Their queued_bytes.
+  size_t pending_bytes() const;
+
+  /// Runs |task| on this printer's producer thread, started on first use.
+  /// Stream jobs are fed from here, in the order they were queued, so a
+  /// slow printer never holds up rasterization for anyone else. Not
+  /// thread-safe; call from the thread that owns the worker.
+  void PostProducer(TaskQueue::Task task);
+
+ private:
+  void Run();
+
+  /// Moves the print jobs that follow |batch|'s first one into it, waiting
+  /// out the batch window. Called with |mutex_| held.
+  void CollectBatch(std::unique_lock<std::mutex> &lock,
+                    std::vector<PrintJob> *batch);
+
+  /// Whether the transport can be polled now. Called with |mutex_| held.
+  bool CanPollStatus() const;
+  /// Queries the transport with |lock| released and caches the result.
+  void PollStatus(std::unique_lock<std::mutex> &lock);
+
+  DWORD Execute(PrintJob &job);
+  /// Writes |batch| as one document; each job gets the document's result.
+  DWORD WriteBatch(std::vector<PrintJob> &batch);
+  /// Writes one print job's bytes into the open document.
+  DWORD WriteJobBytes(const PrintJob &job);
+  DWORD WriteStream(DocumentStream &stream, JobTrace *trace);
+
+  std::unique_ptr<PrinterTransport> printer_;
+  const std::shared_ptr<BufferPool> buffers_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable wake_;
+  std::deque<PrintJob> queue_;
+  size_t in_flight_ = 0;
+  size_t pending_bytes_ = 0;
+  size_t max_queued_bytes_ = kDefaultMaxQueuedBytes;
+  // The stream job being written, so Cancel() can abort it.
+  int64_t in_flight_stream_id_ = 0;
+  std::shared_ptr<DocumentStream> in_flight_stream_;
+  bool stopping_ = false;
+  std::chrono::milliseconds batch_window_{0};
+  bool hold_ = false;
+  std::chrono::steady_clock::time_point hold_deadline_;
+  std::chrono::milliseconds status_interval_{kDefaultStatusInterval};
+  PrinterStatus status_;
+  DWORD status_error_ = ERROR_NOT_READY;
+  // Cleared when the transport answers ERROR_NOT_SUPPORTED, until the
+  // next kSetTransport.
+  bool status_supported_ = true;
+  // Set after a failed job: poll before the next one even if it is queued.
+  bool recheck_status_ = false;
+  std::chrono::steady_clock::time_point next_status_poll_;
+
+  std::unique_ptr<TaskQueue> producer_;
+
+  // Declared last so every member above exists before Run() starts.
+  std::thread thread_;
+};
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_PRINTER_WORKER_H_
@@ -0,0 +1,190 @@
+#include "raster_cache.h"
+
+#include <cstring>
+#include <iterator>
+
+namespace flutter_thermal_printer {
+
+namespace {
+
+constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+
+uint64_t Rotl(uint64_t value, int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+// Little endian on every target Windows runs on.
+uint64_t Read64(const uint8_t *p) {
+  uint64_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+uint32_t Read32(const uint8_t *p) {
+  uint32_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+uint64_t Round(uint64_t acc, uint64_t input) {
+  acc += input * kPrime2;
+  acc = Rotl(acc, 31);
+  return acc * kPrime1;
+}
+
+uint64_t MergeRound(uint64_t acc, uint64_t value) {
+  acc ^= Round(0, value);
+  return acc * kPrime1 + kPrime4;
+}
+
+}  // namespace
+
+uint64_t HashBytes(const uint8_t *data, size_t size, uint64_t seed) {
+  const uint8_t *p = data;
+  const uint8_t *const end = data + size;
+  uint64_t h;
+  if (size >= 32) {
+    uint64_t v1 = seed + kPrime1 + kPrime2;
+    uint64_t v2 = seed + kPrime2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - kPrime1;
+    const uint8_t *const limit = end - 32;
+    do {
+      v1 = Round(v1, Read64(p));
+      v2 = Round(v2, Read64(p + 8));
+      v3 = Round(v3, Read64(p + 16));
+      v4 = Round(v4, Read64(p + 24));
+      p += 32;
+    } while (p <= limit);
+    h = Rotl(v1, 1) + Rotl(v2, 7) + Rotl(v3, 12) + Rotl(v4, 18);
+    h = MergeRound(h, v1);
+    h = MergeRound(h, v2);
+    h = MergeRound(h, v3);
+    h = MergeRound(h, v4);
+  } else {
+    h = seed + kPrime5;
+  }
+  h += static_cast<uint64_t>(size);
+
+  for (; p + 8 <= end; p += 8) {
+    h ^= Round(0, Read64(p));
+    h = Rotl(h, 27) * kPrime1 + kPrime4;
+  }
+  if (p + 4 <= end) {
+    h ^= static_cast<uint64_t>(Read32(p)) * kPrime1;
+    h = Rotl(h, 23) * kPrime2 + kPrime3;
+    p += 4;
+  }
+  for (; p < end; ++p) {
+    h ^= static_cast<uint64_t>(*p) * kPrime5;
+    h = Rotl(h, 11) * kPrime1;
+  }
+
+  h ^= h >> 33;
+  h *= kPrime2;
+  h ^= h >> 29;
+  h *= kPrime3;
+  h ^= h >> 32;
+  return h;
+}
+
+bool RasterCache::Key::operator==(const Key &other) const {
+  return hash == other.hash && width == other.width &&
+         height == other.height && dither == other.dither &&
+         threshold == other.threshold && band_rows == other.band_rows &&
+         scale_width == other.scale_width &&
+         serial_diffusion == other.serial_diffusion &&
+         feed_blank_rows == other.feed_blank_rows;
+}
+
+RasterCache::Key RasterCache::KeyFor(const uint8_t *rgba, size_t size,
+                                     int width, int height,
+                                     const RasterOptions &options) {
+  Key key;
+  key.hash = HashBytes(rgba, size);
+  key.width = width;
+  key.height = height;
+  key.dither = static_cast<int>(options.dither);
+  key.band_rows = options.band_rows;
+  key.feed_blank_rows = options.feed_blank_rows;
+  if (options.scale_width != width) {
+    key.scale_width = options.scale_width;
+  }
+  if (options.dither == DitherMode::kThreshold) {
+    key.threshold = options.threshold;
+  }
+  if (options.dither == DitherMode::kFloydSteinberg) {
+    key.serial_diffusion = options.serial_diffusion;
+  }
+  return key;
+}
+
+RasterCache::RasterCache(size_t max_bytes) : max_bytes_(max_bytes) {}
+
+RasterCache::Raster RasterCache::Find(const Key &key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    ++misses_;
+    return nullptr;
+  }
+  ++hits_;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->raster;
+}
+
+void RasterCache::Insert(const Key &key, Raster raster) {
+  if (raster == nullptr || raster->size() > max_entry_bytes()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    EraseLocked(it->second);
+  }
+  while (!lru_.empty() && bytes_ + raster->size() > max_bytes_) {
+    EraseLocked(std::prev(lru_.end()));
+  }
+  bytes_ += raster->size();
+  lru_.push_front(Entry{key, std::move(raster)});
+  index_[key] = lru_.begin();
+}
+
+void RasterCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  lru_.clear();
+  index_.clear();
+  bytes_ = 0;
+}
+
+size_t RasterCache::bytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return bytes_;
+}
+
+size_t RasterCache::entries() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return lru_.size();
+}
+
+uint64_t RasterCache::hits() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hits_;
+}
+
+uint64_t RasterCache::misses() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return misses_;
+}
+
+void RasterCache::EraseLocked(Lru::iterator it) {
+  bytes_ -= it->raster->size();
+  index_.erase(it->key);
+  lru_.erase(it);
+}
+
+}  // namespace flutter_thermal_printer
@@ -0,0 +1,104 @@
+#ifndef FLUTTER_PLUGIN_RASTER_CACHE_H_
+#define FLUTTER_PLUGIN_RASTER_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "raster_engine.h"
+
+namespace flutter_thermal_printer {
+
+/// XXH64 of |size| bytes. Fast enough (several GB/s) that hashing a logo is
+/// noise next to rasterizing it.
+uint64_t HashBytes(const uint8_t *data, size_t size, uint64_t seed = 0);
+
+/// Finished `GS v 0` bytes for images that repeat across tickets (logos,
+/// QR codes), so converting them again is a hash and a lookup.
+///
+/// Entries are keyed by the pixel hash plus everything that changes the
+/// output: size, dither mode, threshold, band layout and scaling. At most
+/// |max_bytes| of raster is kept, least recently used first out; an image
+/// larger than a quarter of that is never kept, so one tall receipt cannot
+/// flush the logos. Values are shared and immutable. Thread-safe.
+class RasterCache {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 16u * 1024u * 1024u;
+
+  struct Key {
+    uint64_t hash = 0;
+    int width = 0;
+    int height = 0;
+    int dither = 0;
+    int threshold = 0;
+    int band_rows = 0;
+    int scale_width = 0;
+    bool serial_diffusion = false;
+    bool feed_blank_rows = false;
+
+    bool operator==(const Key &other) const;
+  };
+
+  using Raster = std::shared_ptr<const std::vector<uint8_t>>;
+
+  /// The key for rasterizing |rgba| with |options|. Options that cannot
+  /// affect the output (the threshold outside threshold mode) are left
+  /// out, so equivalent requests share an entry.
+  static Key KeyFor(const uint8_t *rgba, size_t size, int width, int height,
+                    const RasterOptions &options);
+
+  explicit RasterCache(size_t max_bytes = kDefaultMaxBytes);
+
+  RasterCache(const RasterCache&) = delete;
+  RasterCache& operator=(const RasterCache&) = delete;
+
+  /// The cached raster for |key|, marked most recently used, or nullptr.
+  Raster Find(const Key &key);
+
+  /// Stores |raster| under |key|, replacing any previous entry and evicting
+  /// the least recently used ones until it fits.
+  void Insert(const Key &key, Raster raster);
+
+  void Clear();
+
+  /// Largest raster Insert() keeps.
+  size_t max_entry_bytes() const { return max_bytes_ / 4; }
+
+  size_t bytes() const;
+  size_t entries() const;
+
+  /// Find() calls that returned an entry / nullptr.
+  uint64_t hits() const;
+  uint64_t misses() const;
+
+ private:
+  struct KeyHash {
+    size_t operator()(const Key &key) const {
+      return static_cast<size_t>(key.hash);
+    }
+  };
+  struct Entry {
+    Key key;
+    Raster raster;
+  };
+  using Lru = std::list<Entry>;
+
+  void EraseLocked(Lru::iterator it);
+
+  const size_t max_bytes_;
+
+  mutable std::mutex mutex_;
+  Lru lru_;  // Most recently used first.
+  std::unordered_map<Key, Lru::iterator, KeyHash> index_;
+  size_t bytes_ = 0;
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+};
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_RASTER_CACHE_H_
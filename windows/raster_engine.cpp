@@ -0,0 +1,383 @@
+#include "raster_engine.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#include "buffer_pool.h"
+#include "raster_kernels.h"
+#include "raster_resampler.h"
+#include "thread_pool.h"
+
+namespace flutter_thermal_printer {
+
+namespace {
+
+// `GS v 0` encodes both dimensions as 16-bit little endian.
+constexpr int kMaxRasterDimension = 0xFFFF;
+
+// Work unit for parallel conversion. Small enough to balance 3000-row
+// receipts over four cores, large enough to amortize the diffusion warm-up.
+constexpr int kParallelBandRows = 64;
+
+// Rows re-diffused above each parallel band. Floyd-Steinberg error decays
+// within a few rows, so this hides the seam a cold start would leave.
+constexpr int kSeamWarmupRows = 8;
+
+constexpr size_t kRasterHeaderSize = 8;
+
+// `ESC J n` feeds at most 255 motion units.
+constexpr int kMaxFeedDots = 255;
+constexpr size_t kFeedCommandSize = 3;
+
+// Bounds what an extreme upscale can ask for: about 30 m of paper.
+constexpr int kMaxScaledRows = 1 << 18;
+
+void WriteRasterHeader(int bytes_per_row, int rows, uint8_t *out) {
+  out[0] = 0x1D;
+  out[1] = 0x76;
+  out[2] = 0x30;
+  out[3] = 0x00;
+  out[4] = static_cast<uint8_t>(bytes_per_row & 0xFF);
+  out[5] = static_cast<uint8_t>((bytes_per_row >> 8) & 0xFF);
+  out[6] = static_cast<uint8_t>(rows & 0xFF);
+  out[7] = static_cast<uint8_t>((rows >> 8) & 0xFF);
+}
+
+bool IsBlankRow(const uint8_t *row, size_t row_bytes) {
+  return std::all_of(row, row + row_bytes,
+                     [](uint8_t byte) { return byte == 0; });
+}
+
+// Worth a feed when the feeds plus the `GS v 0` header that resumes the
+// image are shorter than the rows they replace.
+bool FeedSaves(int rows, size_t row_bytes) {
+  const size_t feeds = static_cast<size_t>((rows + kMaxFeedDots - 1) /
+                                           kMaxFeedDots);
+  return static_cast<size_t>(rows) * row_bytes >
+         feeds * kFeedCommandSize + kRasterHeaderSize;
+}
+
+// Rewrites the `GS v 0` command at |src| to |dst| with its worthwhile runs
+// of blank rows replaced by `ESC J` feeds, splitting it where the image
+// resumes. |dst| may be |src| or before it: the output never overtakes the
+// input. Returns the bytes written.
+size_t FeedBlankRows(const uint8_t *src, uint8_t *dst) {
+  const int bytes_per_row = src[4] | (src[5] << 8);
+  const int rows = src[6] | (src[7] << 8);
+  const size_t row_bytes = static_cast<size_t>(bytes_per_row);
+  const uint8_t *row = src + kRasterHeaderSize;
+  uint8_t *out = dst;
+  uint8_t *header = nullptr;
+  int header_rows = 0;
+  for (int y = 0; y < rows;) {
+    int blank = 0;
+    while (y + blank < rows &&
+           IsBlankRow(row + row_bytes * (y + blank), row_bytes)) {
+      ++blank;
+    }
+    if (blank > 0 && FeedSaves(blank, row_bytes)) {
+      if (header != nullptr) {
+        WriteRasterHeader(bytes_per_row, header_rows, header);
+        header = nullptr;
+      }
+      for (int left = blank; left > 0; left -= kMaxFeedDots) {
+        *out++ = 0x1B;
+        *out++ = 0x4A;
+        *out++ = static_cast<uint8_t>(std::min(left, kMaxFeedDots));
+      }
+      y += blank;
+      continue;
+    }
+    // A short blank run or one inked row stays in the image.
+    const int kept = std::max(blank, 1);
+    if (header == nullptr) {
+      header = out;
+      out += kRasterHeaderSize;
+      header_rows = 0;
+    }
+    std::memmove(out, row + row_bytes * y, row_bytes * kept);
+    out += row_bytes * kept;
+    header_rows += kept;
+    y += kept;
+  }
+  if (header != nullptr) {
+    WriteRasterHeader(bytes_per_row, header_rows, header);
+  }
+  return static_cast<size_t>(out - dst);
+}
+
+// Applies FeedBlankRows() to each of the `GS v 0` commands from |offset|
+// to the end of |out|.
+void FeedBlankRuns(size_t offset, std::vector<uint8_t> *out) {
+  uint8_t *data = out->data();
+  size_t read = offset;
+  size_t write = offset;
+  while (read < out->size()) {
+    const size_t row_bytes = data[read + 4] | (data[read + 5] << 8);
+    const size_t rows = data[read + 6] | (data[read + 7] << 8);
+    const size_t size = kRasterHeaderSize + row_bytes * rows;
+    write += FeedBlankRows(data + read, data + write);
+    read += size;
+  }
+  out->resize(write);
+}
+
+constexpr uint8_t kBayer8[8][8] = {
+    {0, 32, 8, 40, 2, 34, 10, 42},  {48, 16, 56, 24, 50, 18, 58, 26},
+    {12, 44, 4, 36, 14, 46, 6, 38}, {60, 28, 52, 20, 62, 30, 54, 22},
+    {3, 35, 11, 43, 1, 33, 9, 41},  {51, 19, 59, 27, 49, 17, 57, 25},
+    {15, 47, 7, 39, 13, 45, 5, 37}, {63, 31, 55, 23, 61, 29, 53, 21},
+};
+
+}  // namespace
+
+RasterEncoder::RasterEncoder(int width, const RasterOptions &options,
+                             int first_row)
+    : width_(width),
+      options_(options),
+      kernels_(&RasterKernelsForWidth(GetRasterKernels(),
+                                      static_cast<size_t>(width))),
+      row_(first_row),
+      gray_(static_cast<size_t>(width)),
+      thresholds_(static_cast<size_t>(width), options.threshold) {
+  if (options_.dither == DitherMode::kFloydSteinberg) {
+    // Diffused pixels are already 0 or 255; pack them at mid-gray.
+    std::fill(thresholds_.begin(), thresholds_.end(), static_cast<uint8_t>(128));
+    error_.assign(static_cast<size_t>(width) + 2, 0);
+    next_error_.assign(static_cast<size_t>(width) + 2, 0);
+  }
+}
+
+void RasterEncoder::EncodeRgbaRow(const uint8_t *rgba, uint8_t *out) {
+  kernels_->rgba_to_gray(rgba, gray_.data(), gray_.size());
+  EncodeGrayRow(gray_.data(), out);
+}
+
+void RasterEncoder::EncodeGrayRow(const uint8_t *gray, uint8_t *out) {
+  switch (options_.dither) {
+    case DitherMode::kThreshold:
+      kernels_->pack_bits(gray, thresholds_.data(), out, gray_.size());
+      break;
+    case DitherMode::kOrdered: {
+      const uint8_t *pattern = kBayer8[row_ & 7];
+      for (int x = 0; x < width_; ++x) {
+        thresholds_[x] = static_cast<uint8_t>(pattern[x & 7] * 4 + 2);
+      }
+      kernels_->pack_bits(gray, thresholds_.data(), out, gray_.size());
+      break;
+    }
+    case DitherMode::kFloydSteinberg:
+      if (gray != gray_.data()) {
+        std::copy(gray, gray + width_, gray_.begin());
+      }
+      DiffuseRow(gray_.data());
+      kernels_->pack_bits(gray_.data(), thresholds_.data(), out,
+                          gray_.size());
+      break;
+  }
+  ++row_;
+}
+
+// Classic left-to-right Floyd-Steinberg (7/16, 3/16, 5/16, 1/16). Quantizes
+// |gray| in place to 0/255 and carries error into the next row.
+void RasterEncoder::DiffuseRow(uint8_t *gray) {
+  std::fill(next_error_.begin(), next_error_.end(), static_cast<int16_t>(0));
+  int16_t *error = error_.data() + 1;
+  int16_t *next = next_error_.data() + 1;
+  for (int x = 0; x < width_; ++x) {
+    const int value = std::clamp(gray[x] + error[x] / 16, 0, 255);
+    const int quantized = value < 128 ? 0 : 255;
+    const int diff = value - quantized;
+    gray[x] = static_cast<uint8_t>(quantized);
+    error[x + 1] = static_cast<int16_t>(error[x + 1] + diff * 7);
+    next[x - 1] = static_cast<int16_t>(next[x - 1] + diff * 3);
+    next[x] = static_cast<int16_t>(next[x] + diff * 5);
+    next[x + 1] = static_cast<int16_t>(next[x + 1] + diff);
+  }
+  error_.swap(next_error_);
+}
+
+void RasterOutputSize(int width, int height, const RasterOptions &options,
+                      int *out_width, int *out_height) {
+  if (options.scale_width <= 0 || options.scale_width == width ||
+      width <= 0 || height <= 0) {
+    *out_width = width;
+    *out_height = height;
+    return;
+  }
+  *out_width = options.scale_width;
+  *out_height = ScaledHeight(width, height, options.scale_width);
+}
+
+void AppendRasterHeader(int bytes_per_row, int rows, std::vector<uint8_t> *out) {
+  const size_t offset = out->size();
+  out->resize(offset + kRasterHeaderSize);
+  WriteRasterHeader(bytes_per_row, rows, out->data() + offset);
+}
+
+bool RasterizeRgba(const uint8_t *rgba, size_t size, int width, int height,
+                   const RasterOptions &options, std::vector<uint8_t> *out,
+                   ThreadPool *pool) {
+  if (width <= 0 || height <= 0 || (width + 7) / 8 > kMaxRasterDimension ||
+      size != static_cast<size_t>(width) * static_cast<size_t>(height) * 4) {
+    return false;
+  }
+  int out_width = width;
+  int out_height = height;
+  RasterOutputSize(width, height, options, &out_width, &out_height);
+  if (out_width != width) {
+    // The resampler is serial; stream its bands into place instead.
+    RasterOptions whole = options;
+    if (whole.band_rows <= 0) {
+      whole.band_rows = out_height;
+    }
+    const size_t base = out->size();
+    const bool ok = RasterizeRgbaBands(
+        rgba, size, width, height, whole, [out](std::vector<uint8_t> band) {
+          out->insert(out->end(), band.begin(), band.end());
+          return true;
+        });
+    if (!ok) {
+      out->resize(base);
+    }
+    return ok;
+  }
+  int band_rows = options.band_rows > 0 ? options.band_rows : height;
+  band_rows = std::min(band_rows, kMaxRasterDimension);
+
+  const int bytes_per_row = (width + 7) / 8;
+  const size_t row_bytes = static_cast<size_t>(bytes_per_row);
+  const size_t src_stride = static_cast<size_t>(width) * 4;
+  const int band_count = (height + band_rows - 1) / band_rows;
+
+  // Lay out every header up front so any band can be written in place:
+  // row y lives after (y / band_rows + 1) headers and y earlier rows.
+  const size_t base = out->size();
+  out->resize(base + kRasterHeaderSize * band_count + row_bytes * height);
+  uint8_t *dst = out->data() + base;
+  for (int band = 0; band < band_count; ++band) {
+    const int first = band * band_rows;
+    WriteRasterHeader(bytes_per_row, std::min(band_rows, height - first),
+                      dst + kRasterHeaderSize * band + row_bytes * first);
+  }
+  auto row_out = [dst, band_rows, row_bytes](int y) {
+    return dst + kRasterHeaderSize * (y / band_rows + 1) + row_bytes * y;
+  };
+
+  const bool diffusion = options.dither == DitherMode::kFloydSteinberg;
+  if (pool == nullptr || height < 2 * kParallelBandRows ||
+      (diffusion && options.serial_diffusion)) {
+    RasterEncoder encoder(width, options);
+    for (int y = 0; y < height; ++y) {
+      encoder.EncodeRgbaRow(rgba + src_stride * y, row_out(y));
+    }
+  } else {
+    const size_t work_units = static_cast<size_t>(
+        (height + kParallelBandRows - 1) / kParallelBandRows);
+    pool->ParallelFor(work_units, [&](size_t unit) {
+      const int y0 = static_cast<int>(unit) * kParallelBandRows;
+      const int y1 = std::min(y0 + kParallelBandRows, height);
+      const int warmup = diffusion ? std::min(kSeamWarmupRows, y0) : 0;
+      RasterEncoder encoder(width, options, y0 - warmup);
+      if (warmup > 0) {
+        std::vector<uint8_t> scratch(row_bytes);
+        for (int y = y0 - warmup; y < y0; ++y) {
+          encoder.EncodeRgbaRow(rgba + src_stride * y, scratch.data());
+        }
+      }
+      for (int y = y0; y < y1; ++y) {
+        encoder.EncodeRgbaRow(rgba + src_stride * y, row_out(y));
+      }
+    });
+  }
+  if (options.feed_blank_rows) {
+    FeedBlankRuns(base, out);
+  }
+  return true;
+}
+
+bool RasterizeRgbaBands(const uint8_t *rgba, size_t size, int width,
+                        int height, const RasterOptions &options,
+                        const RasterBandSink &sink, BufferPool *buffers) {
+  if (width <= 0 || height <= 0 ||
+      size != static_cast<size_t>(width) * static_cast<size_t>(height) * 4) {
+    return false;
+  }
+  const size_t src_stride = static_cast<size_t>(width) * 4;
+  return RasterizeRgbaRowBands(
+      [rgba, src_stride](int first_row, int) {
+        return rgba + src_stride * first_row;
+      },
+      width, height, options, sink, buffers);
+}
+
+bool RasterizeRgbaRowBands(const RgbaRowSource &source, int width, int height,
+                           const RasterOptions &options,
+                           const RasterBandSink &sink, BufferPool *buffers) {
+  if (width <= 0 || height <= 0) {
+    return false;
+  }
+  int out_width = width;
+  int out_height = height;
+  RasterOutputSize(width, height, options, &out_width, &out_height);
+  if ((out_width + 7) / 8 > kMaxRasterDimension ||
+      (out_width != width && out_height > kMaxScaledRows)) {
+    return false;
+  }
+  int band_rows = options.band_rows > 0 ? options.band_rows : kStreamBandRows;
+  band_rows = std::min(band_rows, kMaxRasterDimension);
+
+  const int bytes_per_row = (out_width + 7) / 8;
+  const size_t row_bytes = static_cast<size_t>(bytes_per_row);
+  const size_t src_stride = static_cast<size_t>(width) * 4;
+  std::unique_ptr<ScaledGrayRows> scaled;
+  if (out_width != width) {
+    scaled = std::make_unique<ScaledGrayRows>(source, width, height,
+                                              out_width, out_height);
+  }
+
+  // One encoder for the whole image keeps diffusion exact across bands.
+  RasterEncoder encoder(out_width, options);
+  for (int first = 0; first < out_height; first += band_rows) {
+    const int rows = std::min(band_rows, out_height - first);
+    const size_t band_size = kRasterHeaderSize + row_bytes * rows;
+    std::vector<uint8_t> band;
+    if (buffers != nullptr) {
+      band = buffers->Acquire(band_size);
+    }
+    band.resize(band_size);
+    WriteRasterHeader(bytes_per_row, rows, band.data());
+    uint8_t *dst = band.data() + kRasterHeaderSize;
+    if (scaled) {
+      for (int y = first; y < first + rows; ++y, dst += row_bytes) {
+        const uint8_t *gray = scaled->Row(y);
+        if (gray == nullptr) {
+          return false;
+        }
+        encoder.EncodeGrayRow(gray, dst);
+      }
+    } else {
+      for (int y = first; y < first + rows;) {
+        const int count = std::min(kStreamBandRows, first + rows - y);
+        const uint8_t *src = source(y, count);
+        if (src == nullptr) {
+          return false;
+        }
+        for (int i = 0; i < count; ++i, src += src_stride, dst += row_bytes) {
+          encoder.EncodeRgbaRow(src, dst);
+        }
+        y += count;
+      }
+    }
+    if (options.feed_blank_rows) {
+      band.resize(FeedBlankRows(band.data(), band.data()));
+    }
+    if (!sink(std::move(band))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace flutter_thermal_printer
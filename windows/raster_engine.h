@@ -0,0 +1,139 @@
+#ifndef FLUTTER_PLUGIN_RASTER_ENGINE_H_
+#define FLUTTER_PLUGIN_RASTER_ENGINE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace flutter_thermal_printer {
+
+class BufferPool;
+struct RasterKernels;
+
+/// How gray levels become printed dots. Values match the Dart `DitherMode`
+/// enum index.
+enum class DitherMode {
+  kThreshold = 0,
+  kFloydSteinberg = 1,
+  kOrdered = 2,
+};
+
+struct RasterOptions {
+  DitherMode dither = DitherMode::kThreshold;
+
+  /// Gray levels below this print black (threshold mode only).
+  uint8_t threshold = 128;
+
+  /// Rows per `GS v 0` command; 0 emits the whole image as one command.
+  int band_rows = 0;
+
+  /// Error diffusion normally runs bands in parallel, each one primed by
+  /// re-diffusing a few rows above it so no seam shows. Set this to get the
+  /// exact serial Floyd-Steinberg result instead (single-threaded).
+  bool serial_diffusion = false;
+
+  /// Width in dots to resample to, keeping the aspect ratio, e.g. 576 for
+  /// 80 mm paper. Scaling is fused with the gray conversion and always runs
+  /// serially. 0 prints the source width as is.
+  int scale_width = 0;
+
+  /// Sends runs of all-white rows as `ESC J` paper feeds instead of raster
+  /// data, where that is shorter. Assumes the vertical motion unit is one
+  /// dot, the default on 203 dpi printers.
+  bool feed_blank_rows = false;
+};
+
+/// Dots per row and rows that rasterizing |width| x |height| with
+/// |options| produces.
+void RasterOutputSize(int width, int height, const RasterOptions &options,
+                      int *out_width, int *out_height);
+
+class ThreadPool;
+
+/// Incremental RGBA -> packed 1-bpp converter. Rows are fed top to bottom
+/// one at a time, so callers never need to hold more than one source row.
+/// Transparent pixels are composited over white paper. Set bits are black,
+/// MSB first; the last byte of a row is padded with white.
+class RasterEncoder {
+ public:
+  /// |first_row| is the image row the first Encode call corresponds to; it
+  /// keeps the ordered-dither pattern aligned when encoding a band.
+  RasterEncoder(int width, const RasterOptions &options, int first_row = 0);
+
+  int width() const { return width_; }
+  int bytes_per_row() const { return (width_ + 7) / 8; }
+
+  /// Converts one row of |width()| RGBA pixels into |bytes_per_row()| bytes.
+  void EncodeRgbaRow(const uint8_t *rgba, uint8_t *out);
+
+  /// Same as EncodeRgbaRow() for a row that is already 8-bit gray.
+  void EncodeGrayRow(const uint8_t *gray, uint8_t *out);
+
+ private:
+  void DiffuseRow(uint8_t *gray);
+
+  int width_;
+  RasterOptions options_;
+  const RasterKernels *kernels_;
+  int row_ = 0;
+
+  std::vector<uint8_t> gray_;
+  std::vector<uint8_t> thresholds_;
+  // Floyd-Steinberg error for the current and next row, with one guard
+  // cell on each side.
+  std::vector<int16_t> error_;
+  std::vector<int16_t> next_error_;
+};
+
+/// Appends `GS v 0 0 xL xH yL yH` for a |bytes_per_row| x |rows| bitmap.
+void AppendRasterHeader(int bytes_per_row, int rows, std::vector<uint8_t> *out);
+
+/// Converts a tightly packed RGBA image into `GS v 0` commands appended to
+/// |out|. Returns false if the dimensions don't match |size|.
+///
+/// With a |pool|, tall images are split into bands converted concurrently
+/// and written straight to their final offsets in |out|. Threshold and
+/// ordered output is identical to the serial result.
+bool RasterizeRgba(const uint8_t *rgba, size_t size, int width, int height,
+                   const RasterOptions &options, std::vector<uint8_t> *out,
+                   ThreadPool *pool = nullptr);
+
+/// Receives one finished `GS v 0` band; returns false to stop early.
+using RasterBandSink = std::function<bool(std::vector<uint8_t> band)>;
+
+/// Streaming form of RasterizeRgba(): converts top to bottom and hands each
+/// band to |sink| as soon as its last row is encoded, so only one band is
+/// held at a time. A |band_rows| of 0 uses kStreamBandRows. The bytes are
+/// the same as RasterizeRgba() with the same band size and no pool.
+/// Band storage comes from |buffers| when given, so a consumer that
+/// releases bands back to it streams without allocating.
+/// Returns false if the dimensions don't match |size| or |sink| stopped.
+bool RasterizeRgbaBands(const uint8_t *rgba, size_t size, int width,
+                        int height, const RasterOptions &options,
+                        const RasterBandSink &sink,
+                        BufferPool *buffers = nullptr);
+
+/// Default band height for RasterizeRgbaBands(): about 8 mm of paper at
+/// 203 dpi, so the first band reaches the printer almost immediately.
+constexpr int kStreamBandRows = 64;
+
+/// Hands out |rows| RGBA rows starting at |first_row|, tightly packed, or
+/// nullptr on a read error. Rows are asked for top to bottom, at most
+/// kStreamBandRows at a time; the pointer only has to stay valid until the
+/// next call.
+using RgbaRowSource = std::function<const uint8_t *(int first_row, int rows)>;
+
+/// RasterizeRgbaBands() pulling pixels from |source| instead of one buffer,
+/// e.g. from an image decoder, so no full-size RGBA image is ever held.
+/// A |band_rows| above kStreamBandRows still reads the source in
+/// kStreamBandRows pieces. Returns false for a bad size, a source error or
+/// when |sink| stopped.
+bool RasterizeRgbaRowBands(const RgbaRowSource &source, int width, int height,
+                           const RasterOptions &options,
+                           const RasterBandSink &sink,
+                           BufferPool *buffers = nullptr);
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_RASTER_ENGINE_H_
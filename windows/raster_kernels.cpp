@@ -0,0 +1,193 @@
+#include "raster_kernels.h"
+
+#include <array>
+
+#if FLUTTER_THERMAL_PRINTER_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace flutter_thermal_printer {
+
+namespace {
+
+struct Scalar {
+  static constexpr const char *kName = "scalar";
+
+  template <size_t kPixels>
+  static void RgbaToGray(const uint8_t *rgba, uint8_t *gray, size_t pixels) {
+    if constexpr (kPixels != 0) {
+      pixels = kPixels;
+    }
+    for (size_t i = 0; i < pixels; ++i, rgba += 4) {
+      const uint32_t luma =
+          (77u * rgba[0] + 150u * rgba[1] + 29u * rgba[2] + 128u) >> 8;
+      const uint32_t alpha = rgba[3];
+      // luma * alpha / 255 rounded exactly, then add the white showing
+      // through.
+      const uint32_t t = luma * alpha + 128u;
+      gray[i] = static_cast<uint8_t>(((t + (t >> 8)) >> 8) + 255u - alpha);
+    }
+  }
+
+  // Builds each output byte from eight compares, without branches.
+  template <size_t kPixels>
+  static void PackBits(const uint8_t *gray, const uint8_t *thresholds,
+                       uint8_t *out, size_t pixels) {
+    if constexpr (kPixels != 0) {
+      pixels = kPixels;
+    }
+    const size_t whole = pixels / 8;
+    for (size_t byte = 0; byte < whole; ++byte) {
+      uint32_t bits = 0;
+      for (size_t bit = 0; bit < 8; ++bit) {
+        bits = (bits << 1) | (gray[bit] < thresholds[bit] ? 1u : 0u);
+      }
+      out[byte] = static_cast<uint8_t>(bits);
+      gray += 8;
+      thresholds += 8;
+    }
+    const size_t tail = pixels % 8;
+    if (tail != 0) {
+      uint32_t bits = 0;
+      for (size_t bit = 0; bit < tail; ++bit) {
+        bits = (bits << 1) | (gray[bit] < thresholds[bit] ? 1u : 0u);
+      }
+      out[whole] = static_cast<uint8_t>(bits << (8 - tail));
+    }
+  }
+};
+
+constexpr const RasterKernels &kScalarKernels =
+    internal::RasterKernelTable<Scalar>::kGeneric;
+
+#if FLUTTER_THERMAL_PRINTER_X86
+struct CpuFeatures {
+  bool sse2 = false;
+  bool avx2 = false;
+};
+
+void Cpuid(int leaf, int subleaf, uint32_t regs[4]) {
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuidex(info, leaf, subleaf);
+  for (int i = 0; i < 4; ++i) {
+    regs[i] = static_cast<uint32_t>(info[i]);
+  }
+#else
+  __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+uint64_t ReadXcr0() {
+#if defined(_MSC_VER)
+  return _xgetbv(0);
+#else
+  uint32_t eax = 0;
+  uint32_t edx = 0;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+
+CpuFeatures DetectCpuFeatures() {
+  CpuFeatures features;
+  uint32_t regs[4] = {};
+  Cpuid(0, 0, regs);
+  const uint32_t max_leaf = regs[0];
+  if (max_leaf < 1) {
+    return features;
+  }
+  Cpuid(1, 0, regs);
+  features.sse2 = (regs[3] & (1u << 26)) != 0;
+  const bool osxsave = (regs[2] & (1u << 27)) != 0;
+  const bool avx = (regs[2] & (1u << 28)) != 0;
+  // AVX state must also be enabled by the OS (XMM and YMM bits in XCR0).
+  if (max_leaf >= 7 && osxsave && avx && (ReadXcr0() & 0x6) == 0x6) {
+    Cpuid(7, 0, regs);
+    features.avx2 = (regs[1] & (1u << 5)) != 0;
+  }
+  return features;
+}
+
+const CpuFeatures &GetCpuFeatures() {
+  static const CpuFeatures features = DetectCpuFeatures();
+  return features;
+}
+#endif  // FLUTTER_THERMAL_PRINTER_X86
+
+constexpr uint8_t ReverseByte(int value) {
+  int reversed = 0;
+  for (int bit = 0; bit < 8; ++bit) {
+    if (value & (1 << bit)) {
+      reversed |= 0x80 >> bit;
+    }
+  }
+  return static_cast<uint8_t>(reversed);
+}
+
+constexpr std::array<uint8_t, 256> MakeReverseBitsTable() {
+  std::array<uint8_t, 256> table = {};
+  for (int value = 0; value < 256; ++value) {
+    table[value] = ReverseByte(value);
+  }
+  return table;
+}
+
+}  // namespace
+
+namespace internal {
+
+const std::array<uint8_t, 256> kReverseBits = MakeReverseBitsTable();
+
+}  // namespace internal
+
+const RasterKernels &ScalarRasterKernels() { return kScalarKernels; }
+
+const RasterKernels *Sse2RasterKernels() {
+#if FLUTTER_THERMAL_PRINTER_X86
+  if (GetCpuFeatures().sse2) {
+    return internal::BuiltSse2RasterKernels();
+  }
+#endif
+  return nullptr;
+}
+
+const RasterKernels *Avx2RasterKernels() {
+#if FLUTTER_THERMAL_PRINTER_X86
+  if (GetCpuFeatures().avx2) {
+    return internal::BuiltAvx2RasterKernels();
+  }
+#endif
+  return nullptr;
+}
+
+const RasterKernels &RasterKernelsForWidth(const RasterKernels &kernels,
+                                           size_t width) {
+  if (kernels.fixed_widths != nullptr) {
+    for (size_t i = 0; i < kFixedRasterWidthCount; ++i) {
+      if (kFixedRasterWidths[i] == width) {
+        return kernels.fixed_widths[i];
+      }
+    }
+  }
+  return kernels;
+}
+
+const RasterKernels &GetRasterKernels() {
+  static const RasterKernels *const kernels = []() {
+    if (const RasterKernels *avx2 = Avx2RasterKernels()) {
+      return avx2;
+    }
+    if (const RasterKernels *sse2 = Sse2RasterKernels()) {
+      return sse2;
+    }
+    return &kScalarKernels;
+  }();
+  return *kernels;
+}
+
+}  // namespace flutter_thermal_printer
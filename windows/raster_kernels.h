@@ -0,0 +1,93 @@
+#ifndef FLUTTER_PLUGIN_RASTER_KERNELS_H_
+#define FLUTTER_PLUGIN_RASTER_KERNELS_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || \
+    defined(__i386__)
+#define FLUTTER_THERMAL_PRINTER_X86 1
+#else
+#define FLUTTER_THERMAL_PRINTER_X86 0
+#endif
+
+namespace flutter_thermal_printer {
+
+/// Dot widths of 58, 80 and 112 mm heads at 203 dpi. Kernel sets are also
+/// instantiated for each of these, with the row width a compile-time
+/// constant, so their row loops unroll and have no scalar tail.
+constexpr size_t kFixedRasterWidths[] = {384, 576, 832};
+constexpr size_t kFixedRasterWidthCount =
+    sizeof(kFixedRasterWidths) / sizeof(kFixedRasterWidths[0]);
+
+/// Inner loops of the raster engine. Every implementation must produce output
+/// bit-identical to the scalar one; raster_kernels_test.cpp enforces this.
+struct RasterKernels {
+  const char *name;
+
+  /// Rec. 601 luma of |pixels| RGBA pixels, composited over white.
+  void (*rgba_to_gray)(const uint8_t *rgba, uint8_t *gray, size_t pixels);
+
+  /// Writes (pixels + 7) / 8 bytes, MSB first, with a bit set wherever
+  /// gray[i] < thresholds[i]. Padding bits in the last byte are zero.
+  void (*pack_bits)(const uint8_t *gray, const uint8_t *thresholds,
+                    uint8_t *out, size_t pixels);
+
+  /// This set instantiated for each of kFixedRasterWidths, in order;
+  /// nullptr on those fixed-width sets themselves.
+  const RasterKernels *fixed_widths;
+};
+
+const RasterKernels &ScalarRasterKernels();
+
+/// nullptr when the kernel set is not built for this target or the running
+/// CPU/OS does not support it.
+const RasterKernels *Sse2RasterKernels();
+const RasterKernels *Avx2RasterKernels();
+
+/// Fastest supported kernel set, picked once via CPUID.
+const RasterKernels &GetRasterKernels();
+
+/// |kernels| specialized for rows of exactly |width| pixels when |width| is
+/// one of kFixedRasterWidths, otherwise |kernels| itself. A specialized set
+/// must only be called with |pixels| == |width|.
+const RasterKernels &RasterKernelsForWidth(const RasterKernels &kernels,
+                                           size_t width);
+
+namespace internal {
+
+// Defined in raster_kernels_sse2.cpp / raster_kernels_avx2.cpp; nullptr when
+// that file was compiled without the instruction set.
+const RasterKernels *BuiltSse2RasterKernels();
+const RasterKernels *BuiltAvx2RasterKernels();
+
+// Reverses the bit order of a byte (LSB-first movemask -> MSB-first dots).
+extern const std::array<uint8_t, 256> kReverseBits;
+
+// Builds a kernel set from |Impl|'s RgbaToGray<kPixels> and
+// PackBits<kPixels> templates, where kPixels == 0 takes the width from the
+// call and any other value fixes it.
+template <typename Impl>
+struct RasterKernelTable {
+  template <size_t kPixels>
+  static constexpr RasterKernels Fixed() {
+    return {Impl::kName, &Impl::template RgbaToGray<kPixels>,
+            &Impl::template PackBits<kPixels>, nullptr};
+  }
+
+  static_assert(kFixedRasterWidthCount == 3, "one entry per fixed width");
+  static constexpr RasterKernels kFixed[kFixedRasterWidthCount] = {
+      Fixed<kFixedRasterWidths[0]>(), Fixed<kFixedRasterWidths[1]>(),
+      Fixed<kFixedRasterWidths[2]>()};
+
+  static constexpr RasterKernels kGeneric = {
+      Impl::kName, &Impl::template RgbaToGray<0>,
+      &Impl::template PackBits<0>, kFixed};
+};
+
+}  // namespace internal
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_RASTER_KERNELS_H_
@@ -0,0 +1,117 @@
+#include "raster_kernels.h"
+
+#include <cstring>
+
+// Built with /arch:AVX2 (see CMakeLists.txt) but only called when CPUID
+// says the CPU supports it.
+#if FLUTTER_THERMAL_PRINTER_X86 && \
+    (defined(_MSC_VER) || defined(__AVX2__))
+#include <immintrin.h>
+#define FLUTTER_THERMAL_PRINTER_HAS_AVX2 1
+#endif
+
+namespace flutter_thermal_printer {
+
+#if defined(FLUTTER_THERMAL_PRINTER_HAS_AVX2)
+
+namespace {
+
+// Eight RGBA pixels in 32-bit lanes -> eight gray values in 32-bit lanes.
+// Same arithmetic as the SSE2 and scalar kernels.
+inline __m256i GrayFromRgba8(__m256i pixels) {
+  const __m256i rb = _mm256_and_si256(pixels, _mm256_set1_epi16(0x00FF));
+  const __m256i ga = _mm256_srli_epi16(pixels, 8);
+  __m256i luma = _mm256_add_epi32(
+      _mm256_madd_epi16(rb, _mm256_set1_epi32((29 << 16) | 77)),
+      _mm256_madd_epi16(ga, _mm256_set1_epi32(150)));
+  luma = _mm256_srli_epi32(_mm256_add_epi32(luma, _mm256_set1_epi32(128)), 8);
+  const __m256i alpha = _mm256_srli_epi32(pixels, 24);
+  __m256i t = _mm256_add_epi32(_mm256_madd_epi16(luma, alpha),
+                               _mm256_set1_epi32(128));
+  t = _mm256_srli_epi32(_mm256_add_epi32(t, _mm256_srli_epi32(t, 8)), 8);
+  return _mm256_sub_epi32(_mm256_add_epi32(t, _mm256_set1_epi32(255)), alpha);
+}
+
+struct Avx2 {
+  static constexpr const char *kName = "avx2";
+
+  template <size_t kPixels>
+  static void RgbaToGray(const uint8_t *rgba, uint8_t *gray, size_t pixels);
+
+  template <size_t kPixels>
+  static void PackBits(const uint8_t *gray, const uint8_t *thresholds,
+                       uint8_t *out, size_t pixels);
+};
+
+template <size_t kPixels>
+void Avx2::RgbaToGray(const uint8_t *rgba, uint8_t *gray, size_t pixels) {
+  if constexpr (kPixels != 0) {
+    pixels = kPixels;
+  }
+  // packs/packus work per 128-bit lane; this restores pixel order.
+  const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+  size_t i = 0;
+  for (; i + 32 <= pixels; i += 32) {
+    const __m256i *src = reinterpret_cast<const __m256i *>(rgba + i * 4);
+    const __m256i g0 = GrayFromRgba8(_mm256_loadu_si256(src));
+    const __m256i g1 = GrayFromRgba8(_mm256_loadu_si256(src + 1));
+    const __m256i g2 = GrayFromRgba8(_mm256_loadu_si256(src + 2));
+    const __m256i g3 = GrayFromRgba8(_mm256_loadu_si256(src + 3));
+    const __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(g0, g1),
+                                               _mm256_packs_epi32(g2, g3));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(gray + i),
+                        _mm256_permutevar8x32_epi32(packed, order));
+  }
+  // Folded away for the fixed widths, which are multiples of 32.
+  if (i < pixels) {
+    ScalarRasterKernels().rgba_to_gray(rgba + i * 4, gray + i, pixels - i);
+  }
+}
+
+template <size_t kPixels>
+void Avx2::PackBits(const uint8_t *gray, const uint8_t *thresholds,
+                    uint8_t *out, size_t pixels) {
+  if constexpr (kPixels != 0) {
+    pixels = kPixels;
+  }
+  const __m256i bias = _mm256_set1_epi8(static_cast<char>(0x80));
+  // Reverse each group of 8 bytes so movemask yields MSB-first dot bytes.
+  const __m256i reverse = _mm256_setr_epi8(
+      7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+      7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+  size_t i = 0;
+  for (; i + 32 <= pixels; i += 32) {
+    const __m256i g = _mm256_xor_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(gray + i)), bias);
+    const __m256i t = _mm256_xor_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(thresholds + i)),
+        bias);
+    const __m256i black =
+        _mm256_shuffle_epi8(_mm256_cmpgt_epi8(t, g), reverse);
+    const uint32_t mask =
+        static_cast<uint32_t>(_mm256_movemask_epi8(black));
+    std::memcpy(out + i / 8, &mask, sizeof(mask));
+  }
+  if (i < pixels) {
+    ScalarRasterKernels().pack_bits(gray + i, thresholds + i, out + i / 8,
+                                    pixels - i);
+  }
+}
+
+}  // namespace
+
+namespace internal {
+const RasterKernels *BuiltAvx2RasterKernels() {
+  return &RasterKernelTable<Avx2>::kGeneric;
+}
+}  // namespace internal
+
+#else
+
+namespace internal {
+const RasterKernels *BuiltAvx2RasterKernels() { return nullptr; }
+}  // namespace internal
+
+#endif  // FLUTTER_THERMAL_PRINTER_HAS_AVX2
+
+}  // namespace flutter_thermal_printer
@@ -0,0 +1,105 @@
+#include "raster_kernels.h"
+
+#if FLUTTER_THERMAL_PRINTER_X86 && \
+    (defined(_MSC_VER) || defined(__SSE2__))
+#include <emmintrin.h>
+#define FLUTTER_THERMAL_PRINTER_HAS_SSE2 1
+#endif
+
+namespace flutter_thermal_printer {
+
+#if defined(FLUTTER_THERMAL_PRINTER_HAS_SSE2)
+
+namespace {
+
+// Four RGBA pixels in 32-bit lanes -> four gray values in 32-bit lanes.
+inline __m128i GrayFromRgba4(__m128i pixels) {
+  const __m128i rb = _mm_and_si128(pixels, _mm_set1_epi16(0x00FF));
+  const __m128i ga = _mm_srli_epi16(pixels, 8);
+  __m128i luma = _mm_add_epi32(
+      _mm_madd_epi16(rb, _mm_set1_epi32((29 << 16) | 77)),
+      _mm_madd_epi16(ga, _mm_set1_epi32(150)));
+  luma = _mm_srli_epi32(_mm_add_epi32(luma, _mm_set1_epi32(128)), 8);
+  const __m128i alpha = _mm_srli_epi32(pixels, 24);
+  // Both operands fit in the low 16 bits, so madd is a plain 32-bit multiply.
+  __m128i t = _mm_add_epi32(_mm_madd_epi16(luma, alpha), _mm_set1_epi32(128));
+  t = _mm_srli_epi32(_mm_add_epi32(t, _mm_srli_epi32(t, 8)), 8);
+  return _mm_sub_epi32(_mm_add_epi32(t, _mm_set1_epi32(255)), alpha);
+}
+
+struct Sse2 {
+  static constexpr const char *kName = "sse2";
+
+  template <size_t kPixels>
+  static void RgbaToGray(const uint8_t *rgba, uint8_t *gray, size_t pixels);
+
+  template <size_t kPixels>
+  static void PackBits(const uint8_t *gray, const uint8_t *thresholds,
+                       uint8_t *out, size_t pixels);
+};
+
+template <size_t kPixels>
+void Sse2::RgbaToGray(const uint8_t *rgba, uint8_t *gray, size_t pixels) {
+  if constexpr (kPixels != 0) {
+    pixels = kPixels;
+  }
+  size_t i = 0;
+  for (; i + 16 <= pixels; i += 16) {
+    const __m128i *src = reinterpret_cast<const __m128i *>(rgba + i * 4);
+    const __m128i g0 = GrayFromRgba4(_mm_loadu_si128(src));
+    const __m128i g1 = GrayFromRgba4(_mm_loadu_si128(src + 1));
+    const __m128i g2 = GrayFromRgba4(_mm_loadu_si128(src + 2));
+    const __m128i g3 = GrayFromRgba4(_mm_loadu_si128(src + 3));
+    const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(g0, g1),
+                                            _mm_packs_epi32(g2, g3));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(gray + i), packed);
+  }
+  // Folded away for the fixed widths, which are multiples of 16.
+  if (i < pixels) {
+    ScalarRasterKernels().rgba_to_gray(rgba + i * 4, gray + i, pixels - i);
+  }
+}
+
+template <size_t kPixels>
+void Sse2::PackBits(const uint8_t *gray, const uint8_t *thresholds,
+                    uint8_t *out, size_t pixels) {
+  if constexpr (kPixels != 0) {
+    pixels = kPixels;
+  }
+  const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80));
+  size_t i = 0;
+  for (; i + 16 <= pixels; i += 16) {
+    // Unsigned gray < threshold via the signed compare on biased values.
+    const __m128i g = _mm_xor_si128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(gray + i)), bias);
+    const __m128i t = _mm_xor_si128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(thresholds + i)),
+        bias);
+    const int mask = _mm_movemask_epi8(_mm_cmplt_epi8(g, t));
+    out[i / 8] = internal::kReverseBits[mask & 0xFF];
+    out[i / 8 + 1] = internal::kReverseBits[(mask >> 8) & 0xFF];
+  }
+  // |i| is a multiple of 16, so the tail starts on a byte boundary.
+  if (i < pixels) {
+    ScalarRasterKernels().pack_bits(gray + i, thresholds + i, out + i / 8,
+                                    pixels - i);
+  }
+}
+
+}  // namespace
+
+namespace internal {
+const RasterKernels *BuiltSse2RasterKernels() {
+  return &RasterKernelTable<Sse2>::kGeneric;
+}
+}  // namespace internal
+
+#else
+
+namespace internal {
+const RasterKernels *BuiltSse2RasterKernels() { return nullptr; }
+}  // namespace internal
+
+#endif  // FLUTTER_THERMAL_PRINTER_HAS_SSE2
+
+}  // namespace flutter_thermal_printer
@@ -0,0 +1,160 @@
+#include "raster_resampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "raster_kernels.h"
+
+namespace flutter_thermal_printer {
+
+namespace {
+
+constexpr int32_t kFilterOne = 1 << ResampleFilter::kFilterBits;
+constexpr int32_t kFilterHalf = kFilterOne / 2;
+
+}  // namespace
+
+int ScaledHeight(int src_width, int src_height, int dst_width) {
+  const int64_t height =
+      (static_cast<int64_t>(src_height) * dst_width + src_width / 2) /
+      src_width;
+  return static_cast<int>(std::max<int64_t>(height, 1));
+}
+
+ResampleFilter::ResampleFilter(int src, int dst)
+    : first_(static_cast<size_t>(dst)),
+      count_(static_cast<size_t>(dst)),
+      offset_(static_cast<size_t>(dst)) {
+  // Weights are worked out in floating point once per size; only the
+  // per-pixel passes are fixed point.
+  const double scale = static_cast<double>(src) / dst;
+  std::vector<double> taps;
+  for (int i = 0; i < dst; ++i) {
+    taps.clear();
+    int first;
+    if (scale > 1.0) {
+      // Each output averages the source span it covers.
+      const double left = i * scale;
+      const double right = (i + 1) * scale;
+      first = static_cast<int>(left);
+      const int last =
+          std::min(src - 1, static_cast<int>(std::ceil(right)) - 1);
+      for (int j = first; j <= last; ++j) {
+        const double overlap =
+            std::min(right, j + 1.0) - std::max(left, static_cast<double>(j));
+        taps.push_back(std::max(overlap, 0.0) / scale);
+      }
+    } else {
+      // Pixel centers are aligned, and the edges clamp.
+      const double center = (i + 0.5) * scale - 0.5;
+      first = static_cast<int>(std::floor(center));
+      double fraction = center - first;
+      if (first < 0) {
+        first = 0;
+        fraction = 0;
+      } else if (first >= src - 1) {
+        first = src - 1;
+        fraction = 0;
+      }
+      taps.push_back(1.0 - fraction);
+      if (fraction > 0) {
+        taps.push_back(fraction);
+      }
+    }
+
+    offset_[i] = weights_.size();
+    int32_t sum = 0;
+    size_t largest = 0;
+    for (size_t k = 0; k < taps.size(); ++k) {
+      const int32_t weight =
+          static_cast<int32_t>(std::lround(taps[k] * kFilterOne));
+      weights_.push_back(weight);
+      sum += weight;
+      if (weight > weights_[offset_[i] + largest]) {
+        largest = k;
+      }
+    }
+    // Rounding must not brighten or darken flat areas.
+    weights_[offset_[i] + largest] += kFilterOne - sum;
+    first_[i] = first;
+    count_[i] = static_cast<int>(taps.size());
+    max_count_ = std::max(max_count_, count_[i]);
+  }
+}
+
+ScaledGrayRows::ScaledGrayRows(RgbaRowSource source, int src_width,
+                               int src_height, int dst_width, int dst_height)
+    : source_(std::move(source)),
+      kernels_(&GetRasterKernels()),
+      src_width_(src_width),
+      src_height_(src_height),
+      dst_width_(dst_width),
+      dst_height_(dst_height),
+      horizontal_(src_width, dst_width),
+      vertical_(src_height, dst_height),
+      ring_rows_(vertical_.max_count()),
+      ring_(static_cast<size_t>(ring_rows_) * dst_width),
+      gray_(static_cast<size_t>(src_width)),
+      sums_(static_cast<size_t>(dst_width)),
+      out_(static_cast<size_t>(dst_width)) {}
+
+const uint8_t *ScaledGrayRows::Row(int y) {
+  if (y < 0 || y >= dst_height_) {
+    return nullptr;
+  }
+  const int first = vertical_.first(y);
+  const int count = vertical_.count(y);
+  if (!LoadThrough(first + count - 1)) {
+    return nullptr;
+  }
+  const int32_t *weights = vertical_.weights(y);
+  std::fill(sums_.begin(), sums_.end(), kFilterHalf);
+  for (int k = 0; k < count; ++k) {
+    const uint8_t *row = LoadedRow(first + k);
+    const int32_t weight = weights[k];
+    for (int x = 0; x < dst_width_; ++x) {
+      sums_[x] += weight * row[x];
+    }
+  }
+  for (int x = 0; x < dst_width_; ++x) {
+    out_[x] = static_cast<uint8_t>(sums_[x] >> ResampleFilter::kFilterBits);
+  }
+  return out_.data();
+}
+
+bool ScaledGrayRows::LoadThrough(int row) {
+  const size_t src_stride = static_cast<size_t>(src_width_) * 4;
+  for (; loaded_rows_ <= row; ++loaded_rows_) {
+    const int r = loaded_rows_;
+    if (r >= chunk_first_ + chunk_rows_) {
+      const int count = std::min(kStreamBandRows, src_height_ - r);
+      chunk_ = source_(r, count);
+      if (chunk_ == nullptr) {
+        return false;
+      }
+      chunk_first_ = r;
+      chunk_rows_ = count;
+    }
+    kernels_->rgba_to_gray(chunk_ + src_stride * (r - chunk_first_),
+                           gray_.data(), gray_.size());
+
+    uint8_t *out = &ring_[static_cast<size_t>(r % ring_rows_) * dst_width_];
+    for (int x = 0; x < dst_width_; ++x) {
+      const uint8_t *src = gray_.data() + horizontal_.first(x);
+      const int32_t *weights = horizontal_.weights(x);
+      int32_t sum = kFilterHalf;
+      for (int k = 0; k < horizontal_.count(x); ++k) {
+        sum += weights[k] * src[k];
+      }
+      out[x] = static_cast<uint8_t>(sum >> ResampleFilter::kFilterBits);
+    }
+  }
+  return true;
+}
+
+const uint8_t *ScaledGrayRows::LoadedRow(int row) const {
+  return &ring_[static_cast<size_t>(row % ring_rows_) * dst_width_];
+}
+
+}  // namespace flutter_thermal_printer
@@ -0,0 +1,93 @@
+#ifndef FLUTTER_PLUGIN_RASTER_RESAMPLER_H_
+#define FLUTTER_PLUGIN_RASTER_RESAMPLER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "raster_engine.h"
+
+namespace flutter_thermal_printer {
+
+struct RasterKernels;
+
+/// Output height that keeps the aspect ratio when |src_width| x
+/// |src_height| is scaled to |dst_width| (at least 1).
+int ScaledHeight(int src_width, int src_height, int dst_width);
+
+/// 1-D filter from |src| samples to |dst|: a box (area average) when
+/// shrinking, bilinear when enlarging. Weights are 14-bit fixed point and
+/// sum to exactly 1 << kFilterBits for every output sample.
+class ResampleFilter {
+ public:
+  static constexpr int kFilterBits = 14;
+
+  ResampleFilter(int src, int dst);
+
+  int size() const { return static_cast<int>(first_.size()); }
+
+  /// Output |i| reads |count(i)| samples from |first(i)|, weighted by
+  /// |weights(i)|. Both ends only move forward as |i| grows.
+  int first(int i) const { return first_[i]; }
+  int count(int i) const { return count_[i]; }
+  const int32_t *weights(int i) const { return &weights_[offset_[i]]; }
+
+  /// Most taps any output uses.
+  int max_count() const { return max_count_; }
+
+ private:
+  std::vector<int> first_;
+  std::vector<int> count_;
+  std::vector<size_t> offset_;
+  std::vector<int32_t> weights_;
+  int max_count_ = 1;
+};
+
+/// Scales RGBA rows pulled from an RgbaRowSource to |dst_width| x
+/// |dst_height| gray, fused with the gray conversion: each source row is
+/// converted and scaled horizontally once, kept in a ring only as long as
+/// the vertical filter needs it, and never copied at full resolution.
+/// Rows must be read in order. Not thread-safe.
+class ScaledGrayRows {
+ public:
+  ScaledGrayRows(RgbaRowSource source, int src_width, int src_height,
+                 int dst_width, int dst_height);
+
+  int width() const { return dst_width_; }
+  int height() const { return dst_height_; }
+
+  /// Output row |y|, valid until the next call; |y| must be the row after
+  /// the previous one. nullptr on a source error.
+  const uint8_t *Row(int y);
+
+ private:
+  // Converts and horizontally scales every source row up to |row|.
+  bool LoadThrough(int row);
+  const uint8_t *LoadedRow(int row) const;
+
+  RgbaRowSource source_;
+  const RasterKernels *kernels_;
+  int src_width_;
+  int src_height_;
+  int dst_width_;
+  int dst_height_;
+  ResampleFilter horizontal_;
+  ResampleFilter vertical_;
+
+  // Current chunk handed out by |source_|.
+  const uint8_t *chunk_ = nullptr;
+  int chunk_first_ = 0;
+  int chunk_rows_ = 0;
+
+  // Horizontally scaled rows; row r lives in slot r % ring_rows_.
+  int ring_rows_;
+  int loaded_rows_ = 0;
+  std::vector<uint8_t> ring_;
+  std::vector<uint8_t> gray_;  // One source row at full width.
+  std::vector<int32_t> sums_;
+  std::vector<uint8_t> out_;
+};
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_RASTER_RESAMPLER_H_
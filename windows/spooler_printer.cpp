@@ -0,0 +1,142 @@
+#include "spooler_printer.h"
+
+#include <winspool.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace flutter_thermal_printer {
+
+namespace {
+
+constexpr wchar_t kDocumentName[] = L"ESC/POS Print Job";
+constexpr wchar_t kRawDatatype[] = L"RAW";
+
+// WritePrinter takes a DWORD length; large payloads go out in slices.
+constexpr size_t kMaxWriteSlice = 1u << 30;
+
+bool IsStaleHandleError(DWORD error) {
+  return error == ERROR_INVALID_HANDLE || error == ERROR_INVALID_PRINTER_NAME ||
+         error == ERROR_PRINTER_DELETED;
+}
+
+}  // namespace
+
+SpoolerPrinter::SpoolerPrinter(std::wstring name) : name_(std::move(name)) {}
+
+SpoolerPrinter::~SpoolerPrinter() { Close(); }
+
+DWORD SpoolerPrinter::Open() {
+  if (handle_ != nullptr) {
+    return ERROR_SUCCESS;
+  }
+  HANDLE handle = nullptr;
+  if (!OpenPrinterW(const_cast<LPWSTR>(name_.c_str()), &handle, nullptr)) {
+    return GetLastError();
+  }
+  handle_ = handle;
+  return ERROR_SUCCESS;
+}
+
+void SpoolerPrinter::Close() {
+  AbortDocument();
+  if (handle_ != nullptr) {
+    ClosePrinter(handle_);
+    handle_ = nullptr;
+  }
+}
+
+DWORD SpoolerPrinter::WriteDocument(const uint8_t* data, size_t size) {
+  DWORD error = WriteDocumentOnce(data, size);
+  if (IsStaleHandleError(error)) {
+    Close();
+    error = WriteDocumentOnce(data, size);
+  }
+  return error;
+}
+
+DWORD SpoolerPrinter::WriteDocumentOnce(const uint8_t* data, size_t size) {
+  DWORD error = BeginDocumentOnce();
+  if (error != ERROR_SUCCESS) {
+    return error;
+  }
+  error = Write(data, size);
+  const DWORD end_error = EndDocument();
+  return error != ERROR_SUCCESS ? error : end_error;
+}
+
+DWORD SpoolerPrinter::BeginDocument() {
+  DWORD error = BeginDocumentOnce();
+  if (IsStaleHandleError(error)) {
+    Close();
+    error = BeginDocumentOnce();
+  }
+  return error;
+}
+
+DWORD SpoolerPrinter::BeginDocumentOnce() {
+  DWORD error = Open();
+  if (error != ERROR_SUCCESS) {
+    return error;
+  }
+
+  DOC_INFO_1W doc_info = {};
+  doc_info.pDocName = const_cast<LPWSTR>(kDocumentName);
+  doc_info.pOutputFile = nullptr;
+  doc_info.pDatatype = const_cast<LPWSTR>(kRawDatatype);
+  if (StartDocPrinterW(handle_, 1, reinterpret_cast<LPBYTE>(&doc_info)) == 0) {
+    return GetLastError();
+  }
+  if (!StartPagePrinter(handle_)) {
+    error = GetLastError();
+    EndDocPrinter(handle_);
+    return error;
+  }
+  in_document_ = true;
+  return ERROR_SUCCESS;
+}
+
+DWORD SpoolerPrinter::Write(const uint8_t* data, size_t size) {
+  if (!in_document_) {
+    return ERROR_INVALID_HANDLE;
+  }
+  size_t offset = 0;
+  while (offset < size) {
+    const DWORD slice =
+        static_cast<DWORD>(std::min(size - offset, kMaxWriteSlice));
+    DWORD written = 0;
+    if (!WritePrinter(handle_, const_cast<uint8_t*>(data + offset), slice,
+                      &written)) {
+      return GetLastError();
+    }
+    if (written == 0) {
+      return ERROR_WRITE_FAULT;
+    }
+    offset += written;
+  }
+  return ERROR_SUCCESS;
+}
+
+DWORD SpoolerPrinter::EndDocument() {
+  if (!in_document_) {
+    return ERROR_SUCCESS;
+  }
+  in_document_ = false;
+  EndPagePrinter(handle_);
+  if (!EndDocPrinter(handle_)) {
+    return GetLastError();
+  }
+  return ERROR_SUCCESS;
+}
+
+void SpoolerPrinter::AbortDocument() {
+  if (!in_document_) {
+    return;
+  }
+  in_document_ = false;
+  // AbortPrinter deletes the spool file; bytes already handed to a
+  // directly-printing port are gone either way.
+  AbortPrinter(handle_);
+}
+
+}  // namespace flutter_thermal_printer
@@ -0,0 +1,62 @@
+#ifndef FLUTTER_PLUGIN_SPOOLER_PRINTER_H_
+#define FLUTTER_PLUGIN_SPOOLER_PRINTER_H_
+
+#include <windows.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "printer_transport.h"
+
+namespace flutter_thermal_printer {
+
+/// One Windows print queue, written to as RAW ESC/POS documents.
+/// The spooler HANDLE is opened on first use and kept until Close(), so
+/// consecutive jobs skip OpenPrinter. Not thread-safe; callers serialize.
+class SpoolerPrinter : public PrinterTransport {
+ public:
+  explicit SpoolerPrinter(std::wstring name);
+  ~SpoolerPrinter() override;
+
+  SpoolerPrinter(const SpoolerPrinter&) = delete;
+  SpoolerPrinter& operator=(const SpoolerPrinter&) = delete;
+
+  const std::wstring& name() const override { return name_; }
+  bool is_open() const override { return handle_ != nullptr; }
+
+  /// Opens the cached handle if needed. Returns ERROR_SUCCESS or a Win32 error.
+  DWORD Open() override;
+
+  /// Releases the cached handle. Safe to call when already closed.
+  void Close() override;
+
+  /// Sends |size| bytes as a single RAW document. If the cached handle went
+  /// stale (queue removed/re-added), it is reopened once and the job retried.
+  DWORD WriteDocument(const uint8_t* data, size_t size) override;
+
+  /// Starts a RAW document to be written piecewise with Write(). Retries a
+  /// stale handle like WriteDocument(), since nothing has been sent yet.
+  DWORD BeginDocument() override;
+
+  /// Appends |size| bytes to the document opened by BeginDocument().
+  DWORD Write(const uint8_t* data, size_t size) override;
+
+  /// Closes the open document so the spooler releases it to the printer.
+  DWORD EndDocument() override;
+
+  /// Deletes the open document instead of printing it.
+  void AbortDocument() override;
+
+ private:
+  DWORD WriteDocumentOnce(const uint8_t* data, size_t size);
+  DWORD BeginDocumentOnce();
+
+  std::wstring name_;
+  HANDLE handle_ = nullptr;
+  bool in_document_ = false;
+};
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_SPOOLER_PRINTER_H_
@@ -0,0 +1,41 @@
+#include "string_utils.h"
+
+#include <windows.h>
+
+namespace flutter_thermal_printer {
+
+std::wstring Utf8ToWide(const std::string &utf8) {
+  if (utf8.empty()) {
+    return std::wstring();
+  }
+  const int length =
+      MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS, utf8.data(),
+                          static_cast<int>(utf8.size()), nullptr, 0);
+  if (length <= 0) {
+    return std::wstring();
+  }
+  std::wstring wide(static_cast<size_t>(length), L'\0');
+  MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS, utf8.data(),
+                      static_cast<int>(utf8.size()), wide.data(), length);
+  return wide;
+}
+
+std::string WideToUtf8(const std::wstring &wide) {
+  if (wide.empty()) {
+    return std::string();
+  }
+  const int length =
+      WideCharToMultiByte(CP_UTF8, WC_ERR_INVALID_CHARS, wide.data(),
+                          static_cast<int>(wide.size()), nullptr, 0, nullptr,
+                          nullptr);
+  if (length <= 0) {
+    return std::string();
+  }
+  std::string utf8(static_cast<size_t>(length), '\0');
+  WideCharToMultiByte(CP_UTF8, WC_ERR_INVALID_CHARS, wide.data(),
+                      static_cast<int>(wide.size()), utf8.data(), length,
+                      nullptr, nullptr);
+  return utf8;
+}
+
+}  // namespace flutter_thermal_printer
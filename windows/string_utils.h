@@ -0,0 +1,16 @@
+#ifndef FLUTTER_PLUGIN_STRING_UTILS_H_
+#define FLUTTER_PLUGIN_STRING_UTILS_H_
+
+#include <string>
+
+namespace flutter_thermal_printer {
+
+/// UTF-8 (Dart/channel strings) to UTF-16 (Win32 W APIs). Empty on failure.
+std::wstring Utf8ToWide(const std::string &utf8);
+
+/// UTF-16 to UTF-8. Empty on failure.
+std::string WideToUtf8(const std::wstring &wide);
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_STRING_UTILS_H_
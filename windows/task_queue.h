@@ -0,0 +1,41 @@
+#ifndef FLUTTER_PLUGIN_TASK_QUEUE_H_
+#define FLUTTER_PLUGIN_TASK_QUEUE_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace flutter_thermal_printer {
+
+/// A single background thread running closures in FIFO order. Used for
+/// CPU-bound work (e.g. rasterization) that must stay off the platform
+/// thread. The destructor drops tasks that have not started and joins.
+class TaskQueue {
+ public:
+  using Task = std::function<void()>;
+
+  TaskQueue();
+  ~TaskQueue();
+
+  TaskQueue(const TaskQueue&) = delete;
+  TaskQueue& operator=(const TaskQueue&) = delete;
+
+  void PostTask(Task task);
+
+ private:
+  void Run();
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::deque<Task> tasks_;
+  bool stopping_ = false;
+
+  // Declared last so every member above exists before Run() starts.
+  std::thread thread_;
+};
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_TASK_QUEUE_H_
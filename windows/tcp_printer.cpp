@@ -0,0 +1,469 @@
+// Winsock 2 has to come before <windows.h>, which tcp_printer.h includes.
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <mstcpip.h>
+
+#include "tcp_printer.h"
+
+#include <algorithm>
+#include <climits>
+#include <string>
+#include <utility>
+
+namespace flutter_thermal_printer {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const TcpSocket kNoSocket = static_cast<TcpSocket>(INVALID_SOCKET);
+
+SOCKET AsSocket(TcpSocket socket) { return static_cast<SOCKET>(socket); }
+
+bool StartWinsock() {
+  WSADATA data;
+  return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+}
+
+void SetBlocking(SOCKET socket, bool blocking) {
+  u_long non_blocking = blocking ? 0 : 1;
+  ioctlsocket(socket, FIONBIO, &non_blocking);
+}
+
+int SocketError(SOCKET socket) {
+  int error = 0;
+  int length = sizeof(error);
+  getsockopt(socket, SOL_SOCKET, SO_ERROR, reinterpret_cast<char *>(&error),
+             &length);
+  return error;
+}
+
+void ConfigureSocket(SOCKET socket, const TcpOptions &options) {
+  const BOOL on = TRUE;
+  setsockopt(socket, IPPROTO_TCP, TCP_NODELAY,
+             reinterpret_cast<const char *>(&on), sizeof(on));
+  setsockopt(socket, SOL_SOCKET, SO_KEEPALIVE,
+             reinterpret_cast<const char *>(&on), sizeof(on));
+  tcp_keepalive keepalive = {};
+  keepalive.onoff = 1;
+  keepalive.keepalivetime = options.keepalive_time_ms;
+  keepalive.keepaliveinterval = options.keepalive_interval_ms;
+  DWORD returned = 0;
+  WSAIoctl(socket, SIO_KEEPALIVE_VALS, &keepalive, sizeof(keepalive), nullptr,
+           0, &returned, nullptr, nullptr);
+  const DWORD send_timeout = options.send_timeout_ms;
+  setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO,
+             reinterpret_cast<const char *>(&send_timeout),
+             sizeof(send_timeout));
+}
+
+// Alternates address families, starting with the resolver's first choice
+// (RFC 8305 section 4), so one broken family cannot stall every attempt.
+std::vector<const addrinfo *> InterleaveFamilies(const addrinfo *list) {
+  std::vector<const addrinfo *> preferred;
+  std::vector<const addrinfo *> other;
+  for (const addrinfo *address = list; address != nullptr;
+       address = address->ai_next) {
+    (address->ai_family == list->ai_family ? preferred : other)
+        .push_back(address);
+  }
+  std::vector<const addrinfo *> ordered;
+  ordered.reserve(preferred.size() + other.size());
+  for (size_t i = 0; i < std::max(preferred.size(), other.size()); ++i) {
+    if (i < preferred.size()) {
+      ordered.push_back(preferred[i]);
+    }
+    if (i < other.size()) {
+      ordered.push_back(other[i]);
+    }
+  }
+  return ordered;
+}
+
+timeval TimevalUntil(Clock::time_point when) {
+  const auto wait = std::max(
+      std::chrono::duration_cast<std::chrono::microseconds>(when -
+                                                            Clock::now()),
+      std::chrono::microseconds(0));
+  timeval timeout;
+  timeout.tv_sec = static_cast<long>(wait.count() / 1000000);
+  timeout.tv_usec = static_cast<long>(wait.count() % 1000000);
+  return timeout;
+}
+
+// Races non-blocking connects: the next address starts every
+// |attempt_delay_ms|, or as soon as one fails, and the first to connect
+// wins. Returns a Winsock error, WSAETIMEDOUT once the budget is spent.
+DWORD Connect(const std::string &host, uint16_t port,
+              const TcpOptions &options, SOCKET *out) {
+  addrinfo hints = {};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_protocol = IPPROTO_TCP;
+  addrinfo *list = nullptr;
+  const int resolved =
+      getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &list);
+  if (resolved != 0) {
+    return static_cast<DWORD>(resolved);
+  }
+  const std::vector<const addrinfo *> addresses = InterleaveFamilies(list);
+
+  const Clock::time_point deadline =
+      Clock::now() + std::chrono::milliseconds(options.connect_timeout_ms);
+  const auto attempt_delay = std::chrono::milliseconds(options.attempt_delay_ms);
+  std::vector<SOCKET> attempts;
+  size_t next = 0;
+  Clock::time_point next_start = Clock::now();
+  DWORD error = WSAETIMEDOUT;
+  SOCKET connected = INVALID_SOCKET;
+  while (connected == INVALID_SOCKET && Clock::now() < deadline) {
+    if (next < addresses.size() && Clock::now() >= next_start) {
+      const addrinfo *address = addresses[next++];
+      SOCKET attempt = socket(address->ai_family, address->ai_socktype,
+                              address->ai_protocol);
+      if (attempt == INVALID_SOCKET) {
+        error = static_cast<DWORD>(WSAGetLastError());
+        continue;
+      }
+      SetBlocking(attempt, false);
+      if (connect(attempt, address->ai_addr,
+                  static_cast<int>(address->ai_addrlen)) == 0) {
+        connected = attempt;
+        break;
+      }
+      const int code = WSAGetLastError();
+      if (code != WSAEWOULDBLOCK) {
+        error = static_cast<DWORD>(code);
+        closesocket(attempt);
+        continue;
+      }
+      attempts.push_back(attempt);
+      next_start = Clock::now() + attempt_delay;
+    }
+    if (attempts.empty()) {
+      if (next >= addresses.size()) {
+        break;
+      }
+      continue;
+    }
+
+    fd_set writable;
+    fd_set failed;
+    FD_ZERO(&writable);
+    FD_ZERO(&failed);
+    for (SOCKET attempt : attempts) {
+      FD_SET(attempt, &writable);
+      FD_SET(attempt, &failed);
+    }
+    timeval timeout = TimevalUntil(
+        next < addresses.size() ? std::min(next_start, deadline) : deadline);
+    if (select(0, nullptr, &writable, &failed, &timeout) == SOCKET_ERROR) {
+      error = static_cast<DWORD>(WSAGetLastError());
+      break;
+    }
+    for (auto it = attempts.begin(); it != attempts.end();) {
+      const SOCKET attempt = *it;
+      const bool done = FD_ISSET(attempt, &writable);
+      if (!done && !FD_ISSET(attempt, &failed)) {
+        ++it;
+        continue;
+      }
+      const int code = SocketError(attempt);
+      it = attempts.erase(it);
+      if (done && code == 0 && connected == INVALID_SOCKET) {
+        connected = attempt;
+        continue;
+      }
+      if (code != 0) {
+        error = static_cast<DWORD>(code);
+      }
+      closesocket(attempt);
+      // A refused address hands over to the next one straight away.
+      next_start = Clock::now();
+    }
+  }
+  for (SOCKET attempt : attempts) {
+    closesocket(attempt);
+  }
+  freeaddrinfo(list);
+  if (connected == INVALID_SOCKET) {
+    return error;
+  }
+  SetBlocking(connected, true);
+  ConfigureSocket(connected, options);
+  *out = connected;
+  return ERROR_SUCCESS;
+}
+
+// False if the peer closed or reset |socket|. Nothing here reads the
+// printer's replies, so bytes it sent unasked (status) are discarded.
+bool IsAlive(SOCKET socket) {
+  for (;;) {
+    fd_set readable;
+    FD_ZERO(&readable);
+    FD_SET(socket, &readable);
+    timeval now = {0, 0};
+    const int ready = select(0, &readable, nullptr, nullptr, &now);
+    if (ready == 0) {
+      return true;
+    }
+    if (ready == SOCKET_ERROR) {
+      return false;
+    }
+    char discard[256];
+    if (recv(socket, discard, sizeof(discard), 0) <= 0) {
+      return false;
+    }
+  }
+}
+
+// Sends all of |data|; |sent| says how much went out before an error.
+DWORD SendAll(SOCKET socket, const uint8_t *data, size_t size,
+              size_t *sent) {
+  *sent = 0;
+  while (*sent < size) {
+    const int chunk = static_cast<int>(std::min<size_t>(size - *sent, INT_MAX));
+    const int written =
+        send(socket, reinterpret_cast<const char *>(data + *sent), chunk, 0);
+    if (written == SOCKET_ERROR) {
+      return static_cast<DWORD>(WSAGetLastError());
+    }
+    *sent += static_cast<size_t>(written);
+  }
+  return ERROR_SUCCESS;
+}
+
+// Receives exactly |size| bytes unless |timeout_ms| passes first.
+DWORD ReceiveWithTimeout(SOCKET socket, uint8_t *data, size_t size,
+                         DWORD timeout_ms, size_t *received) {
+  *received = 0;
+  const auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+  while (*received < size) {
+    fd_set readable;
+    FD_ZERO(&readable);
+    FD_SET(socket, &readable);
+    timeval timeout = TimevalUntil(deadline);
+    const int ready = select(0, &readable, nullptr, nullptr, &timeout);
+    if (ready == SOCKET_ERROR) {
+      return static_cast<DWORD>(WSAGetLastError());
+    }
+    if (ready == 0) {
+      return WSAETIMEDOUT;
+    }
+    const int got = recv(socket, reinterpret_cast<char *>(data + *received),
+                         static_cast<int>(size - *received), 0);
+    if (got == 0) {
+      return WSAECONNRESET;
+    }
+    if (got == SOCKET_ERROR) {
+      return static_cast<DWORD>(WSAGetLastError());
+    }
+    *received += static_cast<size_t>(got);
+  }
+  return ERROR_SUCCESS;
+}
+
+}  // namespace
+
+TcpConnectionPool::TcpConnectionPool() : started_(StartWinsock()) {}
+
+TcpConnectionPool::~TcpConnectionPool() {
+  for (auto &entry : idle_) {
+    for (const Idle &idle : entry.second) {
+      closesocket(AsSocket(idle.socket));
+    }
+  }
+  if (started_) {
+    WSACleanup();
+  }
+}
+
+DWORD TcpConnectionPool::Acquire(const std::string &host, uint16_t port,
+                                 const TcpOptions &options,
+                                 TcpSocket *socket) {
+  if (!started_) {
+    return WSANOTINITIALISED;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = idle_.find({host, port});
+    while (it != idle_.end() && !it->second.empty()) {
+      // Most recently used first; it is the likeliest to still be up.
+      const Idle idle = it->second.back();
+      it->second.pop_back();
+      if (Clock::now() - idle.since > kMaxIdleTime ||
+          !IsAlive(AsSocket(idle.socket))) {
+        closesocket(AsSocket(idle.socket));
+        continue;
+      }
+      ++reuses_;
+      *socket = idle.socket;
+      return ERROR_SUCCESS;
+    }
+  }
+  SOCKET connected = INVALID_SOCKET;
+  const DWORD error = Connect(host, port, options, &connected);
+  if (error != ERROR_SUCCESS) {
+    return error;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++connects_;
+  *socket = static_cast<TcpSocket>(connected);
+  return ERROR_SUCCESS;
+}
+
+void TcpConnectionPool::Release(const std::string &host, uint16_t port,
+                                TcpSocket socket) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<Idle> &idle = idle_[{host, port}];
+  idle.push_back({socket, Clock::now()});
+  if (idle.size() > kMaxIdlePerEndpoint) {
+    closesocket(AsSocket(idle.front().socket));
+    idle.erase(idle.begin());
+  }
+}
+
+void TcpConnectionPool::Discard(TcpSocket socket) {
+  if (socket != kNoSocket) {
+    closesocket(AsSocket(socket));
+  }
+}
+
+size_t TcpConnectionPool::idle_connections() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t count = 0;
+  for (const auto &entry : idle_) {
+    count += entry.second.size();
+  }
+  return count;
+}
+
+uint64_t TcpConnectionPool::connects() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return connects_;
+}
+
+uint64_t TcpConnectionPool::reuses() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return reuses_;
+}
+
+TcpPrinter::TcpPrinter(std::wstring name, std::string host, uint16_t port,
+                       std::shared_ptr<TcpConnectionPool> pool,
+                       TcpOptions options)
+    : name_(std::move(name)),
+      host_(std::move(host)),
+      port_(port),
+      pool_(std::move(pool)),
+      options_(options),
+      socket_(kNoSocket) {}
+
+TcpPrinter::~TcpPrinter() { Close(); }
+
+bool TcpPrinter::is_open() const { return socket_ != kNoSocket; }
+
+DWORD TcpPrinter::Open() {
+  if (is_open()) {
+    return ERROR_SUCCESS;
+  }
+  return pool_->Acquire(host_, port_, options_, &socket_);
+}
+
+void TcpPrinter::Close() {
+  if (is_open()) {
+    pool_->Release(host_, port_, socket_);
+    socket_ = kNoSocket;
+  }
+}
+
+void TcpPrinter::Drop() {
+  TcpConnectionPool::Discard(socket_);
+  socket_ = kNoSocket;
+}
+
+DWORD TcpPrinter::WriteDocument(const uint8_t* data, size_t size) {
+  DWORD error = BeginDocument();
+  if (error == ERROR_SUCCESS) {
+    error = Write(data, size);
+  }
+  if (error != ERROR_SUCCESS) {
+    AbortDocument();
+    return error;
+  }
+  return EndDocument();
+}
+
+DWORD TcpPrinter::BeginDocument() {
+  document_bytes_ = 0;
+  if (is_open() && !IsAlive(AsSocket(socket_))) {
+    Drop();
+  }
+  return Open();
+}
+
+DWORD TcpPrinter::Write(const uint8_t* data, size_t size) {
+  DWORD error = Open();
+  if (error != ERROR_SUCCESS) {
+    return error;
+  }
+  size_t sent = 0;
+  error = SendAll(AsSocket(socket_), data, size, &sent);
+  if (error != ERROR_SUCCESS && document_bytes_ == 0 && sent == 0) {
+    // Died between the liveness check and the first byte; nothing of this
+    // document is out yet, so a fresh connection can take all of it.
+    Drop();
+    error = Open();
+    if (error == ERROR_SUCCESS) {
+      error = SendAll(AsSocket(socket_), data, size, &sent);
+    }
+  }
+  document_bytes_ += sent;
+  if (error != ERROR_SUCCESS) {
+    Drop();
+  }
+  return error;
+}
+
+DWORD TcpPrinter::EndDocument() {
+  // Nothing frames a document on a raw socket; send() returning means the
+  // stack has the bytes.
+  document_bytes_ = 0;
+  return ERROR_SUCCESS;
+}
+
+void TcpPrinter::AbortDocument() {
+  Drop();
+  document_bytes_ = 0;
+}
+
+DWORD TcpPrinter::QueryStatus(PrinterStatus* status) {
+  if (!is_open()) {
+    return WSAENOTCONN;
+  }
+  // Also drains anything the printer sent unasked, e.g. a late reply to an
+  // earlier query, so the replies read below are to this one.
+  if (!IsAlive(AsSocket(socket_))) {
+    Drop();
+    return WSAECONNRESET;
+  }
+  size_t sent = 0;
+  DWORD error =
+      SendAll(AsSocket(socket_), kStatusQuery, sizeof(kStatusQuery), &sent);
+  uint8_t replies[kStatusReplyBytes];
+  size_t received = 0;
+  if (error == ERROR_SUCCESS) {
+    error = ReceiveWithTimeout(AsSocket(socket_), replies, sizeof(replies),
+                               kStatusReplyTimeoutMs, &received);
+  }
+  if (error == WSAETIMEDOUT) {
+    return error;
+  }
+  if (error != ERROR_SUCCESS) {
+    Drop();
+    return error;
+  }
+  return ParseStatusReplies(replies, received, status) ? ERROR_SUCCESS
+                                                       : ERROR_INVALID_DATA;
+}
+
+}  // namespace flutter_thermal_printer
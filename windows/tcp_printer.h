@@ -0,0 +1,153 @@
+#ifndef FLUTTER_PLUGIN_TCP_PRINTER_H_
+#define FLUTTER_PLUGIN_TCP_PRINTER_H_
+
+#include <windows.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "printer_transport.h"
+
+namespace flutter_thermal_printer {
+
+/// A Winsock SOCKET, kept out of this header so it can be included after
+/// <windows.h> without pulling in <winsock2.h>.
+using TcpSocket = uintptr_t;
+
+/// Connection settings for raw TCP (port 9100) printers.
+struct TcpOptions {
+  /// Budget for connecting once the name is resolved.
+  DWORD connect_timeout_ms = 5000;
+
+  /// Head start each address gets before the next one is tried alongside
+  /// it (RFC 8305's connection attempt delay), so a dead IPv6 route or a
+  /// stale DNS entry costs this much instead of the full timeout.
+  DWORD attempt_delay_ms = 250;
+
+  /// Longest one send may block. A printer out of paper stops reading.
+  DWORD send_timeout_ms = 10000;
+
+  /// TCP keep-alive: idle time before the first probe and between probes,
+  /// so Wi-Fi access points and NATs keep a pooled connection open.
+  DWORD keepalive_time_ms = 30000;
+  DWORD keepalive_interval_ms = 5000;
+};
+
+/// Persistent connections to raw TCP printers, shared by every printer's
+/// worker and keyed by host and port. A printer returns its connection
+/// here when it is closed, so the next ticket skips the handshake; an idle
+/// connection the printer dropped is noticed on Acquire() and replaced.
+/// Thread-safe.
+class TcpConnectionPool {
+ public:
+  static constexpr size_t kMaxIdlePerEndpoint = 2;
+  static constexpr std::chrono::minutes kMaxIdleTime{5};
+
+  TcpConnectionPool();
+  ~TcpConnectionPool();
+
+  TcpConnectionPool(const TcpConnectionPool&) = delete;
+  TcpConnectionPool& operator=(const TcpConnectionPool&) = delete;
+
+  /// A connected socket to |host|:|port|: a live idle one if there is one,
+  /// otherwise a new connection. Returns a Winsock error on failure.
+  DWORD Acquire(const std::string &host, uint16_t port,
+                const TcpOptions &options, TcpSocket *socket);
+
+  /// Keeps |socket| for the next Acquire() of the same endpoint, closing
+  /// the oldest idle one if the endpoint already has kMaxIdlePerEndpoint.
+  void Release(const std::string &host, uint16_t port, TcpSocket socket);
+
+  /// Closes |socket| instead of pooling it, e.g. after a failed send.
+  static void Discard(TcpSocket socket);
+
+  size_t idle_connections() const;
+
+  /// Acquire() calls that connected / reused an idle connection.
+  uint64_t connects() const;
+  uint64_t reuses() const;
+
+ private:
+  struct Idle {
+    TcpSocket socket;
+    std::chrono::steady_clock::time_point since;
+  };
+  using Endpoint = std::pair<std::string, uint16_t>;
+
+  const bool started_;
+  mutable std::mutex mutex_;
+  std::map<Endpoint, std::vector<Idle>> idle_;  // Oldest first.
+  uint64_t connects_ = 0;
+  uint64_t reuses_ = 0;
+};
+
+/// Raw ESC/POS over TCP to a network printer (usually port 9100), through
+/// a TcpConnectionPool. Sockets use TCP_NODELAY, so a short ticket goes
+/// out at once instead of waiting on Nagle, and keep-alive. Documents are
+/// byte runs, as with USB. If the connection turns out to be dead before
+/// any byte of a document is sent, the printer reconnects and retries
+/// once; after that a failure is reported, since resending could print
+/// part of a ticket twice. Not thread-safe; callers serialize.
+class TcpPrinter : public PrinterTransport {
+ public:
+  TcpPrinter(std::wstring name, std::string host, uint16_t port,
+             std::shared_ptr<TcpConnectionPool> pool,
+             TcpOptions options = {});
+  ~TcpPrinter() override;
+
+  TcpPrinter(const TcpPrinter&) = delete;
+  TcpPrinter& operator=(const TcpPrinter&) = delete;
+
+  const std::wstring& name() const override { return name_; }
+  bool is_open() const override;
+
+  /// Takes a connection from the pool, connecting if needed.
+  DWORD Open() override;
+
+  /// Hands the connection back to the pool, still connected.
+  void Close() override;
+
+  DWORD WriteDocument(const uint8_t* data, size_t size) override;
+
+  /// Makes sure the connection is still up, reconnecting if the printer
+  /// dropped it while idle.
+  DWORD BeginDocument() override;
+  DWORD Write(const uint8_t* data, size_t size) override;
+  DWORD EndDocument() override;
+
+  /// Drops the connection, so the printer sees the half-sent document end
+  /// instead of the next one continuing it.
+  void AbortDocument() override;
+
+  /// Asks over the open connection; a printer that answers nothing within
+  /// kStatusReplyTimeoutMs keeps the connection.
+  DWORD QueryStatus(PrinterStatus* status) override;
+
+  const std::string& host() const { return host_; }
+  uint16_t port() const { return port_; }
+
+ private:
+  // Closes the connection without pooling it.
+  void Drop();
+
+  std::wstring name_;
+  std::string host_;
+  uint16_t port_;
+  std::shared_ptr<TcpConnectionPool> pool_;
+  TcpOptions options_;
+  TcpSocket socket_;
+  // Bytes of the open document already sent; past zero a retry could
+  // duplicate output.
+  uint64_t document_bytes_ = 0;
+};
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_TCP_PRINTER_H_
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "buffer_pool.h"
+
+namespace flutter_thermal_printer {
+namespace test {
+
+TEST(BufferPool, RecyclesReleasedStorage) {
+  BufferPool pool(1 << 20);
+  std::vector<uint8_t> buffer = pool.Acquire(5000);
+  EXPECT_GE(buffer.capacity(), 5000u);
+  EXPECT_TRUE(buffer.empty());
+  buffer.assign(5000, 0xAB);
+  const uint8_t *storage = buffer.data();
+  pool.Release(std::move(buffer));
+  EXPECT_GT(pool.retained_bytes(), 0u);
+
+  std::vector<uint8_t> again = pool.Acquire(6000);
+  EXPECT_EQ(again.data(), storage);
+  EXPECT_TRUE(again.empty());
+  EXPECT_EQ(pool.hits(), 1u);
+  EXPECT_EQ(pool.misses(), 1u);
+  EXPECT_EQ(pool.retained_bytes(), 0u);
+}
+
+TEST(BufferPool, NeverHandsOutASmallerSlab) {
+  BufferPool pool(1 << 20);
+  pool.Release(pool.Acquire(100));  // One 4 KB slab idle.
+  std::vector<uint8_t> big = pool.Acquire(10000);
+  EXPECT_GE(big.capacity(), 10000u);
+  EXPECT_EQ(pool.hits(), 0u);
+}
+
+TEST(BufferPool, StaysWithinItsBudget) {
+  BufferPool pool(BufferPool::kMinSlab);
+  pool.Release(pool.Acquire(100));
+  pool.Release(pool.Acquire(100));
+  std::vector<uint8_t> a = pool.Acquire(100);
+  std::vector<uint8_t> b = pool.Acquire(100);
+  pool.Release(std::move(a));
+  pool.Release(std::move(b));
+  EXPECT_EQ(pool.retained_bytes(), BufferPool::kMinSlab);
+
+  std::vector<uint8_t> huge;
+  huge.reserve(BufferPool::kMaxSlab * 4);
+  pool.Release(std::move(huge));
+  EXPECT_EQ(pool.retained_bytes(), BufferPool::kMinSlab);
+}
+
+TEST(PrinterBuffers, LeasedBytesMoveIntoTheJob) {
+  PrinterBuffers buffers;
+  int64_t lease = 0;
+  uint8_t *data = buffers.Lease("POS-80", 8, &lease);
+  ASSERT_NE(data, nullptr);
+  for (uint8_t i = 0; i < 8; ++i) {
+    data[i] = i;
+  }
+  std::vector<uint8_t> job;
+  EXPECT_FALSE(buffers.Take(lease, 9, &job));
+  ASSERT_TRUE(buffers.Take(lease, 5, &job));
+  EXPECT_EQ(job, (std::vector<uint8_t>{0, 1, 2, 3, 4}));
+  EXPECT_EQ(job.data(), data);
+  EXPECT_FALSE(buffers.Take(lease, 5, &job));
+  EXPECT_EQ(buffers.outstanding_leases(), 0u);
+}
+
+TEST(PrinterBuffers, CapsOutstandingLeases) {
+  PrinterBuffers buffers;
+  std::vector<int64_t> leases;
+  int64_t lease = 0;
+  while (buffers.Lease("POS-80", 16, &lease) != nullptr) {
+    leases.push_back(lease);
+  }
+  EXPECT_EQ(leases.size(), PrinterBuffers::kMaxLeases);
+  buffers.Release(leases.back());
+  EXPECT_NE(buffers.Lease("POS-80", 16, &lease), nullptr);
+  // The released slab came back through the same printer's pool.
+  EXPECT_EQ(buffers.PoolFor("POS-80")->hits(), 1u);
+}
+
+}  // namespace test
+}  // namespace flutter_thermal_printer
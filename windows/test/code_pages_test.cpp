@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include "code_pages.h"
+
+namespace flutter_thermal_printer {
+namespace test {
+
+TEST(CodePages, ParsesChannelNames) {
+  CodePage page = CodePage::kCp437;
+  ASSERT_TRUE(CodePageFromName("cp858", &page));
+  EXPECT_EQ(page, CodePage::kCp858);
+  ASSERT_TRUE(CodePageFromName("iscii", &page));
+  EXPECT_EQ(page, CodePage::kIscii);
+  EXPECT_FALSE(CodePageFromName("utf8", &page));
+  EXPECT_EQ(page, CodePage::kIscii);
+
+  EXPECT_EQ(DefaultCodePageId(CodePage::kCp437), 0);
+  EXPECT_EQ(DefaultCodePageId(CodePage::kCp858), 19);
+  EXPECT_EQ(DefaultCodePageId(CodePage::kIscii), -1);
+}
+
+TEST(CodePages, EncodesLatinTables) {
+  EXPECT_EQ(EncodeCodePoint(CodePage::kCp437, U'A'), 'A');
+  EXPECT_EQ(EncodeCodePoint(CodePage::kCp437, U'\u00E9'), 0x82);
+  EXPECT_EQ(EncodeCodePoint(CodePage::kCp437, U'\u2500'), 0xC4);  // Box.
+  EXPECT_EQ(EncodeCodePoint(CodePage::kCp437, U'\u00A0'), 0xFF);  // NBSP.
+  // The euro sign is only on CP858, where it replaced the dotless i.
+  EXPECT_EQ(EncodeCodePoint(CodePage::kCp437, U'\u20AC'), '?');
+  EXPECT_EQ(EncodeCodePoint(CodePage::kCp858, U'\u20AC'), 0xD5);
+  EXPECT_EQ(EncodeCodePoint(CodePage::kCp858, U'\u00E9'), 0x82);
+}
+
+TEST(CodePages, EncodesArabicInIsolatedForms) {
+  // Both the letter and its isolated presentation form print the same.
+  EXPECT_EQ(EncodeCodePoint(CodePage::kCp864, U'\u0628'), 0xA9);  // Beh.
+  EXPECT_EQ(EncodeCodePoint(CodePage::kCp864, U'\uFE8F'), 0xA9);
+  EXPECT_EQ(EncodeCodePoint(CodePage::kCp864, U'\u0661'), 0xB1);  // Digit one.
+  EXPECT_EQ(EncodeCodePoint(CodePage::kCp864, U'\u060C'), 0xAC);  // Comma.
+  EXPECT_EQ(EncodeCodePoint(CodePage::kCp864, U'\u00E9'), '?');
+}
+
+TEST(CodePages, EncodesDevanagariAsIscii) {
+  EXPECT_EQ(EncodeCodePoint(CodePage::kIscii, U'\u0915'), 0xB3);  // Ka.
+  EXPECT_EQ(EncodeCodePoint(CodePage::kIscii, U'\u093E'), 0xDA);  // Sign aa.
+  EXPECT_EQ(EncodeCodePoint(CodePage::kIscii, U'\u094D'), 0xE8);  // Virama.
+  EXPECT_EQ(EncodeCodePoint(CodePage::kIscii, U'\u0967'), 0xF2);  // Digit one.
+  EXPECT_EQ(EncodeCodePoint(CodePage::kIscii, U'\U0001F600'), '?');
+}
+
+}  // namespace test
+}  // namespace flutter_thermal_printer
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "document_stream.h"
+
+namespace flutter_thermal_printer {
+namespace test {
+
+TEST(DocumentStream, DeliversChunksInOrderThenEnds) {
+  DocumentStream stream(2);
+  std::thread producer([&stream] {
+    for (uint8_t i = 0; i < 50; ++i) {
+      ASSERT_TRUE(stream.Push(std::vector<uint8_t>(3, i)));
+    }
+    stream.Finish(true);
+  });
+  std::vector<uint8_t> chunk;
+  uint8_t expected = 0;
+  while (stream.Pop(&chunk)) {
+    ASSERT_EQ(chunk, std::vector<uint8_t>(3, expected));
+    ++expected;
+  }
+  producer.join();
+  EXPECT_EQ(expected, 50);
+  EXPECT_TRUE(stream.complete());
+}
+
+TEST(DocumentStream, IncompleteFinishIsReported) {
+  DocumentStream stream(4);
+  ASSERT_TRUE(stream.Push({1, 2}));
+  stream.Finish(false);
+  std::vector<uint8_t> chunk;
+  EXPECT_TRUE(stream.Pop(&chunk));
+  EXPECT_FALSE(stream.Pop(&chunk));
+  EXPECT_FALSE(stream.complete());
+}
+
+TEST(DocumentStream, AbortWakesBlockedProducer) {
+  DocumentStream stream(1);
+  ASSERT_TRUE(stream.Push({1}));
+  bool pushed = true;
+  std::thread producer([&] { pushed = stream.Push({2}); });
+  stream.Abort();
+  producer.join();
+  EXPECT_FALSE(pushed);
+  std::vector<uint8_t> chunk;
+  EXPECT_FALSE(stream.Pop(&chunk));
+  EXPECT_FALSE(stream.Push({3}));
+}
+
+}  // namespace test
+}  // namespace flutter_thermal_printer
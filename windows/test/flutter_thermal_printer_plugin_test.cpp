@@ -4,9 +4,12 @@
 #include <gtest/gtest.h>
 #include <windows.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <variant>
+#include <vector>
 
 #include "flutter_thermal_printer_plugin.h"
 
@@ -20,6 +23,20 @@ using flutter::EncodableValue;
 using flutter::MethodCall;
 using flutter::MethodResultFunctions;
 
+// Print workers reply through the plugin's message-only window, so tests
+// must pump this thread's messages to see deferred results.
+template <typename Predicate>
+void PumpMessagesUntil(Predicate done) {
+  for (int i = 0; i < 500 && !done(); ++i) {
+    MSG msg;
+    while (PeekMessageW(&msg, nullptr, 0, 0, PM_REMOVE)) {
+      TranslateMessage(&msg);
+      DispatchMessageW(&msg);
+    }
+    Sleep(10);
+  }
+}
+
 }  // namespace
 
 TEST(FlutterThermalPrinterPlugin, GetPlatformVersion) {
@@ -39,5 +56,257 @@ TEST(FlutterThermalPrinterPlugin, GetPlatformVersion) {
   EXPECT_TRUE(result_string.rfind("Windows ", 0) == 0);
 }
 
+TEST(FlutterThermalPrinterPlugin, AnswersRawMessagesThroughTheMessageLoop) {
+  FlutterThermalPrinterPlugin plugin;
+  const auto &codec = flutter::StandardMethodCodec::GetInstance();
+  int replies = 0;
+  std::string version;
+  std::vector<uint8_t> text;
+
+  auto version_call = codec.EncodeMethodCall(
+      MethodCall("getPlatformVersion", std::make_unique<EncodableValue>()));
+  plugin.HandleMessage(
+      version_call->data(), version_call->size(),
+      [&](const uint8_t *reply, size_t size) {
+        MethodResultFunctions<> result(
+            [&version](const EncodableValue *value) {
+              version = std::get<std::string>(*value);
+            },
+            nullptr, nullptr);
+        codec.DecodeAndProcessResponseEnvelope(reply, size, &result);
+        ++replies;
+      });
+
+  // Answered on the message queue itself; it touches no plugin state.
+  EncodableMap args = {
+      {EncodableValue("rows"),
+       EncodableValue(flutter::EncodableList{EncodableValue(
+           EncodableMap{{EncodableValue("text"), EncodableValue("Tea")}})})},
+  };
+  auto text_call = codec.EncodeMethodCall(
+      MethodCall("encodeText", std::make_unique<EncodableValue>(args)));
+  plugin.HandleMessage(
+      text_call->data(), text_call->size(),
+      [&](const uint8_t *reply, size_t size) {
+        MethodResultFunctions<> result(
+            [&text](const EncodableValue *value) {
+              text = std::get<std::vector<uint8_t>>(*value);
+            },
+            nullptr, nullptr);
+        codec.DecodeAndProcessResponseEnvelope(reply, size, &result);
+        ++replies;
+      });
+
+  // Nothing is decoded or answered inline.
+  EXPECT_EQ(replies, 0);
+  PumpMessagesUntil([&replies] { return replies == 2; });
+  EXPECT_EQ(replies, 2);
+  EXPECT_EQ(version.rfind("Windows ", 0), 0u);
+  ASSERT_GE(text.size(), 4u);
+  EXPECT_EQ(std::vector<uint8_t>(text.end() - 4, text.end()),
+            (std::vector<uint8_t>{'T', 'e', 'a', '\n'}));
+}
+
+TEST(FlutterThermalPrinterPlugin, PrintTextRequiresPrinterName) {
+  FlutterThermalPrinterPlugin plugin;
+  std::string error_code;
+  EncodableMap args = {
+      {EncodableValue("data"), EncodableValue(flutter::EncodableList{})},
+  };
+  plugin.HandleMethodCall(
+      MethodCall("printText", std::make_unique<EncodableValue>(args)),
+      std::make_unique<MethodResultFunctions<>>(
+          nullptr,
+          [&error_code](const std::string& code, const std::string& message,
+                        const EncodableValue* details) { error_code = code; },
+          nullptr));
+
+  EXPECT_EQ(error_code, "INVALID_ARGUMENT");
+}
+
+TEST(FlutterThermalPrinterPlugin, IsConnectedFalseForUnknownPrinter) {
+  FlutterThermalPrinterPlugin plugin;
+  bool replied = false;
+  bool connected = true;
+  EncodableMap args = {
+      {EncodableValue("name"),
+       EncodableValue("flutter_thermal_printer test queue that does not exist")},
+  };
+  plugin.HandleMethodCall(
+      MethodCall("isConnected", std::make_unique<EncodableValue>(args)),
+      std::make_unique<MethodResultFunctions<>>(
+          [&replied, &connected](const EncodableValue* result) {
+            replied = true;
+            connected = std::get<bool>(*result);
+          },
+          nullptr, nullptr));
+  PumpMessagesUntil([&replied] { return replied; });
+
+  EXPECT_TRUE(replied);
+  EXPECT_FALSE(connected);
+}
+
+TEST(FlutterThermalPrinterPlugin, SubmitJobRepliesWithJobIdImmediately) {
+  FlutterThermalPrinterPlugin plugin;
+  int64_t job_id = 0;
+  EncodableMap args = {
+      {EncodableValue("name"),
+       EncodableValue("flutter_thermal_printer test queue that does not exist")},
+      {EncodableValue("data"),
+       EncodableValue(flutter::EncodableList{EncodableValue(0x1b),
+                                             EncodableValue(0x40)})},
+  };
+  plugin.HandleMethodCall(
+      MethodCall("submitJob", std::make_unique<EncodableValue>(args)),
+      std::make_unique<MethodResultFunctions<>>(
+          [&job_id](const EncodableValue* result) {
+            job_id = result->LongValue();
+          },
+          nullptr, nullptr));
+
+  // No message pumping: the id must be available before the spooler runs.
+  EXPECT_GT(job_id, 0);
+}
+
+TEST(FlutterThermalPrinterPlugin, PrintImageRejectsMismatchedPixels) {
+  FlutterThermalPrinterPlugin plugin;
+  std::string error_code;
+  EncodableMap args = {
+      {EncodableValue("name"), EncodableValue("any queue")},
+      {EncodableValue("pixels"), EncodableValue(std::vector<uint8_t>(10))},
+      {EncodableValue("width"), EncodableValue(8)},
+      {EncodableValue("height"), EncodableValue(8)},
+  };
+  plugin.HandleMethodCall(
+      MethodCall("printImage", std::make_unique<EncodableValue>(args)),
+      std::make_unique<MethodResultFunctions<>>(
+          nullptr,
+          [&error_code](const std::string& code, const std::string& message,
+                        const EncodableValue* details) { error_code = code; },
+          nullptr));
+
+  // Rejected before anything is queued, so no pumping is needed.
+  EXPECT_EQ(error_code, "INVALID_ARGUMENT");
+}
+
+TEST(FlutterThermalPrinterPlugin, PrintImageRejectsAMalformedSuffix) {
+  FlutterThermalPrinterPlugin plugin;
+  std::string error_code;
+  EncodableMap args = {
+      {EncodableValue("name"), EncodableValue("any queue")},
+      {EncodableValue("pixels"), EncodableValue(std::vector<uint8_t>(256))},
+      {EncodableValue("width"), EncodableValue(8)},
+      {EncodableValue("height"), EncodableValue(8)},
+      // A cut whose last element is not a byte.
+      {EncodableValue("suffix"),
+       EncodableValue(flutter::EncodableList{EncodableValue(0x1D),
+                                             EncodableValue(0x56),
+                                             EncodableValue("x")})},
+  };
+  plugin.HandleMethodCall(
+      MethodCall("printImage", std::make_unique<EncodableValue>(args)),
+      std::make_unique<MethodResultFunctions<>>(
+          nullptr,
+          [&error_code](const std::string& code, const std::string& message,
+                        const EncodableValue* details) { error_code = code; },
+          nullptr));
+
+  EXPECT_EQ(error_code, "INVALID_ARGUMENT");
+}
+
+TEST(FlutterThermalPrinterPlugin, SetTransportRejectsUnknownTransport) {
+  FlutterThermalPrinterPlugin plugin;
+  std::string error_code;
+  EncodableMap args = {
+      {EncodableValue("name"), EncodableValue("any queue")},
+      {EncodableValue("transport"), EncodableValue("bluetooth")},
+  };
+  plugin.HandleMethodCall(
+      MethodCall("setTransport", std::make_unique<EncodableValue>(args)),
+      std::make_unique<MethodResultFunctions<>>(
+          nullptr,
+          [&error_code](const std::string& code, const std::string& message,
+                        const EncodableValue* details) { error_code = code; },
+          nullptr));
+
+  EXPECT_EQ(error_code, "INVALID_ARGUMENT");
+}
+
+TEST(FlutterThermalPrinterPlugin, PrintLogoRequiresAStoredKey) {
+  FlutterThermalPrinterPlugin plugin;
+  std::string error_code;
+  EncodableMap args = {
+      {EncodableValue("name"), EncodableValue("any queue")},
+      {EncodableValue("key"), EncodableValue("L1")},
+  };
+  plugin.HandleMethodCall(
+      MethodCall("printLogo", std::make_unique<EncodableValue>(args)),
+      std::make_unique<MethodResultFunctions<>>(
+          nullptr,
+          [&error_code](const std::string& code, const std::string& message,
+                        const EncodableValue* details) { error_code = code; },
+          nullptr));
+
+  EXPECT_EQ(error_code, "INVALID_ARGUMENT");
+}
+
+TEST(FlutterThermalPrinterPlugin, GetPrintersRepliesWithCachedList) {
+  FlutterThermalPrinterPlugin plugin;
+  int replies = 0;
+  bool is_list = false;
+  auto get_printers = [&]() {
+    plugin.HandleMethodCall(
+        MethodCall("getPrinters", std::make_unique<EncodableValue>()),
+        std::make_unique<MethodResultFunctions<>>(
+            [&](const EncodableValue* result) {
+              ++replies;
+              is_list = std::holds_alternative<flutter::EncodableList>(*result);
+            },
+            nullptr, nullptr));
+  };
+
+  // The first call waits for the watcher's initial enumeration.
+  get_printers();
+  PumpMessagesUntil([&replies] { return replies == 1; });
+  ASSERT_EQ(replies, 1);
+  EXPECT_TRUE(is_list);
+
+  // Later calls are answered from the cache without pumping.
+  get_printers();
+  EXPECT_EQ(replies, 2);
+  EXPECT_TRUE(is_list);
+}
+
+TEST(FlutterThermalPrinterPlugin, WarmUpReportsEachStep) {
+  FlutterThermalPrinterPlugin plugin;
+  int replies = 0;
+  std::vector<std::string> steps;
+  plugin.HandleMethodCall(
+      MethodCall("warmUp", std::make_unique<EncodableValue>(EncodableMap{})),
+      std::make_unique<MethodResultFunctions<>>(
+          [&](const EncodableValue* result) {
+            ++replies;
+            const auto& report = std::get<EncodableMap>(*result);
+            const auto& list = std::get<flutter::EncodableList>(
+                report.at(EncodableValue("steps")));
+            for (const EncodableValue& step : list) {
+              steps.push_back(std::get<std::string>(
+                  std::get<EncodableMap>(step).at(EncodableValue("step"))));
+            }
+          },
+          nullptr, nullptr));
+
+  // The enumeration and the kernels finish on background threads.
+  PumpMessagesUntil([&replies] { return replies == 1; });
+  ASSERT_EQ(replies, 1);
+  EXPECT_EQ(steps.size(), 3u);
+  EXPECT_NE(std::find(steps.begin(), steps.end(), "platformThread"),
+            steps.end());
+  EXPECT_NE(std::find(steps.begin(), steps.end(), "enumeratePrinters"),
+            steps.end());
+  EXPECT_NE(std::find(steps.begin(), steps.end(), "rasterKernels"),
+            steps.end());
+}
+
 }  // namespace test
 }  // namespace flutter_thermal_printer
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "job_stats.h"
+
+namespace flutter_thermal_printer {
+namespace test {
+
+namespace {
+
+JobStageTimes MakeJob(const std::string &printer, double total_ms,
+                      bool success = true) {
+  JobStageTimes times;
+  times.printer = printer;
+  times.total_ms = total_ms;
+  times.spool_ms = total_ms / 2;
+  times.bytes = 100;
+  times.success = success;
+  return times;
+}
+
+}  // namespace
+
+TEST(JobStats, StageTimesFromTicks) {
+  JobTrace trace;
+  trace.received = 1000;
+  trace.started = 3000;
+  trace.raster_ticks = 500;
+  trace.spool_begin = 3000;
+  trace.spool_end = 8000;
+  trace.finished = 9000;
+  trace.bytes = 42;
+  // 1000 ticks per second, so one tick is a millisecond.
+  const JobStageTimes times = ToStageTimes(trace, 1000);
+  EXPECT_DOUBLE_EQ(times.queue_ms, 2000);
+  EXPECT_DOUBLE_EQ(times.raster_ms, 500);
+  EXPECT_DOUBLE_EQ(times.spool_ms, 5000);
+  EXPECT_DOUBLE_EQ(times.total_ms, 8000);
+  EXPECT_EQ(times.bytes, 42u);
+}
+
+TEST(JobStats, MissingStagesAreZero) {
+  JobTrace trace;
+  trace.received = 1000;
+  trace.finished = 1500;
+  const JobStageTimes times = ToStageTimes(trace, 1000);
+  EXPECT_DOUBLE_EQ(times.queue_ms, 0);
+  EXPECT_DOUBLE_EQ(times.spool_ms, 0);
+  EXPECT_DOUBLE_EQ(times.total_ms, 500);
+}
+
+TEST(JobStats, NearestRankPercentiles) {
+  std::vector<double> samples;
+  for (int i = 100; i >= 1; --i) {
+    samples.push_back(i);
+  }
+  const Percentiles percentiles = ComputePercentiles(&samples);
+  EXPECT_DOUBLE_EQ(percentiles.p50, 50);
+  EXPECT_DOUBLE_EQ(percentiles.p95, 95);
+  EXPECT_DOUBLE_EQ(percentiles.p99, 99);
+
+  std::vector<double> single = {7};
+  EXPECT_DOUBLE_EQ(ComputePercentiles(&single).p99, 7);
+  std::vector<double> none;
+  EXPECT_DOUBLE_EQ(ComputePercentiles(&none).p50, 0);
+}
+
+TEST(JobStats, SummariesArePerPrinter) {
+  JobStats stats;
+  for (int i = 1; i <= 10; ++i) {
+    stats.Record(MakeJob("Front", i));
+  }
+  stats.Record(MakeJob("Kitchen", 1000, false));
+
+  const PrinterJobSummary front = stats.Summary("Front");
+  EXPECT_EQ(front.jobs, 10u);
+  EXPECT_EQ(front.failures, 0u);
+  EXPECT_EQ(front.bytes, 1000u);
+  EXPECT_DOUBLE_EQ(front.total_ms.p50, 5);
+  EXPECT_DOUBLE_EQ(front.total_ms.p99, 10);
+  EXPECT_DOUBLE_EQ(front.spool_ms.p50, 2.5);
+
+  const PrinterJobSummary kitchen = stats.Summary("Kitchen");
+  EXPECT_EQ(kitchen.jobs, 1u);
+  EXPECT_EQ(kitchen.failures, 1u);
+  EXPECT_DOUBLE_EQ(kitchen.total_ms.p50, 1000);
+
+  EXPECT_EQ(stats.Summary("Unknown").jobs, 0u);
+  EXPECT_EQ(stats.printers(), (std::vector<std::string>{"Front", "Kitchen"}));
+}
+
+TEST(JobStats, WindowAndRecentAreBounded) {
+  JobStats stats;
+  for (size_t i = 0; i < JobStats::kWindow + 10; ++i) {
+    // Early slow jobs fall out of the window.
+    stats.Record(MakeJob("Front", i < 10 ? 1e6 : 1));
+  }
+  const PrinterJobSummary summary = stats.Summary("Front");
+  EXPECT_EQ(summary.jobs, JobStats::kWindow + 10);
+  EXPECT_DOUBLE_EQ(summary.total_ms.p99, 1);
+  EXPECT_EQ(stats.recent().size(), JobStats::kRecent);
+}
+
+}  // namespace test
+}  // namespace flutter_thermal_printer
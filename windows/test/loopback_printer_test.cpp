@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <windows.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "buffer_pool.h"
+#include "loopback_printer.h"
+#include "printer_worker.h"
+
+namespace flutter_thermal_printer {
+namespace test {
+
+namespace {
+
+std::unique_ptr<LoopbackPrinter> Discarding(
+    std::shared_ptr<LoopbackRecord> record, uint32_t baud_rate = 0,
+    uint32_t latency_ms = 0) {
+  LoopbackOptions options;
+  options.baud_rate = baud_rate;
+  options.latency_ms = latency_ms;
+  return std::make_unique<LoopbackPrinter>(L"loopback", options,
+                                           std::move(record));
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+}  // namespace
+
+TEST(LoopbackPrinter, RecordsWhatWasWritten) {
+  auto record = std::make_shared<LoopbackRecord>(1024);
+  auto printer = Discarding(record);
+  const uint8_t first[] = {1, 2, 3};
+  EXPECT_EQ(printer->WriteDocument(first, sizeof(first)), ERROR_SUCCESS);
+  EXPECT_EQ(printer->BeginDocument(), ERROR_SUCCESS);
+  EXPECT_EQ(printer->Write(first, 1), ERROR_SUCCESS);
+  EXPECT_EQ(printer->Write(first + 1, 2), ERROR_SUCCESS);
+  printer->AbortDocument();
+  EXPECT_EQ(printer->WriteDocument(first + 2, 1), ERROR_SUCCESS);
+
+  EXPECT_EQ(record->documents(), 2u);
+  EXPECT_EQ(record->aborted(), 1u);
+  EXPECT_EQ(record->bytes(), 7u);
+  EXPECT_EQ(record->captured(),
+            (std::vector<std::vector<uint8_t>>{{1, 2, 3}, {3}}));
+}
+
+TEST(LoopbackPrinter, StopsCapturingAtTheCap) {
+  auto record = std::make_shared<LoopbackRecord>(4);
+  auto printer = Discarding(record);
+  const uint8_t data[] = {1, 2, 3};
+  for (int i = 0; i < 3; ++i) {
+    printer->WriteDocument(data, sizeof(data));
+  }
+  // Only whole documents are kept; the rest are still counted.
+  EXPECT_EQ(record->captured(), (std::vector<std::vector<uint8_t>>{{1, 2, 3}}));
+  EXPECT_EQ(record->documents(), 3u);
+  EXPECT_EQ(record->bytes(), 9u);
+}
+
+TEST(LoopbackPrinter, PacesWritesAtTheBaudRate) {
+  // 960 bytes at 96000 baud is 100 ms on the line, plus 20 ms latency.
+  auto printer = Discarding(nullptr, 96000, 20);
+  const std::vector<uint8_t> data(960, 0x55);
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(printer->WriteDocument(data.data(), data.size()), ERROR_SUCCESS);
+  EXPECT_GE(MillisecondsSince(start), 120.0);
+}
+
+TEST(LoopbackPrinter, SlowLineBacksUpTheQueue) {
+  auto record = std::make_shared<LoopbackRecord>();
+  std::mutex mutex;
+  std::condition_variable done;
+  int completed = 0;
+  {
+    // 100 bytes at 2000 baud: half a second per job.
+    PrinterWorker worker(Discarding(record, 2000),
+                         std::make_shared<BufferPool>(0));
+    worker.SetMaxQueuedBytes(250);
+    int accepted = 0;
+    for (int i = 0; i < 4; ++i) {
+      PrintJob job;
+      job.data.assign(100, static_cast<uint8_t>(i));
+      job.on_complete = [&](DWORD) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++completed;
+        done.notify_all();
+      };
+      accepted += worker.Enqueue(std::move(job)) ? 1 : 0;
+    }
+    EXPECT_EQ(accepted, 2);
+    EXPECT_LE(worker.pending_bytes(), 250u);
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(done.wait_for(lock, std::chrono::seconds(5),
+                              [&] { return completed == accepted; }));
+  }
+  EXPECT_EQ(record->bytes(), 200u);
+}
+
+}  // namespace test
+}  // namespace flutter_thermal_printer
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "nv_graphics.h"
+
+namespace flutter_thermal_printer {
+namespace test {
+
+namespace {
+
+// A |width| x |height| RGBA image, black on the left half.
+std::vector<uint8_t> HalfBlack(int width, int height) {
+  std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4, 0xFF);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width / 2; ++x) {
+      uint8_t *pixel = &rgba[(static_cast<size_t>(y) * width + x) * 4];
+      pixel[0] = pixel[1] = pixel[2] = 0;
+    }
+  }
+  return rgba;
+}
+
+}  // namespace
+
+TEST(NvGraphics, DefinesARasterGraphic) {
+  const std::vector<uint8_t> rgba = HalfBlack(16, 2);
+  std::vector<uint8_t> out;
+  ASSERT_TRUE(AppendNvGraphicsDefine("L1", rgba.data(), rgba.size(), 16, 2,
+                                     RasterOptions(), &out));
+  const std::vector<uint8_t> expected = {
+      0x1D, 0x28, 0x4C, 15,   0,    0x30, 0x43, 0x30, 'L',  '1', 0x01,
+      16,   0,    2,    0,    0x31, 0xFF, 0x00, 0xFF, 0x00,
+  };
+  EXPECT_EQ(out, expected);
+}
+
+TEST(NvGraphics, SwitchesToTheLongFormForLargeGraphics) {
+  const std::vector<uint8_t> rgba = HalfBlack(576, 1000);
+  std::vector<uint8_t> out;
+  ASSERT_TRUE(AppendNvGraphicsDefine("AB", rgba.data(), rgba.size(), 576,
+                                     1000, RasterOptions(), &out));
+  const size_t params = 11 + 72 * 1000;
+  ASSERT_EQ(out.size(), 7 + params);
+  EXPECT_EQ(out[1], 0x38);
+  EXPECT_EQ(out[3] | (out[4] << 8) | (out[5] << 16), static_cast<int>(params));
+  EXPECT_EQ(out[6], 0);
+  EXPECT_EQ(out[7], 0x30);
+  EXPECT_EQ(out[8], 0x43);
+}
+
+TEST(NvGraphics, StoresTheScaledGraphic) {
+  const std::vector<uint8_t> rgba = HalfBlack(32, 4);
+  RasterOptions options;
+  options.scale_width = 16;
+  std::vector<uint8_t> out;
+  ASSERT_TRUE(AppendNvGraphicsDefine("L1", rgba.data(), rgba.size(), 32, 4,
+                                     options, &out));
+  const std::vector<uint8_t> expected = {
+      0x1D, 0x28, 0x4C, 15,   0,    0x30, 0x43, 0x30, 'L',  '1', 0x01,
+      16,   0,    2,    0,    0x31, 0xFF, 0x00, 0xFF, 0x00,
+  };
+  EXPECT_EQ(out, expected);
+  EXPECT_NE(NvGraphicsHash(rgba.data(), rgba.size(), 32, 4, options),
+            NvGraphicsHash(rgba.data(), rgba.size(), 32, 4, RasterOptions()));
+}
+
+TEST(NvGraphics, RejectsBadKeysAndSizes) {
+  const std::vector<uint8_t> rgba = HalfBlack(8, 8);
+  std::vector<uint8_t> out;
+  EXPECT_FALSE(AppendNvGraphicsDefine("A", rgba.data(), rgba.size(), 8, 8,
+                                      RasterOptions(), &out));
+  EXPECT_FALSE(AppendNvGraphicsDefine("A\x7F", rgba.data(), rgba.size(), 8,
+                                      8, RasterOptions(), &out));
+  EXPECT_FALSE(AppendNvGraphicsDefine("AB", rgba.data(), rgba.size(), 8, 7,
+                                      RasterOptions(), &out));
+  EXPECT_TRUE(out.empty());
+}
+
+TEST(NvGraphics, PrintsByKey) {
+  std::vector<uint8_t> out;
+  AppendNvGraphicsPrint("L1", &out);
+  const std::vector<uint8_t> expected = {0x1D, 0x28, 0x4C, 6,    0, 0x30,
+                                         0x45, 'L',  '1',  0x01, 0x01};
+  EXPECT_EQ(out, expected);
+}
+
+TEST(NvGraphics, RegistryTracksTheLatestUpload) {
+  NvGraphicsRegistry registry;
+  registry.Record("POS-80", "L1", 7);
+  EXPECT_TRUE(registry.Holds("POS-80", "L1", 7));
+  EXPECT_FALSE(registry.Holds("POS-80", "L1", 8));
+  EXPECT_FALSE(registry.HasKey("POS-58", "L1"));
+
+  // A failed older upload must not forget the newer one.
+  registry.Record("POS-80", "L1", 8);
+  registry.Forget("POS-80", "L1", 7);
+  EXPECT_TRUE(registry.Holds("POS-80", "L1", 8));
+  registry.Forget("POS-80", "L1", 8);
+  EXPECT_FALSE(registry.HasKey("POS-80", "L1"));
+}
+
+}  // namespace test
+}  // namespace flutter_thermal_printer
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <windows.h>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "overlapped_writer.h"
+
+namespace flutter_thermal_printer {
+namespace test {
+
+namespace {
+
+// A byte pipe with a small buffer stands in for the usbprint device: a
+// write pends until the reader drains it, like a busy bulk endpoint.
+struct PipePair {
+  HANDLE server = INVALID_HANDLE_VALUE;
+  HANDLE client = INVALID_HANDLE_VALUE;
+
+  explicit PipePair(DWORD buffer_size) {
+    const std::wstring name = L"\\\\.\\pipe\\flutter_thermal_printer_test_" +
+                              std::to_wstring(GetCurrentProcessId());
+    server = CreateNamedPipeW(name.c_str(), PIPE_ACCESS_INBOUND,
+                              PIPE_TYPE_BYTE | PIPE_WAIT, 1, 0, buffer_size, 0,
+                              nullptr);
+    client = CreateFileW(name.c_str(), GENERIC_WRITE, 0, nullptr,
+                         OPEN_EXISTING, FILE_FLAG_OVERLAPPED, nullptr);
+  }
+
+  ~PipePair() {
+    if (client != INVALID_HANDLE_VALUE) {
+      CloseHandle(client);
+    }
+    if (server != INVALID_HANDLE_VALUE) {
+      CloseHandle(server);
+    }
+  }
+};
+
+std::vector<uint8_t> Pattern(size_t size) {
+  std::vector<uint8_t> data(size);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<uint8_t>(i * 31 + (i >> 8));
+  }
+  return data;
+}
+
+}  // namespace
+
+TEST(OverlappedWriter, PipelinesChunksInOrder) {
+  PipePair pipe(4096);
+  ASSERT_NE(pipe.server, INVALID_HANDLE_VALUE);
+  ASSERT_NE(pipe.client, INVALID_HANDLE_VALUE);
+
+  const std::vector<uint8_t> data = Pattern(300000);
+  std::vector<uint8_t> received;
+  std::thread reader([&pipe, &received, size = data.size()] {
+    std::vector<uint8_t> buffer(8192);
+    while (received.size() < size) {
+      DWORD read = 0;
+      if (!ReadFile(pipe.server, buffer.data(),
+                    static_cast<DWORD>(buffer.size()), &read, nullptr) ||
+          read == 0) {
+        break;
+      }
+      received.insert(received.end(), buffer.begin(), buffer.begin() + read);
+    }
+  });
+
+  OverlappedWriteOptions options;
+  options.chunk_size = 4096;
+  options.max_in_flight = 3;
+  OverlappedWriter writer(options);
+  ASSERT_EQ(writer.Attach(pipe.client), static_cast<DWORD>(ERROR_SUCCESS));
+  // Uneven pieces so chunks straddle Write() calls.
+  size_t offset = 0;
+  for (size_t piece : {1000u, 50000u, 7u, 100000u}) {
+    ASSERT_EQ(writer.Write(data.data() + offset, piece),
+              static_cast<DWORD>(ERROR_SUCCESS));
+    offset += piece;
+  }
+  ASSERT_EQ(writer.Write(data.data() + offset, data.size() - offset),
+            static_cast<DWORD>(ERROR_SUCCESS));
+  EXPECT_LE(writer.in_flight(), 3u);
+  EXPECT_EQ(writer.Flush(), static_cast<DWORD>(ERROR_SUCCESS));
+  EXPECT_EQ(writer.in_flight(), 0u);
+  EXPECT_EQ(writer.completed_bytes(), data.size());
+
+  reader.join();
+  EXPECT_EQ(received, data);
+}
+
+TEST(OverlappedWriter, TimesOutAndReapsWhenNobodyReads) {
+  PipePair pipe(1024);
+  ASSERT_NE(pipe.client, INVALID_HANDLE_VALUE);
+
+  OverlappedWriteOptions options;
+  options.chunk_size = 1024;
+  options.max_in_flight = 2;
+  options.timeout_ms = 50;
+  OverlappedWriter writer(options);
+  ASSERT_EQ(writer.Attach(pipe.client), static_cast<DWORD>(ERROR_SUCCESS));
+
+  const std::vector<uint8_t> data = Pattern(64 * 1024);
+  EXPECT_EQ(writer.Write(data.data(), data.size()),
+            static_cast<DWORD>(ERROR_TIMEOUT));
+  // Cancelled writes were reaped, so the slots are free again.
+  EXPECT_EQ(writer.in_flight(), 0u);
+  EXPECT_LT(writer.completed_bytes(), data.size());
+  EXPECT_EQ(writer.Flush(), static_cast<DWORD>(ERROR_TIMEOUT));
+  EXPECT_EQ(writer.Flush(), static_cast<DWORD>(ERROR_SUCCESS));
+}
+
+}  // namespace test
+}  // namespace flutter_thermal_printer
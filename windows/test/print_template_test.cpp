@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "print_template.h"
+
+namespace flutter_thermal_printer {
+namespace test {
+
+namespace {
+
+std::vector<uint8_t> Bytes(const std::string &text) {
+  return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+std::string RenderToString(const PrintTemplate &print_template,
+                           const PrintTemplate::Values &values,
+                           size_t *spans = nullptr) {
+  std::string out;
+  size_t count = 0;
+  print_template.Render(values, [&](const uint8_t *data, size_t size) {
+    out.append(reinterpret_cast<const char *>(data), size);
+    ++count;
+    return true;
+  });
+  if (spans != nullptr) {
+    *spans = count;
+  }
+  return out;
+}
+
+}  // namespace
+
+TEST(PrintTemplate, SplicesFieldsAtTheirOffsets) {
+  // "HEAD|" <items> "|TOTAL " <total> "|FOOT"
+  auto print_template = PrintTemplate::Create(
+      Bytes("HEAD||TOTAL |FOOT"),
+      {{"total", 12}, {"items", 5}});
+  ASSERT_NE(print_template, nullptr);
+  EXPECT_EQ(print_template->fields().front().name, "items");
+
+  const PrintTemplate::Values values = {{"items", Bytes("2x tea")},
+                                        {"total", Bytes("4.00")}};
+  size_t spans = 0;
+  EXPECT_EQ(RenderToString(*print_template, values, &spans),
+            "HEAD|2x tea|TOTAL 4.00|FOOT");
+  EXPECT_EQ(spans, 5u);
+  EXPECT_EQ(print_template->RenderedSize(values), 27u);
+}
+
+TEST(PrintTemplate, RepeatsFieldsAndSkipsMissingOnes) {
+  auto print_template = PrintTemplate::Create(
+      Bytes("<>~<>"), {{"total", 1}, {"note", 2}, {"total", 4}});
+  ASSERT_NE(print_template, nullptr);
+  EXPECT_TRUE(print_template->HasField("note"));
+  EXPECT_FALSE(print_template->HasField("items"));
+
+  EXPECT_EQ(RenderToString(*print_template, {{"total", Bytes("9")}}),
+            "<9>~<9>");
+}
+
+TEST(PrintTemplate, RejectsOffsetsPastTheEnd) {
+  EXPECT_EQ(PrintTemplate::Create(Bytes("abc"), {{"x", 4}}), nullptr);
+  auto at_end = PrintTemplate::Create(Bytes("abc"), {{"x", 3}});
+  ASSERT_NE(at_end, nullptr);
+  EXPECT_EQ(RenderToString(*at_end, {{"x", Bytes("!")}}), "abc!");
+}
+
+TEST(TemplateStore, ReplacesAndBoundsTemplates) {
+  TemplateStore store;
+  auto first = PrintTemplate::Create(Bytes("one"), {});
+  auto second = PrintTemplate::Create(Bytes("two"), {});
+  ASSERT_TRUE(store.Register("receipt", first));
+  ASSERT_TRUE(store.Register("receipt", second));
+  EXPECT_EQ(store.Find("receipt"), second);
+  EXPECT_EQ(store.size(), 1u);
+
+  for (size_t i = 1; i < TemplateStore::kMaxTemplates; ++i) {
+    ASSERT_TRUE(store.Register("t" + std::to_string(i), first));
+  }
+  EXPECT_FALSE(store.Register("one too many", first));
+  EXPECT_TRUE(store.Register("receipt", first));
+
+  EXPECT_TRUE(store.Remove("receipt"));
+  EXPECT_FALSE(store.Remove("receipt"));
+  EXPECT_EQ(store.Find("receipt"), nullptr);
+}
+
+}  // namespace test
+}  // namespace flutter_thermal_printer
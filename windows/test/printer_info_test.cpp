@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "printer_info.h"
+
+namespace flutter_thermal_printer {
+namespace test {
+
+namespace {
+
+PrinterInfo MakePrinter(const std::string &name, uint32_t status = 0) {
+  PrinterInfo printer;
+  printer.name = name;
+  printer.status = status;
+  return printer;
+}
+
+PrinterMap MakeMap(std::initializer_list<PrinterInfo> printers) {
+  PrinterMap map;
+  for (const PrinterInfo &printer : printers) {
+    map.emplace(printer.name, printer);
+  }
+  return map;
+}
+
+}  // namespace
+
+TEST(PrinterInfo, FirstEnumerationReportsEveryPrinterAsAdded) {
+  const PrinterChanges changes =
+      DiffPrinters(PrinterMap(), MakeMap({MakePrinter("B"), MakePrinter("A")}));
+  ASSERT_EQ(changes.added.size(), 2u);
+  EXPECT_EQ(changes.added[0].name, "A");
+  EXPECT_EQ(changes.added[1].name, "B");
+  EXPECT_TRUE(changes.changed.empty());
+  EXPECT_TRUE(changes.removed.empty());
+}
+
+TEST(PrinterInfo, DiffReportsOnlyWhatChanged) {
+  const PrinterMap before =
+      MakeMap({MakePrinter("Kitchen"), MakePrinter("Front"), MakePrinter("Old")});
+  const PrinterMap after = MakeMap(
+      {MakePrinter("Kitchen"), MakePrinter("Front", 0x80), MakePrinter("New")});
+  const PrinterChanges changes = DiffPrinters(before, after);
+  ASSERT_EQ(changes.added.size(), 1u);
+  EXPECT_EQ(changes.added[0].name, "New");
+  ASSERT_EQ(changes.changed.size(), 1u);
+  EXPECT_EQ(changes.changed[0].name, "Front");
+  EXPECT_TRUE(changes.changed[0].offline());
+  ASSERT_EQ(changes.removed.size(), 1u);
+  EXPECT_EQ(changes.removed[0], "Old");
+
+  EXPECT_TRUE(DiffPrinters(after, after).empty());
+}
+
+TEST(PrinterInfo, OfflineCoversPausedAndWorkOffline) {
+  EXPECT_FALSE(MakePrinter("P").offline());
+  EXPECT_TRUE(MakePrinter("P", 0x1).offline());
+  PrinterInfo work_offline = MakePrinter("P");
+  work_offline.attributes = 0x400;
+  EXPECT_TRUE(work_offline.offline());
+}
+
+TEST(PrinterInfo, RawUsbNeedsUsbPortAndRawDatatype) {
+  PrinterInfo printer = MakePrinter("POS-80");
+  printer.port = "usb001";
+  EXPECT_TRUE(printer.usb());
+  EXPECT_FALSE(printer.raw_usb());
+  printer.raw = true;
+  EXPECT_TRUE(printer.raw_usb());
+  printer.port = "LPT1:";
+  EXPECT_FALSE(printer.raw_usb());
+  printer.port = "US";
+  EXPECT_FALSE(printer.usb());
+}
+
+TEST(PrinterInfo, ApplyChangesReproducesNewEnumeration) {
+  PrinterInfo moved = MakePrinter("Front");
+  moved.port = "USB002";
+  const PrinterMap before =
+      MakeMap({MakePrinter("Kitchen"), MakePrinter("Front"), MakePrinter("Old")});
+  const PrinterMap after = MakeMap({MakePrinter("Kitchen"), moved,
+                                    MakePrinter("New")});
+  PrinterMap cache = before;
+  ApplyPrinterChanges(DiffPrinters(before, after), &cache);
+  EXPECT_EQ(cache, after);
+}
+
+}  // namespace test
+}  // namespace flutter_thermal_printer
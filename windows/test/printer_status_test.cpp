@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "printer_status.h"
+
+namespace flutter_thermal_printer {
+namespace test {
+
+TEST(PrinterStatus, ReadsAReadyPrinter) {
+  const uint8_t replies[] = {0x16, 0x12, 0x12};
+  PrinterStatus status;
+  ASSERT_TRUE(ParseStatusReplies(replies, sizeof(replies), &status));
+  EXPECT_TRUE(status.known);
+  EXPECT_TRUE(status.online);
+  EXPECT_FALSE(status.cover_open);
+  EXPECT_FALSE(status.paper_out);
+  EXPECT_FALSE(status.paper_near_end);
+  EXPECT_FALSE(status.error);
+  EXPECT_FALSE(status.blocks_printing());
+}
+
+TEST(PrinterStatus, ReadsOfflineCauses) {
+  // Offline with the cover open; roll nearly used up.
+  const uint8_t cover[] = {0x1A, 0x16, 0x1E};
+  PrinterStatus status;
+  ASSERT_TRUE(ParseStatusReplies(cover, sizeof(cover), &status));
+  EXPECT_FALSE(status.online);
+  EXPECT_TRUE(status.cover_open);
+  EXPECT_TRUE(status.paper_near_end);
+  EXPECT_FALSE(status.paper_out);
+  EXPECT_TRUE(status.blocks_printing());
+
+  // Out of paper.
+  const uint8_t paper[] = {0x1A, 0x32, 0x72};
+  ASSERT_TRUE(ParseStatusReplies(paper, sizeof(paper), &status));
+  EXPECT_TRUE(status.paper_out);
+  EXPECT_FALSE(status.cover_open);
+  EXPECT_TRUE(status.blocks_printing());
+}
+
+TEST(PrinterStatus, RejectsBytesThatAreNotStatusReplies) {
+  PrinterStatus status;
+  const uint8_t stray[] = {0x16, 0x41, 0x12};
+  EXPECT_FALSE(ParseStatusReplies(stray, sizeof(stray), &status));
+  const uint8_t short_reply[] = {0x16, 0x12};
+  EXPECT_FALSE(ParseStatusReplies(short_reply, sizeof(short_reply), &status));
+  EXPECT_FALSE(status.known);
+  EXPECT_FALSE(status.blocks_printing());
+}
+
+}  // namespace test
+}  // namespace flutter_thermal_printer
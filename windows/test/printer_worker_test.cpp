@@ -0,0 +1,355 @@
+#include <gtest/gtest.h>
+#include <windows.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "buffer_pool.h"
+#include "document_stream.h"
+#include "printer_worker.h"
+
+namespace flutter_thermal_printer {
+namespace test {
+
+namespace {
+
+// Records each document the worker writes.
+class RecordingTransport : public PrinterTransport {
+ public:
+  explicit RecordingTransport(std::vector<std::vector<uint8_t>> *documents)
+      : documents_(documents) {}
+
+  const std::wstring& name() const override { return name_; }
+  bool is_open() const override { return true; }
+  DWORD Open() override { return ERROR_SUCCESS; }
+  void Close() override {}
+
+  DWORD WriteDocument(const uint8_t* data, size_t size) override {
+    documents_->emplace_back(data, data + size);
+    return ERROR_SUCCESS;
+  }
+  DWORD BeginDocument() override {
+    documents_->emplace_back();
+    return ERROR_SUCCESS;
+  }
+  DWORD Write(const uint8_t* data, size_t size) override {
+    documents_->back().insert(documents_->back().end(), data, data + size);
+    return ERROR_SUCCESS;
+  }
+  DWORD EndDocument() override { return ERROR_SUCCESS; }
+  void AbortDocument() override {}
+
+ private:
+  std::wstring name_ = L"recording";
+  std::vector<std::vector<uint8_t>> *documents_;
+};
+
+// Reports the paper as out until |paper_loaded| is set.
+class StatusTransport : public RecordingTransport {
+ public:
+  StatusTransport(std::vector<std::vector<uint8_t>> *documents,
+                  const std::atomic<bool> *paper_loaded)
+      : RecordingTransport(documents), paper_loaded_(paper_loaded) {}
+
+  DWORD QueryStatus(PrinterStatus* status) override {
+    const uint8_t ready[] = {0x16, 0x12, 0x12};
+    const uint8_t paper_out[] = {0x1A, 0x32, 0x72};
+    ParseStatusReplies(*paper_loaded_ ? ready : paper_out, kStatusReplyBytes,
+                       status);
+    return ERROR_SUCCESS;
+  }
+
+ private:
+  const std::atomic<bool> *paper_loaded_;
+};
+
+// Polls |worker| until its cached status satisfies |done|.
+bool WaitForStatus(
+    const PrinterWorker &worker,
+    const std::function<bool(DWORD, const PrinterStatus &)> &done) {
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  PrinterStatus status;
+  while (!done(worker.GetStatus(&status), status)) {
+    if (std::chrono::steady_clock::now() >= deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+// Counts completions so the test can wait for the worker.
+struct Completions {
+  std::mutex mutex;
+  std::condition_variable done;
+  int count = 0;
+
+  std::function<void(DWORD)> Callback() {
+    return [this](DWORD) {
+      std::lock_guard<std::mutex> lock(mutex);
+      ++count;
+      done.notify_all();
+    };
+  }
+
+  bool WaitFor(int expected) {
+    std::unique_lock<std::mutex> lock(mutex);
+    return done.wait_for(lock, std::chrono::seconds(5),
+                         [&] { return count >= expected; });
+  }
+};
+
+PrintJob PrintOf(std::vector<uint8_t> data, Completions *completions) {
+  PrintJob job;
+  job.data = std::move(data);
+  job.on_complete = completions->Callback();
+  return job;
+}
+
+}  // namespace
+
+TEST(PrinterWorker, HeldJobsGoOutAsOneDocument) {
+  // Only read after the worker is joined.
+  std::vector<std::vector<uint8_t>> documents;
+  Completions completions;
+  {
+    PrinterWorker worker(std::make_unique<RecordingTransport>(&documents),
+                         std::make_shared<BufferPool>(0));
+    worker.HoldBatch();
+    worker.Enqueue(PrintOf({1, 2}, &completions));
+    worker.Enqueue(PrintOf({3}, &completions));
+    worker.Enqueue(PrintOf({4, 5}, &completions));
+    EXPECT_EQ(worker.pending_jobs(), 3u);
+    worker.ReleaseBatch();
+    ASSERT_TRUE(completions.WaitFor(3));
+
+    // A barrier ends coalescing; the next job is its own document.
+    PrintJob barrier;
+    barrier.type = PrintJob::Type::kBarrier;
+    barrier.on_complete = completions.Callback();
+    worker.Enqueue(std::move(barrier));
+    worker.Enqueue(PrintOf({6}, &completions));
+    ASSERT_TRUE(completions.WaitFor(5));
+  }
+  ASSERT_EQ(documents.size(), 2u);
+  EXPECT_EQ(documents[0], (std::vector<uint8_t>{1, 2, 3, 4, 5}));
+  EXPECT_EQ(documents[1], (std::vector<uint8_t>{6}));
+}
+
+TEST(PrinterWorker, BatchWindowMergesLateJobs) {
+  std::vector<std::vector<uint8_t>> documents;
+  Completions completions;
+  {
+    PrinterWorker worker(std::make_unique<RecordingTransport>(&documents),
+                         std::make_shared<BufferPool>(0));
+    worker.SetBatchWindow(std::chrono::milliseconds(500));
+    worker.Enqueue(PrintOf({1}, &completions));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    worker.Enqueue(PrintOf({2}, &completions));
+    ASSERT_TRUE(completions.WaitFor(2));
+  }
+  ASSERT_EQ(documents.size(), 1u);
+  EXPECT_EQ(documents[0], (std::vector<uint8_t>{1, 2}));
+}
+
+TEST(PrinterWorker, WritesTemplatesWithTheirFields) {
+  std::vector<std::vector<uint8_t>> documents;
+  Completions completions;
+  {
+    PrinterWorker worker(std::make_unique<RecordingTransport>(&documents),
+                         std::make_shared<BufferPool>(0));
+    PrintJob job;
+    job.print_template = PrintTemplate::Create({'[', ']'}, {{"total", 1}});
+    job.fields["total"] = {'4', '2'};
+    job.on_complete = completions.Callback();
+    worker.Enqueue(std::move(job));
+    ASSERT_TRUE(completions.WaitFor(1));
+  }
+  ASSERT_EQ(documents.size(), 1u);
+  EXPECT_EQ(documents[0], (std::vector<uint8_t>{'[', '4', '2', ']'}));
+}
+
+TEST(PrinterWorker, WorkersShareOneFanOutDocument) {
+  std::vector<std::vector<uint8_t>> first;
+  std::vector<std::vector<uint8_t>> second;
+  Completions completions;
+  auto document = PrintTemplate::Create({1, 2, 3}, {});
+  {
+    PrinterWorker a(std::make_unique<RecordingTransport>(&first),
+                    std::make_shared<BufferPool>(0));
+    PrinterWorker b(std::make_unique<RecordingTransport>(&second),
+                    std::make_shared<BufferPool>(0));
+    for (PrinterWorker *worker : {&a, &b}) {
+      PrintJob job;
+      job.print_template = document;
+      job.on_complete = completions.Callback();
+      worker->Enqueue(std::move(job));
+    }
+    ASSERT_TRUE(completions.WaitFor(2));
+  }
+  // The jobs held references, not copies, and let go once written.
+  EXPECT_EQ(document.use_count(), 1);
+  ASSERT_EQ(first.size(), 1u);
+  ASSERT_EQ(second.size(), 1u);
+  EXPECT_EQ(first[0], (std::vector<uint8_t>{1, 2, 3}));
+  EXPECT_EQ(second[0], first[0]);
+}
+
+TEST(PrinterWorker, HigherPriorityJobsGoFirst) {
+  std::vector<std::vector<uint8_t>> documents;
+  Completions completions;
+  {
+    PrinterWorker worker(std::make_unique<RecordingTransport>(&documents),
+                         std::make_shared<BufferPool>(0));
+    worker.HoldBatch();
+    worker.Enqueue(PrintOf({1}, &completions));
+    worker.Enqueue(PrintOf({2}, &completions));
+    PrintJob urgent = PrintOf({9}, &completions);
+    urgent.priority = 1;
+    worker.Enqueue(std::move(urgent));
+    worker.ReleaseBatch();
+    ASSERT_TRUE(completions.WaitFor(3));
+  }
+  ASSERT_EQ(documents.size(), 1u);
+  EXPECT_EQ(documents[0], (std::vector<uint8_t>{9, 1, 2}));
+}
+
+TEST(PrinterWorker, StreamsKeepTheirProducersOrder) {
+  std::vector<std::vector<uint8_t>> documents;
+  Completions completions;
+  {
+    PrinterWorker worker(std::make_unique<RecordingTransport>(&documents),
+                         std::make_shared<BufferPool>(0));
+    worker.HoldBatch();
+    // Each producer fills its one-chunk stream several times over, so the
+    // first blocks until the worker takes its document.
+    auto stream_of = [&](uint8_t value, int priority) {
+      PrintJob job;
+      job.type = PrintJob::Type::kStream;
+      job.priority = priority;
+      job.stream = std::make_shared<DocumentStream>(1);
+      job.on_complete = completions.Callback();
+      worker.PostProducer([stream = job.stream, value]() {
+        bool ok = true;
+        for (int i = 0; i < 3 && ok; ++i) {
+          ok = stream->Push({value});
+        }
+        stream->Finish(ok);
+      });
+      return job;
+    };
+    worker.Enqueue(stream_of(1, 0));
+    worker.Enqueue(PrintOf({9}, &completions));
+    // Overtakes the print job, but not the first stream.
+    worker.Enqueue(stream_of(5, 5));
+    worker.ReleaseBatch();
+    ASSERT_TRUE(completions.WaitFor(3));
+  }
+  ASSERT_EQ(documents.size(), 3u);
+  EXPECT_EQ(documents[0], (std::vector<uint8_t>{1, 1, 1}));
+  EXPECT_EQ(documents[1], (std::vector<uint8_t>{5, 5, 5}));
+  EXPECT_EQ(documents[2], (std::vector<uint8_t>{9}));
+}
+
+TEST(PrinterWorker, CancelsQueuedJobs) {
+  std::vector<std::vector<uint8_t>> documents;
+  std::vector<DWORD> errors;
+  Completions completions;
+  {
+    PrinterWorker worker(std::make_unique<RecordingTransport>(&documents),
+                         std::make_shared<BufferPool>(0));
+    worker.HoldBatch();
+    for (int64_t id = 1; id <= 3; ++id) {
+      PrintJob job;
+      job.id = id;
+      job.data = {static_cast<uint8_t>(id)};
+      job.on_complete = [&errors, callback = completions.Callback()](
+                            DWORD error) {
+        errors.push_back(error);
+        callback(error);
+      };
+      worker.Enqueue(std::move(job));
+    }
+    EXPECT_TRUE(worker.Cancel(2));
+    EXPECT_FALSE(worker.Cancel(2));
+    EXPECT_FALSE(worker.Cancel(42));
+    EXPECT_EQ(worker.pending_jobs(), 2u);
+    worker.ReleaseBatch();
+    ASSERT_TRUE(completions.WaitFor(3));
+  }
+  ASSERT_EQ(documents.size(), 1u);
+  EXPECT_EQ(documents[0], (std::vector<uint8_t>{1, 3}));
+  EXPECT_EQ(errors, (std::vector<DWORD>{ERROR_CANCELLED, ERROR_SUCCESS,
+                                        ERROR_SUCCESS}));
+}
+
+TEST(PrinterWorker, RefusesJobsPastTheQueueLimit) {
+  std::vector<std::vector<uint8_t>> documents;
+  Completions completions;
+  {
+    PrinterWorker worker(std::make_unique<RecordingTransport>(&documents),
+                         std::make_shared<BufferPool>(0));
+    worker.SetMaxQueuedBytes(4);
+    worker.HoldBatch();
+    // Accepted however large while nothing else is pending.
+    EXPECT_TRUE(worker.Enqueue(PrintOf({1, 2, 3, 4, 5, 6}, &completions)));
+    EXPECT_FALSE(worker.Enqueue(PrintOf({7}, &completions)));
+    EXPECT_EQ(worker.pending_bytes(), 6u);
+    worker.ReleaseBatch();
+    ASSERT_TRUE(completions.WaitFor(1));
+
+    EXPECT_TRUE(worker.Enqueue(PrintOf({7, 8}, &completions)));
+    ASSERT_TRUE(completions.WaitFor(2));
+  }
+  EXPECT_EQ(completions.count, 2);
+  ASSERT_EQ(documents.size(), 2u);
+  EXPECT_EQ(documents[1], (std::vector<uint8_t>{7, 8}));
+}
+
+TEST(PrinterWorker, HoldsDocumentsWhileThePrinterIsOffline) {
+  std::vector<std::vector<uint8_t>> documents;
+  std::atomic<bool> paper_loaded{false};
+  Completions completions;
+  {
+    PrinterWorker worker(
+        std::make_unique<StatusTransport>(&documents, &paper_loaded),
+        std::make_shared<BufferPool>(0));
+    worker.SetStatusInterval(std::chrono::milliseconds(10));
+    ASSERT_TRUE(WaitForStatus(worker, [](DWORD error, const PrinterStatus &status) {
+      return error == ERROR_SUCCESS && status.paper_out;
+    }));
+
+    ASSERT_TRUE(worker.Enqueue(PrintOf({1}, &completions)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(worker.pending_jobs(), 1u);
+
+    paper_loaded = true;
+    ASSERT_TRUE(completions.WaitFor(1));
+    PrinterStatus status;
+    EXPECT_EQ(worker.GetStatus(&status), static_cast<DWORD>(ERROR_SUCCESS));
+    EXPECT_TRUE(status.online);
+    EXPECT_FALSE(status.paper_out);
+  }
+  ASSERT_EQ(documents.size(), 1u);
+  EXPECT_EQ(documents[0], (std::vector<uint8_t>{1}));
+}
+
+TEST(PrinterWorker, ReportsTransportsWithoutAStatusChannel) {
+  std::vector<std::vector<uint8_t>> documents;
+  PrinterWorker worker(std::make_unique<RecordingTransport>(&documents),
+                       std::make_shared<BufferPool>(0));
+  EXPECT_TRUE(WaitForStatus(worker, [](DWORD error, const PrinterStatus &status) {
+    return error == ERROR_NOT_SUPPORTED && !status.known;
+  }));
+}
+
+}  // namespace test
+}  // namespace flutter_thermal_printer
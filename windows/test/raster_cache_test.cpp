@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "raster_cache.h"
+
+namespace flutter_thermal_printer {
+namespace test {
+
+namespace {
+
+RasterCache::Raster MakeRaster(size_t size, uint8_t fill) {
+  return std::make_shared<const std::vector<uint8_t>>(size, fill);
+}
+
+RasterCache::Key KeyWithHash(uint64_t hash) {
+  RasterCache::Key key;
+  key.hash = hash;
+  key.width = 8;
+  key.height = 8;
+  return key;
+}
+
+}  // namespace
+
+TEST(RasterCache, HashMatchesXxh64) {
+  const uint8_t abc[] = {'a', 'b', 'c'};
+  EXPECT_EQ(HashBytes(nullptr, 0), 0xEF46DB3751D8E999ULL);
+  EXPECT_EQ(HashBytes(abc, sizeof(abc)), 0x44BC2CF5AD770999ULL);
+}
+
+TEST(RasterCache, KeyCoversEverythingThatChangesOutput) {
+  const std::vector<uint8_t> pixels(8 * 2 * 4, 0x80);
+  RasterOptions options;
+  const RasterCache::Key base =
+      RasterCache::KeyFor(pixels.data(), pixels.size(), 8, 2, options);
+
+  RasterOptions darker = options;
+  darker.threshold = 100;
+  EXPECT_FALSE(base == RasterCache::KeyFor(pixels.data(), pixels.size(), 8,
+                                           2, darker));
+  EXPECT_FALSE(base ==
+               RasterCache::KeyFor(pixels.data(), pixels.size(), 16, 1,
+                                   options));
+
+  // The threshold is ignored by ordered dithering, so it is not keyed.
+  RasterOptions ordered = options;
+  ordered.dither = DitherMode::kOrdered;
+  darker.dither = DitherMode::kOrdered;
+  EXPECT_TRUE(RasterCache::KeyFor(pixels.data(), pixels.size(), 8, 2,
+                                  ordered) ==
+              RasterCache::KeyFor(pixels.data(), pixels.size(), 8, 2, darker));
+}
+
+TEST(RasterCache, EvictsLeastRecentlyUsed) {
+  RasterCache cache(400);
+  cache.Insert(KeyWithHash(1), MakeRaster(100, 1));
+  cache.Insert(KeyWithHash(2), MakeRaster(100, 2));
+  cache.Insert(KeyWithHash(3), MakeRaster(100, 3));
+  ASSERT_NE(cache.Find(KeyWithHash(1)), nullptr);  // 2 is now the oldest.
+
+  cache.Insert(KeyWithHash(4), MakeRaster(100, 4));
+  cache.Insert(KeyWithHash(5), MakeRaster(100, 5));
+  EXPECT_EQ(cache.Find(KeyWithHash(2)), nullptr);
+  EXPECT_NE(cache.Find(KeyWithHash(1)), nullptr);
+  EXPECT_NE(cache.Find(KeyWithHash(5)), nullptr);
+  EXPECT_EQ(cache.entries(), 4u);
+  EXPECT_EQ(cache.bytes(), 400u);
+  EXPECT_EQ(cache.hits(), 3u);
+  EXPECT_EQ(cache.misses(), 1u);
+}
+
+TEST(RasterCache, SkipsRastersLargerThanAQuarter) {
+  RasterCache cache(400);
+  cache.Insert(KeyWithHash(1), MakeRaster(101, 1));
+  EXPECT_EQ(cache.entries(), 0u);
+
+  // Replacing an entry keeps the byte count exact.
+  cache.Insert(KeyWithHash(2), MakeRaster(100, 1));
+  cache.Insert(KeyWithHash(2), MakeRaster(50, 2));
+  EXPECT_EQ(cache.bytes(), 50u);
+  EXPECT_EQ((*cache.Find(KeyWithHash(2)))[0], 2);
+}
+
+TEST(RasterCache, CachedRasterMatchesFreshConversion) {
+  std::vector<uint8_t> pixels(24 * 20 * 4);
+  for (size_t i = 0; i < pixels.size(); ++i) {
+    pixels[i] = static_cast<uint8_t>(i * 37);
+  }
+  RasterOptions options;
+  options.dither = DitherMode::kFloydSteinberg;
+  std::vector<uint8_t> fresh;
+  ASSERT_TRUE(RasterizeRgba(pixels.data(), pixels.size(), 24, 20, options,
+                            &fresh));
+
+  RasterCache cache;
+  const RasterCache::Key key =
+      RasterCache::KeyFor(pixels.data(), pixels.size(), 24, 20, options);
+  cache.Insert(key, std::make_shared<const std::vector<uint8_t>>(fresh));
+  RasterCache::Raster cached = cache.Find(
+      RasterCache::KeyFor(pixels.data(), pixels.size(), 24, 20, options));
+  ASSERT_NE(cached, nullptr);
+  EXPECT_EQ(*cached, fresh);
+}
+
+}  // namespace test
+}  // namespace flutter_thermal_printer
@@ -0,0 +1,336 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "raster_engine.h"
+#include "thread_pool.h"
+
+namespace flutter_thermal_printer {
+namespace test {
+
+namespace {
+
+std::vector<uint8_t> SolidImage(int width, int height, uint8_t r, uint8_t g,
+                                uint8_t b, uint8_t a = 255) {
+  std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+  for (size_t i = 0; i < rgba.size(); i += 4) {
+    rgba[i] = r;
+    rgba[i + 1] = g;
+    rgba[i + 2] = b;
+    rgba[i + 3] = a;
+  }
+  return rgba;
+}
+
+size_t CountBlackDots(const std::vector<uint8_t> &raster, size_t offset,
+                      size_t end = SIZE_MAX) {
+  size_t dots = 0;
+  for (size_t i = offset; i < std::min(end, raster.size()); ++i) {
+    for (uint8_t bits = raster[i]; bits != 0; bits &= bits - 1) {
+      ++dots;
+    }
+  }
+  return dots;
+}
+
+// Horizontal gradient with some vertical structure, like a widget receipt.
+std::vector<uint8_t> GradientImage(int width, int height) {
+  std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      uint8_t *pixel = &rgba[(static_cast<size_t>(y) * width + x) * 4];
+      const uint8_t value = static_cast<uint8_t>((x * 255 / width + y) & 0xFF);
+      pixel[0] = pixel[1] = pixel[2] = value;
+      pixel[3] = 255;
+    }
+  }
+  return rgba;
+}
+
+}  // namespace
+
+TEST(RasterEngine, EmitsGsV0HeaderAndPaddedRows) {
+  // 10 px wide -> 2 bytes per row; only the first 10 bits may be set.
+  std::vector<uint8_t> rgba = SolidImage(10, 3, 0, 0, 0);
+  std::vector<uint8_t> raster;
+  ASSERT_TRUE(RasterizeRgba(rgba.data(), rgba.size(), 10, 3, RasterOptions(),
+                            &raster));
+
+  const std::vector<uint8_t> header = {0x1D, 0x76, 0x30, 0x00,
+                                       0x02, 0x00, 0x03, 0x00};
+  ASSERT_EQ(raster.size(), header.size() + 2 * 3);
+  EXPECT_TRUE(std::equal(header.begin(), header.end(), raster.begin()));
+  for (int row = 0; row < 3; ++row) {
+    EXPECT_EQ(raster[8 + row * 2], 0xFF);
+    EXPECT_EQ(raster[8 + row * 2 + 1], 0xC0);
+  }
+}
+
+TEST(RasterEngine, PacksMostSignificantBitFirst) {
+  std::vector<uint8_t> rgba = SolidImage(8, 1, 255, 255, 255);
+  rgba[0] = rgba[1] = rgba[2] = 0;           // pixel 0 black
+  rgba[7 * 4] = rgba[7 * 4 + 1] = rgba[7 * 4 + 2] = 0;  // pixel 7 black
+  std::vector<uint8_t> raster;
+  ASSERT_TRUE(RasterizeRgba(rgba.data(), rgba.size(), 8, 1, RasterOptions(),
+                            &raster));
+  EXPECT_EQ(raster.back(), 0x81);
+}
+
+TEST(RasterEngine, TransparentPixelsAreWhite) {
+  std::vector<uint8_t> rgba = SolidImage(16, 2, 0, 0, 0, 0);
+  std::vector<uint8_t> raster;
+  ASSERT_TRUE(RasterizeRgba(rgba.data(), rgba.size(), 16, 2, RasterOptions(),
+                            &raster));
+  EXPECT_EQ(CountBlackDots(raster, 8), 0u);
+}
+
+TEST(RasterEngine, SplitsIntoBands) {
+  std::vector<uint8_t> rgba = SolidImage(8, 5, 0, 0, 0);
+  RasterOptions options;
+  options.band_rows = 2;
+  std::vector<uint8_t> raster;
+  ASSERT_TRUE(
+      RasterizeRgba(rgba.data(), rgba.size(), 8, 5, options, &raster));
+  // Bands of 2, 2, 1 rows, each with its own 8-byte header.
+  ASSERT_EQ(raster.size(), 3u * 8 + 5u);
+  EXPECT_EQ(raster[6], 2);
+  EXPECT_EQ(raster[8 + 2 + 6], 2);
+  EXPECT_EQ(raster[2 * (8 + 2) + 6], 1);
+}
+
+TEST(RasterEngine, DitheringMidGrayPrintsAboutHalfTheDots) {
+  constexpr int kSize = 64;
+  std::vector<uint8_t> rgba = SolidImage(kSize, kSize, 128, 128, 128);
+  for (DitherMode mode : {DitherMode::kFloydSteinberg, DitherMode::kOrdered}) {
+    RasterOptions options;
+    options.dither = mode;
+    std::vector<uint8_t> raster;
+    ASSERT_TRUE(RasterizeRgba(rgba.data(), rgba.size(), kSize, kSize, options,
+                              &raster));
+    const size_t dots = CountBlackDots(raster, 8);
+    EXPECT_GT(dots, kSize * kSize * 4 / 10);
+    EXPECT_LT(dots, kSize * kSize * 6 / 10);
+  }
+
+  // Plain threshold at 128 leaves mid-gray (128) white.
+  std::vector<uint8_t> raster;
+  ASSERT_TRUE(RasterizeRgba(rgba.data(), rgba.size(), kSize, kSize,
+                            RasterOptions(), &raster));
+  EXPECT_EQ(CountBlackDots(raster, 8), 0u);
+}
+
+TEST(RasterEngine, ParallelBandsMatchSerialOutput) {
+  constexpr int kWidth = 576;
+  constexpr int kHeight = 1000;
+  const std::vector<uint8_t> rgba = GradientImage(kWidth, kHeight);
+  ThreadPool pool(3);
+  for (DitherMode mode : {DitherMode::kThreshold, DitherMode::kOrdered}) {
+    for (int band_rows : {0, 30, 255}) {
+      RasterOptions options;
+      options.dither = mode;
+      options.band_rows = band_rows;
+      std::vector<uint8_t> serial;
+      std::vector<uint8_t> parallel;
+      ASSERT_TRUE(RasterizeRgba(rgba.data(), rgba.size(), kWidth, kHeight,
+                                options, &serial));
+      ASSERT_TRUE(RasterizeRgba(rgba.data(), rgba.size(), kWidth, kHeight,
+                                options, &parallel, &pool));
+      EXPECT_EQ(parallel, serial) << "band_rows " << band_rows;
+    }
+  }
+}
+
+TEST(RasterEngine, ParallelDiffusionIsSeamAware) {
+  constexpr int kWidth = 384;
+  constexpr int kHeight = 640;
+  const std::vector<uint8_t> rgba = GradientImage(kWidth, kHeight);
+  ThreadPool pool(3);
+  RasterOptions options;
+  options.dither = DitherMode::kFloydSteinberg;
+
+  options.serial_diffusion = true;
+  std::vector<uint8_t> exact;
+  std::vector<uint8_t> exact_with_pool;
+  ASSERT_TRUE(RasterizeRgba(rgba.data(), rgba.size(), kWidth, kHeight,
+                            options, &exact));
+  ASSERT_TRUE(RasterizeRgba(rgba.data(), rgba.size(), kWidth, kHeight,
+                            options, &exact_with_pool, &pool));
+  EXPECT_EQ(exact_with_pool, exact);
+
+  options.serial_diffusion = false;
+  std::vector<uint8_t> banded;
+  ASSERT_TRUE(RasterizeRgba(rgba.data(), rgba.size(), kWidth, kHeight,
+                            options, &banded, &pool));
+  ASSERT_EQ(banded.size(), exact.size());
+  // Tone is preserved overall and the rows right after each band start are
+  // not dramatically different from the serial result.
+  const double exact_dots = static_cast<double>(CountBlackDots(exact, 8));
+  const double banded_dots = static_cast<double>(CountBlackDots(banded, 8));
+  EXPECT_NEAR(banded_dots / exact_dots, 1.0, 0.01);
+  const size_t row_bytes = kWidth / 8;
+  for (int y = 64; y < kHeight; y += 64) {
+    const size_t begin = 8 + y * row_bytes;
+    const size_t exact_row = CountBlackDots(exact, begin, begin + row_bytes);
+    const size_t banded_row = CountBlackDots(banded, begin, begin + row_bytes);
+    EXPECT_NEAR(static_cast<double>(banded_row), static_cast<double>(exact_row),
+                kWidth * 0.05)
+        << "row " << y;
+  }
+}
+
+TEST(RasterEngine, StreamedBandsMatchBufferedOutput) {
+  constexpr int kWidth = 200;
+  constexpr int kHeight = 150;
+  const std::vector<uint8_t> rgba = GradientImage(kWidth, kHeight);
+  for (DitherMode dither : {DitherMode::kThreshold, DitherMode::kFloydSteinberg,
+                            DitherMode::kOrdered}) {
+    RasterOptions options;
+    options.dither = dither;
+    options.band_rows = 40;
+    std::vector<uint8_t> buffered;
+    ASSERT_TRUE(RasterizeRgba(rgba.data(), rgba.size(), kWidth, kHeight,
+                              options, &buffered));
+
+    std::vector<uint8_t> streamed;
+    int bands = 0;
+    ASSERT_TRUE(RasterizeRgbaBands(rgba.data(), rgba.size(), kWidth, kHeight,
+                                   options, [&](std::vector<uint8_t> band) {
+                                     ++bands;
+                                     streamed.insert(streamed.end(),
+                                                     band.begin(), band.end());
+                                     return true;
+                                   }));
+    EXPECT_EQ(bands, 4);
+    EXPECT_EQ(streamed, buffered) << static_cast<int>(dither);
+  }
+}
+
+TEST(RasterEngine, StreamStopsWhenSinkDeclines) {
+  const std::vector<uint8_t> rgba = SolidImage(16, 300, 0, 0, 0);
+  int bands = 0;
+  EXPECT_FALSE(RasterizeRgbaBands(rgba.data(), rgba.size(), 16, 300,
+                                  RasterOptions(),
+                                  [&](std::vector<uint8_t> band) {
+                                    // Default band height applies.
+                                    EXPECT_EQ(band[6], kStreamBandRows);
+                                    return ++bands < 2;
+                                  }));
+  EXPECT_EQ(bands, 2);
+}
+
+TEST(RasterEngine, RowSourceReadsInSmallPieces) {
+  constexpr int kWidth = 40;
+  constexpr int kHeight = 150;
+  const std::vector<uint8_t> rgba = GradientImage(kWidth, kHeight);
+  RasterOptions options;
+  options.dither = DitherMode::kFloydSteinberg;
+  options.band_rows = kHeight;  // One command, but never a full-size read.
+  std::vector<uint8_t> buffered;
+  ASSERT_TRUE(RasterizeRgba(rgba.data(), rgba.size(), kWidth, kHeight,
+                            options, &buffered));
+
+  // Copies each request so a stale pointer would show up as wrong output.
+  std::vector<uint8_t> scratch;
+  int next_row = 0;
+  auto source = [&](int first_row, int rows) -> const uint8_t * {
+    EXPECT_EQ(first_row, next_row);
+    EXPECT_LE(rows, kStreamBandRows);
+    next_row = first_row + rows;
+    const size_t stride = kWidth * 4;
+    scratch.assign(rgba.begin() + stride * first_row,
+                   rgba.begin() + stride * next_row);
+    return scratch.data();
+  };
+  std::vector<uint8_t> streamed;
+  ASSERT_TRUE(RasterizeRgbaRowBands(source, kWidth, kHeight, options,
+                                    [&](std::vector<uint8_t> band) {
+                                      streamed.insert(streamed.end(),
+                                                      band.begin(),
+                                                      band.end());
+                                      return true;
+                                    }));
+  EXPECT_EQ(next_row, kHeight);
+  EXPECT_EQ(streamed, buffered);
+
+  EXPECT_FALSE(RasterizeRgbaRowBands(
+      [](int, int) -> const uint8_t * { return nullptr; }, kWidth, kHeight,
+      options, [](std::vector<uint8_t>) { return true; }));
+}
+
+TEST(RasterEngine, FeedsBlankRowRuns) {
+  // Black rows 0-1, 22-23 and 25-29 on white, 64 dots (8 bytes) wide.
+  constexpr int kWidth = 64;
+  constexpr int kHeight = 330;
+  std::vector<uint8_t> rgba = SolidImage(kWidth, kHeight, 255, 255, 255);
+  for (int y : {0, 1, 22, 23, 25, 26, 27, 28, 29}) {
+    std::fill(rgba.begin() + y * kWidth * 4,
+              rgba.begin() + (y + 1) * kWidth * 4, uint8_t{0});
+    for (int x = 0; x < kWidth; ++x) {
+      rgba[(y * kWidth + x) * 4 + 3] = 255;
+    }
+  }
+  RasterOptions options;
+  options.feed_blank_rows = true;
+  std::vector<uint8_t> raster = {0xAB};
+  ASSERT_TRUE(RasterizeRgba(rgba.data(), rgba.size(), kWidth, kHeight,
+                            options, &raster));
+
+  std::vector<uint8_t> expected = {0xAB, 0x1D, 0x76, 0x30, 0, 8, 0, 2, 0};
+  expected.insert(expected.end(), 16, 0xFF);
+  expected.insert(expected.end(), {0x1B, 0x4A, 20});
+  // The single white row 24 is cheaper to send than to feed.
+  expected.insert(expected.end(), {0x1D, 0x76, 0x30, 0, 8, 0, 8, 0});
+  expected.insert(expected.end(), 16, 0xFF);
+  expected.insert(expected.end(), 8, 0x00);
+  expected.insert(expected.end(), 40, 0xFF);
+  expected.insert(expected.end(), {0x1B, 0x4A, 255, 0x1B, 0x4A, 45});
+  EXPECT_EQ(raster, expected);
+}
+
+TEST(RasterEngine, FeedsBlankRowsInEveryBand) {
+  constexpr int kWidth = 576;
+  constexpr int kHeight = 600;
+  std::vector<uint8_t> rgba = GradientImage(kWidth, kHeight);
+  // White gaps across band boundaries.
+  for (int y : {50, 200, 450}) {
+    std::fill(rgba.begin() + y * kWidth * 4,
+              rgba.begin() + (y + 70) * kWidth * 4, uint8_t{255});
+  }
+  ThreadPool pool(3);
+  for (int band_rows : {64, kHeight}) {
+    RasterOptions options;
+    options.band_rows = band_rows;
+    std::vector<uint8_t> plain;
+    ASSERT_TRUE(RasterizeRgba(rgba.data(), rgba.size(), kWidth, kHeight,
+                              options, &plain));
+    options.feed_blank_rows = true;
+    std::vector<uint8_t> fed;
+    ASSERT_TRUE(RasterizeRgba(rgba.data(), rgba.size(), kWidth, kHeight,
+                              options, &fed, &pool));
+    std::vector<uint8_t> streamed;
+    ASSERT_TRUE(RasterizeRgbaBands(rgba.data(), rgba.size(), kWidth, kHeight,
+                                   options, [&](std::vector<uint8_t> band) {
+                                     streamed.insert(streamed.end(),
+                                                     band.begin(), band.end());
+                                     return true;
+                                   }));
+    EXPECT_EQ(streamed, fed) << "band_rows " << band_rows;
+    // About 210 rows of 72 bytes are fed instead of sent.
+    EXPECT_LT(fed.size() + 200 * 72, plain.size())
+        << "band_rows " << band_rows;
+  }
+}
+
+TEST(RasterEngine, RejectsMismatchedBuffer) {
+  std::vector<uint8_t> rgba(10);
+  std::vector<uint8_t> raster;
+  EXPECT_FALSE(RasterizeRgba(rgba.data(), rgba.size(), 8, 8, RasterOptions(),
+                             &raster));
+  EXPECT_FALSE(RasterizeRgba(rgba.data(), rgba.size(), 0, 1, RasterOptions(),
+                             &raster));
+}
+
+}  // namespace test
+}  // namespace flutter_thermal_printer
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "raster_kernels.h"
+
+namespace flutter_thermal_printer {
+namespace test {
+
+namespace {
+
+std::vector<const RasterKernels *> AcceleratedKernels() {
+  std::vector<const RasterKernels *> kernels;
+  for (const RasterKernels *candidate :
+       {Sse2RasterKernels(), Avx2RasterKernels()}) {
+    if (candidate != nullptr) {
+      kernels.push_back(candidate);
+    }
+  }
+  return kernels;
+}
+
+// Lengths around every vector width plus the common paper widths.
+const size_t kLengths[] = {0,  1,  7,  8,  9,   15,  16,  17,  31,
+                           32, 33, 63, 64, 65, 384, 576, 831, 832};
+
+}  // namespace
+
+TEST(RasterKernels, DispatchPicksASupportedKernelSet) {
+  const RasterKernels &kernels = GetRasterKernels();
+  ASSERT_NE(kernels.name, nullptr);
+  std::cout << "[ kernels  ] using " << kernels.name << std::endl;
+}
+
+TEST(RasterKernels, RgbaToGrayMatchesScalarForAllLumaAlphaPairs) {
+  // Every (value, alpha) pair, with R/G/B varied so all weights matter.
+  std::vector<uint8_t> rgba;
+  for (int alpha = 0; alpha < 256; ++alpha) {
+    for (int value = 0; value < 256; ++value) {
+      rgba.push_back(static_cast<uint8_t>(value));
+      rgba.push_back(static_cast<uint8_t>(255 - value));
+      rgba.push_back(static_cast<uint8_t>(value * 7));
+      rgba.push_back(static_cast<uint8_t>(alpha));
+    }
+  }
+  const size_t pixels = rgba.size() / 4;
+  std::vector<uint8_t> expected(pixels);
+  ScalarRasterKernels().rgba_to_gray(rgba.data(), expected.data(), pixels);
+
+  for (const RasterKernels *kernels : AcceleratedKernels()) {
+    std::vector<uint8_t> actual(pixels);
+    kernels->rgba_to_gray(rgba.data(), actual.data(), pixels);
+    EXPECT_EQ(actual, expected) << kernels->name;
+  }
+}
+
+TEST(RasterKernels, RgbaToGrayMatchesScalarOnOddLengths) {
+  std::mt19937 rng(1234);
+  for (size_t length : kLengths) {
+    std::vector<uint8_t> rgba(length * 4);
+    for (uint8_t &byte : rgba) {
+      byte = static_cast<uint8_t>(rng());
+    }
+    std::vector<uint8_t> expected(length);
+    ScalarRasterKernels().rgba_to_gray(rgba.data(), expected.data(), length);
+    for (const RasterKernels *kernels : AcceleratedKernels()) {
+      std::vector<uint8_t> actual(length);
+      kernels->rgba_to_gray(rgba.data(), actual.data(), length);
+      EXPECT_EQ(actual, expected) << kernels->name << " length " << length;
+    }
+  }
+}
+
+TEST(RasterKernels, PackBitsMatchesScalar) {
+  std::mt19937 rng(42);
+  for (size_t length : kLengths) {
+    std::vector<uint8_t> gray(length);
+    std::vector<uint8_t> thresholds(length);
+    for (size_t i = 0; i < length; ++i) {
+      gray[i] = static_cast<uint8_t>(rng());
+      // Include equal and extreme values, where the unsigned compare matters.
+      thresholds[i] = (i % 5 == 0) ? gray[i] : static_cast<uint8_t>(rng());
+    }
+    const size_t bytes = (length + 7) / 8;
+    std::vector<uint8_t> expected(bytes, 0xAA);
+    ScalarRasterKernels().pack_bits(gray.data(), thresholds.data(),
+                                    expected.data(), length);
+    for (const RasterKernels *kernels : AcceleratedKernels()) {
+      std::vector<uint8_t> actual(bytes, 0x55);
+      kernels->pack_bits(gray.data(), thresholds.data(), actual.data(),
+                         length);
+      EXPECT_EQ(actual, expected) << kernels->name << " length " << length;
+    }
+  }
+}
+
+TEST(RasterKernels, FixedWidthSetsMatchScalar) {
+  std::vector<const RasterKernels *> sets = AcceleratedKernels();
+  sets.push_back(&ScalarRasterKernels());
+  std::mt19937 rng(7);
+  for (size_t width : kFixedRasterWidths) {
+    std::vector<uint8_t> rgba(width * 4);
+    std::vector<uint8_t> thresholds(width);
+    for (uint8_t &byte : rgba) {
+      byte = static_cast<uint8_t>(rng());
+    }
+    for (uint8_t &byte : thresholds) {
+      byte = static_cast<uint8_t>(rng());
+    }
+    std::vector<uint8_t> expected_gray(width);
+    std::vector<uint8_t> expected_bits(width / 8);
+    ScalarRasterKernels().rgba_to_gray(rgba.data(), expected_gray.data(),
+                                       width);
+    ScalarRasterKernels().pack_bits(expected_gray.data(), thresholds.data(),
+                                    expected_bits.data(), width);
+    for (const RasterKernels *generic : sets) {
+      const RasterKernels &fixed = RasterKernelsForWidth(*generic, width);
+      ASSERT_NE(&fixed, generic) << generic->name << " width " << width;
+      std::vector<uint8_t> gray(width);
+      std::vector<uint8_t> bits(width / 8, 0x55);
+      fixed.rgba_to_gray(rgba.data(), gray.data(), width);
+      fixed.pack_bits(gray.data(), thresholds.data(), bits.data(), width);
+      EXPECT_EQ(gray, expected_gray) << fixed.name << " width " << width;
+      EXPECT_EQ(bits, expected_bits) << fixed.name << " width " << width;
+    }
+  }
+}
+
+TEST(RasterKernels, OtherWidthsUseTheGenericSet) {
+  const RasterKernels &kernels = GetRasterKernels();
+  EXPECT_EQ(&RasterKernelsForWidth(kernels, 512), &kernels);
+  EXPECT_EQ(&RasterKernelsForWidth(kernels, 383), &kernels);
+  // A fixed set is not specialized again.
+  const RasterKernels &fixed = RasterKernelsForWidth(kernels, 576);
+  EXPECT_EQ(&RasterKernelsForWidth(fixed, 576), &fixed);
+}
+
+TEST(RasterKernels, ScalarPackBitsIsMostSignificantBitFirst) {
+  const uint8_t gray[9] = {0, 255, 255, 255, 255, 255, 255, 0, 0};
+  uint8_t thresholds[9];
+  std::fill(std::begin(thresholds), std::end(thresholds), uint8_t{128});
+  uint8_t out[2] = {0xFF, 0xFF};
+  ScalarRasterKernels().pack_bits(gray, thresholds, out, 9);
+  EXPECT_EQ(out[0], 0x81);
+  EXPECT_EQ(out[1], 0x80);
+}
+
+}  // namespace test
+}  // namespace flutter_thermal_printer
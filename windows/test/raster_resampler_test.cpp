@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "raster_engine.h"
+#include "raster_resampler.h"
+
+namespace flutter_thermal_printer {
+namespace test {
+
+namespace {
+
+// Opaque gray RGBA image whose pixel (x, y) has luma |value(x, y)|.
+template <typename F>
+std::vector<uint8_t> GrayImage(int width, int height, F value) {
+  std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      uint8_t *pixel = &rgba[(static_cast<size_t>(y) * width + x) * 4];
+      pixel[0] = pixel[1] = pixel[2] = static_cast<uint8_t>(value(x, y));
+      pixel[3] = 255;
+    }
+  }
+  return rgba;
+}
+
+RgbaRowSource BufferSource(const std::vector<uint8_t> &rgba, int width) {
+  return [&rgba, width](int first_row, int) {
+    return rgba.data() + static_cast<size_t>(first_row) * width * 4;
+  };
+}
+
+}  // namespace
+
+TEST(RasterResampler, FilterWeightsSumToOne) {
+  for (auto [src, dst] : {std::pair{1000, 576}, std::pair{300, 576},
+                          std::pair{577, 576}, std::pair{1, 384}}) {
+    ResampleFilter filter(src, dst);
+    ASSERT_EQ(filter.size(), dst);
+    int last_first = 0;
+    for (int i = 0; i < dst; ++i) {
+      int32_t sum = 0;
+      for (int k = 0; k < filter.count(i); ++k) {
+        EXPECT_GE(filter.weights(i)[k], 0);
+        sum += filter.weights(i)[k];
+      }
+      EXPECT_EQ(sum, 1 << ResampleFilter::kFilterBits) << src << "->" << dst;
+      EXPECT_GE(filter.first(i), last_first);
+      EXPECT_LE(filter.first(i) + filter.count(i), src);
+      last_first = filter.first(i);
+    }
+  }
+}
+
+TEST(RasterResampler, HalvingAveragesPairs) {
+  const std::vector<uint8_t> rgba =
+      GrayImage(8, 4, [](int x, int y) { return x % 2 == 0 ? 10 : 30; });
+  ScaledGrayRows rows(BufferSource(rgba, 8), 8, 4, 4, 2);
+  for (int y = 0; y < 2; ++y) {
+    const uint8_t *row = rows.Row(y);
+    ASSERT_NE(row, nullptr);
+    for (int x = 0; x < 4; ++x) {
+      EXPECT_EQ(row[x], 20);
+    }
+  }
+}
+
+TEST(RasterResampler, FlatAreasStayFlat) {
+  const std::vector<uint8_t> rgba =
+      GrayImage(1000, 30, [](int, int) { return 100; });
+  ScaledGrayRows rows(BufferSource(rgba, 1000), 1000, 30, 576,
+                      ScaledHeight(1000, 30, 576));
+  ASSERT_EQ(rows.height(), 17);
+  for (int y = 0; y < rows.height(); ++y) {
+    const uint8_t *row = rows.Row(y);
+    ASSERT_NE(row, nullptr);
+    for (int x = 0; x < 576; ++x) {
+      ASSERT_EQ(row[x], 100) << x << "," << y;
+    }
+  }
+}
+
+TEST(RasterResampler, ReadsEachSourceRowOnceInOrder) {
+  constexpr int kHeight = 300;
+  const std::vector<uint8_t> rgba =
+      GrayImage(40, kHeight, [](int x, int y) { return (x * 7 + y) & 0xFF; });
+  int next_row = 0;
+  RgbaRowSource source = [&](int first_row, int count) {
+    EXPECT_EQ(first_row, next_row);
+    EXPECT_LE(count, kStreamBandRows);
+    next_row = first_row + count;
+    return rgba.data() + static_cast<size_t>(first_row) * 40 * 4;
+  };
+  ScaledGrayRows rows(source, 40, kHeight, 96, ScaledHeight(40, kHeight, 96));
+  for (int y = 0; y < rows.height(); ++y) {
+    ASSERT_NE(rows.Row(y), nullptr);
+  }
+  EXPECT_EQ(next_row, kHeight);
+}
+
+TEST(RasterResampler, EngineScalesToTheDotWidth) {
+  const std::vector<uint8_t> rgba =
+      GrayImage(600, 100, [](int x, int) { return x < 300 ? 0 : 255; });
+  RasterOptions options;
+  options.scale_width = 576;
+  std::vector<uint8_t> raster;
+  ASSERT_TRUE(RasterizeRgba(rgba.data(), rgba.size(), 600, 100, options,
+                            &raster));
+  // One `GS v 0` of 72 bytes x 96 rows: the left half black.
+  ASSERT_EQ(raster.size(), 8u + 72u * 96u);
+  EXPECT_EQ(raster[4], 72);
+  EXPECT_EQ(raster[6], 96);
+  EXPECT_EQ(raster[8], 0xFF);
+  EXPECT_EQ(raster[8 + 35], 0xFF);
+  EXPECT_EQ(raster[8 + 36], 0x00);
+
+  // Streaming gives the same bytes.
+  std::vector<uint8_t> streamed;
+  options.band_rows = 96;
+  ASSERT_TRUE(RasterizeRgbaBands(rgba.data(), rgba.size(), 600, 100, options,
+                                 [&](std::vector<uint8_t> band) {
+                                   streamed.insert(streamed.end(),
+                                                   band.begin(), band.end());
+                                   return true;
+                                 }));
+  EXPECT_EQ(streamed, raster);
+}
+
+}  // namespace test
+}  // namespace flutter_thermal_printer
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <windows.h>
+
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "tcp_printer.h"
+
+namespace flutter_thermal_printer {
+namespace test {
+
+namespace {
+
+// A printer on 127.0.0.1. Loopback connects complete from the backlog and
+// small sends fit the socket buffers, so the test thread can write first
+// and accept and read afterwards.
+class LoopbackServer {
+ public:
+  LoopbackServer() {
+    WSADATA data;
+    started_ = WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    listener_ = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int length = sizeof(address);
+    if (bind(listener_, reinterpret_cast<sockaddr *>(&address),
+             sizeof(address)) == 0 &&
+        listen(listener_, 4) == 0 &&
+        getsockname(listener_, reinterpret_cast<sockaddr *>(&address),
+                    reinterpret_cast<socklen_t *>(&length)) == 0) {
+      port_ = ntohs(address.sin_port);
+    }
+  }
+
+  ~LoopbackServer() {
+    Disconnect();
+    closesocket(listener_);
+    if (started_) {
+      WSACleanup();
+    }
+  }
+
+  uint16_t port() const { return port_; }
+
+  bool Accept() {
+    Disconnect();
+    connection_ = accept(listener_, nullptr, nullptr);
+    return connection_ != INVALID_SOCKET;
+  }
+
+  std::vector<uint8_t> Read(size_t size) {
+    std::vector<uint8_t> received(size);
+    size_t offset = 0;
+    while (offset < size) {
+      const int got =
+          recv(connection_, reinterpret_cast<char *>(received.data() + offset),
+               static_cast<int>(size - offset), 0);
+      if (got <= 0) {
+        break;
+      }
+      offset += static_cast<size_t>(got);
+    }
+    received.resize(offset);
+    return received;
+  }
+
+  void Send(const std::vector<uint8_t> &data) {
+    send(connection_, reinterpret_cast<const char *>(data.data()),
+         static_cast<int>(data.size()), 0);
+  }
+
+  void Disconnect() {
+    if (connection_ != INVALID_SOCKET) {
+      closesocket(connection_);
+      connection_ = INVALID_SOCKET;
+    }
+  }
+
+ private:
+  bool started_ = false;
+  SOCKET listener_ = INVALID_SOCKET;
+  SOCKET connection_ = INVALID_SOCKET;
+  uint16_t port_ = 0;
+};
+
+}  // namespace
+
+TEST(TcpPrinter, PoolsTheConnectionAcrossPrinters) {
+  LoopbackServer server;
+  ASSERT_NE(server.port(), 0);
+  auto pool = std::make_shared<TcpConnectionPool>();
+
+  TcpPrinter printer(L"kitchen", "127.0.0.1", server.port(), pool);
+  const std::vector<uint8_t> first = {1, 2, 3};
+  ASSERT_EQ(printer.WriteDocument(first.data(), first.size()),
+            static_cast<DWORD>(ERROR_SUCCESS));
+  printer.Close();
+  EXPECT_EQ(pool->idle_connections(), 1u);
+
+  TcpPrinter again(L"kitchen (copy)", "127.0.0.1", server.port(), pool);
+  const std::vector<uint8_t> second = {4, 5};
+  ASSERT_EQ(again.WriteDocument(second.data(), second.size()),
+            static_cast<DWORD>(ERROR_SUCCESS));
+
+  ASSERT_TRUE(server.Accept());
+  EXPECT_EQ(server.Read(5), (std::vector<uint8_t>{1, 2, 3, 4, 5}));
+  EXPECT_EQ(pool->connects(), 1u);
+  EXPECT_EQ(pool->reuses(), 1u);
+}
+
+TEST(TcpPrinter, ReconnectsAfterThePrinterDropsTheConnection) {
+  LoopbackServer server;
+  ASSERT_NE(server.port(), 0);
+  auto pool = std::make_shared<TcpConnectionPool>();
+  TcpPrinter printer(L"kitchen", "127.0.0.1", server.port(), pool);
+
+  const std::vector<uint8_t> first = {1, 2};
+  ASSERT_EQ(printer.WriteDocument(first.data(), first.size()),
+            static_cast<DWORD>(ERROR_SUCCESS));
+  ASSERT_TRUE(server.Accept());
+  EXPECT_EQ(server.Read(2), first);
+  // A printer power-cycled or timed out between tickets.
+  server.Disconnect();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  const std::vector<uint8_t> second = {3};
+  ASSERT_EQ(printer.WriteDocument(second.data(), second.size()),
+            static_cast<DWORD>(ERROR_SUCCESS));
+  ASSERT_TRUE(server.Accept());
+  EXPECT_EQ(server.Read(1), second);
+  EXPECT_EQ(pool->connects(), 2u);
+}
+
+TEST(TcpPrinter, QueriesTheStatusOverTheConnection) {
+  LoopbackServer server;
+  ASSERT_NE(server.port(), 0);
+  TcpPrinter printer(L"kitchen", "127.0.0.1", server.port(),
+                     std::make_shared<TcpConnectionPool>());
+  ASSERT_EQ(printer.Open(), static_cast<DWORD>(ERROR_SUCCESS));
+  ASSERT_TRUE(server.Accept());
+
+  std::vector<uint8_t> query;
+  std::thread responder([&server, &query] {
+    query = server.Read(sizeof(kStatusQuery));
+    // Online, cover open.
+    server.Send({0x16, 0x16, 0x12});
+  });
+  PrinterStatus status;
+  const DWORD error = printer.QueryStatus(&status);
+  responder.join();
+  ASSERT_EQ(error, static_cast<DWORD>(ERROR_SUCCESS));
+  EXPECT_EQ(query, std::vector<uint8_t>(std::begin(kStatusQuery),
+                                        std::end(kStatusQuery)));
+  EXPECT_TRUE(status.online);
+  EXPECT_TRUE(status.cover_open);
+  EXPECT_TRUE(printer.is_open());
+}
+
+TEST(TcpPrinter, ReportsARefusedConnection) {
+  uint16_t port = 0;
+  {
+    LoopbackServer closed;
+    port = closed.port();
+  }
+  ASSERT_NE(port, 0);
+  TcpOptions options;
+  options.connect_timeout_ms = 2000;
+  TcpPrinter printer(L"kitchen", "127.0.0.1", port,
+                     std::make_shared<TcpConnectionPool>(), options);
+  EXPECT_NE(printer.Open(), static_cast<DWORD>(ERROR_SUCCESS));
+  EXPECT_FALSE(printer.is_open());
+}
+
+}  // namespace test
+}  // namespace flutter_thermal_printer
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "text_encoder.h"
+
+namespace flutter_thermal_printer {
+namespace test {
+
+using namespace std::string_literals;
+
+namespace {
+
+// The bytes written after the `ESC @` / `ESC t` header.
+std::string Body(const TextEncoder &encoder, size_t header) {
+  const std::vector<uint8_t> &bytes = encoder.bytes();
+  return std::string(bytes.begin() + header, bytes.end());
+}
+
+}  // namespace
+
+TEST(TextEncoder, StartsWithInitializeAndTableSelect) {
+  TextEncoder encoder(CodePage::kCp858, 19, 48);
+  EXPECT_EQ(encoder.bytes(),
+            (std::vector<uint8_t>{0x1B, 0x40, 0x1B, 0x74, 19}));
+
+  TextEncoder iscii(CodePage::kIscii, -1, 48);
+  EXPECT_EQ(iscii.bytes(), (std::vector<uint8_t>{0x1B, 0x40}));
+}
+
+TEST(TextEncoder, OnlyEmitsStyleChanges) {
+  TextEncoder encoder(CodePage::kCp437, -1, 32);
+  TextStyle title;
+  title.align = TextAlign::kCenter;
+  title.bold = true;
+  title.width = 2;
+  title.height = 2;
+  encoder.Text("Shop", title);
+  encoder.Text("Receipt", title);
+  encoder.Text("caf\xC3\xA9", TextStyle());
+  EXPECT_EQ(Body(encoder, 2),
+            "\x1B\x61\x01\x1B\x45\x01\x1D\x21\x11"
+            "Shop\nReceipt\n"
+            "\x1B\x61\x00\x1B\x45\x00\x1D\x21\x00"
+            "caf\x82\n"s);
+}
+
+TEST(TextEncoder, PadsAndWrapsColumns) {
+  TextEncoder encoder(CodePage::kCp437, -1, 20);
+  encoder.Columns({{"Masala chai with ginger", 2, TextAlign::kLeft},
+                   {"2", 1, TextAlign::kCenter},
+                   {"1.50", 1, TextAlign::kRight}},
+                  TextStyle());
+  // 10 + 5 + 5 cells; the item name wraps at its spaces.
+  EXPECT_EQ(Body(encoder, 2),
+            "Masala      2   1.50\n"
+            "chai with           \n"
+            "ginger              \n");
+}
+
+TEST(TextEncoder, CutsWordsLongerThanTheirColumn) {
+  TextEncoder encoder(CodePage::kCp437, -1, 8);
+  encoder.Columns({{"ABCDEFGHIJ", 1, TextAlign::kLeft},
+                   {"x", 1, TextAlign::kRight}},
+                  TextStyle());
+  EXPECT_EQ(Body(encoder, 2), "ABCD   x\nEFGH    \nIJ      \n");
+}
+
+TEST(TextEncoder, HalvesTheLineForDoubleWidthRules) {
+  TextEncoder encoder(CodePage::kCp437, -1, 8);
+  TextStyle wide;
+  wide.width = 2;
+  encoder.Rule(U'-', wide);
+  encoder.Rule(U'\u2500', TextStyle());
+  EXPECT_EQ(Body(encoder, 2),
+            "\x1D\x21\x10----\n"
+            "\x1D\x21\x00\xC4\xC4\xC4\xC4\xC4\xC4\xC4\xC4\n"s);
+}
+
+TEST(TextEncoder, FeedsAndCuts) {
+  TextEncoder encoder(CodePage::kCp437, -1, 48);
+  encoder.Feed(0);
+  encoder.Feed(300);
+  encoder.Cut(true);
+  encoder.Cut(false);
+  EXPECT_EQ(Body(encoder, 2),
+            "\x1B\x64\xFF\x1D\x56\x42\x00\x1D\x56\x41\x00"s);
+}
+
+TEST(TextEncoder, ReplacesMalformedUtf8) {
+  EXPECT_EQ(DecodeUtf8("a\xE2\x82\xAC"), U"a\u20AC");
+  EXPECT_EQ(DecodeUtf8("\xC0\xAF"), U"\uFFFD");      // Overlong '/'.
+  EXPECT_EQ(DecodeUtf8("\xE2\x82"), U"\uFFFD");      // Truncated.
+  EXPECT_EQ(DecodeUtf8("\xED\xA0\x80"), U"\uFFFD");  // Surrogate.
+  EXPECT_EQ(DecodeUtf8("\xFFok"), U"\uFFFDok");
+  EXPECT_EQ(DecodeUtf8("\xF0\x9F\x98\x80"), U"\U0001F600");
+}
+
+}  // namespace test
+}  // namespace flutter_thermal_printer
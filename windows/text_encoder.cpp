@@ -0,0 +1,228 @@
+#include "text_encoder.h"
+
+#include <algorithm>
+
+namespace flutter_thermal_printer {
+
+namespace {
+
+constexpr char32_t kReplacementCharacter = 0xFFFD;
+
+// A run of an encoded column that fits on one line.
+struct Piece {
+  size_t offset;
+  size_t size;
+};
+
+// Breaks |text| into runs of at most |width| bytes, at the last space that
+// fits where there is one. The spaces at a break are dropped.
+std::vector<Piece> Wrap(const std::vector<uint8_t> &text, size_t width) {
+  std::vector<Piece> pieces;
+  size_t start = 0;
+  while (text.size() - start > width) {
+    const size_t end = start + width;
+    size_t cut = end;
+    while (cut > start && text[cut] != ' ') {
+      --cut;
+    }
+    if (cut == start) {
+      cut = end;
+    }
+    pieces.push_back({start, cut - start});
+    start = cut;
+    while (start < text.size() && text[start] == ' ') {
+      ++start;
+    }
+  }
+  pieces.push_back({start, text.size() - start});
+  return pieces;
+}
+
+TextStyle Clamped(TextStyle style) {
+  style.width = std::clamp(style.width, 1, kMaxTextScale);
+  style.height = std::clamp(style.height, 1, kMaxTextScale);
+  return style;
+}
+
+}  // namespace
+
+std::u32string DecodeUtf8(const std::string &utf8) {
+  std::u32string decoded;
+  decoded.reserve(utf8.size());
+  size_t i = 0;
+  while (i < utf8.size()) {
+    const uint8_t lead = static_cast<uint8_t>(utf8[i]);
+    int length = 0;
+    char32_t code_point = 0;
+    if (lead < 0x80) {
+      decoded.push_back(lead);
+      ++i;
+      continue;
+    } else if ((lead & 0xE0) == 0xC0) {
+      length = 2;
+      code_point = lead & 0x1F;
+    } else if ((lead & 0xF0) == 0xE0) {
+      length = 3;
+      code_point = lead & 0x0F;
+    } else if ((lead & 0xF8) == 0xF0) {
+      length = 4;
+      code_point = lead & 0x07;
+    } else {
+      decoded.push_back(kReplacementCharacter);
+      ++i;
+      continue;
+    }
+    int taken = 1;
+    while (taken < length && i + taken < utf8.size() &&
+           (static_cast<uint8_t>(utf8[i + taken]) & 0xC0) == 0x80) {
+      code_point = (code_point << 6) |
+                   (static_cast<uint8_t>(utf8[i + taken]) & 0x3F);
+      ++taken;
+    }
+    // Truncated, overlong and surrogate encodings are all malformed.
+    static constexpr char32_t kMinimum[] = {0, 0, 0x80, 0x800, 0x10000};
+    if (taken < length || code_point < kMinimum[length] ||
+        code_point > 0x10FFFF ||
+        (code_point >= 0xD800 && code_point <= 0xDFFF)) {
+      code_point = kReplacementCharacter;
+    }
+    decoded.push_back(code_point);
+    i += taken;
+  }
+  return decoded;
+}
+
+TextEncoder::TextEncoder(CodePage page, int code_page_id, int chars_per_line)
+    : page_(page), chars_per_line_(std::max(chars_per_line, 1)) {
+  out_ = {0x1B, 0x40};
+  if (code_page_id >= 0 && code_page_id <= 255) {
+    out_.insert(out_.end(), {0x1B, 0x74, static_cast<uint8_t>(code_page_id)});
+  }
+}
+
+void TextEncoder::Text(const std::string &utf8, const TextStyle &style) {
+  ApplyStyle(style);
+  const std::vector<uint8_t> text = Encode(utf8);
+  out_.insert(out_.end(), text.begin(), text.end());
+  out_.push_back('\n');
+}
+
+void TextEncoder::Columns(const std::vector<TextColumn> &columns,
+                          const TextStyle &style) {
+  if (columns.empty()) {
+    return;
+  }
+  TextStyle row_style = style;
+  row_style.align = TextAlign::kLeft;
+  ApplyStyle(row_style);
+
+  const size_t line = LineWidth(style);
+  size_t total_flex = 0;
+  for (const TextColumn &column : columns) {
+    total_flex += static_cast<size_t>(std::max(column.flex, 1));
+  }
+  // Cumulative rounding, so the widths always add up to the line.
+  std::vector<size_t> widths;
+  std::vector<std::vector<uint8_t>> texts;
+  std::vector<std::vector<Piece>> pieces;
+  size_t used = 0;
+  size_t flex_so_far = 0;
+  size_t rows = 1;
+  for (const TextColumn &column : columns) {
+    flex_so_far += static_cast<size_t>(std::max(column.flex, 1));
+    const size_t end = line * flex_so_far / total_flex;
+    widths.push_back(end - used);
+    used = end;
+    std::vector<uint8_t> text = Encode(column.text);
+    // A control character would break the row apart.
+    std::replace_if(
+        text.begin(), text.end(), [](uint8_t c) { return c < 0x20; }, ' ');
+    pieces.push_back(widths.back() == 0 ? std::vector<Piece>()
+                                        : Wrap(text, widths.back()));
+    rows = std::max(rows, pieces.back().size());
+    texts.push_back(std::move(text));
+  }
+
+  for (size_t row = 0; row < rows; ++row) {
+    for (size_t i = 0; i < columns.size(); ++i) {
+      const Piece piece =
+          row < pieces[i].size() ? pieces[i][row] : Piece{0, 0};
+      const size_t padding = widths[i] - piece.size;
+      size_t before = 0;
+      if (columns[i].align == TextAlign::kRight) {
+        before = padding;
+      } else if (columns[i].align == TextAlign::kCenter) {
+        before = padding / 2;
+      }
+      out_.insert(out_.end(), before, ' ');
+      const auto text = texts[i].begin() + piece.offset;
+      out_.insert(out_.end(), text, text + piece.size);
+      out_.insert(out_.end(), padding - before, ' ');
+    }
+    out_.push_back('\n');
+  }
+}
+
+void TextEncoder::Rule(char32_t character, const TextStyle &style) {
+  TextStyle rule_style = style;
+  rule_style.align = TextAlign::kLeft;
+  ApplyStyle(rule_style);
+  out_.insert(out_.end(), LineWidth(style), EncodeCodePoint(page_, character));
+  out_.push_back('\n');
+}
+
+void TextEncoder::Feed(int lines) {
+  if (lines <= 0) {
+    return;
+  }
+  out_.insert(out_.end(),
+              {0x1B, 0x64, static_cast<uint8_t>(std::min(lines, 255))});
+}
+
+void TextEncoder::Cut(bool partial) {
+  // m=65/66: feed to the cutting position, then cut fully/partially.
+  out_.insert(out_.end(),
+              {0x1D, 0x56, static_cast<uint8_t>(partial ? 66 : 65), 0x00});
+}
+
+void TextEncoder::ApplyStyle(const TextStyle &requested) {
+  const TextStyle style = Clamped(requested);
+  if (style.align != current_.align) {
+    out_.insert(out_.end(),
+                {0x1B, 0x61, static_cast<uint8_t>(style.align)});
+  }
+  if (style.bold != current_.bold) {
+    out_.insert(out_.end(), {0x1B, 0x45, static_cast<uint8_t>(style.bold)});
+  }
+  if (style.underline != current_.underline) {
+    out_.insert(out_.end(),
+                {0x1B, 0x2D, static_cast<uint8_t>(style.underline)});
+  }
+  if (style.invert != current_.invert) {
+    out_.insert(out_.end(), {0x1D, 0x42, static_cast<uint8_t>(style.invert)});
+  }
+  if (style.width != current_.width || style.height != current_.height) {
+    out_.insert(out_.end(),
+                {0x1D, 0x21,
+                 static_cast<uint8_t>(((style.width - 1) << 4) |
+                                      (style.height - 1))});
+  }
+  current_ = style;
+}
+
+size_t TextEncoder::LineWidth(const TextStyle &style) const {
+  return static_cast<size_t>(
+      std::max(chars_per_line_ / Clamped(style).width, 1));
+}
+
+std::vector<uint8_t> TextEncoder::Encode(const std::string &utf8) const {
+  const std::u32string decoded = DecodeUtf8(utf8);
+  std::vector<uint8_t> encoded;
+  encoded.reserve(decoded.size());
+  for (char32_t code_point : decoded) {
+    encoded.push_back(EncodeCodePoint(page_, code_point));
+  }
+  return encoded;
+}
+
+}  // namespace flutter_thermal_printer
@@ -0,0 +1,84 @@
+#ifndef FLUTTER_PLUGIN_TEXT_ENCODER_H_
+#define FLUTTER_PLUGIN_TEXT_ENCODER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "code_pages.h"
+
+namespace flutter_thermal_printer {
+
+/// `ESC a` values.
+enum class TextAlign { kLeft = 0, kCenter = 1, kRight = 2 };
+
+struct TextStyle {
+  TextAlign align = TextAlign::kLeft;
+  bool bold = false;
+  bool underline = false;
+  /// White on black (`GS B`).
+  bool invert = false;
+  /// Character magnification (`GS !`), 1 to kMaxTextScale.
+  int width = 1;
+  int height = 1;
+};
+
+constexpr int kMaxTextScale = 8;
+
+/// One cell of a column row: |flex| shares of the line width.
+struct TextColumn {
+  std::string text;  // UTF-8.
+  int flex = 1;
+  TextAlign align = TextAlign::kLeft;
+};
+
+/// Builds a text-mode ESC/POS ticket: styled lines, column rows wrapped to
+/// the paper width, rules, feeds and cuts, with text converted to the
+/// printer's code page. Style commands are only emitted when the style
+/// changes. Starts with `ESC @` and the `ESC t` table select. Not
+/// thread-safe.
+class TextEncoder {
+ public:
+  /// |code_page_id| is the `ESC t` number; negative sends none.
+  /// |chars_per_line| is the normal-width line, e.g. 48 on 80 mm paper.
+  TextEncoder(CodePage page, int code_page_id, int chars_per_line);
+
+  /// A line of text; the printer wraps it if it is too long.
+  void Text(const std::string &utf8, const TextStyle &style);
+
+  /// One row of |columns|, each padded to its share of the line and
+  /// word-wrapped onto further lines when it does not fit. |style.align|
+  /// is ignored; each column has its own.
+  void Columns(const std::vector<TextColumn> &columns, const TextStyle &style);
+
+  /// A full-width line of |character|, e.g. `-` between items and totals.
+  void Rule(char32_t character, const TextStyle &style);
+
+  /// Feeds |lines| (`ESC d`), up to 255.
+  void Feed(int lines);
+
+  /// Feeds to the cutter and cuts (`GS V`); |partial| leaves a tab.
+  void Cut(bool partial);
+
+  const std::vector<uint8_t>& bytes() const { return out_; }
+
+ private:
+  void ApplyStyle(const TextStyle &style);
+  /// Characters per line at |style|'s width.
+  size_t LineWidth(const TextStyle &style) const;
+  /// |utf8| in the code page, one byte per character.
+  std::vector<uint8_t> Encode(const std::string &utf8) const;
+
+  const CodePage page_;
+  const int chars_per_line_;
+  TextStyle current_;
+  std::vector<uint8_t> out_;
+};
+
+/// Decodes UTF-8, replacing malformed sequences with U+FFFD.
+std::u32string DecodeUtf8(const std::string &utf8);
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_TEXT_ENCODER_H_
@@ -0,0 +1,96 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace flutter_thermal_printer {
+
+ThreadPool::ThreadPool(size_t threads) {
+  threads = std::max<size_t>(threads, 1);
+  threads_.reserve(threads);
+  for (size_t i = 0; i < threads; ++i) {
+    threads_.emplace_back(&ThreadPool::Run, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread &thread : threads_) {
+    thread.join();
+  }
+}
+
+size_t ThreadPool::DefaultThreadCount(size_t max_threads) {
+  const size_t hardware = std::thread::hardware_concurrency();
+  return std::clamp<size_t>(hardware > 1 ? hardware - 1 : 1, 1, max_threads);
+}
+
+void ThreadPool::ParallelFor(size_t count,
+                             const std::function<void(size_t)> &fn) {
+  if (count == 0) {
+    return;
+  }
+  struct Batch {
+    std::atomic<size_t> next{0};
+    size_t done = 0;
+    std::mutex mutex;
+    std::condition_variable finished;
+  };
+  auto batch = std::make_shared<Batch>();
+  // Drains indices until none are left; shared by helpers and the caller.
+  auto drain = [batch, count, &fn]() {
+    size_t completed = 0;
+    for (size_t i = batch->next.fetch_add(1); i < count;
+         i = batch->next.fetch_add(1)) {
+      fn(i);
+      ++completed;
+    }
+    if (completed > 0) {
+      std::lock_guard<std::mutex> lock(batch->mutex);
+      batch->done += completed;
+      if (batch->done == count) {
+        batch->finished.notify_all();
+      }
+    }
+  };
+
+  const size_t helpers = std::min(count - 1, threads_.size());
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < helpers; ++i) {
+      tasks_.push_back(drain);
+    }
+  }
+  for (size_t i = 0; i < helpers; ++i) {
+    wake_.notify_one();
+  }
+  drain();
+
+  // |fn| is referenced by helpers, so wait for every index, not just ours.
+  std::unique_lock<std::mutex> lock(batch->mutex);
+  batch->finished.wait(lock, [&batch, count] { return batch->done == count; });
+}
+
+void ThreadPool::Run() {
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+      if (stopping_ && tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+}  // namespace flutter_thermal_printer
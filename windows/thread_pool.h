@@ -0,0 +1,49 @@
+#ifndef FLUTTER_PLUGIN_THREAD_POOL_H_
+#define FLUTTER_PLUGIN_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace flutter_thermal_printer {
+
+/// Fixed-size pool for data-parallel work such as converting raster bands.
+/// ParallelFor() also runs work on the calling thread, so it cannot deadlock
+/// even when every pool thread is busy.
+class ThreadPool {
+ public:
+  /// Starts |threads| workers (at least one).
+  explicit ThreadPool(size_t threads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /// Pool threads plus the calling thread.
+  size_t concurrency() const { return threads_.size() + 1; }
+
+  /// Calls |fn(i)| for every i in [0, count) and returns when all are done.
+  /// Indices are handed out in increasing order; completion order varies.
+  void ParallelFor(size_t count, const std::function<void(size_t)> &fn);
+
+  /// Default size for a pool that leaves one core to the UI: hardware
+  /// threads minus one, capped at |max_threads|.
+  static size_t DefaultThreadCount(size_t max_threads);
+
+ private:
+  void Run();
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::deque<std::function<void()>> tasks_;
+  bool stopping_ = false;
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_THREAD_POOL_H_
@@ -0,0 +1,296 @@
+#include "usb_printer.h"
+
+#include <setupapi.h>
+#include <winspool.h>
+
+#include <cstdint>
+#include <cwchar>
+#include <utility>
+#include <vector>
+
+namespace flutter_thermal_printer {
+
+namespace {
+
+// {28D78FAD-5A12-11D1-AE5B-0000F803A8C2}, GUID_DEVINTERFACE_USBPRINT.
+constexpr GUID kUsbPrintInterface = {
+    0x28d78fad,
+    0x5a12,
+    0x11d1,
+    {0xae, 0x5b, 0x00, 0x00, 0xf8, 0x03, 0xa8, 0xc2}};
+
+bool IsDisconnectError(DWORD error) {
+  return error == ERROR_INVALID_HANDLE || error == ERROR_DEVICE_NOT_CONNECTED ||
+         error == ERROR_GEN_FAILURE || error == ERROR_FILE_NOT_FOUND ||
+         error == ERROR_BAD_COMMAND;
+}
+
+// Reads up to |size| bytes within |timeout_ms|. The event handle's low
+// bit keeps the completions off the writer's completion port.
+DWORD ReadWithTimeout(HANDLE device, uint8_t *data, size_t size,
+                      DWORD timeout_ms, size_t *received) {
+  *received = 0;
+  HANDLE event = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+  if (event == nullptr) {
+    return GetLastError();
+  }
+  const ULONGLONG deadline = GetTickCount64() + timeout_ms;
+  DWORD error = ERROR_SUCCESS;
+  while (*received < size) {
+    const ULONGLONG now = GetTickCount64();
+    if (now >= deadline) {
+      error = ERROR_TIMEOUT;
+      break;
+    }
+    OVERLAPPED overlapped = {};
+    overlapped.hEvent =
+        reinterpret_cast<HANDLE>(reinterpret_cast<uintptr_t>(event) | 1);
+    if (!ReadFile(device, data + *received,
+                  static_cast<DWORD>(size - *received), nullptr,
+                  &overlapped)) {
+      error = GetLastError();
+      if (error != ERROR_IO_PENDING) {
+        break;
+      }
+      if (WaitForSingleObject(event, static_cast<DWORD>(deadline - now)) !=
+          WAIT_OBJECT_0) {
+        CancelIoEx(device, &overlapped);
+      }
+    }
+    DWORD read = 0;
+    if (!GetOverlappedResult(device, &overlapped, &read, TRUE)) {
+      error = GetLastError();
+      if (error == ERROR_OPERATION_ABORTED) {
+        error = ERROR_TIMEOUT;
+      }
+      break;
+    }
+    error = ERROR_SUCCESS;
+    if (read == 0) {
+      // Some firmware completes reads at once with nothing to say yet.
+      Sleep(10);
+    }
+    *received += read;
+  }
+  CloseHandle(event);
+  return error;
+}
+
+// usbprint stores the port it created under the interface's device
+// parameters: "Base Name" (USB) + "Port Number" (1 -> USB001).
+std::wstring PortNameForInterface(HDEVINFO devices,
+                                  SP_DEVICE_INTERFACE_DATA *interface_data) {
+  HKEY key = SetupDiOpenDeviceInterfaceRegKey(devices, interface_data, 0,
+                                              KEY_READ);
+  if (key == INVALID_HANDLE_VALUE) {
+    return std::wstring();
+  }
+  wchar_t base_name[32] = L"USB";
+  DWORD size = sizeof(base_name) - sizeof(wchar_t);
+  DWORD type = 0;
+  if (RegQueryValueExW(key, L"Base Name", nullptr, &type,
+                       reinterpret_cast<LPBYTE>(base_name), &size) !=
+          ERROR_SUCCESS ||
+      type != REG_SZ) {
+    wcscpy_s(base_name, L"USB");
+  }
+  DWORD port_number = 0;
+  size = sizeof(port_number);
+  const LONG status =
+      RegQueryValueExW(key, L"Port Number", nullptr, &type,
+                       reinterpret_cast<LPBYTE>(&port_number), &size);
+  RegCloseKey(key);
+  if (status != ERROR_SUCCESS || type != REG_DWORD) {
+    return std::wstring();
+  }
+  wchar_t port[48];
+  swprintf_s(port, L"%s%03lu", base_name, port_number);
+  return port;
+}
+
+}  // namespace
+
+UsbPrinter::UsbPrinter(std::wstring name, std::wstring device_path,
+                       OverlappedWriteOptions write_options)
+    : name_(std::move(name)),
+      configured_path_(std::move(device_path)),
+      writer_(write_options) {}
+
+UsbPrinter::~UsbPrinter() { Close(); }
+
+DWORD UsbPrinter::Open() {
+  if (device_ != INVALID_HANDLE_VALUE) {
+    return ERROR_SUCCESS;
+  }
+  std::wstring path = configured_path_;
+  if (path.empty()) {
+    std::wstring port;
+    const DWORD error = QueryPortName(&port);
+    if (error != ERROR_SUCCESS) {
+      return error;
+    }
+    path = FindDevicePath(port);
+    if (path.empty()) {
+      return ERROR_DEVICE_NOT_CONNECTED;
+    }
+  }
+  HANDLE device = CreateFileW(path.c_str(), GENERIC_WRITE | GENERIC_READ,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_OVERLAPPED, nullptr);
+  if (device == INVALID_HANDLE_VALUE) {
+    return GetLastError();
+  }
+  const DWORD error = writer_.Attach(device);
+  if (error != ERROR_SUCCESS) {
+    CloseHandle(device);
+    return error;
+  }
+  device_ = device;
+  return ERROR_SUCCESS;
+}
+
+void UsbPrinter::Close() {
+  if (device_ != INVALID_HANDLE_VALUE) {
+    writer_.Detach();
+    CloseHandle(device_);
+    device_ = INVALID_HANDLE_VALUE;
+  }
+}
+
+DWORD UsbPrinter::WriteDocument(const uint8_t* data, size_t size) {
+  DWORD error = BeginDocument();
+  if (error != ERROR_SUCCESS) {
+    return error;
+  }
+  const uint64_t taken = writer_.completed_bytes();
+  error = Write(data, size);
+  if (error == ERROR_SUCCESS) {
+    error = EndDocument();
+  }
+  if (error != ERROR_SUCCESS) {
+    // Reaps the writes still in flight, so the count below is final.
+    AbortDocument();
+  }
+  // Resent only if the device took none of it; otherwise part of the
+  // ticket would print twice, as with TcpPrinter.
+  if (IsDisconnectError(error) && writer_.completed_bytes() == taken) {
+    Close();
+    error = Open();
+    if (error == ERROR_SUCCESS) {
+      error = Write(data, size);
+    }
+    if (error == ERROR_SUCCESS) {
+      error = EndDocument();
+    }
+    if (error != ERROR_SUCCESS) {
+      AbortDocument();
+    }
+  }
+  return error;
+}
+
+DWORD UsbPrinter::BeginDocument() {
+  DWORD error = Open();
+  if (IsDisconnectError(error)) {
+    Close();
+    error = Open();
+  }
+  return error;
+}
+
+DWORD UsbPrinter::Write(const uint8_t* data, size_t size) {
+  if (device_ == INVALID_HANDLE_VALUE) {
+    return ERROR_INVALID_HANDLE;
+  }
+  return writer_.Write(data, size);
+}
+
+DWORD UsbPrinter::EndDocument() {
+  if (device_ == INVALID_HANDLE_VALUE) {
+    return ERROR_INVALID_HANDLE;
+  }
+  return writer_.Flush();
+}
+
+void UsbPrinter::AbortDocument() { writer_.Cancel(); }
+
+DWORD UsbPrinter::QueryStatus(PrinterStatus* status) {
+  if (device_ == INVALID_HANDLE_VALUE) {
+    return ERROR_INVALID_HANDLE;
+  }
+  DWORD error = writer_.Write(kStatusQuery, sizeof(kStatusQuery));
+  if (error == ERROR_SUCCESS) {
+    error = writer_.Flush();
+  }
+  uint8_t replies[kStatusReplyBytes];
+  size_t received = 0;
+  if (error == ERROR_SUCCESS) {
+    error = ReadWithTimeout(device_, replies, sizeof(replies),
+                            kStatusReplyTimeoutMs, &received);
+  }
+  if (error != ERROR_SUCCESS) {
+    return error;
+  }
+  return ParseStatusReplies(replies, received, status) ? ERROR_SUCCESS
+                                                       : ERROR_INVALID_DATA;
+}
+
+DWORD UsbPrinter::QueryPortName(std::wstring* port) const {
+  HANDLE printer = nullptr;
+  if (!OpenPrinterW(const_cast<LPWSTR>(name_.c_str()), &printer, nullptr)) {
+    return GetLastError();
+  }
+  DWORD needed = 0;
+  GetPrinterW(printer, 5, nullptr, 0, &needed);
+  std::vector<BYTE> buffer(needed);
+  DWORD error = ERROR_SUCCESS;
+  if (needed == 0 ||
+      !GetPrinterW(printer, 5, buffer.data(), needed, &needed)) {
+    error = needed == 0 ? ERROR_INVALID_PRINTER_NAME : GetLastError();
+  } else {
+    const auto* info = reinterpret_cast<const PRINTER_INFO_5W*>(buffer.data());
+    *port = info->pPortName != nullptr ? info->pPortName : L"";
+  }
+  ClosePrinter(printer);
+  return error;
+}
+
+std::wstring UsbPrinter::FindDevicePath(const std::wstring& port) {
+  HDEVINFO devices =
+      SetupDiGetClassDevsW(&kUsbPrintInterface, nullptr, nullptr,
+                           DIGCF_PRESENT | DIGCF_DEVICEINTERFACE);
+  if (devices == INVALID_HANDLE_VALUE) {
+    return std::wstring();
+  }
+  std::wstring path;
+  SP_DEVICE_INTERFACE_DATA interface_data = {};
+  interface_data.cbSize = sizeof(interface_data);
+  for (DWORD index = 0; path.empty() &&
+                        SetupDiEnumDeviceInterfaces(devices, nullptr,
+                                                    &kUsbPrintInterface, index,
+                                                    &interface_data);
+       ++index) {
+    if (_wcsicmp(PortNameForInterface(devices, &interface_data).c_str(),
+                 port.c_str()) != 0) {
+      continue;
+    }
+    DWORD needed = 0;
+    SetupDiGetDeviceInterfaceDetailW(devices, &interface_data, nullptr, 0,
+                                     &needed, nullptr);
+    if (needed < sizeof(SP_DEVICE_INTERFACE_DETAIL_DATA_W)) {
+      continue;
+    }
+    std::vector<BYTE> buffer(needed);
+    auto* detail =
+        reinterpret_cast<SP_DEVICE_INTERFACE_DETAIL_DATA_W*>(buffer.data());
+    detail->cbSize = sizeof(SP_DEVICE_INTERFACE_DETAIL_DATA_W);
+    if (SetupDiGetDeviceInterfaceDetailW(devices, &interface_data, detail,
+                                         needed, nullptr, nullptr)) {
+      path = detail->DevicePath;
+    }
+  }
+  SetupDiDestroyDeviceInfoList(devices);
+  return path;
+}
+
+}  // namespace flutter_thermal_printer
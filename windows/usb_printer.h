@@ -0,0 +1,81 @@
+#ifndef FLUTTER_PLUGIN_USB_PRINTER_H_
+#define FLUTTER_PLUGIN_USB_PRINTER_H_
+
+#include <windows.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "overlapped_writer.h"
+#include "printer_transport.h"
+
+namespace flutter_thermal_printer {
+
+/// Writes straight to a printer's usbprint device interface
+/// (`\\?\USB#VID_...`), bypassing the spooler. Chunks are pipelined through
+/// an OverlappedWriter so the bulk pipe never idles between them.
+/// Documents are just byte runs here: there is no job to start or delete.
+/// Not thread-safe; callers serialize.
+class UsbPrinter : public PrinterTransport {
+ public:
+  /// |device_path| may be empty: it is then resolved on Open() from the
+  /// queue's port (`USB001`) by matching the usbprint interface that owns
+  /// that port number.
+  UsbPrinter(std::wstring name, std::wstring device_path,
+             OverlappedWriteOptions write_options = {});
+  ~UsbPrinter() override;
+
+  UsbPrinter(const UsbPrinter&) = delete;
+  UsbPrinter& operator=(const UsbPrinter&) = delete;
+
+  const std::wstring& name() const override { return name_; }
+  bool is_open() const override { return device_ != INVALID_HANDLE_VALUE; }
+
+  DWORD Open() override;
+  void Close() override;
+
+  /// Writes |size| bytes. If the device was unplugged and re-enumerated
+  /// since the handle was opened, reopens once and retries, but only when
+  /// the device took none of the document; resending part of a ticket
+  /// would print it twice.
+  DWORD WriteDocument(const uint8_t* data, size_t size) override;
+
+  /// Opens the device; retries a stale handle since nothing is sent yet.
+  DWORD BeginDocument() override;
+
+  /// Returns once |data| is queued on the device, not written.
+  DWORD Write(const uint8_t* data, size_t size) override;
+
+  /// Waits for every queued chunk to reach the device.
+  DWORD EndDocument() override;
+
+  /// Cancels the queued chunks that have not gone out yet.
+  void AbortDocument() override;
+
+  /// Writes the status request and reads the replies from the bulk IN
+  /// pipe, which usbprint exposes through ReadFile on the same handle.
+  DWORD QueryStatus(PrinterStatus* status) override;
+
+  const OverlappedWriteOptions& write_options() const {
+    return writer_.options();
+  }
+
+  /// The usbprint interface path for USB port |port| (e.g. `USB001`), or
+  /// an empty string if no attached printer owns it.
+  static std::wstring FindDevicePath(const std::wstring& port);
+
+ private:
+  /// Port of the queue |name_| as configured in the spooler.
+  DWORD QueryPortName(std::wstring* port) const;
+
+  std::wstring name_;
+  // Explicit path from Dart; empty means resolve from the port each open.
+  std::wstring configured_path_;
+  HANDLE device_ = INVALID_HANDLE_VALUE;
+  OverlappedWriter writer_;
+};
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_USB_PRINTER_H_
@@ -0,0 +1,90 @@
+#include "wic_image_decoder.h"
+
+#include <climits>
+
+namespace flutter_thermal_printer {
+
+using Microsoft::WRL::ComPtr;
+
+ScopedComInitializer::ScopedComInitializer() {
+  // S_FALSE (already initialized) still has to be balanced; a thread that
+  // is in a single-threaded apartment keeps it.
+  const HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+  initialized_ = SUCCEEDED(hr);
+}
+
+ScopedComInitializer::~ScopedComInitializer() {
+  if (initialized_) {
+    CoUninitialize();
+  }
+}
+
+HRESULT WicImageDecoder::Open(const uint8_t *data, size_t size,
+                              std::unique_ptr<WicImageDecoder> *decoder) {
+  if (data == nullptr || size == 0 || size > ULONG_MAX) {
+    return E_INVALIDARG;
+  }
+  std::unique_ptr<WicImageDecoder> result(new WicImageDecoder());
+  HRESULT hr = CoCreateInstance(CLSID_WICImagingFactory, nullptr,
+                                CLSCTX_INPROC_SERVER,
+                                IID_PPV_ARGS(&result->factory_));
+  if (SUCCEEDED(hr)) {
+    hr = result->factory_->CreateStream(&result->stream_);
+  }
+  if (SUCCEEDED(hr)) {
+    // WIC only reads through the stream; the cast is for its signature.
+    hr = result->stream_->InitializeFromMemory(const_cast<BYTE *>(data),
+                                               static_cast<DWORD>(size));
+  }
+  if (SUCCEEDED(hr)) {
+    hr = result->factory_->CreateDecoderFromStream(
+        result->stream_.Get(), nullptr, WICDecodeMetadataCacheOnDemand,
+        &result->decoder_);
+  }
+  ComPtr<IWICBitmapFrameDecode> frame;
+  if (SUCCEEDED(hr)) {
+    hr = result->decoder_->GetFrame(0, &frame);
+  }
+  if (SUCCEEDED(hr)) {
+    hr = result->factory_->CreateFormatConverter(&result->converter_);
+  }
+  if (SUCCEEDED(hr)) {
+    hr = result->converter_->Initialize(
+        frame.Get(), GUID_WICPixelFormat32bppRGBA, WICBitmapDitherTypeNone,
+        nullptr, 0.0, WICBitmapPaletteTypeCustom);
+  }
+  UINT width = 0;
+  UINT height = 0;
+  if (SUCCEEDED(hr)) {
+    hr = result->converter_->GetSize(&width, &height);
+  }
+  if (SUCCEEDED(hr) &&
+      (width == 0 || height == 0 || width > INT_MAX / 4 || height > INT_MAX)) {
+    hr = WINCODEC_ERR_IMAGESIZEOUTOFRANGE;
+  }
+  if (FAILED(hr)) {
+    return hr;
+  }
+  result->width_ = static_cast<int>(width);
+  result->height_ = static_cast<int>(height);
+  *decoder = std::move(result);
+  return S_OK;
+}
+
+const uint8_t *WicImageDecoder::ReadRows(int first_row, int rows) {
+  if (first_row < 0 || rows <= 0 || first_row + rows > height_) {
+    return nullptr;
+  }
+  const UINT stride = static_cast<UINT>(width_) * 4;
+  const size_t size = static_cast<size_t>(stride) * rows;
+  if (size > UINT_MAX) {
+    return nullptr;
+  }
+  rows_.resize(size);
+  const WICRect rect = {0, first_row, width_, rows};
+  const HRESULT hr = converter_->CopyPixels(
+      &rect, stride, static_cast<UINT>(size), rows_.data());
+  return SUCCEEDED(hr) ? rows_.data() : nullptr;
+}
+
+}  // namespace flutter_thermal_printer
@@ -0,0 +1,68 @@
+#ifndef FLUTTER_PLUGIN_WIC_IMAGE_DECODER_H_
+#define FLUTTER_PLUGIN_WIC_IMAGE_DECODER_H_
+
+#include <windows.h>
+#include <wincodec.h>
+#include <wrl/client.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace flutter_thermal_printer {
+
+/// Joins the calling thread to the multithreaded COM apartment for its
+/// lifetime, unless the thread already belongs to one.
+class ScopedComInitializer {
+ public:
+  ScopedComInitializer();
+  ~ScopedComInitializer();
+
+  ScopedComInitializer(const ScopedComInitializer&) = delete;
+  ScopedComInitializer& operator=(const ScopedComInitializer&) = delete;
+
+ private:
+  bool initialized_ = false;
+};
+
+/// Decodes an encoded image (PNG from a widget capture, or anything else
+/// WIC reads) into RGBA rows on demand, a band at a time, so the plugin
+/// never holds the full-size bitmap. Rows come out non-premultiplied,
+/// which is what the raster engine composites over paper.
+///
+/// The encoded bytes are not copied and must outlive the decoder. COM must
+/// be initialized on the calling thread. Not thread-safe.
+class WicImageDecoder {
+ public:
+  /// Parses the header of |data|. Fails with the WIC HRESULT if it is not
+  /// an image WIC can decode.
+  static HRESULT Open(const uint8_t *data, size_t size,
+                      std::unique_ptr<WicImageDecoder> *decoder);
+
+  WicImageDecoder(const WicImageDecoder&) = delete;
+  WicImageDecoder& operator=(const WicImageDecoder&) = delete;
+
+  int width() const { return width_; }
+  int height() const { return height_; }
+
+  /// Decodes |rows| rows from |first_row| into a buffer owned by the
+  /// decoder, valid until the next call; nullptr on a decode error.
+  /// Suits RgbaRowSource, so rows should be read top to bottom.
+  const uint8_t *ReadRows(int first_row, int rows);
+
+ private:
+  WicImageDecoder() = default;
+
+  Microsoft::WRL::ComPtr<IWICImagingFactory> factory_;
+  Microsoft::WRL::ComPtr<IWICStream> stream_;
+  Microsoft::WRL::ComPtr<IWICBitmapDecoder> decoder_;
+  Microsoft::WRL::ComPtr<IWICFormatConverter> converter_;
+  int width_ = 0;
+  int height_ = 0;
+  std::vector<uint8_t> rows_;
+};
+
+}  // namespace flutter_thermal_printer
+
+#endif  // FLUTTER_PLUGIN_WIC_IMAGE_DECODER_H_